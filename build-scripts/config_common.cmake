@@ -165,12 +165,44 @@ elseif (NOT (WAMR_BUILD_SANITIZER STREQUAL "") )
 endif()
 
 if (WAMR_BUILD_LINUX_PERF EQUAL 1)
-  if (NOT WAMR_BUILD_JIT AND NOT WAMR_BUILD_AOT)
-    message(WARNING "only support perf in aot and llvm-jit")
+  if (NOT WAMR_BUILD_JIT AND NOT WAMR_BUILD_FAST_JIT AND NOT WAMR_BUILD_AOT)
+    message(WARNING "only support perf in aot, llvm-jit and fast-jit")
     set(WAMR_BUILD_LINUX_PERF 0)
   endif ()
 endif ()
 
+if (WAMR_BUILD_HW_PERF_COUNTERS EQUAL 1)
+  if (NOT WAMR_BUILD_PLATFORM STREQUAL "linux")
+    message(WARNING "only support hardware performance counters on linux")
+    set(WAMR_BUILD_HW_PERF_COUNTERS 0)
+  else ()
+    # the counters are reported with the performance profiling data
+    set(WAMR_BUILD_PERF_PROFILING 1)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_FUEL EQUAL 1)
+  if (WAMR_BUILD_FAST_JIT EQUAL 1 OR WAMR_BUILD_JIT EQUAL 1)
+    message(FATAL_ERROR "fuel metering doesn't support Fast JIT or LLVM JIT")
+  endif ()
+  if (WAMR_BUILD_INTERP EQUAL 1 AND NOT WAMR_BUILD_FAST_INTERP EQUAL 1)
+    message(FATAL_ERROR "fuel metering doesn't support the classic interpreter, enable the fast interpreter")
+  endif ()
+endif ()
+
+if (WAMR_BUILD_SAMPLING_PROFILER EQUAL 1)
+  if (NOT WAMR_BUILD_PLATFORM STREQUAL "linux"
+      AND NOT WAMR_BUILD_PLATFORM STREQUAL "darwin")
+    message(WARNING "only support sampling profiler on linux and darwin")
+    set(WAMR_BUILD_SAMPLING_PROFILER 0)
+  else ()
+    # the samples are taken with wasm_copy_callstack, which walks the
+    # frames kept for dumping the call stack
+    set(WAMR_ENABLE_COPY_CALLSTACK 1)
+    set(WAMR_BUILD_DUMP_CALL_STACK 1)
+  endif ()
+endif ()
+
 if (NOT DEFINED WAMR_BUILD_SHRUNK_MEMORY)
   # Enable shrunk memory by default
   set (WAMR_BUILD_SHRUNK_MEMORY 1)
@@ -361,6 +393,47 @@ if (WAMR_BUILD_MINI_LOADER EQUAL 1)
 else ()
   add_definitions (-DWASM_ENABLE_MINI_LOADER=0)
 endif ()
+if (WAMR_BUILD_PARALLEL_LOADER EQUAL 1)
+  if (WAMR_BUILD_LAZY_LOADER EQUAL 1)
+    message (FATAL_ERROR "parallel loader and lazy loader can't be enabled at the same time")
+  endif ()
+  if (WAMR_BUILD_MINI_LOADER EQUAL 1)
+    message (WARNING "     Parallel loader isn't supported by the mini loader")
+  else ()
+    add_definitions (-DWASM_ENABLE_PARALLEL_LOADER=1)
+    message ("     Parallel loader enabled")
+  endif ()
+endif ()
+if (WAMR_BUILD_LAZY_LOADER EQUAL 1)
+  if (WAMR_BUILD_MINI_LOADER EQUAL 1 OR WAMR_BUILD_FAST_JIT EQUAL 1
+      OR WAMR_BUILD_JIT EQUAL 1 OR WAMR_BUILD_DEBUG_INTERP EQUAL 1)
+    message (WARNING "     Lazy loader isn't supported by the mini loader, JIT "
+                     "and debug interpreter")
+  else ()
+    add_definitions (-DWASM_ENABLE_LAZY_LOADER=1)
+    message ("     Lazy loader enabled")
+  endif ()
+endif ()
+if (WAMR_BUILD_STREAMING_LOADER EQUAL 1)
+  if (WAMR_BUILD_MINI_LOADER EQUAL 1)
+    message (WARNING "     Streaming loader isn't supported by the mini loader")
+  else ()
+    add_definitions (-DWASM_ENABLE_STREAMING_LOADER=1)
+    message ("     Streaming loader enabled")
+  endif ()
+endif ()
+if (WAMR_BUILD_MODULE_IMAGE EQUAL 1)
+  if (NOT WAMR_BUILD_FAST_INTERP EQUAL 1 OR WAMR_BUILD_MINI_LOADER EQUAL 1
+      OR WAMR_BUILD_JIT EQUAL 1 OR WAMR_BUILD_FAST_JIT EQUAL 1
+      OR WAMR_BUILD_LAZY_LOADER EQUAL 1 OR WAMR_BUILD_GC EQUAL 1
+      OR WAMR_BUILD_EXCE_HANDLING EQUAL 1 OR WAMR_BUILD_DEBUG_INTERP EQUAL 1
+      OR NOT WAMR_BUILD_PLATFORM MATCHES "^(linux|darwin)$")
+    message (WARNING "     Module image is only supported by the fast interpreter without JIT, GC, exception handling, lazy loader or debug interpreter on Linux and MacOS")
+  else ()
+    add_definitions (-DWASM_ENABLE_MODULE_IMAGE=1)
+    message ("     Module image enabled")
+  endif ()
+endif ()
 if (WAMR_DISABLE_HW_BOUND_CHECK EQUAL 1)
   add_definitions (-DWASM_DISABLE_HW_BOUND_CHECK=1)
   add_definitions (-DWASM_DISABLE_STACK_HW_BOUND_CHECK=1)
@@ -403,6 +476,22 @@ if (WAMR_BUILD_PERF_PROFILING EQUAL 1)
   add_definitions (-DWASM_ENABLE_PERF_PROFILING=1)
   message ("     Performance profiling enabled")
 endif ()
+if (WAMR_BUILD_HW_PERF_COUNTERS EQUAL 1)
+  add_definitions (-DWASM_ENABLE_HW_PERF_COUNTERS=1)
+  message ("     Hardware performance counters enabled")
+endif ()
+if (WAMR_BUILD_INSTANCE_STATS EQUAL 1)
+  add_definitions (-DWASM_ENABLE_INSTANCE_STATS=1)
+  message ("     Instance stats enabled")
+endif ()
+if (WAMR_BUILD_FUEL EQUAL 1)
+  add_definitions (-DWASM_ENABLE_FUEL=1)
+  message ("     Fuel metering enabled")
+endif ()
+if (WAMR_BUILD_SAMPLING_PROFILER EQUAL 1)
+  add_definitions (-DWASM_ENABLE_SAMPLING_PROFILER=1)
+  message ("     Sampling profiler enabled")
+endif ()
 if (DEFINED WAMR_APP_THREAD_STACK_SIZE_MAX)
   add_definitions (-DAPP_THREAD_STACK_SIZE_MAX=${WAMR_APP_THREAD_STACK_SIZE_MAX})
 endif ()
@@ -431,6 +520,22 @@ if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_PERF_PROFILING EQUAL 1)
 else ()
   message ("     GC performance profiling disabled")
 endif ()
+if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_GENERATIONAL EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_GENERATIONAL=1)
+  message ("     Generational GC enabled")
+endif ()
+if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_PARALLEL EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_PARALLEL=1)
+  message ("     Parallel GC enabled")
+endif ()
+if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_INCREMENTAL EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_INCREMENTAL=1)
+  message ("     Incremental GC enabled")
+endif ()
+if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_GROWABLE_HEAP EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_GROWABLE_HEAP=1)
+  message ("     Growable GC heap enabled")
+endif ()
 if (WAMR_BUILD_STRINGREF EQUAL 1)
   if (NOT DEFINED WAMR_STRINGREF_IMPL_SOURCE)
     message ("       Using WAMR builtin implementation for stringref")
@@ -638,6 +743,22 @@ else ()
   # Disable quick aot/jit entries for interp and fast-jit
   add_definitions (-DWASM_ENABLE_QUICK_AOT_ENTRY=0)
 endif ()
+if (WAMR_BUILD_INTERP EQUAL 1 OR WAMR_BUILD_FAST_JIT EQUAL 1
+    OR WAMR_BUILD_JIT EQUAL 1)
+  if (NOT DEFINED WAMR_BUILD_QUICK_NATIVE_ENTRY)
+    # Enable quick native entries by default
+    set (WAMR_BUILD_QUICK_NATIVE_ENTRY 1)
+  endif ()
+  if (WAMR_BUILD_QUICK_NATIVE_ENTRY EQUAL 1)
+    add_definitions (-DWASM_ENABLE_QUICK_NATIVE_ENTRY=1)
+    message ("     Quick native entries enabled")
+  else ()
+    add_definitions (-DWASM_ENABLE_QUICK_NATIVE_ENTRY=0)
+    message ("     Quick native entries disabled")
+  endif ()
+else ()
+  add_definitions (-DWASM_ENABLE_QUICK_NATIVE_ENTRY=0)
+endif ()
 if (WAMR_BUILD_AOT EQUAL 1)
   if (NOT DEFINED WAMR_BUILD_AOT_INTRINSICS)
     # Enable aot intrinsics by default
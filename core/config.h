@@ -84,7 +84,7 @@
 #endif
 
 #define AOT_MAGIC_NUMBER 0x746f6100
-#define AOT_CURRENT_VERSION 4
+#define AOT_CURRENT_VERSION 5
 
 #ifndef WASM_ENABLE_JIT
 #define WASM_ENABLE_JIT 0
@@ -305,6 +305,29 @@
 #define WASM_ENABLE_MINI_LOADER 0
 #endif
 
+/* Parallel loader (validating the function bodies with helper threads) */
+#ifndef WASM_ENABLE_PARALLEL_LOADER
+#define WASM_ENABLE_PARALLEL_LOADER 0
+#endif
+
+/* Lazy loader (validating a function body when it is called first time) */
+#ifndef WASM_ENABLE_LAZY_LOADER
+#define WASM_ENABLE_LAZY_LOADER 0
+#elif WASM_ENABLE_LAZY_LOADER != 0 && WASM_ENABLE_PARALLEL_LOADER != 0
+#error "Lazy loader and parallel loader can't be enabled at the same time"
+#endif
+
+/* Streaming loader (loading the sections of a module as they arrive) */
+#ifndef WASM_ENABLE_STREAMING_LOADER
+#define WASM_ENABLE_STREAMING_LOADER 0
+#endif
+
+/* Module image (sharing the prepared function bodies of a module between
+   processes with a file mapped read-only) */
+#ifndef WASM_ENABLE_MODULE_IMAGE
+#define WASM_ENABLE_MODULE_IMAGE 0
+#endif
+
 /* Disable boundary check with hardware trap or not,
  * enable it by default if it is supported */
 #ifndef WASM_DISABLE_HW_BOUND_CHECK
@@ -333,6 +356,26 @@ unless used elsewhere */
 #define WASM_ENABLE_GC_PERF_PROFILING 0
 #endif
 
+/* Generational GC (minor GC of the young objects) */
+#ifndef WASM_ENABLE_GC_GENERATIONAL
+#define WASM_ENABLE_GC_GENERATIONAL 0
+#endif
+
+/* Parallel GC (marking and sweeping with helper threads) */
+#ifndef WASM_ENABLE_GC_PARALLEL
+#define WASM_ENABLE_GC_PARALLEL 0
+#endif
+
+/* Incremental GC (marking and sweeping in slices with a time budget) */
+#ifndef WASM_ENABLE_GC_INCREMENTAL
+#define WASM_ENABLE_GC_INCREMENTAL 0
+#endif
+
+/* Growable GC heap (reserve the maximum size and commit on demand) */
+#ifndef WASM_ENABLE_GC_GROWABLE_HEAP
+#define WASM_ENABLE_GC_GROWABLE_HEAP 0
+#endif
+
 /* Memory profiling */
 #ifndef WASM_ENABLE_MEMORY_PROFILING
 #define WASM_ENABLE_MEMORY_PROFILING 0
@@ -348,11 +391,45 @@ unless used elsewhere */
 #define WASM_ENABLE_PERF_PROFILING 0
 #endif
 
+/* Hardware performance counters of each function in the performance
+   profiling data */
+#ifndef WASM_ENABLE_HW_PERF_COUNTERS
+#define WASM_ENABLE_HW_PERF_COUNTERS 0
+#elif WASM_ENABLE_HW_PERF_COUNTERS != 0 && WASM_ENABLE_PERF_PROFILING == 0
+#error "Hardware performance counters require performance profiling"
+#endif
+
+/* Resource accounting of each module instance */
+#ifndef WASM_ENABLE_INSTANCE_STATS
+#define WASM_ENABLE_INSTANCE_STATS 0
+#endif
+
+/* Deterministic fuel metering, the fuel of an exec_env is charged per
+   basic block and checked at function entries and loop headers, by the
+   fast interpreter and the AOT code */
+#ifndef WASM_ENABLE_FUEL
+#define WASM_ENABLE_FUEL 0
+#elif WASM_ENABLE_FUEL != 0 && WASM_ENABLE_WAMR_COMPILER == 0 \
+    && (WASM_ENABLE_FAST_JIT != 0 || WASM_ENABLE_JIT != 0)
+#error "Fuel metering doesn't support Fast JIT or LLVM JIT"
+#elif WASM_ENABLE_FUEL != 0 && WASM_ENABLE_WAMR_COMPILER == 0 \
+    && WASM_ENABLE_INTERP != 0 && WASM_ENABLE_FAST_INTERP == 0
+#error "Fuel metering doesn't support the classic interpreter"
+#endif
+
 /* Dump call stack */
 #ifndef WASM_ENABLE_DUMP_CALL_STACK
 #define WASM_ENABLE_DUMP_CALL_STACK 0
 #endif
 
+/* Sampling profiler, the samples are taken with wasm_copy_callstack */
+#ifndef WASM_ENABLE_SAMPLING_PROFILER
+#define WASM_ENABLE_SAMPLING_PROFILER 0
+#elif WASM_ENABLE_SAMPLING_PROFILER != 0 \
+    && (WAMR_ENABLE_COPY_CALLSTACK == 0 || WASM_ENABLE_DUMP_CALL_STACK == 0)
+#error "Sampling profiler requires copy callstack and dump call stack"
+#endif
+
 /* AOT stack frame */
 #ifndef WASM_ENABLE_AOT_STACK_FRAME
 #define WASM_ENABLE_AOT_STACK_FRAME 0
@@ -667,6 +744,13 @@ unless used elsewhere */
 #define WASM_ENABLE_QUICK_AOT_ENTRY 1
 #endif
 
+/* Support calling the native functions imported by the interpreter and
+   JIT with the quick entries of their signatures, instead of building
+   the arguments for invokeNative in each call */
+#ifndef WASM_ENABLE_QUICK_NATIVE_ENTRY
+#define WASM_ENABLE_QUICK_NATIVE_ENTRY 1
+#endif
+
 /* Support AOT intrinsic functions which can be called from the AOT code
    when `--disable-llvm-intrinsics` flag or
    `--enable-builtin-intrinsics=<intr1,intr2,...>` is used by wamrc to
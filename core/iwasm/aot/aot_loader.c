@@ -513,6 +513,14 @@ check_feature_flags(char *error_buf, uint32 error_buf_size,
     }
 #endif
 
+#if WASM_ENABLE_FUEL == 0
+    if (feature_flags & WASM_FEATURE_FUEL) {
+        set_error_buf(error_buf, error_buf_size,
+                      "fuel metering is not enabled in this build");
+        return false;
+    }
+#endif
+
     return true;
 }
 
@@ -604,10 +612,23 @@ load_target_info_section(const uint8 *buf, const uint8 *buf_end,
         return false;
     }
 
-#if WASM_ENABLE_DUMP_CALL_STACK != 0
+#if WASM_ENABLE_AOT_STACK_FRAME != 0 || WASM_ENABLE_GC != 0
     module->feature_flags = target_info.feature_flags;
 #endif
 
+#if WASM_ENABLE_GC != 0
+    /* The GC objects are allocated inline and the write barriers are
+       emitted since version 5, an older GC module would store old to
+       young references unseen by the generational GC */
+    if ((target_info.feature_flags & WASM_FEATURE_GARBAGE_COLLECTION)
+        && module->package_version < 5) {
+        set_error_buf(error_buf, error_buf_size,
+                      "garbage collection module compiled by an older "
+                      "wamrc, please recompile it");
+        return false;
+    }
+#endif
+
     /* Finally, check feature flags */
     return check_feature_flags(error_buf, error_buf_size,
                                target_info.feature_flags);
@@ -4327,7 +4348,7 @@ aot_compatible_version(uint32 version)
      * refer to "AoT-compiled module compatibility among WAMR versions" in
      * ./doc/biuld_wasm_app.md
      */
-    return version == 4 || version == 3;
+    return version == 5 || version == 4 || version == 3;
 }
 
 static bool
@@ -12,6 +12,9 @@
 #if WASM_ENABLE_STRINGREF != 0
 #include "string_object.h"
 #endif
+#if WASM_ENABLE_FUEL != 0
+#include "../common/wasm_fuel.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -154,6 +157,8 @@ typedef struct {
     REG_SYM(wasm_externref_obj_to_internal_obj), \
     REG_SYM(wasm_internal_obj_to_externref_obj), \
     REG_SYM(wasm_obj_is_type_of),          \
+    REG_SYM(wasm_obj_pre_write_barrier),   \
+    REG_SYM(wasm_obj_write_barrier),       \
     REG_SYM(wasm_struct_obj_new),
 #else
 #define REG_GC_SYM()
@@ -185,6 +190,13 @@ typedef struct {
 #define REG_STRINGREF_SYM()
 #endif
 
+#if WASM_ENABLE_FUEL != 0
+#define REG_FUEL_SYM()                     \
+    REG_SYM(wasm_fuel_exhausted),
+#else
+#define REG_FUEL_SYM()
+#endif
+
 #define REG_COMMON_SYMBOLS                \
     REG_SYM(aot_set_exception_with_id),   \
     REG_SYM(aot_invoke_native),           \
@@ -218,6 +230,7 @@ typedef struct {
     REG_LLVM_PGO_SYM()                    \
     REG_GC_SYM()                          \
     REG_STRINGREF_SYM()                   \
+    REG_FUEL_SYM()                        \
 
 #define CHECK_RELOC_OFFSET(data_size) do {              \
     if (!check_reloc_offset(target_section_size,        \
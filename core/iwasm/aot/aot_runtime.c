@@ -20,6 +20,7 @@
 /*
  * Note: These offsets need to match the values hardcoded in
  * AoT compilation code: aot_create_func_context, check_suspend_flags.
+ * The offset of the fuel is checked in wasm_exec_env.c.
  */
 
 bh_static_assert(offsetof(WASMExecEnv, cur_frame) == 1 * sizeof(uintptr_t));
@@ -60,6 +61,12 @@ bh_static_assert(offsetof(AOTModuleInstanceExtra, stack_sizes) == 0);
 bh_static_assert(offsetof(AOTModuleInstanceExtra, shared_heap_base_addr_adj)
                  == 8);
 bh_static_assert(offsetof(AOTModuleInstanceExtra, shared_heap_start_off) == 16);
+#if WASM_ENABLE_GC != 0
+bh_static_assert(offsetof(AOTModuleInstanceExtra, gc_tlab)
+                 == AOT_INST_EXTRA_GC_TLAB_OFFSET);
+bh_static_assert(offsetof(AOTModuleInstanceExtra, rtt_types)
+                 == AOT_INST_EXTRA_RTT_TYPES_OFFSET);
+#endif
 
 bh_static_assert(sizeof(CApiFuncImport) == sizeof(uintptr_t) * 3);
 
@@ -1830,27 +1837,67 @@ aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
     module_inst->e =
         (WASMModuleInstanceExtra *)((uint8 *)module_inst + extra_info_offset);
     extra = (AOTModuleInstanceExtra *)module_inst->e;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_init((WASMModuleInstanceCommon *)module_inst,
+                             (WASMModuleInstanceCommon *)parent);
+#endif
 
 #if WASM_ENABLE_GC != 0
     /* Initialize gc heap first since it may be used when initializing
        globals and others */
     if (!is_sub_inst) {
         uint32 gc_heap_size = wasm_runtime_get_gc_heap_size_default();
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+        uint32 gc_heap_max_size = wasm_runtime_get_gc_heap_max_size_default();
+#endif
 
         if (gc_heap_size < GC_HEAP_SIZE_MIN)
             gc_heap_size = GC_HEAP_SIZE_MIN;
         if (gc_heap_size > GC_HEAP_SIZE_MAX)
             gc_heap_size = GC_HEAP_SIZE_MAX;
 
-        extra->common.gc_heap_pool =
-            runtime_malloc(gc_heap_size, error_buf, error_buf_size);
-        if (!extra->common.gc_heap_pool)
-            goto fail;
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+        if (gc_heap_max_size > gc_heap_size) {
+            if (gc_heap_max_size > GC_HEAP_SIZE_MAX)
+                gc_heap_max_size = GC_HEAP_SIZE_MAX;
+            /* the heap reserves its own address range, no pool is used */
+            extra->common.gc_heap_handle =
+                mem_allocator_create_growable(gc_heap_size, gc_heap_max_size);
+            if (!extra->common.gc_heap_handle) {
+                set_error_buf(error_buf, error_buf_size,
+                              "create growable gc heap failed");
+                goto fail;
+            }
+        }
+        else
+#endif
+        {
+            extra->common.gc_heap_pool =
+                runtime_malloc(gc_heap_size, error_buf, error_buf_size);
+            if (!extra->common.gc_heap_pool)
+                goto fail;
 
-        extra->common.gc_heap_handle =
-            mem_allocator_create(extra->common.gc_heap_pool, gc_heap_size);
-        if (!extra->common.gc_heap_handle)
-            goto fail;
+            extra->common.gc_heap_handle = mem_allocator_create(
+                extra->common.gc_heap_pool, gc_heap_size);
+            if (!extra->common.gc_heap_handle)
+                goto fail;
+        }
+
+#if WASM_ENABLE_GC_GENERATIONAL != 0
+        /* The minor GC relies on the write barrier, which isn't
+           emitted by the older versions of wamrc */
+        if (!(module->feature_flags & WASM_FEATURE_GC_WRITE_BARRIER))
+            mem_allocator_disable_minor_gc(extra->common.gc_heap_handle);
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        /* The incremental marking relies on the pre write barrier */
+        if (!(module->feature_flags & WASM_FEATURE_GC_PRE_WRITE_BARRIER))
+            mem_allocator_disable_incremental_gc(
+                extra->common.gc_heap_handle);
+#endif
+        extra->gc_tlab =
+            mem_allocator_get_tlab(extra->common.gc_heap_handle);
+        extra->rtt_types = module->rtt_types;
     }
 #endif
 
@@ -2440,6 +2487,11 @@ aot_call_function(WASMExecEnv *exec_env, AOTFunctionInstance *function,
                          ? function->u.func_import->func_ptr_linked
                          : function->u.func.func_ptr;
     void *attachment = NULL;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    uint8 stats_state = function->is_import_func ? WASM_STATS_STATE_HOST
+                                                 : WASM_STATS_STATE_WASM;
+    uint8 prev_stats_state;
+#endif
 #if WASM_ENABLE_MULTI_MODULE != 0
     bh_list *sub_module_list_node = NULL;
     const char *sub_inst_name = NULL;
@@ -2553,9 +2605,15 @@ aot_call_function(WASMExecEnv *exec_env, AOTFunctionInstance *function,
         }
 #endif
 
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        prev_stats_state = wasm_instance_stats_switch(exec_env, stats_state);
+#endif
         ret = invoke_native_internal(exec_env, function->u.func.func_ptr,
                                      func_type, NULL, attachment, argv1, argc,
                                      argv);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
 
         if (!ret) {
 #ifdef AOT_STACK_FRAME_DEBUG
@@ -2627,8 +2685,14 @@ aot_call_function(WASMExecEnv *exec_env, AOTFunctionInstance *function,
         }
 #endif
 
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        prev_stats_state = wasm_instance_stats_switch(exec_env, stats_state);
+#endif
         ret = invoke_native_internal(exec_env, func_ptr, func_type, NULL,
                                      attachment, argv, argc, argv);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
 
         if (!ret) {
 #ifdef AOT_STACK_FRAME_DEBUG
@@ -2655,6 +2719,68 @@ aot_call_function(WASMExecEnv *exec_env, AOTFunctionInstance *function,
     }
 }
 
+void
+aot_call_function_batch(WASMExecEnv *exec_env, AOTFunctionInstance *function,
+                        WASMBatchCall *batch)
+{
+    AOTModuleInstance *module_inst = (AOTModuleInstance *)exec_env->module_inst;
+    uint32 i;
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+    WASMJmpBuf jmpbuf_node = { 0 }, *jmpbuf_node_pop;
+    /* it is changed after os_setjmp and read after os_longjmp */
+    volatile uint32 next = 0;
+
+    /* Set up the signal env once and keep it with an outer jmpbuf, so
+       that each call only pushes its own jmpbuf */
+    if (!wasm_runtime_get_exec_env_tls()) {
+        if (!os_thread_signal_inited()) {
+            aot_set_exception(module_inst, "thread signal env not inited");
+            wasm_runtime_batch_call_abort(batch, 0);
+            return;
+        }
+        wasm_exec_env_set_thread_info(exec_env);
+        wasm_runtime_set_exec_env_tls(exec_env);
+    }
+
+    wasm_exec_env_push_jmpbuf(exec_env, &jmpbuf_node);
+
+    if (os_setjmp(jmpbuf_node.jmpbuf) == 0) {
+        for (i = 0; i < batch->num_calls; i++) {
+            next = i;
+            wasm_runtime_batch_call_begin(batch, i);
+            if (!wasm_runtime_batch_call_end(
+                    (WASMModuleInstanceCommon *)module_inst, batch, i,
+                    aot_call_function(exec_env, function,
+                                      batch->param_cell_num, batch->argv)))
+                break;
+        }
+    }
+    else {
+        /* The calls catch their traps, it is only reached if the
+           runtime itself traps, stop the batch */
+        os_sigreturn();
+        os_signal_unmask();
+        wasm_runtime_batch_call_abort(batch, next);
+    }
+
+    jmpbuf_node_pop = wasm_exec_env_pop_jmpbuf(exec_env);
+    bh_assert(&jmpbuf_node == jmpbuf_node_pop);
+    if (!exec_env->jmpbuf_stack_top) {
+        wasm_runtime_set_exec_env_tls(NULL);
+    }
+    (void)jmpbuf_node_pop;
+#else
+    for (i = 0; i < batch->num_calls; i++) {
+        wasm_runtime_batch_call_begin(batch, i);
+        if (!wasm_runtime_batch_call_end(
+                (WASMModuleInstanceCommon *)module_inst, batch, i,
+                aot_call_function(exec_env, function, batch->param_cell_num,
+                                  batch->argv)))
+            break;
+    }
+#endif
+}
+
 void
 aot_set_exception(AOTModuleInstance *module_inst, const char *exception)
 {
@@ -3098,6 +3224,11 @@ aot_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
     void *attachment;
     char buf[96];
     bool ret = false;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    /* exec_env may be switched to the one of the sub module instance */
+    WASMExecEnv *caller_exec_env = exec_env;
+    uint8 prev_stats_state = WASM_STATS_STATE_NONE;
+#endif
     bh_assert(func_idx < aot_module->import_func_count);
 
     import_func = aot_module->import_funcs + func_idx;
@@ -3114,6 +3245,10 @@ aot_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
     }
 
     attachment = import_func->attachment;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    prev_stats_state =
+        wasm_instance_stats_switch(exec_env, WASM_STATS_STATE_HOST);
+#endif
     if (import_func->call_conv_wasm_c_api) {
         ret = wasm_runtime_invoke_c_api_native(
             (WASMModuleInstanceCommon *)module_inst, func_ptr, func_type, argc,
@@ -3159,6 +3294,11 @@ aot_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
     }
 
 fail:
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    /* the unlinked import function isn't called */
+    if (func_ptr)
+        wasm_instance_stats_switch(caller_exec_env, prev_stats_state);
+#endif
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     if (!ret)
         wasm_runtime_access_exce_check_guard_page();
@@ -3184,6 +3324,9 @@ aot_call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 table_elem_idx,
     void *attachment = NULL;
     char buf[96];
     bool ret;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    uint8 stats_state, prev_stats_state;
+#endif
 
     /* this function is called from native code, so exec_env->handle and
        exec_env->native_stack_boundary must have been set, we don't set
@@ -3232,15 +3375,28 @@ aot_call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 table_elem_idx,
         goto fail;
     }
 
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    stats_state = func_idx < aot_module->import_func_count
+                      ? WASM_STATS_STATE_HOST
+                      : WASM_STATS_STATE_WASM;
+#endif
+
     if (func_idx < aot_module->import_func_count) {
         /* Call native function */
         import_func = aot_module->import_funcs + func_idx;
         signature = import_func->signature;
         attachment = import_func->attachment;
         if (import_func->call_conv_raw) {
+#if WASM_ENABLE_INSTANCE_STATS != 0
+            prev_stats_state =
+                wasm_instance_stats_switch(exec_env, stats_state);
+#endif
             ret = wasm_runtime_invoke_native_raw(exec_env, func_ptr, func_type,
                                                  signature, attachment, argv,
                                                  argc, argv);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+            wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
             if (!ret)
                 goto fail;
 
@@ -3293,9 +3449,15 @@ aot_call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 table_elem_idx,
                 wasm_runtime_free(argv1);
             return false;
         }
+#endif
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        prev_stats_state = wasm_instance_stats_switch(exec_env, stats_state);
 #endif
         ret = invoke_native_internal(exec_env, func_ptr, func_type, signature,
                                      attachment, argv1, argc, argv);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
 #if WASM_ENABLE_AOT_STACK_FRAME != 0
         /* Free all frames allocated, note that some frames
            may be allocated in AOT code and haven't been
@@ -3353,9 +3515,15 @@ aot_call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 table_elem_idx,
             && !aot_alloc_frame(exec_env, func_idx)) {
             return false;
         }
+#endif
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        prev_stats_state = wasm_instance_stats_switch(exec_env, stats_state);
 #endif
         ret = invoke_native_internal(exec_env, func_ptr, func_type, signature,
                                      attachment, argv, argc, argv);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+        wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
 #if WASM_ENABLE_AOT_STACK_FRAME != 0
         /* Free all frames allocated, note that some frames
            may be allocated in AOT code and haven't been
@@ -3908,6 +4076,18 @@ get_func_name_from_index(const AOTModuleInstance *module_inst,
 #endif /* end of WASM_ENABLE_DUMP_CALL_STACK != 0 || \
           WASM_ENABLE_PERF_PROFILING != 0 */
 
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+/* Add the hardware counters since the last call or return to the function
+   of the frame, which is the one that ran meanwhile */
+static inline void
+aot_frame_attribute_hw_counters(WASMExecEnv *exec_env, AOTFrame *frame)
+{
+    wasm_hw_counters_attribute(
+        &exec_env->hw_counters,
+        frame ? frame->func_perf_prof_info->hw_counters : NULL);
+}
+#endif
+
 #if WASM_ENABLE_GC == 0
 static bool
 aot_alloc_standard_frame(WASMExecEnv *exec_env, uint32 func_index)
@@ -3941,6 +4121,10 @@ aot_alloc_standard_frame(WASMExecEnv *exec_env, uint32 func_index)
     frame->time_started = (uintptr_t)os_time_thread_cputime_us();
     frame->func_perf_prof_info = func_perf_prof;
 #endif
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    /* the caller ran until now */
+    aot_frame_attribute_hw_counters(exec_env, (AOTFrame *)exec_env->cur_frame);
+#endif
 #if WASM_ENABLE_MEMORY_PROFILING != 0
     {
         uint32 wasm_stack_used =
@@ -4000,6 +4184,10 @@ aot_alloc_standard_frame(WASMExecEnv *exec_env, uint32 func_index)
     frame->time_started = (uintptr_t)os_time_thread_cputime_us();
     frame->func_perf_prof_info = func_perf_prof;
 #endif
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    /* the caller ran until now */
+    aot_frame_attribute_hw_counters(exec_env, (AOTFrame *)exec_env->cur_frame);
+#endif
 
 #if WASM_ENABLE_GC != 0
     frame->sp = frame->lp + max_local_cell_num;
@@ -4067,6 +4255,9 @@ aot_free_standard_frame(WASMExecEnv *exec_env)
     /* parent function */
     if (prev_frame)
         prev_frame->func_perf_prof_info->children_exec_time += time_elapsed;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    aot_frame_attribute_hw_counters(exec_env, cur_frame);
+#endif
 #endif
 
 #if WASM_ENABLE_GC != 0
@@ -4105,6 +4296,9 @@ aot_frame_update_profile_info(WASMExecEnv *exec_env, bool alloc_frame)
     if (alloc_frame) {
         cur_frame->time_started = (uintptr_t)os_time_thread_cputime_us();
         cur_frame->func_perf_prof_info = func_perf_prof;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        aot_frame_attribute_hw_counters(exec_env, cur_frame->prev_frame);
+#endif
     }
     else {
         AOTFrame *prev_frame = cur_frame->prev_frame;
@@ -4117,6 +4311,9 @@ aot_frame_update_profile_info(WASMExecEnv *exec_env, bool alloc_frame)
         /* parent function */
         if (prev_frame)
             prev_frame->func_perf_prof_info->children_exec_time += time_elapsed;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        aot_frame_attribute_hw_counters(exec_env, cur_frame);
+#endif
     }
 #endif
 
@@ -4481,6 +4678,9 @@ aot_dump_perf_profiling(const AOTModuleInstance *module_inst)
                       i, perf_prof->total_exec_time / 1000.0f,
                       perf_prof->total_exec_cnt,
                       perf_prof->children_exec_time / 1000.0f);
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        wasm_hw_counters_dump(perf_prof->hw_counters);
+#endif
     }
 }
 
@@ -35,6 +35,15 @@ extern "C" {
  * and not at the beginning of each function call */
 #define WASM_FEATURE_FRAME_PER_FUNCTION (1 << 12)
 #define WASM_FEATURE_FRAME_NO_FUNC_IDX (1 << 13)
+/* The write barrier required by the generational GC is emitted
+ * when a reference is stored into a GC object */
+#define WASM_FEATURE_GC_WRITE_BARRIER (1 << 14)
+/* The pre write barrier required by the incremental GC is emitted
+ * before a reference in a GC object is overwritten */
+#define WASM_FEATURE_GC_PRE_WRITE_BARRIER (1 << 15)
+/* The fuel of the exec_env is charged per basic block and checked at
+ * function entries and loop headers */
+#define WASM_FEATURE_FUEL (1 << 16)
 
 typedef enum AOTSectionType {
     AOT_SECTION_TYPE_TARGET_INFO = 0,
@@ -116,6 +125,11 @@ typedef struct ExportFuncMap {
     uint32 export_idx;
 } ExportFuncMap;
 
+/* Offsets of the fields of AOTModuleInstanceExtra accessed by the aot
+   code, which are the same for 32-bit and 64-bit targets */
+#define AOT_INST_EXTRA_GC_TLAB_OFFSET 24
+#define AOT_INST_EXTRA_RTT_TYPES_OFFSET 32
+
 typedef struct AOTModuleInstanceExtra {
     DefPointer(const uint32 *, stack_sizes);
     /*
@@ -126,6 +140,15 @@ typedef struct AOTModuleInstanceExtra {
     DefPointer(uint8 *, shared_heap_base_addr_adj);
     MemBound shared_heap_start_off;
 
+#if WASM_ENABLE_GC != 0
+    /* The nursery of the GC heap (gc_tlab_t) and the rtt types of
+       the module, used by the aot code to allocate GC objects inline,
+       their offsets are AOT_INST_EXTRA_GC_TLAB_OFFSET and
+       AOT_INST_EXTRA_RTT_TYPES_OFFSET */
+    DefPointer(void *, gc_tlab);
+    DefPointer(struct WASMRttType **, rtt_types);
+#endif
+
     WASMModuleInstanceExtraCommon common;
 
     /**
@@ -357,7 +380,7 @@ typedef struct AOTModule {
     uint8 *merged_data_text_sections;
     uint32 merged_data_text_sections_size;
 
-#if WASM_ENABLE_AOT_STACK_FRAME != 0
+#if WASM_ENABLE_AOT_STACK_FRAME != 0 || WASM_ENABLE_GC != 0
     uint32 feature_flags;
 #endif
 } AOTModule;
@@ -399,6 +422,10 @@ typedef struct AOTFuncPerfProfInfo {
     uint32 total_exec_cnt;
     /* children execution time */
     uint64 children_exec_time;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    /* hardware counters, excluding the children's */
+    uint64 hw_counters[WASM_HW_COUNTER_NUM];
+#endif
 } AOTFuncPerfProfInfo;
 
 /* AOT auxiliary call stack */
@@ -616,6 +643,14 @@ bool
 aot_call_function(WASMExecEnv *exec_env, AOTFunctionInstance *function,
                   unsigned argc, uint32 argv[]);
 
+/**
+ * Call an AOT function over the argument sets of a batch, the signal
+ * env is set up once for all the calls.
+ */
+void
+aot_call_function_batch(WASMExecEnv *exec_env, AOTFunctionInstance *function,
+                        WASMBatchCall *batch);
+
 /**
  * Set AOT module instance exception with exception string
  *
@@ -5,6 +5,7 @@
 
 #include "../wasm_runtime_common.h"
 #include "gc_export.h"
+#include "mem_alloc.h"
 #if WASM_ENABLE_INTERP != 0
 #include "../interpreter/wasm_runtime.h"
 #endif
@@ -976,6 +977,59 @@ wasm_runtime_get_gc_heap_handle(WASMModuleInstanceCommon *module_inst)
     return NULL;
 }
 
+bool
+wasm_runtime_get_gc_stats(WASMModuleInstanceCommon *module_inst,
+                          wasm_gc_stats_t *stats)
+{
+    void *handle = wasm_runtime_get_gc_heap_handle(module_inst);
+
+    if (!handle)
+        return false;
+
+    mem_allocator_get_pause_stat(handle, stats);
+    return true;
+}
+
+typedef struct GCLiveSizes {
+    uint64 *sizes;
+    uint32 count;
+} GCLiveSizes;
+
+static void
+add_object_live_size(void *obj, uint32 size, void *user_data)
+{
+    GCLiveSizes *live_sizes = (GCLiveSizes *)user_data;
+    WASMObjectHeader header = ((WASMObjectRef)obj)->header;
+    WASMRttTypeRef rtt_type;
+
+    /* externref and anyref objects have no defined type, and the header
+       of an object being created may not be set yet */
+    if (header & (WASM_OBJ_EXTERNREF_OBJ_FLAG | WASM_OBJ_ANYREF_OBJ_FLAG))
+        return;
+    if (!(rtt_type = (WASMRttTypeRef)(header & WASM_OBJ_HEADER_MASK)))
+        return;
+
+    if (rtt_type->defined_type_idx < live_sizes->count)
+        live_sizes->sizes[rtt_type->defined_type_idx] += size;
+}
+
+bool
+wasm_runtime_get_gc_live_sizes(WASMModuleInstanceCommon *module_inst,
+                               uint64 *sizes, uint32 count)
+{
+    void *handle = wasm_runtime_get_gc_heap_handle(module_inst);
+    GCLiveSizes live_sizes;
+
+    if (!handle)
+        return false;
+
+    memset(sizes, 0, sizeof(uint64) * count);
+    live_sizes.sizes = sizes;
+    live_sizes.count = count;
+    return mem_allocator_traverse_objects(handle, add_object_live_size,
+                                          &live_sizes);
+}
+
 bool
 wasm_runtime_get_wasm_object_extra_info_flag(WASMObjectRef obj)
 {
@@ -37,6 +37,7 @@ wasm_rtt_type_new(WASMType *defined_type, uint32 defined_type_idx,
         rtt_type->inherit_depth = defined_type->inherit_depth;
         rtt_type->defined_type = defined_type;
         rtt_type->root_type = defined_type->root_type;
+        rtt_type->defined_type_idx = defined_type_idx;
 
         rtt_types[defined_type_idx] = rtt_type;
     }
@@ -123,6 +124,9 @@ wasm_struct_obj_set_field(WASMStructObjectRef struct_obj, uint32 field_idx,
     field_data = (uint8 *)struct_obj + field->field_offset;
     field_size = field->field_size;
 
+    if (wasm_is_type_reftype(field->field_type))
+        mem_allocator_pre_write_barrier(field_data, 1);
+
     if (field_size == 4) {
         *(int32 *)field_data = value->i32;
     }
@@ -143,6 +147,9 @@ wasm_struct_obj_set_field(WASMStructObjectRef struct_obj, uint32 field_idx,
     else {
         bh_assert(0);
     }
+
+    if (wasm_is_type_reftype(field->field_type))
+        mem_allocator_write_barrier(struct_obj);
 }
 
 void
@@ -272,12 +279,26 @@ wasm_array_obj_new(WASMExecEnv *exec_env, WASMRttTypeRef rtt_type,
                                        init_value);
 }
 
+static inline bool
+array_obj_is_ref_array(const WASMArrayObjectRef array_obj)
+{
+    WASMRttTypeRef rtt_type =
+        (WASMRttTypeRef)wasm_object_header((WASMObjectRef)array_obj);
+    WASMArrayType *array_type = (WASMArrayType *)rtt_type->defined_type;
+
+    return wasm_is_type_reftype(array_type->elem_type);
+}
+
 void
 wasm_array_obj_set_elem(WASMArrayObjectRef array_obj, uint32 elem_idx,
                         const WASMValue *value)
 {
     uint8 *elem_data = wasm_array_obj_elem_addr(array_obj, elem_idx);
     uint32 elem_size = 1 << wasm_array_obj_elem_size_log(array_obj);
+    bool is_ref_array = array_obj_is_ref_array(array_obj);
+
+    if (is_ref_array)
+        mem_allocator_pre_write_barrier(elem_data, 1);
 
     switch (elem_size) {
         case 1:
@@ -293,6 +314,9 @@ wasm_array_obj_set_elem(WASMArrayObjectRef array_obj, uint32 elem_idx,
             PUT_I64_TO_ADDR((uint32 *)elem_data, value->i64);
             break;
     }
+
+    if (is_ref_array)
+        mem_allocator_write_barrier(array_obj);
 }
 
 void
@@ -327,12 +351,17 @@ wasm_array_obj_fill(const WASMArrayObjectRef array_obj, uint32 elem_idx,
     uint32 i;
     uint8 *elem_data = wasm_array_obj_elem_addr(array_obj, elem_idx);
     uint32 elem_size = 1 << wasm_array_obj_elem_size_log(array_obj);
+    bool is_ref_array;
 
     if (elem_size == 1) {
         memset(elem_data, (int8)value->i32, len);
         return;
     }
 
+    is_ref_array = array_obj_is_ref_array(array_obj);
+    if (is_ref_array)
+        mem_allocator_pre_write_barrier(elem_data, len);
+
     for (i = 0; i < len; i++) {
         switch (elem_size) {
             case 2:
@@ -347,6 +376,9 @@ wasm_array_obj_fill(const WASMArrayObjectRef array_obj, uint32 elem_idx,
         }
         elem_data += elem_size;
     }
+
+    if (is_ref_array)
+        mem_allocator_write_barrier(array_obj);
 }
 
 void
@@ -356,8 +388,15 @@ wasm_array_obj_copy(WASMArrayObjectRef dst_obj, uint32 dst_idx,
     uint8 *dst_data = wasm_array_obj_elem_addr(dst_obj, dst_idx);
     uint8 *src_data = wasm_array_obj_elem_addr(src_obj, src_idx);
     uint32 elem_size = 1 << wasm_array_obj_elem_size_log(dst_obj);
+    bool is_ref_array = array_obj_is_ref_array(dst_obj);
+
+    if (is_ref_array)
+        mem_allocator_pre_write_barrier(dst_data, len);
 
     bh_memmove_s(dst_data, elem_size * len, src_data, elem_size * len);
+
+    if (is_ref_array)
+        mem_allocator_write_barrier(dst_obj);
 }
 
 uint32
@@ -718,6 +757,18 @@ wasm_obj_is_type_of(WASMObjectRef obj, int32 heap_type)
     return false;
 }
 
+void
+wasm_obj_write_barrier(void *obj)
+{
+    mem_allocator_write_barrier(obj);
+}
+
+void
+wasm_obj_pre_write_barrier(void *slots, uint32 slot_num)
+{
+    mem_allocator_pre_write_barrier(slots, slot_num);
+}
+
 bool
 wasm_obj_equal(WASMObjectRef obj1, WASMObjectRef obj2)
 {
@@ -46,6 +46,8 @@ typedef struct WASMRttType {
     uint32 inherit_depth;
     WASMType *defined_type;
     WASMType *root_type;
+    /* index of the defined type in its module */
+    uint32 defined_type_idx;
 } WASMRttType, *WASMRttTypeRef;
 
 /* Representation of WASM externref objects */
@@ -325,6 +327,21 @@ wasm_obj_is_instance_of(WASMObjectRef obj, uint32 type_idx, WASMType **types,
 bool
 wasm_obj_is_type_of(WASMObjectRef obj, int32 heap_type);
 
+/**
+ * Write barrier of the generational GC, called by the AOT code after
+ * a reference is stored into an old object, see gc_write_barrier()
+ */
+void
+wasm_obj_write_barrier(void *obj);
+
+/**
+ * Pre write barrier of the incremental GC, called before the references
+ * in the slots of an object are overwritten by the AOT code, see
+ * gc_pre_write_barrier()
+ */
+void
+wasm_obj_pre_write_barrier(void *slots, uint32 slot_num);
+
 bool
 wasm_obj_equal(WASMObjectRef obj1, WASMObjectRef obj2);
 
@@ -8,6 +8,9 @@
 #if WASM_ENABLE_GC != 0
 #include "mem_alloc.h"
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+#include "wasm_sampling_profiler.h"
+#endif
 #if WASM_ENABLE_INTERP != 0
 #include "../interpreter/wasm_runtime.h"
 #endif
@@ -15,6 +18,13 @@
 #include "../aot/aot_runtime.h"
 #endif
 
+#if WASM_ENABLE_FUEL != 0 && WASM_ENABLE_AOT != 0
+/* The AOTed code accesses the fuel at
+   align_uint(pointer_size * 13, 8), see create_fuel_ptr() */
+bh_static_assert(offsetof(WASMExecEnv, fuel)
+                 == ((sizeof(uintptr_t) * 13 + 7) & ~(size_t)7));
+#endif
+
 #if WASM_ENABLE_AOT != 0
 #include "aot_runtime.h"
 #endif
@@ -73,6 +83,11 @@ wasm_exec_env_create_internal(struct WASMModuleInstanceCommon *module_inst,
         exec_env->wasm_stack.bottom + stack_size;
     exec_env->wasm_stack.top = exec_env->wasm_stack.bottom;
 
+#if WASM_ENABLE_FUEL != 0
+    /* Unlimited until wasm_runtime_set_fuel is called */
+    exec_env->fuel = INT64_MAX;
+#endif
+
 #if WASM_ENABLE_AOT != 0
     if (module_inst->module_type == Wasm_Module_AoT) {
         AOTModuleInstance *i = (AOTModuleInstance *)module_inst;
@@ -85,6 +100,14 @@ wasm_exec_env_create_internal(struct WASMModuleInstanceCommon *module_inst,
     wasm_runtime_dump_exec_env_mem_consumption(exec_env);
 #endif
 
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    wasm_hw_counters_init(&exec_env->hw_counters);
+#endif
+
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_add_exec_env(exec_env);
+#endif
+
     return exec_env;
 
 #ifdef OS_ENABLE_HW_BOUND_CHECK
@@ -113,6 +136,12 @@ fail1:
 void
 wasm_exec_env_destroy_internal(WASMExecEnv *exec_env)
 {
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_remove_exec_env(exec_env);
+#endif
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    wasm_hw_counters_destroy(&exec_env->hw_counters);
+#endif
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     os_munmap(exec_env->exce_check_guard_page, os_getpagesize());
 #endif
@@ -154,7 +183,7 @@ wasm_exec_env_create(struct WASMModuleInstanceCommon *module_inst,
             (uintptr_t)module->aux_stack_bottom - module->aux_stack_size;
 #if WASM_ENABLE_GC != 0
         gc_heap_handle =
-            ((WASMModuleInstance *)module_inst)->e->common.gc_heap_pool;
+            ((WASMModuleInstance *)module_inst)->e->common.gc_heap_handle;
 #endif
     }
 #endif
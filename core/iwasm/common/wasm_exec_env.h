@@ -8,6 +8,9 @@
 
 #include "bh_assert.h"
 #include "wasm_suspend_flags.h"
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+#include "wasm_hw_counters.h"
+#endif
 #if WASM_ENABLE_INTERP != 0
 #include "../interpreter/wasm.h"
 #endif
@@ -87,6 +90,18 @@ typedef struct WASMExecEnv {
         uint8 *bottom;
     } wasm_stack;
 
+#if WASM_ENABLE_FUEL != 0
+#if UINTPTR_MAX == UINT32_MAX
+    /* Keep fuel 8-byte aligned as AOTed code expects */
+    uint32 fuel_padding;
+#endif
+    /* The fuel left, it is charged per basic block by the fast interpreter
+       and the AOTed code, which accesses it by offset, don't change the
+       place of it, see create_fuel_ptr() in aot_llvm.c and the static
+       assert in wasm_exec_env.c */
+    int64 fuel;
+#endif
+
 #if WASM_ENABLE_FAST_JIT != 0
     /**
      * Cache for
@@ -157,6 +172,30 @@ typedef struct WASMExecEnv {
     uint32 max_wasm_stack_used;
 #endif
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    /* The next exec_env in the list of the sampling profiler */
+    struct WASMExecEnv *sampling_next;
+#endif
+
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    /* The hardware counters of the thread running the exec_env */
+    WASMHwCounters hw_counters;
+#endif
+
+#if WASM_ENABLE_FUEL != 0
+    /* Called when the fuel is exhausted */
+    bool (*fuel_exhausted_callback)(struct WASMExecEnv *exec_env,
+                                    void *user_data);
+    void *fuel_exhausted_user_data;
+#endif
+
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    /* What the exec_env is running, WASM_STATS_STATE_XXX, the CPU time
+       since stats_last_cputime_us is charged to it */
+    uint8 stats_state;
+    uint64 stats_last_cputime_us;
+#endif
+
     /* The WASM stack size */
     uint32 wasm_stack_size;
 
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_fuel.h"
+#include "wasm_runtime_common.h"
+
+#if WASM_ENABLE_FUEL != 0
+
+bool
+wasm_fuel_exhausted(WASMExecEnv *exec_env)
+{
+    if (exec_env->fuel_exhausted_callback
+        && exec_env->fuel_exhausted_callback(
+            exec_env, exec_env->fuel_exhausted_user_data)
+        && exec_env->fuel >= 0)
+        return true;
+
+    wasm_runtime_set_exception(exec_env->module_inst, "fuel exhausted");
+    return false;
+}
+
+#endif /* end of WASM_ENABLE_FUEL != 0 */
+
+bool
+wasm_runtime_set_fuel(WASMExecEnv *exec_env, uint64 fuel)
+{
+#if WASM_ENABLE_FUEL != 0
+    exec_env->fuel = fuel > INT64_MAX ? INT64_MAX : (int64)fuel;
+    return true;
+#else
+    (void)exec_env;
+    (void)fuel;
+    return false;
+#endif
+}
+
+bool
+wasm_runtime_add_fuel(WASMExecEnv *exec_env, uint64 fuel)
+{
+#if WASM_ENABLE_FUEL != 0
+    /* the fuel left may be negative as it is checked at loop headers */
+    if (fuel >= (uint64)INT64_MAX
+        || exec_env->fuel > INT64_MAX - (int64)fuel)
+        exec_env->fuel = INT64_MAX;
+    else
+        exec_env->fuel += (int64)fuel;
+    return true;
+#else
+    (void)exec_env;
+    (void)fuel;
+    return false;
+#endif
+}
+
+uint64
+wasm_runtime_get_fuel(WASMExecEnv *exec_env)
+{
+#if WASM_ENABLE_FUEL != 0
+    return exec_env->fuel > 0 ? (uint64)exec_env->fuel : 0;
+#else
+    (void)exec_env;
+    return 0;
+#endif
+}
+
+void
+wasm_runtime_set_fuel_exhausted_callback(
+    WASMExecEnv *exec_env, wasm_fuel_exhausted_callback_t callback,
+    void *user_data)
+{
+#if WASM_ENABLE_FUEL != 0
+    exec_env->fuel_exhausted_callback = callback;
+    exec_env->fuel_exhausted_user_data = user_data;
+#else
+    (void)exec_env;
+    (void)callback;
+    (void)user_data;
+#endif
+}
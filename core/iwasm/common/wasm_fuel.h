@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_FUEL_H
+#define _WASM_FUEL_H
+
+#include "bh_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_FUEL != 0
+
+struct WASMExecEnv;
+
+/**
+ * Called by the fast interpreter, the jitted and the AOTed code when the
+ * fuel of an exec_env is found exhausted at a function entry or a loop
+ * header, the fuel exhausted callback may refill it.
+ *
+ * @param exec_env the exec_env
+ *
+ * @return true if the fuel is refilled and the execution continues,
+ *         false if the "fuel exhausted" exception is thrown
+ */
+bool
+wasm_fuel_exhausted(struct WASMExecEnv *exec_env);
+
+#endif /* end of WASM_ENABLE_FUEL != 0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_FUEL_H */
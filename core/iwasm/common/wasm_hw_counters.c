@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_hw_counters.h"
+#include "bh_atomic.h"
+#include "bh_log.h"
+
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+
+typedef struct HwCounterDesc {
+    const char *name;
+    uint32 type;
+    uint64 config;
+} HwCounterDesc;
+
+static const HwCounterDesc hw_counter_descs[WASM_HW_COUNTER_NUM] = {
+    { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { "cache misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { "branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+    { "iTLB misses", PERF_TYPE_HW_CACHE,
+      PERF_COUNT_HW_CACHE_ITLB | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+};
+
+/* The counters opened by any thread, only they are dumped */
+static bh_atomic_32_t hw_counters_opened_mask;
+static bool hw_counters_warned;
+
+static int
+open_counter(const HwCounterDesc *desc, int group_fd)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = desc->type;
+    attr.config = desc->config;
+    attr.read_format = PERF_FORMAT_GROUP;
+    /* only count the wasm code and the native functions it calls, which
+       also works when perf_event_paranoid is 2 */
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    /* count the current thread on any cpu */
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0);
+}
+
+static void
+open_counters(WASMHwCounters *counters)
+{
+    uint32 i;
+    int fd;
+
+    counters->open_tried = true;
+    counters->tid = os_self_thread();
+
+    for (i = 0; i < WASM_HW_COUNTER_NUM; i++) {
+        fd = open_counter(&hw_counter_descs[i], counters->group_fd);
+        if (fd < 0)
+            continue;
+
+        if (counters->group_fd < 0)
+            counters->group_fd = fd;
+        counters->fds[i] = fd;
+        counters->read_index[i] = (int8)counters->read_num++;
+        BH_ATOMIC_32_FETCH_OR(hw_counters_opened_mask, 1 << i);
+    }
+
+    if (counters->group_fd < 0 && !hw_counters_warned) {
+        /* it is only a hint, a race here at most prints it twice */
+        hw_counters_warned = true;
+        LOG_WARNING("warning: can't open the hardware performance counters, "
+                    "because %s",
+                    strerror(errno));
+    }
+}
+
+void
+wasm_hw_counters_init(WASMHwCounters *counters)
+{
+    uint32 i;
+
+    memset(counters, 0, sizeof(*counters));
+    counters->group_fd = -1;
+    for (i = 0; i < WASM_HW_COUNTER_NUM; i++) {
+        counters->fds[i] = -1;
+        counters->read_index[i] = -1;
+    }
+}
+
+void
+wasm_hw_counters_destroy(WASMHwCounters *counters)
+{
+    uint32 i;
+
+    for (i = 0; i < WASM_HW_COUNTER_NUM; i++) {
+        if (counters->fds[i] >= 0)
+            close(counters->fds[i]);
+    }
+    wasm_hw_counters_init(counters);
+}
+
+void
+wasm_hw_counters_attribute(WASMHwCounters *counters, uint64 *func_counters)
+{
+    /* nr followed by the values of the group */
+    uint64 buf[1 + WASM_HW_COUNTER_NUM], value;
+    uint32 i;
+    int index;
+
+    if (!counters->open_tried)
+        open_counters(counters);
+
+    if (counters->group_fd < 0 || counters->tid != os_self_thread())
+        return;
+
+    if (read(counters->group_fd, buf, sizeof(buf))
+        != (ssize_t)(sizeof(uint64) * (1 + counters->read_num)))
+        return;
+
+    for (i = 0; i < WASM_HW_COUNTER_NUM; i++) {
+        if ((index = counters->read_index[i]) < 0)
+            continue;
+
+        value = buf[1 + index];
+        if (func_counters)
+            func_counters[i] += value - counters->last[i];
+        counters->last[i] = value;
+    }
+}
+
+void
+wasm_hw_counters_dump(const uint64 *func_counters)
+{
+    uint32 opened_mask = BH_ATOMIC_32_LOAD(hw_counters_opened_mask);
+    const char *sep = "    ";
+    uint32 i;
+
+    if (!opened_mask)
+        return;
+
+    for (i = 0; i < WASM_HW_COUNTER_NUM; i++) {
+        if (opened_mask & (1 << i)) {
+            os_printf("%s%s: %" PRIu64, sep, hw_counter_descs[i].name,
+                      func_counters[i]);
+            sep = ", ";
+        }
+    }
+    os_printf("\n");
+}
+
+#endif /* end of WASM_ENABLE_HW_PERF_COUNTERS != 0 */
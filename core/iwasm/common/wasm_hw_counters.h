@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_HW_COUNTERS_H
+#define _WASM_HW_COUNTERS_H
+
+#include "bh_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+
+/* instructions, cache misses, branch misses and iTLB misses */
+#define WASM_HW_COUNTER_NUM 4
+
+/* The hardware counters of the thread running an exec_env */
+typedef struct WASMHwCounters {
+    /* The counters are opened by the first call into wasm */
+    bool open_tried;
+    /* The thread which opened the counters, they only count it */
+    korp_tid tid;
+    /* The leader of the counter group, -1 if no counter is opened */
+    int group_fd;
+    int fds[WASM_HW_COUNTER_NUM];
+    /* Index of each counter in the values read from the group, -1 if
+       the counter isn't supported */
+    int8 read_index[WASM_HW_COUNTER_NUM];
+    uint32 read_num;
+    /* The values read last time */
+    uint64 last[WASM_HW_COUNTER_NUM];
+} WASMHwCounters;
+
+void
+wasm_hw_counters_init(WASMHwCounters *counters);
+
+void
+wasm_hw_counters_destroy(WASMHwCounters *counters);
+
+/**
+ * Read the counters and add the increments since the last read to the
+ * function which ran meanwhile, it is called when a function is called
+ * or returns, so the increments of a function don't include the ones of
+ * its callees.
+ *
+ * @param counters the counters of the current exec_env
+ * @param func_counters the counters of the function which ran since the
+ *        last read, NULL if it isn't a wasm function
+ */
+void
+wasm_hw_counters_attribute(WASMHwCounters *counters, uint64 *func_counters);
+
+/**
+ * Print the counters of a function in the performance profiler data
+ */
+void
+wasm_hw_counters_dump(const uint64 *func_counters);
+
+#endif /* end of WASM_ENABLE_HW_PERF_COUNTERS != 0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_HW_COUNTERS_H */
@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_instance_stats.h"
+#include "wasm_runtime_common.h"
+#include "mem_alloc.h"
+#if WASM_ENABLE_INTERP != 0
+#include "../interpreter/wasm_runtime.h"
+#endif
+#if WASM_ENABLE_AOT != 0
+#include "../aot/aot_runtime.h"
+#endif
+
+#if WASM_ENABLE_INSTANCE_STATS != 0
+
+static WASMModuleInstanceExtraCommon *
+get_extra_common(WASMModuleInstanceCommon *inst)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (inst->module_type == Wasm_Module_Bytecode) {
+        return &((WASMModuleInstance *)inst)->e->common;
+    }
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (inst->module_type == Wasm_Module_AoT) {
+        return &((AOTModuleInstanceExtra *)((AOTModuleInstance *)inst)->e)
+                    ->common;
+    }
+#endif
+    bh_assert(false);
+    return NULL;
+}
+
+static WASMInstanceStats *
+get_instance_stats(WASMModuleInstanceCommon *inst)
+{
+    return get_extra_common(inst)->counted_stats;
+}
+
+void
+wasm_instance_stats_init(WASMModuleInstanceCommon *module_inst,
+                         WASMModuleInstanceCommon *parent)
+{
+    WASMModuleInstanceExtraCommon *common = get_extra_common(module_inst);
+
+    /* The instance of a spawned thread is destroyed before the one which
+       spawned it, so its resources are added to the stats of the parent
+       and all the threads are counted by the instance first created */
+    common->counted_stats =
+        parent ? get_instance_stats(parent) : &common->stats;
+}
+
+uint8
+wasm_instance_stats_switch(WASMExecEnv *exec_env, uint8 state)
+{
+    WASMInstanceStats *stats = get_instance_stats(exec_env->module_inst);
+    uint8 prev_state = exec_env->stats_state;
+    uint64 now;
+
+    if (state == WASM_STATS_STATE_HOST)
+        BH_ATOMIC_64_FETCH_ADD(stats->host_call_count, 1);
+
+    /* e.g. a host function called by another one through the runtime */
+    if (state == prev_state)
+        return prev_state;
+
+    now = os_time_thread_cputime_us();
+    if (prev_state == WASM_STATS_STATE_WASM)
+        BH_ATOMIC_64_FETCH_ADD(stats->wasm_cpu_time_us,
+                               now - exec_env->stats_last_cputime_us);
+    else if (prev_state == WASM_STATS_STATE_HOST)
+        BH_ATOMIC_64_FETCH_ADD(stats->host_cpu_time_us,
+                               now - exec_env->stats_last_cputime_us);
+
+    exec_env->stats_last_cputime_us = now;
+    exec_env->stats_state = state;
+    return prev_state;
+}
+
+void
+wasm_instance_stats_add_wasi_call(WASMExecEnv *exec_env,
+                                  wasi_call_type_t type)
+{
+    bh_assert(type < WASI_CALL_TYPE_NUM);
+    BH_ATOMIC_64_FETCH_ADD(
+        get_instance_stats(exec_env->module_inst)->wasi_call_counts[type], 1);
+}
+
+void
+wasm_instance_stats_add_wasi_io(WASMExecEnv *exec_env, uint64 bytes_read,
+                                uint64 bytes_written)
+{
+    WASMInstanceStats *stats = get_instance_stats(exec_env->module_inst);
+
+    BH_ATOMIC_64_FETCH_ADD(stats->wasi_bytes_read, bytes_read);
+    BH_ATOMIC_64_FETCH_ADD(stats->wasi_bytes_written, bytes_written);
+}
+
+void
+wasm_instance_stats_add_jit_transition(WASMExecEnv *exec_env, bool is_exit,
+                                       bool is_slow)
+{
+    WASMInstanceStats *stats = get_instance_stats(exec_env->module_inst);
+
+    if (is_exit)
+        BH_ATOMIC_64_FETCH_ADD(stats->jit_exit_count, 1);
+    else
+        BH_ATOMIC_64_FETCH_ADD(stats->jit_entry_count, 1);
+    if (is_slow)
+        BH_ATOMIC_64_FETCH_ADD(stats->jit_slow_transition_count, 1);
+}
+
+#endif /* end of WASM_ENABLE_INSTANCE_STATS != 0 */
+
+bool
+wasm_runtime_get_instance_stats(WASMModuleInstanceCommon *module_inst,
+                                wasm_instance_stats_t *stats)
+{
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    WASMModuleInstance *inst = (WASMModuleInstance *)module_inst;
+    WASMInstanceStats *inst_stats = get_instance_stats(module_inst);
+    WASMMemoryInstance *memory_inst;
+    mem_alloc_info_t heap_info;
+    uint32 i;
+
+    memset(stats, 0, sizeof(*stats));
+    stats->wasm_cpu_time_us = BH_ATOMIC_64_LOAD(inst_stats->wasm_cpu_time_us);
+    stats->host_cpu_time_us = BH_ATOMIC_64_LOAD(inst_stats->host_cpu_time_us);
+    stats->host_call_count = BH_ATOMIC_64_LOAD(inst_stats->host_call_count);
+    for (i = 0; i < WASI_CALL_TYPE_NUM; i++)
+        stats->wasi_call_counts[i] =
+            BH_ATOMIC_64_LOAD(inst_stats->wasi_call_counts[i]);
+    stats->wasi_bytes_read = BH_ATOMIC_64_LOAD(inst_stats->wasi_bytes_read);
+    stats->wasi_bytes_written =
+        BH_ATOMIC_64_LOAD(inst_stats->wasi_bytes_written);
+    stats->jit_entry_count = BH_ATOMIC_64_LOAD(inst_stats->jit_entry_count);
+    stats->jit_exit_count = BH_ATOMIC_64_LOAD(inst_stats->jit_exit_count);
+    stats->jit_slow_transition_count =
+        BH_ATOMIC_64_LOAD(inst_stats->jit_slow_transition_count);
+
+    for (i = 0; i < inst->memory_count; i++) {
+        memory_inst = inst->memories[i];
+        stats->linear_memory_size += memory_inst->memory_data_size;
+        /* only the default memory may have the app heap */
+        if (memory_inst->heap_handle
+            && mem_allocator_get_alloc_info(memory_inst->heap_handle,
+                                            &heap_info)) {
+            stats->app_heap_size = heap_info.total_size;
+            stats->app_heap_used =
+                heap_info.total_size - heap_info.total_free_size;
+            stats->app_heap_peak_used = heap_info.highmark_size;
+        }
+    }
+    return true;
+#else
+    (void)module_inst;
+    (void)stats;
+    return false;
+#endif
+}
+
+void
+wasm_runtime_reset_instance_stats(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    WASMInstanceStats *stats = get_instance_stats(module_inst);
+    uint32 i;
+
+    BH_ATOMIC_64_STORE(stats->wasm_cpu_time_us, 0);
+    BH_ATOMIC_64_STORE(stats->host_cpu_time_us, 0);
+    BH_ATOMIC_64_STORE(stats->host_call_count, 0);
+    for (i = 0; i < WASI_CALL_TYPE_NUM; i++)
+        BH_ATOMIC_64_STORE(stats->wasi_call_counts[i], 0);
+    BH_ATOMIC_64_STORE(stats->wasi_bytes_read, 0);
+    BH_ATOMIC_64_STORE(stats->wasi_bytes_written, 0);
+    BH_ATOMIC_64_STORE(stats->jit_entry_count, 0);
+    BH_ATOMIC_64_STORE(stats->jit_exit_count, 0);
+    BH_ATOMIC_64_STORE(stats->jit_slow_transition_count, 0);
+#else
+    (void)module_inst;
+#endif
+}
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_INSTANCE_STATS_H
+#define _WASM_INSTANCE_STATS_H
+
+#include "bh_platform.h"
+#include "bh_atomic.h"
+#include "wasm_export.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_INSTANCE_STATS != 0
+
+/* What an exec_env is running, the CPU time is charged to it */
+#define WASM_STATS_STATE_NONE 0
+#define WASM_STATS_STATE_WASM 1
+#define WASM_STATS_STATE_HOST 2
+
+/* The counters of a module instance, the memory usage isn't kept here
+   but read from the memories when the stats are queried. The threads of
+   an instance add to them at the same time, so they are updated with
+   atomic operations. */
+typedef struct WASMInstanceStats {
+    bh_atomic_64_t wasm_cpu_time_us;
+    bh_atomic_64_t host_cpu_time_us;
+    bh_atomic_64_t host_call_count;
+    bh_atomic_64_t wasi_call_counts[WASI_CALL_TYPE_NUM];
+    bh_atomic_64_t wasi_bytes_read;
+    bh_atomic_64_t wasi_bytes_written;
+    bh_atomic_64_t jit_entry_count;
+    bh_atomic_64_t jit_exit_count;
+    bh_atomic_64_t jit_slow_transition_count;
+} WASMInstanceStats;
+
+struct WASMExecEnv;
+struct WASMModuleInstanceCommon;
+
+/**
+ * Set the stats which a new module instance counts into: those of the
+ * instance which spawned it for the instance of a spawned thread, or its
+ * own ones otherwise
+ *
+ * @param module_inst the new module instance
+ * @param parent the instance which spawned the thread, or NULL
+ */
+void
+wasm_instance_stats_init(struct WASMModuleInstanceCommon *module_inst,
+                         struct WASMModuleInstanceCommon *parent);
+
+/**
+ * Switch what an exec_env is running, and charge the CPU time since the
+ * last switch to the module instance of the exec_env, it is called when
+ * wasm code is entered from the host or a host function is called, and
+ * again with the returned state when they return.
+ *
+ * @param exec_env the exec_env
+ * @param state the new state, WASM_STATS_STATE_XXX
+ *
+ * @return the previous state
+ */
+uint8
+wasm_instance_stats_switch(struct WASMExecEnv *exec_env, uint8 state);
+
+/**
+ * Count a WASI function called by the module instance of an exec_env
+ */
+void
+wasm_instance_stats_add_wasi_call(struct WASMExecEnv *exec_env,
+                                  wasi_call_type_t type);
+
+/**
+ * Add the bytes read or written by a WASI function
+ */
+void
+wasm_instance_stats_add_wasi_io(struct WASMExecEnv *exec_env,
+                                uint64 bytes_read, uint64 bytes_written);
+
+/**
+ * Count a transition between the runtime and the jitted code
+ *
+ * @param exec_env the exec_env
+ * @param is_exit true if the jitted code calls back into the runtime,
+ *        false if it is called from the interpreter or the host
+ * @param is_slow true if the arguments and results go through the
+ *        generic path instead of a per-signature quick entry
+ */
+void
+wasm_instance_stats_add_jit_transition(struct WASMExecEnv *exec_env,
+                                       bool is_exit, bool is_slow);
+
+#endif /* end of WASM_ENABLE_INSTANCE_STATS != 0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_INSTANCE_STATS_H */
@@ -0,0 +1,258 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_jit_perf.h"
+#include "bh_log.h"
+
+#if WASM_ENABLE_LINUX_PERF != 0
+
+#include <elf.h>
+#include <sys/syscall.h>
+
+/*
+ * The jitdump format is described in tools/perf/Documentation/
+ * jitdump-specification.txt of the linux kernel. The file must be mapped
+ * executable so that `perf record` sees it, and the timestamps must come
+ * from the clock perf uses, i.e. record with `perf record -k mono`.
+ */
+
+#define JITDUMP_MAGIC 0x4A695444
+#define JITDUMP_VERSION 1
+
+#define JIT_CODE_LOAD 0
+#define JIT_CODE_DEBUG_INFO 2
+
+#if defined(BUILD_TARGET_X86_64) || defined(BUILD_TARGET_AMD_64)
+#define JITDUMP_ELF_MACH EM_X86_64
+#elif defined(BUILD_TARGET_X86_32)
+#define JITDUMP_ELF_MACH EM_386
+#elif defined(BUILD_TARGET_AARCH64)
+#define JITDUMP_ELF_MACH EM_AARCH64
+#elif defined(BUILD_TARGET_ARM) || defined(BUILD_TARGET_THUMB)
+#define JITDUMP_ELF_MACH EM_ARM
+#elif defined(BUILD_TARGET_RISCV64_LP64D) || defined(BUILD_TARGET_RISCV64_LP64)
+#define JITDUMP_ELF_MACH EM_RISCV
+#else
+#define JITDUMP_ELF_MACH EM_NONE
+#endif
+
+typedef struct JitDumpHeader {
+    uint32 magic;
+    uint32 version;
+    uint32 total_size;
+    uint32 elf_mach;
+    uint32 pad1;
+    uint32 pid;
+    uint64 timestamp;
+    uint64 flags;
+} JitDumpHeader;
+
+typedef struct JitDumpRecordHeader {
+    uint32 id;
+    uint32 total_size;
+    uint64 timestamp;
+} JitDumpRecordHeader;
+
+/* Followed by the name and the code */
+typedef struct JitDumpCodeLoad {
+    JitDumpRecordHeader header;
+    uint32 pid;
+    uint32 tid;
+    uint64 vma;
+    uint64 code_addr;
+    uint64 code_size;
+    uint64 code_index;
+} JitDumpCodeLoad;
+
+/* Followed by the entries */
+typedef struct JitDumpDebugInfo {
+    JitDumpRecordHeader header;
+    uint64 code_addr;
+    uint64 nr_entry;
+} JitDumpDebugInfo;
+
+/* Followed by the file name */
+typedef struct JitDumpDebugEntry {
+    uint64 addr;
+    int32 lineno;
+    int32 discrim;
+} JitDumpDebugEntry;
+
+static bool jit_perf_inited = false;
+/* Protects the files and the code index, the code may be jitted by
+   several threads */
+static korp_mutex jit_perf_lock;
+/* The files are created when the first code is jitted */
+static bool jit_perf_files_opened = false;
+static FILE *perf_map;
+static FILE *jit_dump;
+static void *jit_dump_mark;
+static uint64 code_index;
+
+static uint64
+get_timestamp(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64)ts.tv_sec * 1000000000 + (uint64)ts.tv_nsec;
+}
+
+static void
+open_jit_perf_files(void)
+{
+    char path[64];
+    JitDumpHeader header = { 0 };
+    pid_t pid = getpid();
+
+    jit_perf_files_opened = true;
+
+    (void)snprintf(path, sizeof(path), "/tmp/perf-%d.map", pid);
+    if (!(perf_map = fopen(path, "a")))
+        LOG_WARNING("warning: can't create %s, because %s", path,
+                    strerror(errno));
+
+    (void)snprintf(path, sizeof(path), "/tmp/jit-%d.dump", pid);
+    if (!(jit_dump = fopen(path, "w+"))) {
+        LOG_WARNING("warning: can't create %s, because %s", path,
+                    strerror(errno));
+        return;
+    }
+
+    /* perf record finds the file by this mapping */
+    jit_dump_mark = mmap(NULL, getpagesize(), PROT_READ | PROT_EXEC,
+                         MAP_PRIVATE, fileno(jit_dump), 0);
+    if (jit_dump_mark == MAP_FAILED) {
+        LOG_WARNING("warning: can't map %s, because %s", path,
+                    strerror(errno));
+        jit_dump_mark = NULL;
+        fclose(jit_dump);
+        jit_dump = NULL;
+        return;
+    }
+
+    header.magic = JITDUMP_MAGIC;
+    header.version = JITDUMP_VERSION;
+    header.total_size = sizeof(header);
+    header.elf_mach = JITDUMP_ELF_MACH;
+    header.pid = (uint32)pid;
+    header.timestamp = get_timestamp();
+    (void)fwrite(&header, sizeof(header), 1, jit_dump);
+    fflush(jit_dump);
+}
+
+static void
+write_debug_info(const void *code, const WASMJitPerfLineInfo *lines,
+                 uint32 line_count, uint64 timestamp)
+{
+    JitDumpDebugInfo info = { 0 };
+    JitDumpDebugEntry entry = { 0 };
+    uint32 i, total_size = sizeof(info);
+
+    for (i = 0; i < line_count; i++)
+        total_size += (uint32)(sizeof(entry) + strlen(lines[i].file_name) + 1);
+
+    info.header.id = JIT_CODE_DEBUG_INFO;
+    info.header.total_size = total_size;
+    info.header.timestamp = timestamp;
+    info.code_addr = (uint64)(uintptr_t)code;
+    info.nr_entry = line_count;
+    (void)fwrite(&info, sizeof(info), 1, jit_dump);
+
+    for (i = 0; i < line_count; i++) {
+        entry.addr = (uint64)lines[i].addr;
+        entry.lineno = (int32)lines[i].line;
+        (void)fwrite(&entry, sizeof(entry), 1, jit_dump);
+        (void)fwrite(lines[i].file_name, strlen(lines[i].file_name) + 1, 1,
+                     jit_dump);
+    }
+}
+
+static void
+write_code_load(const char *name, const void *code, uint32 code_size,
+                uint64 timestamp)
+{
+    JitDumpCodeLoad load = { 0 };
+    uint32 name_size = (uint32)strlen(name) + 1;
+
+    load.header.id = JIT_CODE_LOAD;
+    load.header.total_size = sizeof(load) + name_size + code_size;
+    load.header.timestamp = timestamp;
+    load.pid = (uint32)getpid();
+    load.tid = (uint32)syscall(SYS_gettid);
+    load.vma = load.code_addr = (uint64)(uintptr_t)code;
+    load.code_size = code_size;
+    load.code_index = code_index++;
+    (void)fwrite(&load, sizeof(load), 1, jit_dump);
+    (void)fwrite(name, name_size, 1, jit_dump);
+    (void)fwrite(code, code_size, 1, jit_dump);
+}
+
+bool
+wasm_jit_perf_init(void)
+{
+    if (jit_perf_inited)
+        return true;
+
+    if (os_mutex_init(&jit_perf_lock) != 0)
+        return false;
+
+    jit_perf_inited = true;
+    return true;
+}
+
+void
+wasm_jit_perf_destroy(void)
+{
+    if (!jit_perf_inited)
+        return;
+
+    if (jit_dump_mark)
+        munmap(jit_dump_mark, getpagesize());
+    if (jit_dump)
+        fclose(jit_dump);
+    if (perf_map)
+        fclose(perf_map);
+    jit_dump_mark = NULL;
+    jit_dump = perf_map = NULL;
+    jit_perf_files_opened = false;
+
+    os_mutex_destroy(&jit_perf_lock);
+    jit_perf_inited = false;
+}
+
+void
+wasm_jit_perf_add_code(const char *name, const void *code, uint32 code_size,
+                       const WASMJitPerfLineInfo *lines, uint32 line_count)
+{
+    uint64 timestamp;
+
+    if (!jit_perf_inited)
+        return;
+
+    os_mutex_lock(&jit_perf_lock);
+
+    if (!jit_perf_files_opened)
+        open_jit_perf_files();
+
+    if (perf_map) {
+        (void)fprintf(perf_map, "%" PRIxPTR "  %x  %s\n", (uintptr_t)code,
+                      code_size, name);
+        fflush(perf_map);
+    }
+
+    if (jit_dump) {
+        timestamp = get_timestamp();
+        /* the debug info must come before the code it describes */
+        if (lines && line_count > 0)
+            write_debug_info(code, lines, line_count, timestamp);
+        write_code_load(name, code, code_size, timestamp);
+        fflush(jit_dump);
+    }
+
+    os_mutex_unlock(&jit_perf_lock);
+}
+
+#endif /* end of WASM_ENABLE_LINUX_PERF != 0 */
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_JIT_PERF_H
+#define _WASM_JIT_PERF_H
+
+#include "bh_platform.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_LINUX_PERF != 0
+
+/* A line of the source code of the jitted code, the code from addr to
+   the addr of the next line info is generated for it */
+typedef struct WASMJitPerfLineInfo {
+    uintptr_t addr;
+    uint32 line;
+    const char *file_name;
+} WASMJitPerfLineInfo;
+
+bool
+wasm_jit_perf_init(void);
+
+void
+wasm_jit_perf_destroy(void);
+
+/**
+ * Tell linux perf about the code generated by the JIT compilers: append
+ * it to /tmp/perf-<pid>.map, and to the jitdump file /tmp/jit-<pid>.dump
+ * together with its line info, which `perf inject --jit` merges into the
+ * recorded samples.
+ *
+ * @param name the symbol name of the code
+ * @param code the address of the code
+ * @param code_size the size of the code
+ * @param lines the line info sorted by address, can be NULL
+ * @param line_count the number of the line info
+ */
+void
+wasm_jit_perf_add_code(const char *name, const void *code, uint32 code_size,
+                       const WASMJitPerfLineInfo *lines, uint32 line_count);
+
+#endif /* end of WASM_ENABLE_LINUX_PERF != 0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_JIT_PERF_H */
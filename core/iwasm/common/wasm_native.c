@@ -472,7 +472,7 @@ wasi_context_dtor(WASMModuleInstanceCommon *inst, void *ctx)
 }
 #endif /* end of WASM_ENABLE_LIBC_WASI */
 
-#if WASM_ENABLE_QUICK_AOT_ENTRY != 0
+#if WASM_ENABLE_QUICK_AOT_ENTRY != 0 || WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
 static bool
 quick_aot_entry_init(void);
 #endif
@@ -595,7 +595,7 @@ wasm_native_init()
         goto fail;
 #endif /* WASM_ENABLE_WASI_NN != 0 || WASM_ENABLE_WASI_EPHEMERAL_NN != 0 */
 
-#if WASM_ENABLE_QUICK_AOT_ENTRY != 0
+#if WASM_ENABLE_QUICK_AOT_ENTRY != 0 || WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
     if (!quick_aot_entry_init()) {
 #if WASM_ENABLE_SPEC_TEST != 0 || WASM_ENABLE_LIBC_BUILTIN != 0          \
     || WASM_ENABLE_BASE_LIB != 0 || WASM_ENABLE_LIBC_EMCC != 0           \
@@ -657,7 +657,7 @@ wasm_native_destroy()
     g_native_symbols_list = NULL;
 }
 
-#if WASM_ENABLE_QUICK_AOT_ENTRY != 0
+#if WASM_ENABLE_QUICK_AOT_ENTRY != 0 || WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
 static void
 invoke_no_args_v(void *func_ptr, void *exec_env, int32 *argv, int32 *argv_ret)
 {
@@ -1482,6 +1482,20 @@ quick_aot_entry_init(void)
     return true;
 }
 
+static QuickAOTEntry *
+lookup_quick_aot_entry(const char *signature)
+{
+    QuickAOTEntry key = { 0 };
+
+    key.signature = signature;
+    return bsearch(&key, quick_aot_entries,
+                   sizeof(quick_aot_entries) / sizeof(QuickAOTEntry),
+                   sizeof(QuickAOTEntry), quick_aot_entry_cmp);
+}
+#endif /* end of WASM_ENABLE_QUICK_AOT_ENTRY != 0 \
+          || WASM_ENABLE_QUICK_NATIVE_ENTRY != 0 */
+
+#if WASM_ENABLE_QUICK_AOT_ENTRY != 0
 void *
 wasm_native_lookup_quick_aot_entry(const WASMFuncType *func_type)
 {
@@ -1489,7 +1503,7 @@ wasm_native_lookup_quick_aot_entry(const WASMFuncType *func_type)
     uint32 param_count = func_type->param_count;
     uint32 result_count = func_type->result_count, i, j = 0;
     const uint8 *types = func_type->types;
-    QuickAOTEntry *quick_aot_entry, key = { 0 };
+    QuickAOTEntry *quick_aot_entry;
 
     if (param_count > 5 || result_count > 1)
         return NULL;
@@ -1519,14 +1533,156 @@ wasm_native_lookup_quick_aot_entry(const WASMFuncType *func_type)
             return NULL;
     }
 
-    key.signature = signature;
-    if ((quick_aot_entry =
-             bsearch(&key, quick_aot_entries,
-                     sizeof(quick_aot_entries) / sizeof(QuickAOTEntry),
-                     sizeof(QuickAOTEntry), quick_aot_entry_cmp))) {
+    if ((quick_aot_entry = lookup_quick_aot_entry(signature))) {
         return quick_aot_entry->func_ptr;
     }
 
     return NULL;
 }
 #endif /* end of WASM_ENABLE_QUICK_AOT_ENTRY != 0 */
+
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+/* A pointer param is passed to the invoke_xxx entry as an i64 */
+#if UINTPTR_MAX == UINT64_MAX
+#define QUICK_NATIVE_PTR_TYPE 'I'
+#define QUICK_NATIVE_PTR_CELL_NUM 2
+#else
+#define QUICK_NATIVE_PTR_TYPE 'i'
+#define QUICK_NATIVE_PTR_CELL_NUM 1
+#endif
+
+void *
+wasm_native_lookup_quick_native_entry(const WASMFuncType *func_type,
+                                      const char *signature,
+                                      bool *p_ptr_args)
+{
+    char native_signature[16] = { 0 };
+    uint32 param_count = func_type->param_count;
+    uint32 result_count = func_type->result_count, i, j = 0;
+    const uint8 *types = func_type->types;
+    QuickAOTEntry *quick_aot_entry;
+    bool ptr_args = false;
+    char c;
+
+    if (param_count > 5 || result_count > 1)
+        return NULL;
+
+    native_signature[j++] = '(';
+
+    for (i = 0; i < param_count; i++) {
+        c = signature ? signature[i + 1] : '\0';
+        if (types[i] == VALUE_TYPE_I32) {
+            if (c == '*' || c == '$') {
+                native_signature[j++] = QUICK_NATIVE_PTR_TYPE;
+                ptr_args = true;
+            }
+            else
+                native_signature[j++] = 'i';
+        }
+        else if (types[i] == VALUE_TYPE_I64)
+            native_signature[j++] = 'I';
+        else
+            return NULL;
+    }
+
+    native_signature[j++] = ')';
+
+    if (result_count == 0) {
+        native_signature[j++] = 'v';
+    }
+    else {
+        if (types[i] == VALUE_TYPE_I32)
+            native_signature[j++] = 'i';
+        else if (types[i] == VALUE_TYPE_I64)
+            native_signature[j++] = 'I';
+        else
+            return NULL;
+    }
+
+    if (!(quick_aot_entry = lookup_quick_aot_entry(native_signature)))
+        return NULL;
+
+    *p_ptr_args = ptr_args;
+    return quick_aot_entry->func_ptr;
+}
+
+bool
+wasm_native_invoke_quick_native_entry(WASMExecEnv *exec_env,
+                                      void *quick_native_entry, void *func_ptr,
+                                      const WASMFuncType *func_type,
+                                      const char *signature, bool ptr_args,
+                                      void *attachment, uint32 *argv,
+                                      uint32 *argv_ret)
+{
+    WASMModuleInstanceCommon *module = wasm_runtime_get_module_inst(exec_env);
+    void (*invoke_native)(void *func_ptr, void *exec_env, uint32 *argv,
+                          uint32 *argv_ret) = quick_native_entry;
+    /* at most 5 params of 2 cells */
+    uint32 argv1[10], *argv_src = argv, arg_i32, ptr_len, i, j = 0;
+    void *native_addr;
+#if WASM_ENABLE_MEMORY64 != 0
+    WASMMemoryInstance *memory;
+#endif
+
+    if (ptr_args) {
+#if WASM_ENABLE_MEMORY64 != 0
+        /* the pointers of memory64 are i64, which aren't converted here */
+        memory = wasm_get_default_memory((WASMModuleInstance *)module);
+        if (memory && memory->is_memory64)
+            return wasm_runtime_invoke_native(
+                exec_env, func_ptr, func_type, signature, attachment, argv,
+                func_type->param_cell_num, argv_ret);
+#endif
+        /* Check and convert the pointer params to native addresses as
+           wasm_runtime_invoke_native does */
+        for (i = 0; i < func_type->param_count; i++) {
+            if (func_type->types[i] == VALUE_TYPE_I64) {
+                argv1[j++] = *argv_src++;
+                argv1[j++] = *argv_src++;
+                continue;
+            }
+
+            arg_i32 = *argv_src++;
+            if (signature[i + 1] == '*') {
+                /* param is a pointer */
+                if (signature[i + 2] == '~')
+                    /* pointer with length followed */
+                    ptr_len = *argv_src;
+                else
+                    /* pointer without length followed */
+                    ptr_len = 1;
+
+                if (!wasm_runtime_validate_app_addr(module, (uint64)arg_i32,
+                                                    (uint64)ptr_len))
+                    return false;
+            }
+            else if (signature[i + 1] == '$') {
+                /* param is a string */
+                if (!wasm_runtime_validate_app_str_addr(module,
+                                                        (uint64)arg_i32))
+                    return false;
+            }
+            else {
+                argv1[j++] = arg_i32;
+                continue;
+            }
+
+            native_addr =
+                wasm_runtime_addr_app_to_native(module, (uint64)arg_i32);
+#if QUICK_NATIVE_PTR_CELL_NUM == 2
+            PUT_I64_TO_ADDR(argv1 + j, (uint64)(uintptr_t)native_addr);
+#else
+            argv1[j] = (uint32)(uintptr_t)native_addr;
+#endif
+            j += QUICK_NATIVE_PTR_CELL_NUM;
+        }
+        argv = argv1;
+    }
+
+    exec_env->attachment = attachment;
+    invoke_native(func_ptr, exec_env, argv, argv_ret);
+    exec_env->attachment = NULL;
+
+    return !wasm_runtime_get_exception(module);
+}
+#endif /* end of WASM_ENABLE_QUICK_NATIVE_ENTRY != 0 */
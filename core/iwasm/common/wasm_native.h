@@ -110,6 +110,38 @@ void *
 wasm_native_lookup_quick_aot_entry(const WASMFuncType *func_type);
 #endif
 
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+struct WASMExecEnv;
+
+/**
+ * Lookup the quick entry to call a native function registered with a
+ * signature, which passes the arguments to the function directly instead
+ * of building them for invokeNative in each call.
+ *
+ * @param func_type the wasm function type of the import
+ * @param signature the signature of the native function, may be NULL
+ * @param p_ptr_args return whether there are pointer or string params,
+ *        which are checked and converted to native addresses in each call
+ *
+ * @return the quick entry, NULL if there isn't one for the signature
+ */
+void *
+wasm_native_lookup_quick_native_entry(const WASMFuncType *func_type,
+                                      const char *signature, bool *p_ptr_args);
+
+/**
+ * Call a native function with its quick entry, the same as
+ * wasm_runtime_invoke_native does for a non-raw native function.
+ */
+bool
+wasm_native_invoke_quick_native_entry(struct WASMExecEnv *exec_env,
+                                      void *quick_native_entry, void *func_ptr,
+                                      const WASMFuncType *func_type,
+                                      const char *signature, bool ptr_args,
+                                      void *attachment, uint32 *argv,
+                                      uint32 *argv_ret);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
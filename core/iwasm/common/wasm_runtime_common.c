@@ -12,6 +12,9 @@
 #include "wasm_memory.h"
 #if WASM_ENABLE_INTERP != 0
 #include "../interpreter/wasm_runtime.h"
+#if WASM_ENABLE_PARALLEL_LOADER != 0 || WASM_ENABLE_STREAMING_LOADER != 0
+#include "../interpreter/wasm_loader.h"
+#endif
 #endif
 #if WASM_ENABLE_AOT != 0
 #include "../aot/aot_runtime.h"
@@ -21,6 +24,7 @@
 #endif
 #if WASM_ENABLE_GC != 0
 #include "gc/gc_object.h"
+#include "mem_alloc.h"
 #endif
 #if WASM_ENABLE_THREAD_MGR != 0
 #include "../libraries/thread-mgr/thread_manager.h"
@@ -31,6 +35,12 @@
 #if WASM_ENABLE_SHARED_MEMORY != 0
 #include "wasm_shared_memory.h"
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+#include "wasm_sampling_profiler.h"
+#endif
+#if WASM_ENABLE_LINUX_PERF != 0
+#include "wasm_jit_perf.h"
+#endif
 #if WASM_ENABLE_FAST_JIT != 0
 #include "../fast-jit/jit_compiler.h"
 #endif
@@ -171,6 +181,9 @@ static LLVMJITOptions llvm_jit_options = { 3, 3, 0, false };
 
 #if WASM_ENABLE_GC != 0
 static uint32 gc_heap_size_default = GC_HEAP_SIZE_DEFAULT;
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+static uint32 gc_heap_max_size_default = 0;
+#endif
 #endif
 
 static RunningMode runtime_running_mode = Mode_Default;
@@ -460,6 +473,12 @@ wasm_runtime_env_init(void)
     if (bh_platform_init() != 0)
         return false;
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    if (!wasm_sampling_profiler_init()) {
+        goto fail0;
+    }
+#endif
+
     if (wasm_native_init() == false) {
         goto fail1;
     }
@@ -574,6 +593,10 @@ fail2:
 #endif
     wasm_native_destroy();
 fail1:
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    wasm_sampling_profiler_destroy();
+fail0:
+#endif
     bh_platform_destroy();
 
     return false;
@@ -641,6 +664,11 @@ wasm_runtime_init()
 static void
 wasm_runtime_destroy_internal(void)
 {
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    /* stop the profiler thread before the exec_envs go away */
+    wasm_sampling_profiler_destroy();
+#endif
+
 #if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
     wasm_externref_map_destroy();
 #endif
@@ -683,6 +711,11 @@ wasm_runtime_destroy_internal(void)
     jit_compiler_destroy();
 #endif
 
+#if WASM_ENABLE_LINUX_PERF != 0
+    /* after the JIT compilers, which may still be adding code */
+    wasm_jit_perf_destroy();
+#endif
+
 #if WASM_ENABLE_SHARED_MEMORY
     wasm_shared_memory_destroy();
 #endif
@@ -694,6 +727,14 @@ wasm_runtime_destroy_internal(void)
     thread_manager_destroy();
 #endif
 
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_PARALLEL != 0
+    mem_allocator_destroy_gc_helper_threads();
+#endif
+
+#if WASM_ENABLE_INTERP != 0 && WASM_ENABLE_PARALLEL_LOADER != 0
+    wasm_loader_destroy_helper_threads();
+#endif
+
     wasm_native_destroy();
     bh_platform_destroy();
 
@@ -738,6 +779,14 @@ wasm_runtime_get_gc_heap_size_default(void)
 {
     return gc_heap_size_default;
 }
+
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+uint32
+wasm_runtime_get_gc_heap_max_size_default(void)
+{
+    return gc_heap_max_size_default;
+}
+#endif
 #endif
 
 static bool
@@ -761,6 +810,20 @@ wasm_runtime_full_init_internal(RuntimeInitArgs *init_args)
     if (gc_heap_size > 0) {
         gc_heap_size_default = gc_heap_size;
     }
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+    gc_heap_max_size_default = init_args->gc_heap_max_size;
+    if (!mem_allocator_set_gc_heap_growth_policy(
+            init_args->gc_heap_live_ratio, init_args->gc_heap_max_pause_us)) {
+        LOG_ERROR("Invalid GC heap live ratio %" PRIu32,
+                  init_args->gc_heap_live_ratio);
+        wasm_runtime_memory_destroy();
+        return false;
+    }
+#else
+    if (init_args->gc_heap_max_size > 0)
+        LOG_WARNING("warning: to enable growable GC heap, please recompile "
+                    "with -DWAMR_BUILD_GC_GROWABLE_HEAP=1");
+#endif
 #endif
 
 #if WASM_ENABLE_JIT != 0
@@ -782,6 +845,47 @@ wasm_runtime_full_init_internal(RuntimeInitArgs *init_args)
         return false;
     }
 
+#if WASM_ENABLE_LINUX_PERF != 0
+    if (init_args->enable_linux_perf && !wasm_jit_perf_init()) {
+        wasm_runtime_destroy();
+        return false;
+    }
+#endif
+
+#if WASM_ENABLE_INTERP != 0 && WASM_ENABLE_PARALLEL_LOADER != 0
+    if (init_args->loader_helper_thread_num > 0
+        && !wasm_loader_init_helper_threads(
+            init_args->loader_helper_thread_num))
+        LOG_WARNING("warning: create loader helper threads failed, "
+                    "modules are loaded by one thread");
+#else
+    if (init_args->loader_helper_thread_num > 0)
+        LOG_WARNING("warning: to enable parallel loader, please recompile "
+                    "with -DWAMR_BUILD_PARALLEL_LOADER=1");
+#endif
+
+#if WASM_ENABLE_GC != 0
+#if WASM_ENABLE_GC_PARALLEL != 0
+    if (init_args->gc_helper_thread_num > 0
+        && !mem_allocator_init_gc_helper_threads(
+            init_args->gc_helper_thread_num))
+        LOG_WARNING("warning: create GC helper threads failed, "
+                    "GC is done by one thread");
+#else
+    if (init_args->gc_helper_thread_num > 0)
+        LOG_WARNING("warning: to enable parallel GC, please recompile "
+                    "with -DWAMR_BUILD_GC_PARALLEL=1");
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    mem_allocator_set_gc_slice_budget(init_args->gc_slice_budget_us);
+#else
+    if (init_args->gc_slice_budget_us > 0)
+        LOG_WARNING("warning: to enable incremental GC, please recompile "
+                    "with -DWAMR_BUILD_GC_INCREMENTAL=1");
+#endif
+#endif
+
 #if WASM_ENABLE_DEBUG_INTERP != 0
     if (strlen(init_args->ip_addr))
         if (!wasm_debug_engine_init(init_args->ip_addr,
@@ -1570,6 +1674,83 @@ wasm_runtime_load_from_sections(WASMSection *section_list, bool is_aot,
 #endif
 }
 
+wasm_module_stream_t
+wasm_runtime_load_stream_begin(uint32 total_size, const LoadArgs *args,
+                               char *error_buf, uint32 error_buf_size)
+{
+#if WASM_ENABLE_INTERP != 0 && WASM_ENABLE_STREAMING_LOADER != 0
+    if (!args) {
+        set_error_buf(error_buf, error_buf_size,
+                      "WASM module load failed: null load arguments");
+        return NULL;
+    }
+
+    return wasm_loader_stream_begin(total_size, args, error_buf,
+                                    error_buf_size);
+#else
+    (void)total_size;
+    (void)args;
+    set_error_buf(error_buf, error_buf_size,
+                  "WASM module load failed: streaming loader isn't enabled");
+    return NULL;
+#endif
+}
+
+bool
+wasm_runtime_load_stream_feed(wasm_module_stream_t stream, const uint8 *buf,
+                              uint32 size, char *error_buf,
+                              uint32 error_buf_size)
+{
+#if WASM_ENABLE_INTERP != 0 && WASM_ENABLE_STREAMING_LOADER != 0
+    return wasm_loader_stream_feed(stream, buf, size, error_buf,
+                                   error_buf_size);
+#else
+    (void)stream;
+    (void)buf;
+    (void)size;
+    set_error_buf(error_buf, error_buf_size,
+                  "WASM module load failed: streaming loader isn't enabled");
+    return false;
+#endif
+}
+
+WASMModuleCommon *
+wasm_runtime_load_stream_finish(wasm_module_stream_t stream, char *error_buf,
+                                uint32 error_buf_size)
+{
+#if WASM_ENABLE_INTERP != 0 && WASM_ENABLE_STREAMING_LOADER != 0
+    WASMModuleCommon *module_common =
+        (WASMModuleCommon *)wasm_loader_stream_finish(stream,
+#if WASM_ENABLE_MULTI_MODULE != 0
+                                                      true,
+#endif
+                                                      error_buf,
+                                                      error_buf_size);
+    if (!module_common) {
+        LOG_DEBUG("WASM module load failed from stream");
+        return NULL;
+    }
+
+    return register_module_with_null_name(module_common, error_buf,
+                                          error_buf_size);
+#else
+    (void)stream;
+    set_error_buf(error_buf, error_buf_size,
+                  "WASM module load failed: streaming loader isn't enabled");
+    return NULL;
+#endif
+}
+
+void
+wasm_runtime_load_stream_abort(wasm_module_stream_t stream)
+{
+#if WASM_ENABLE_INTERP != 0 && WASM_ENABLE_STREAMING_LOADER != 0
+    wasm_loader_stream_abort(stream);
+#else
+    (void)stream;
+#endif
+}
+
 void
 wasm_runtime_unload(WASMModuleCommon *module)
 {
@@ -2968,6 +3149,305 @@ fail1:
     return ret;
 }
 
+/* A call of a wasm function prepared once and repeated with raw arguments */
+struct WASMPreparedCall {
+    WASMExecEnv *exec_env;
+    WASMFunctionInstanceCommon *function;
+    uint32 module_type;
+    uint32 param_count;
+    uint32 result_count;
+    uint32 param_cell_num;
+    /* Whether the arguments or results are converted by
+       wasm_runtime_call_wasm, e.g. the externrefs are mapped to indexes */
+    bool convert_refs;
+    /* The buffer of the argument and result cells */
+    uint32 *argv;
+    /* The cell num of each param and then each result, 1 or 2 */
+    uint8 *cell_nums;
+};
+
+WASMPreparedCall *
+wasm_runtime_create_prepared_call(WASMExecEnv *exec_env,
+                                  WASMFunctionInstanceCommon *function)
+{
+    WASMPreparedCall *call;
+    WASMFuncType *type;
+    uint32 i, cell_num, param_cell_num = 0, ret_cell_num = 0, argv_cell_num;
+    uint64 total_size;
+    bool convert_refs = false;
+
+    type = wasm_runtime_get_function_type(function,
+                                          exec_env->module_inst->module_type);
+    if (!type) {
+        LOG_ERROR("Function type get failed, WAMR Interpreter and AOT must be "
+                  "enabled at least one.");
+        return NULL;
+    }
+
+    for (i = 0; i < type->param_count + type->result_count; i++) {
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+        cell_num = wasm_value_type_cell_num_outside(type->types[i]);
+        if (type->types[i] == VALUE_TYPE_EXTERNREF)
+            convert_refs = true;
+#else
+        cell_num = wasm_value_type_cell_num(type->types[i]);
+#endif
+        if (cell_num > 2) {
+            LOG_ERROR("Prepared call of a function with v128 parameters or "
+                      "results isn't supported.");
+            return NULL;
+        }
+        if (i < type->param_count)
+            param_cell_num += cell_num;
+        else
+            ret_cell_num += cell_num;
+    }
+
+    argv_cell_num = param_cell_num > ret_cell_num ? param_cell_num
+                                                  : ret_cell_num;
+    if (argv_cell_num < 2)
+        argv_cell_num = 2;
+
+    total_size = sizeof(WASMPreparedCall)
+                 + sizeof(uint32) * (uint64)argv_cell_num
+                 + (uint64)type->param_count + type->result_count;
+    if (!(call = runtime_malloc(total_size, exec_env->module_inst, NULL, 0)))
+        return NULL;
+
+    call->exec_env = exec_env;
+    call->function = function;
+    call->module_type = exec_env->module_inst->module_type;
+    call->param_count = type->param_count;
+    call->result_count = type->result_count;
+    call->param_cell_num = param_cell_num;
+    call->convert_refs = convert_refs;
+    call->argv = (uint32 *)(call + 1);
+    call->cell_nums = (uint8 *)(call->argv + argv_cell_num);
+    for (i = 0; i < type->param_count + type->result_count; i++) {
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+        call->cell_nums[i] =
+            (uint8)wasm_value_type_cell_num_outside(type->types[i]);
+#else
+        call->cell_nums[i] = (uint8)wasm_value_type_cell_num(type->types[i]);
+#endif
+    }
+    return call;
+}
+
+void
+wasm_runtime_destroy_prepared_call(WASMPreparedCall *call)
+{
+    wasm_runtime_free(call);
+}
+
+bool
+wasm_runtime_call_prepared(WASMPreparedCall *call, const uint64 *args,
+                           uint64 *results)
+{
+    WASMExecEnv *exec_env = call->exec_env;
+    uint32 *argv = call->argv;
+    uint32 i, cell = 0;
+    bool ret = false;
+
+    for (i = 0; i < call->param_count; i++) {
+        if (call->cell_nums[i] == 1) {
+            argv[cell++] = (uint32)args[i];
+        }
+        else {
+            PUT_I64_TO_ADDR(argv + cell, args[i]);
+            cell += 2;
+        }
+    }
+
+    if (call->convert_refs) {
+        ret = wasm_runtime_call_wasm(exec_env, call->function,
+                                     call->param_cell_num, argv);
+    }
+    else {
+        /* the function type is already checked, enter the function as
+           wasm_runtime_call_wasm does without converting the arguments */
+        if (!wasm_runtime_exec_env_check(exec_env)) {
+            LOG_ERROR("Invalid exec env stack info.");
+            return false;
+        }
+#if WASM_ENABLE_INTERP != 0
+        if (call->module_type == Wasm_Module_Bytecode)
+            ret = wasm_call_function(exec_env,
+                                     (WASMFunctionInstance *)call->function,
+                                     call->param_cell_num, argv);
+#endif
+#if WASM_ENABLE_AOT != 0
+        if (call->module_type == Wasm_Module_AoT)
+            ret = aot_call_function(exec_env,
+                                    (AOTFunctionInstance *)call->function,
+                                    call->param_cell_num, argv);
+#endif
+    }
+    if (!ret)
+        return false;
+
+    for (i = 0, cell = 0; i < call->result_count; i++) {
+        if (call->cell_nums[call->param_count + i] == 1) {
+            results[i] = argv[cell++];
+        }
+        else {
+            results[i] = (uint64)GET_I64_FROM_ADDR(argv + cell);
+            cell += 2;
+        }
+    }
+    return true;
+}
+
+void
+wasm_runtime_batch_call_begin(WASMBatchCall *batch, uint32 index)
+{
+    if (batch->param_cell_num > 0)
+        bh_memcpy_s(batch->argv, sizeof(uint32) * batch->param_cell_num,
+                    batch->args + (uint64)batch->param_cell_num * index,
+                    sizeof(uint32) * batch->param_cell_num);
+}
+
+void
+wasm_runtime_batch_call_abort(WASMBatchCall *batch, uint32 index)
+{
+    uint32 i;
+
+    for (i = index; i < batch->num_calls; i++) {
+        if (batch->failed)
+            batch->failed[i] = true;
+        batch->failed_count++;
+    }
+    batch->stopped = true;
+}
+
+bool
+wasm_runtime_batch_call_end(WASMModuleInstanceCommon *module_inst,
+                            WASMBatchCall *batch, uint32 index, bool success)
+{
+    const char *exception, *prefix = "Exception: ";
+
+    if (success) {
+        if (batch->ret_cell_num > 0)
+            bh_memcpy_s(batch->results + (uint64)batch->ret_cell_num * index,
+                        sizeof(uint32) * batch->ret_cell_num, batch->argv,
+                        sizeof(uint32) * batch->ret_cell_num);
+        if (batch->failed)
+            batch->failed[index] = false;
+        return true;
+    }
+
+    exception = wasm_runtime_get_exception(module_inst);
+    if (!exception)
+        exception = "unknown error";
+    else if (!strncmp(exception, prefix, strlen(prefix)))
+        exception += strlen(prefix);
+
+    if (!strcmp(exception, "wasi proc exit")
+        || !strcmp(exception, "terminated by user")) {
+        /* keep the exception and skip the remaining calls */
+        wasm_runtime_batch_call_abort(batch, index);
+        return false;
+    }
+
+    if (batch->failed)
+        batch->failed[index] = true;
+    batch->failed_count++;
+    snprintf(batch->exception, sizeof(batch->exception), "%s", exception);
+    wasm_runtime_clear_exception(module_inst);
+    return true;
+}
+
+uint32
+wasm_runtime_call_wasm_batch(WASMExecEnv *exec_env,
+                             WASMFunctionInstanceCommon *function,
+                             uint32 num_calls, const uint32 *args,
+                             uint32 *results, bool *failed)
+{
+    WASMModuleInstanceCommon *module_inst = exec_env->module_inst;
+    WASMBatchCall batch = { 0 };
+    WASMFuncType *type;
+    uint32 argv_buf[32], cell_num, i;
+    uint64 total_size;
+    bool convert_refs = false;
+
+    batch.num_calls = num_calls;
+    batch.args = args;
+    batch.results = results;
+    batch.failed = failed;
+    batch.argv = argv_buf;
+
+    if (!(type = wasm_runtime_get_function_type(function,
+                                                module_inst->module_type))) {
+        LOG_ERROR("Function type get failed, WAMR Interpreter and AOT must be "
+                  "enabled at least one.");
+        goto fail;
+    }
+
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+    for (i = 0; i < type->param_count + type->result_count; i++) {
+        cell_num = wasm_value_type_cell_num_outside(type->types[i]);
+        if (type->types[i] == VALUE_TYPE_EXTERNREF)
+            convert_refs = true;
+        if (i < type->param_count)
+            batch.param_cell_num += cell_num;
+        else
+            batch.ret_cell_num += cell_num;
+    }
+#else
+    batch.param_cell_num = type->param_cell_num;
+    batch.ret_cell_num = type->ret_cell_num;
+#endif
+
+    if (!wasm_runtime_exec_env_check(exec_env)) {
+        LOG_ERROR("Invalid exec env stack info.");
+        goto fail;
+    }
+
+    cell_num = batch.param_cell_num > batch.ret_cell_num ? batch.param_cell_num
+                                                         : batch.ret_cell_num;
+    total_size = sizeof(uint32) * (uint64)(cell_num > 2 ? cell_num : 2);
+    if (total_size > sizeof(argv_buf)
+        && !(batch.argv = runtime_malloc(total_size, module_inst, NULL, 0)))
+        goto fail;
+
+    if (convert_refs) {
+        /* the externrefs are converted in each call */
+        for (i = 0; i < num_calls; i++) {
+            wasm_runtime_batch_call_begin(&batch, i);
+            if (!wasm_runtime_batch_call_end(
+                    module_inst, &batch, i,
+                    wasm_runtime_call_wasm(exec_env, function,
+                                           batch.param_cell_num, batch.argv)))
+                break;
+        }
+    }
+#if WASM_ENABLE_INTERP != 0
+    else if (module_inst->module_type == Wasm_Module_Bytecode)
+        wasm_call_function_batch(exec_env, (WASMFunctionInstance *)function,
+                                 &batch);
+#endif
+#if WASM_ENABLE_AOT != 0
+    else if (module_inst->module_type == Wasm_Module_AoT)
+        aot_call_function_batch(exec_env, (AOTFunctionInstance *)function,
+                                &batch);
+#endif
+
+    if (batch.argv != argv_buf)
+        wasm_runtime_free(batch.argv);
+
+    /* report the exception of the last failed call */
+    if (batch.failed_count > 0 && !batch.stopped)
+        wasm_runtime_set_exception(module_inst, batch.exception);
+    return batch.failed_count;
+
+fail:
+    if (failed) {
+        for (i = 0; i < num_calls; i++)
+            failed[i] = true;
+    }
+    return num_calls;
+}
+
 bool
 wasm_runtime_create_exec_env_singleton(
     WASMModuleInstanceCommon *module_inst_comm)
@@ -7844,7 +8324,8 @@ wasm_runtime_is_underlying_binary_freeable(WASMModuleCommon *const module)
 #if (WASM_ENABLE_JIT != 0 || WASM_ENABLE_FAST_JIT != 0) \
     && (WASM_ENABLE_LAZY_JIT != 0)
         return false;
-#elif WASM_ENABLE_FAST_INTERP == 0
+#elif WASM_ENABLE_FAST_INTERP == 0 || WASM_ENABLE_LAZY_LOADER != 0
+        /* the function bodies are prepared from the binary at run time */
         return false;
 #else
         /* Fast interpreter mode */
@@ -630,6 +630,11 @@ wasm_runtime_get_llvm_jit_options(void);
 /* Internal API */
 uint32
 wasm_runtime_get_gc_heap_size_default(void);
+
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+uint32
+wasm_runtime_get_gc_heap_max_size_default(void);
+#endif
 #endif
 
 /* See wasm_export.h for description */
@@ -826,6 +831,68 @@ wasm_runtime_call_wasm_v(WASMExecEnv *exec_env,
                          uint32 num_results, wasm_val_t *results,
                          uint32 num_args, ...);
 
+/* The calls of a function over many argument sets in one runtime entry */
+typedef struct WASMBatchCall {
+    uint32 num_calls;
+    uint32 param_cell_num;
+    uint32 ret_cell_num;
+    /* param_cell_num cells of arguments for each call */
+    const uint32 *args;
+    /* ret_cell_num cells of results for each call */
+    uint32 *results;
+    /* whether each call failed, may be NULL */
+    bool *failed;
+    uint32 failed_count;
+    /* the remaining calls are skipped, e.g. after proc_exit */
+    bool stopped;
+    /* the argument and result cells of the current call */
+    uint32 *argv;
+    /* the exception of the last failed call, EXCEPTION_BUF_LEN */
+    char exception[128];
+} WASMBatchCall;
+
+/* Copy the arguments of a call of a batch to the argv of the batch */
+void
+wasm_runtime_batch_call_begin(WASMBatchCall *batch, uint32 index);
+
+/* Mark the calls of a batch from index on failed and skip them */
+void
+wasm_runtime_batch_call_abort(WASMBatchCall *batch, uint32 index);
+
+/**
+ * Record the result or the exception of a call of a batch, and clear the
+ * exception for the next call.
+ *
+ * @return false if the remaining calls are skipped, then they are marked
+ *         failed and the exception is kept
+ */
+bool
+wasm_runtime_batch_call_end(WASMModuleInstanceCommon *module_inst,
+                            WASMBatchCall *batch, uint32 index, bool success);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN uint32
+wasm_runtime_call_wasm_batch(WASMExecEnv *exec_env,
+                             WASMFunctionInstanceCommon *function,
+                             uint32 num_calls, const uint32 *args,
+                             uint32 *results, bool *failed);
+
+typedef struct WASMPreparedCall WASMPreparedCall;
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN WASMPreparedCall *
+wasm_runtime_create_prepared_call(WASMExecEnv *exec_env,
+                                  WASMFunctionInstanceCommon *function);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_destroy_prepared_call(WASMPreparedCall *call);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_call_prepared(WASMPreparedCall *call, const uint64 *args,
+                           uint64 *results);
+
 /* See wasm_export.h for description */
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
@@ -0,0 +1,422 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_sampling_profiler.h"
+#include "wasm_runtime_common.h"
+#include "bh_atomic.h"
+#include "bh_hashmap.h"
+#include "bh_log.h"
+#if WASM_ENABLE_INTERP != 0
+#include "../interpreter/wasm_runtime.h"
+#endif
+#if WASM_ENABLE_AOT != 0
+#include "../aot/aot_runtime.h"
+#endif
+
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+
+#if BH_ATOMIC_32_IS_ATOMIC == 0
+#error "Sampling profiler requires atomic operations"
+#endif
+
+/*
+ * The profiler thread wakes up every interval and samples the exec_envs
+ * running wasm code one by one: it sends SIGPROF to the thread of the
+ * exec_env, whose signal handler copies the frames of the exec_env with
+ * wasm_copy_callstack. The profiler thread then turns the frames into a
+ * folded stack and counts it, so the signal handler doesn't allocate
+ * memory or take locks.
+ *
+ * wasm_copy_callstack is async-signal-safe: it runs in the thread of the
+ * exec_env, only reads the exec_env, its instance and module, and only
+ * follows the frame links which point between the bottom and the top
+ * boundary of the wasm stack. A signal which interrupts the push or pop
+ * of a frame may give a truncated or stale sample, but no invalid read.
+ */
+
+/* States of a sample request, the bits are set one by one */
+#define SAMPLE_PENDING 1
+/* the signal handler is copying the frames */
+#define SAMPLE_TAKEN 2
+/* the frames have been copied */
+#define SAMPLE_DONE 4
+/* the profiler thread stopped waiting before the handler took it */
+#define SAMPLE_CANCELLED 8
+#define SAMPLE_STATE_MASK 0xF
+/* The sequence number of the request is kept in the other bits of the
+   state, so that a signal handler which is interrupted between reading
+   the state and taking the request can't take a later request */
+#define SAMPLE_SEQ_SHIFT 4
+
+/* How long the profiler thread waits for a signal handler */
+#define SAMPLE_TIMEOUT_US 10000
+#define SAMPLE_POLL_US 20
+
+/* Size of a folded stack and of a frame name in it */
+#define FOLDED_STACK_SIZE_MAX 4096
+#define FRAME_NAME_SIZE_MAX 128
+
+/* Protects the list of the exec_envs and the samples, it is held by the
+   profiler thread while it samples */
+static korp_mutex profiler_lock;
+/* The exec_envs which can be sampled */
+static WASMExecEnv *exec_env_list;
+/* Number of each folded stack sampled, the keys are the folded stacks */
+static HashMap *folded_stacks;
+
+static korp_tid profiler_tid;
+static bh_atomic_32_t is_profiler_running;
+static uint32 sampling_interval;
+
+static bool is_signal_handler_installed;
+static struct sigaction prev_sigprof_action;
+
+/* The request to the signal handler, sample_exec_env and sample_tid are
+   set before the state is */
+static bh_atomic_32_t sample_state;
+static uint32 sample_seq;
+static WASMExecEnv *volatile sample_exec_env;
+static korp_tid volatile sample_tid;
+static wasm_frame_t sample_frames[WASM_SAMPLING_MAX_DEPTH];
+static uint32 sample_frame_num;
+static char sample_error_buf[128];
+
+static void
+sigprof_handler(int sig)
+{
+    uint32 state = BH_ATOMIC_32_LOAD(sample_state);
+    int saved_errno = errno;
+
+    (void)sig;
+
+    /* Only the thread of the pending request takes it, a late signal of
+       a cancelled request is ignored. The exec_env isn't dereferenced
+       before the request is taken: the profiler thread may have given up
+       the request, and the exec_env may be destroyed then. */
+    if ((state & SAMPLE_STATE_MASK) == SAMPLE_PENDING
+        && pthread_equal(pthread_self(), sample_tid)
+        && BH_ATOMIC_32_COMPARE_EXCHANGE(sample_state, state,
+                                         state | SAMPLE_TAKEN)) {
+        sample_frame_num = wasm_copy_callstack(
+            sample_exec_env, sample_frames, WASM_SAMPLING_MAX_DEPTH, 0,
+            sample_error_buf, sizeof(sample_error_buf));
+        BH_ATOMIC_32_FETCH_OR(sample_state, SAMPLE_DONE);
+    }
+
+    errno = saved_errno;
+}
+
+static uint32
+folded_stack_hash(const void *key)
+{
+    const uint8 *p = (const uint8 *)key;
+    uint32 hash = 2166136261u;
+
+    while (*p)
+        hash = (hash ^ *p++) * 16777619u;
+    return hash;
+}
+
+static bool
+folded_stack_equal(void *key1, void *key2)
+{
+    return strcmp((const char *)key1, (const char *)key2) == 0;
+}
+
+/* Get the name of a frame in the form the flame graph helper in
+   test-tools/flame-graph-helper translates: "aot_func#N" or
+   "[module name]#aot_func#N", N is the index of the function without
+   the imported ones */
+static void
+get_frame_name(WASMModuleInstanceCommon *module_inst, uint32 func_index,
+               char *buf, uint32 buf_size)
+{
+    WASMModuleCommon *module = wasm_runtime_get_module(module_inst);
+    const char *module_name = wasm_runtime_get_module_name(module);
+    const char *import_module = NULL, *import_field = NULL;
+    uint32 import_count = 0;
+
+#if WASM_ENABLE_INTERP != 0
+    if (module->module_type == Wasm_Module_Bytecode) {
+        WASMModule *wasm_module = (WASMModule *)module;
+        import_count = wasm_module->import_function_count;
+        if (func_index < import_count) {
+            import_module =
+                wasm_module->import_functions[func_index].u.function.module_name;
+            import_field =
+                wasm_module->import_functions[func_index].u.function.field_name;
+        }
+    }
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module->module_type == Wasm_Module_AoT) {
+        AOTModule *aot_module = (AOTModule *)module;
+        import_count = aot_module->import_func_count;
+        if (func_index < import_count) {
+            import_module = aot_module->import_funcs[func_index].module_name;
+            import_field = aot_module->import_funcs[func_index].func_name;
+        }
+    }
+#endif
+
+    if (func_index < import_count)
+        snprintf(buf, buf_size, "[Native] %s.%s", import_module,
+                 import_field);
+    else if (module_name && module_name[0])
+        snprintf(buf, buf_size, "[%s]#aot_func#%u", module_name,
+                 func_index - import_count);
+    else
+        snprintf(buf, buf_size, "aot_func#%u", func_index - import_count);
+}
+
+/* Count the frames copied by the signal handler as a folded stack, the
+   profiler lock should be held */
+static void
+add_sample(void)
+{
+    char folded_stack[FOLDED_STACK_SIZE_MAX];
+    char name[FRAME_NAME_SIZE_MAX];
+    uint32 i, len = 0, name_len;
+    uintptr_t count;
+    void *value, *old_value;
+    char *key;
+
+    if (sample_frame_num == 0)
+        return;
+
+    /* the outermost frame comes first */
+    for (i = sample_frame_num; i > 0; i--) {
+        get_frame_name(sample_frames[i - 1].instance,
+                       sample_frames[i - 1].func_index, name, sizeof(name));
+        name_len = (uint32)strlen(name);
+        if (len + name_len + 2 > sizeof(folded_stack))
+            break;
+        if (len > 0)
+            folded_stack[len++] = ';';
+        bh_memcpy_s(folded_stack + len, sizeof(folded_stack) - len, name,
+                    name_len);
+        len += name_len;
+    }
+    folded_stack[len] = '\0';
+
+    if ((value = bh_hash_map_find(folded_stacks, folded_stack))) {
+        count = (uintptr_t)value + 1;
+        bh_hash_map_update(folded_stacks, folded_stack, (void *)count,
+                           &old_value);
+        return;
+    }
+
+    if (!(key = wasm_runtime_malloc(len + 1)))
+        return;
+    bh_memcpy_s(key, len + 1, folded_stack, len + 1);
+    if (!bh_hash_map_insert(folded_stacks, key, (void *)(uintptr_t)1))
+        wasm_runtime_free(key);
+}
+
+/* Sample an exec_env running wasm code, the profiler lock should be held
+   so that the exec_env isn't destroyed meanwhile */
+static void
+sample_exec_env_frames(WASMExecEnv *exec_env)
+{
+    uint32 waited_us = 0;
+
+    sample_frame_num = 0;
+    sample_exec_env = exec_env;
+    sample_tid = exec_env->handle;
+    sample_seq++;
+    BH_ATOMIC_32_STORE(sample_state,
+                       (sample_seq << SAMPLE_SEQ_SHIFT) | SAMPLE_PENDING);
+
+    if (pthread_kill(exec_env->handle, SIGPROF) != 0) {
+        BH_ATOMIC_32_FETCH_OR(sample_state, SAMPLE_CANCELLED);
+        return;
+    }
+
+    while (!(BH_ATOMIC_32_LOAD(sample_state) & SAMPLE_DONE)) {
+        if (waited_us >= SAMPLE_TIMEOUT_US) {
+            if (!(BH_ATOMIC_32_FETCH_OR(sample_state, SAMPLE_CANCELLED)
+                  & SAMPLE_TAKEN))
+                /* the thread didn't handle the signal in time, e.g. it
+                   isn't scheduled, the handler ignores it later */
+                return;
+            /* the handler is copying the frames, it doesn't take long */
+            while (!(BH_ATOMIC_32_LOAD(sample_state) & SAMPLE_DONE))
+                ;
+            break;
+        }
+        os_usleep(SAMPLE_POLL_US);
+        waited_us += SAMPLE_POLL_US;
+    }
+
+    add_sample();
+}
+
+static void *
+profiler_thread_routine(void *arg)
+{
+    WASMExecEnv *exec_env;
+
+    (void)arg;
+
+    while (BH_ATOMIC_32_LOAD(is_profiler_running)) {
+        os_usleep(sampling_interval);
+
+        os_mutex_lock(&profiler_lock);
+        for (exec_env = exec_env_list; exec_env;
+             exec_env = exec_env->sampling_next) {
+            /* only the exec_envs running wasm code have frames, their
+               threads are the ones which called into wasm. AOT code with
+               tiny frames only moves the stack top, the other frames are
+               linked from cur_frame. */
+            if ((exec_env->wasm_stack.top > exec_env->wasm_stack.bottom
+                 || exec_env->cur_frame)
+                && exec_env->handle)
+                sample_exec_env_frames(exec_env);
+        }
+        os_mutex_unlock(&profiler_lock);
+    }
+
+    return NULL;
+}
+
+bool
+wasm_sampling_profiler_init(void)
+{
+    if (os_mutex_init(&profiler_lock) != 0)
+        return false;
+
+    if (!(folded_stacks = bh_hash_map_create(
+              256, false, folded_stack_hash, folded_stack_equal,
+              wasm_runtime_free, NULL))) {
+        os_mutex_destroy(&profiler_lock);
+        return false;
+    }
+
+    exec_env_list = NULL;
+    return true;
+}
+
+void
+wasm_sampling_profiler_destroy(void)
+{
+    struct sigaction sig_act;
+
+    wasm_runtime_stop_sampling_profiler();
+
+    if (is_signal_handler_installed) {
+        /* a signal sent to a thread which didn't handle it in time may
+           still be pending, don't let it terminate the process */
+        if (prev_sigprof_action.sa_handler == SIG_DFL) {
+            memset(&sig_act, 0, sizeof(sig_act));
+            sig_act.sa_handler = SIG_IGN;
+            sigaction(SIGPROF, &sig_act, NULL);
+        }
+        else {
+            sigaction(SIGPROF, &prev_sigprof_action, NULL);
+        }
+        is_signal_handler_installed = false;
+    }
+
+    bh_hash_map_destroy(folded_stacks);
+    folded_stacks = NULL;
+    os_mutex_destroy(&profiler_lock);
+}
+
+void
+wasm_sampling_profiler_add_exec_env(WASMExecEnv *exec_env)
+{
+    os_mutex_lock(&profiler_lock);
+    exec_env->sampling_next = exec_env_list;
+    exec_env_list = exec_env;
+    os_mutex_unlock(&profiler_lock);
+}
+
+void
+wasm_sampling_profiler_remove_exec_env(WASMExecEnv *exec_env)
+{
+    WASMExecEnv **p_exec_env;
+
+    os_mutex_lock(&profiler_lock);
+    for (p_exec_env = &exec_env_list; *p_exec_env;
+         p_exec_env = &(*p_exec_env)->sampling_next) {
+        if (*p_exec_env == exec_env) {
+            *p_exec_env = exec_env->sampling_next;
+            break;
+        }
+    }
+    os_mutex_unlock(&profiler_lock);
+}
+
+bool
+wasm_runtime_start_sampling_profiler(uint32 interval_us)
+{
+    struct sigaction sig_act;
+
+    if (BH_ATOMIC_32_LOAD(is_profiler_running))
+        return true;
+
+    if (!is_signal_handler_installed) {
+        memset(&sig_act, 0, sizeof(sig_act));
+        sig_act.sa_handler = sigprof_handler;
+        sig_act.sa_flags = SA_RESTART;
+        sigemptyset(&sig_act.sa_mask);
+        if (sigaction(SIGPROF, &sig_act, &prev_sigprof_action) != 0) {
+            LOG_ERROR("install SIGPROF handler failed");
+            return false;
+        }
+        is_signal_handler_installed = true;
+    }
+
+    sampling_interval =
+        interval_us > 0 ? interval_us : WASM_SAMPLING_INTERVAL_DEFAULT;
+    BH_ATOMIC_32_STORE(is_profiler_running, 1);
+    if (os_thread_create(&profiler_tid, profiler_thread_routine, NULL,
+                         APP_THREAD_STACK_SIZE_DEFAULT)
+        != BHT_OK) {
+        LOG_ERROR("create sampling profiler thread failed");
+        BH_ATOMIC_32_STORE(is_profiler_running, 0);
+        return false;
+    }
+    return true;
+}
+
+void
+wasm_runtime_stop_sampling_profiler(void)
+{
+    if (!BH_ATOMIC_32_LOAD(is_profiler_running))
+        return;
+
+    BH_ATOMIC_32_STORE(is_profiler_running, 0);
+    os_thread_join(profiler_tid, NULL);
+}
+
+static void
+write_folded_stack(void *key, void *value, void *user_data)
+{
+    fprintf((FILE *)user_data, "%s %" PRIu64 "\n", (const char *)key,
+            (uint64)(uintptr_t)value);
+}
+
+bool
+wasm_runtime_dump_sampling_profile(const char *file_name)
+{
+    FILE *file;
+    bool ret;
+
+    if (!(file = fopen(file_name, "w"))) {
+        LOG_ERROR("open %s failed", file_name);
+        return false;
+    }
+
+    os_mutex_lock(&profiler_lock);
+    ret = bh_hash_map_traverse(folded_stacks, write_folded_stack, file);
+    os_mutex_unlock(&profiler_lock);
+
+    if (fclose(file) != 0)
+        ret = false;
+    return ret;
+}
+
+#endif /* end of WASM_ENABLE_SAMPLING_PROFILER != 0 */
@@ -0,0 +1,50 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_SAMPLING_PROFILER_H
+#define _WASM_SAMPLING_PROFILER_H
+
+#include "bh_common.h"
+#include "wasm_exec_env.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+
+/* Default interval between two samples of an exec_env */
+#ifndef WASM_SAMPLING_INTERVAL_DEFAULT
+#define WASM_SAMPLING_INTERVAL_DEFAULT 10000
+#endif
+
+/* The frames deeper than it are dropped from a sample */
+#ifndef WASM_SAMPLING_MAX_DEPTH
+#define WASM_SAMPLING_MAX_DEPTH 64
+#endif
+
+bool
+wasm_sampling_profiler_init(void);
+
+void
+wasm_sampling_profiler_destroy(void);
+
+/**
+ * Add an exec_env to the ones sampled by the profiler, it is sampled
+ * while its thread runs wasm code
+ */
+void
+wasm_sampling_profiler_add_exec_env(WASMExecEnv *exec_env);
+
+void
+wasm_sampling_profiler_remove_exec_env(WASMExecEnv *exec_env);
+
+#endif /* end of WASM_ENABLE_SAMPLING_PROFILER != 0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_SAMPLING_PROFILER_H */
@@ -1043,9 +1043,23 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
         }
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_check(comp_ctx, func_ctx))
+        return false;
+#endif
+
     while (frame_ip < frame_ip_end) {
         opcode = *frame_ip++;
 
+#if WASM_ENABLE_FUEL != 0
+        if (comp_ctx->enable_fuel && WASM_FUEL_IS_CHARGED(opcode)) {
+            func_ctx->fuel_cost++;
+            if (WASM_FUEL_IS_BLOCK_END(opcode)
+                && !aot_emit_fuel_charge(comp_ctx, func_ctx))
+                return false;
+        }
+#endif
+
         if (comp_ctx->aot_frame) {
             comp_ctx->aot_frame->frame_ip = frame_ip - 1;
         }
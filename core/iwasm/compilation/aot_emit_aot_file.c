@@ -4456,6 +4456,9 @@ aot_obj_data_create(AOTCompContext *comp_ctx)
     }
     if (comp_ctx->enable_gc) {
         obj_data->target_info.feature_flags |= WASM_FEATURE_GARBAGE_COLLECTION;
+        obj_data->target_info.feature_flags |= WASM_FEATURE_GC_WRITE_BARRIER;
+        obj_data->target_info.feature_flags |=
+            WASM_FEATURE_GC_PRE_WRITE_BARRIER;
     }
     if (comp_ctx->aux_stack_frame_type == AOT_STACK_FRAME_TYPE_TINY) {
         obj_data->target_info.feature_flags |= WASM_FEATURE_TINY_STACK_FRAME;
@@ -4466,6 +4469,9 @@ aot_obj_data_create(AOTCompContext *comp_ctx)
     if (!comp_ctx->call_stack_features.func_idx) {
         obj_data->target_info.feature_flags |= WASM_FEATURE_FRAME_NO_FUNC_IDX;
     }
+    if (comp_ctx->enable_fuel) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_FUEL;
+    }
 
     bh_print_time("Begin to resolve object file info");
 
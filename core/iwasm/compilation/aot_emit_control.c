@@ -12,6 +12,9 @@
 #endif
 #include "../aot/aot_runtime.h"
 #include "../interpreter/wasm_loader.h"
+#if WASM_ENABLE_FUEL != 0
+#include "../common/wasm_fuel.h"
+#endif
 
 #if WASM_ENABLE_DEBUG_AOT != 0
 #include "debug/dwarf_extractor.h"
@@ -273,6 +276,10 @@ handle_next_reachable_block(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     aot_checked_addr_list_destroy(func_ctx);
     bh_assert(block);
 
+    /* The skipped opcodes are unreachable, a new basic block starts at
+       the next reachable one */
+    func_ctx->fuel_cost = 0;
+
 #if WASM_ENABLE_DEBUG_AOT != 0
     return_location = dwarf_gen_location(
         comp_ctx, func_ctx,
@@ -395,6 +402,10 @@ handle_next_reachable_block(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         }
     }
     if (block->label_type == LABEL_TYPE_FUNCTION) {
+#if WASM_ENABLE_FUEL != 0
+        if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+            goto fail;
+#endif
         if (block->result_count) {
             /* Return the first return value */
             if (!(ret =
@@ -633,6 +644,11 @@ aot_compile_op_block(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         SET_BUILDER_POS(block->llvm_entry_block);
         if (label_type == LABEL_TYPE_LOOP)
             aot_checked_addr_list_destroy(func_ctx);
+#if WASM_ENABLE_FUEL != 0
+        if (label_type == LABEL_TYPE_LOOP && comp_ctx->enable_fuel
+            && !aot_emit_fuel_check(comp_ctx, func_ctx))
+            goto fail;
+#endif
     }
     else if (label_type == LABEL_TYPE_IF) {
         POP_COND(value);
@@ -945,6 +961,121 @@ fail:
     return false;
 }
 
+#if WASM_ENABLE_FUEL != 0
+bool
+aot_emit_fuel_charge(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMValueRef fuel, cost;
+
+    if (!func_ctx->fuel_cost)
+        return true;
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE, func_ctx->fuel,
+                                "fuel"))) {
+        aot_set_last_error("llvm build load failed.");
+        return false;
+    }
+
+    if (!(cost = I64_CONST(func_ctx->fuel_cost))
+        || !(fuel =
+                 LLVMBuildSub(comp_ctx->builder, fuel, cost, "fuel_left"))) {
+        aot_set_last_error("llvm build sub failed.");
+        return false;
+    }
+
+    if (!LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel)) {
+        aot_set_last_error("llvm build store failed.");
+        return false;
+    }
+
+    func_ctx->fuel_cost = 0;
+    return true;
+}
+
+bool
+aot_emit_fuel_commit(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMValueRef fuel;
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE, func_ctx->fuel,
+                                "fuel"))
+        || !LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel_ptr)) {
+        aot_set_last_error("llvm build load or store failed.");
+        return false;
+    }
+    return true;
+}
+
+bool
+aot_emit_fuel_reload(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMValueRef fuel;
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE,
+                                func_ctx->fuel_ptr, "fuel"))
+        || !LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel)) {
+        aot_set_last_error("llvm build load or store failed.");
+        return false;
+    }
+    return true;
+}
+
+bool
+aot_emit_fuel_check(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMTypeRef param_types[1], ret_type, func_type, func_ptr_type;
+    LLVMValueRef fuel, res, func, value, ret;
+    LLVMBasicBlockRef exhausted_block, refilled_block;
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE, func_ctx->fuel,
+                                "fuel"))) {
+        aot_set_last_error("llvm build load failed.");
+        return false;
+    }
+
+    CREATE_BLOCK(refilled_block, "fuel_refilled");
+    MOVE_BLOCK_AFTER_CURR(refilled_block);
+
+    CREATE_BLOCK(exhausted_block, "fuel_exhausted");
+    MOVE_BLOCK_AFTER_CURR(exhausted_block);
+
+    BUILD_ICMP(LLVMIntSLT, fuel, I64_ZERO, res, "is_fuel_exhausted");
+    BUILD_COND_BR(res, exhausted_block, refilled_block);
+
+    /* Move builder to exhausted block, the fuel exhausted callback may
+       refill the fuel, or the exception is thrown */
+    SET_BUILDER_POS(exhausted_block);
+
+    param_types[0] = comp_ctx->exec_env_type;
+    ret_type = INT8_TYPE;
+    GET_AOT_FUNCTION(wasm_fuel_exhausted, 1);
+
+    if (!aot_emit_fuel_commit(comp_ctx, func_ctx))
+        goto fail;
+
+    if (!(ret = LLVMBuildCall2(comp_ctx->builder, func_type, func,
+                               &func_ctx->exec_env, 1, "fuel_exhausted"))) {
+        aot_set_last_error("llvm build call failed.");
+        goto fail;
+    }
+
+    if (!aot_emit_fuel_reload(comp_ctx, func_ctx))
+        goto fail;
+
+    BUILD_ICMP(LLVMIntEQ, ret, I8_ZERO, res, "is_not_refilled");
+    if (!aot_emit_exception(comp_ctx, func_ctx, EXCE_ALREADY_THROWN, true, res,
+                            refilled_block))
+        goto fail;
+
+    /* Move builder to refilled block */
+    SET_BUILDER_POS(refilled_block);
+    return true;
+
+fail:
+    return false;
+}
+#endif /* end of WASM_ENABLE_FUEL != 0 */
+
 bool
 aot_compile_op_br(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                   uint32 br_depth, uint8 **p_frame_ip)
@@ -1419,6 +1550,11 @@ aot_compile_op_return(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         return false;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+        return false;
+#endif
+
     if (block_func->result_count) {
         /* Store extra result values to function parameters */
         for (i = 0; i < block_func->result_count - 1; i++) {
@@ -54,6 +54,26 @@ bool
 check_suspend_flags(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                     bool check_terminate_and_suspend);
 
+#if WASM_ENABLE_FUEL != 0
+/* Subtract the opcodes translated since the last charge from the fuel */
+bool
+aot_emit_fuel_charge(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
+
+/* Call wasm_fuel_exhausted if the fuel is negative, it is emitted at the
+   function entry and the loop headers */
+bool
+aot_emit_fuel_check(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
+
+/* Store the fuel charged in the function to exec_env->fuel, before the
+   code which may charge or read it runs */
+bool
+aot_emit_fuel_commit(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
+
+/* Load the fuel of the function from exec_env->fuel after that code */
+bool
+aot_emit_fuel_reload(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
+#endif
+
 #if WASM_ENABLE_GC != 0
 bool
 aot_compile_op_br_on_null(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
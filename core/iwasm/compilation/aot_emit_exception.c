@@ -4,6 +4,7 @@
  */
 
 #include "aot_emit_exception.h"
+#include "aot_emit_control.h"
 #include "aot_compiler.h"
 #include "../interpreter/wasm_runtime.h"
 #include "../aot/aot_runtime.h"
@@ -57,6 +58,12 @@ aot_emit_exception(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
             }
         }
 
+#if WASM_ENABLE_FUEL != 0
+        /* Commit the fuel charged before the exception */
+        if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+            return false;
+#endif
+
         /* Call aot_set_exception_with_id() to throw exception */
         param_types[0] = INT8_PTR_TYPE;
         param_types[1] = I32_TYPE;
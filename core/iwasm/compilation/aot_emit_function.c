@@ -262,6 +262,11 @@ call_aot_invoke_native_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         return false;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+        return false;
+#endif
+
     /* call aot_invoke_native() function */
     if (!(res = LLVMBuildCall2(comp_ctx->builder, func_type, func,
                                func_param_values, 4, "res"))) {
@@ -269,6 +274,11 @@ call_aot_invoke_native_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         return false;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_reload(comp_ctx, func_ctx))
+        return false;
+#endif
+
     /* get function return value */
     if (wasm_ret_type != VALUE_TYPE_VOID) {
         if (!(ret_ptr_type = LLVMPointerType(ret_type, 0))) {
@@ -434,6 +444,11 @@ call_aot_invoke_c_api_native(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         LLVMBuildStore(comp_ctx->builder, params[i], c_api_param_value);
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+        goto fail;
+#endif
+
     /* Call the function */
     if (!(res = LLVMBuildCall2(comp_ctx->builder, func_type, func, param_values,
                                6, "call"))) {
@@ -441,6 +456,11 @@ call_aot_invoke_c_api_native(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_reload(comp_ctx, func_ctx))
+        goto fail;
+#endif
+
     /* Check whether exception was thrown when executing the function */
     if (comp_ctx->enable_bound_check
         && !check_call_return(comp_ctx, func_ctx, res)) {
@@ -1704,6 +1724,12 @@ aot_compile_op_call(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                 goto fail;
             }
 
+#if WASM_ENABLE_FUEL != 0
+            if (comp_ctx->enable_fuel
+                && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+                goto fail;
+#endif
+
             /* Call the function */
             if (!(value_ret = LLVMBuildCall2(
                       comp_ctx->builder, native_func_type, func, param_values,
@@ -1713,6 +1739,12 @@ aot_compile_op_call(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                 goto fail;
             }
 
+#if WASM_ENABLE_FUEL != 0
+            if (comp_ctx->enable_fuel
+                && !aot_emit_fuel_reload(comp_ctx, func_ctx))
+                goto fail;
+#endif
+
             /* Check whether there was exception thrown when executing
                the function */
             if (!check_exception_thrown(comp_ctx, func_ctx)) {
@@ -1800,6 +1832,11 @@ aot_compile_op_call(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         llvm_func_type = func_ctxes[func_idx - import_func_count]->func_type;
 #endif
 
+#if WASM_ENABLE_FUEL != 0
+        if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+            goto fail;
+#endif
+
         /* Call the function */
         if (!(value_ret = LLVMBuildCall2(
                   comp_ctx->builder, llvm_func_type, func, param_values,
@@ -1809,6 +1846,11 @@ aot_compile_op_call(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
             goto fail;
         }
 
+#if WASM_ENABLE_FUEL != 0
+        if (comp_ctx->enable_fuel && !aot_emit_fuel_reload(comp_ctx, func_ctx))
+            goto fail;
+#endif
+
         if (tail_call)
             LLVMSetTailCall(value_ret, true);
 
@@ -2036,6 +2078,11 @@ call_aot_call_indirect_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         return false;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+        return false;
+#endif
+
     /* call aot_call_indirect() function */
     if (!(res = LLVMBuildCall2(comp_ctx->builder, func_type, func,
                                func_param_values, 5, "res"))) {
@@ -2043,6 +2090,11 @@ call_aot_call_indirect_func(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         return false;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_reload(comp_ctx, func_ctx))
+        return false;
+#endif
+
     /* get function result values */
     cell_num = 0;
     for (i = 0; i < result_count; i++) {
@@ -2673,6 +2725,11 @@ aot_compile_op_call_indirect(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+        goto fail;
+#endif
+
     if (!(value_ret = LLVMBuildCall2(comp_ctx->builder, llvm_func_type, func,
                                      param_values, total_param_count,
                                      func_result_count > 0 ? "ret" : ""))) {
@@ -2680,6 +2737,11 @@ aot_compile_op_call_indirect(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_reload(comp_ctx, func_ctx))
+        goto fail;
+#endif
+
     /* Check whether exception was thrown when executing the function */
     if ((comp_ctx->enable_bound_check || is_win_platform(comp_ctx))
         && !check_exception_thrown(comp_ctx, func_ctx))
@@ -3173,6 +3235,11 @@ aot_compile_op_call_ref(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_commit(comp_ctx, func_ctx))
+        goto fail;
+#endif
+
     if (!(value_ret = LLVMBuildCall2(comp_ctx->builder, llvm_func_type, func,
                                      param_values, total_param_count,
                                      func_result_count > 0 ? "ret" : ""))) {
@@ -3180,6 +3247,11 @@ aot_compile_op_call_ref(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
     }
 
+#if WASM_ENABLE_FUEL != 0
+    if (comp_ctx->enable_fuel && !aot_emit_fuel_reload(comp_ctx, func_ctx))
+        goto fail;
+#endif
+
     /* Set calling convention for the call with the func's calling
        convention */
     LLVMSetInstructionCallConv(value_ret, LLVMGetFunctionCallConv(func));
@@ -6,6 +6,8 @@
 #include "aot_emit_gc.h"
 #include "aot_compiler.h"
 #include "aot_emit_exception.h"
+#include "aot_emit_table.h"
+#include "ems/ems_gc.h"
 
 #if WASM_ENABLE_GC != 0
 
@@ -295,6 +297,361 @@ fail:
     return false;
 }
 
+/* Write barrier of the generational GC, the runtime is called to
+   remember the object if it is old (marked) and not remembered yet,
+   so that the minor GC scans it for the references to young objects:
+     if ((hmu->header & GC_HMU_WO_UT_MB_RB_MASK) == GC_HMU_WO_UT_MB)
+         wasm_obj_write_barrier(obj); */
+static bool
+aot_gc_write_barrier(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
+                     LLVMValueRef obj)
+{
+    LLVMValueRef offset, header_ptr, header, value, cmp;
+    LLVMValueRef param_values[1], func;
+    LLVMTypeRef param_types[1], ret_type, func_type, func_ptr_type;
+    LLVMBasicBlockRef remember_obj, barrier_end;
+
+    if (!(obj = LLVMBuildBitCast(comp_ctx->builder, obj, INT8_PTR_TYPE,
+                                 "obj_i8p"))) {
+        aot_set_last_error("llvm build bitcast failed.");
+        goto fail;
+    }
+
+    offset = I32_CONST(-GC_HMU_HEADER_SIZE);
+    if (!(header_ptr = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE, obj,
+                                             &offset, 1, "hmu_header_i8p"))) {
+        aot_set_last_error("llvm build gep failed.");
+        goto fail;
+    }
+
+    if (!(header_ptr = LLVMBuildBitCast(comp_ctx->builder, header_ptr,
+                                        INT32_PTR_TYPE, "hmu_header_ptr"))) {
+        aot_set_last_error("llvm build bitcast failed.");
+        goto fail;
+    }
+
+    if (!(header = LLVMBuildLoad2(comp_ctx->builder, I32_TYPE, header_ptr,
+                                  "hmu_header"))) {
+        aot_set_last_error("llvm build load failed.");
+        goto fail;
+    }
+
+    if (!(value = LLVMBuildAnd(comp_ctx->builder, header,
+                               I32_CONST(GC_HMU_WO_UT_MB_RB_MASK),
+                               "hmu_header_masked"))) {
+        aot_set_last_error("llvm build and failed.");
+        goto fail;
+    }
+
+    ADD_BASIC_BLOCK(remember_obj, "remember_obj");
+    MOVE_BLOCK_AFTER_CURR(remember_obj);
+    ADD_BASIC_BLOCK(barrier_end, "write_barrier_end");
+    MOVE_BLOCK_AFTER(barrier_end, remember_obj);
+
+    BUILD_ICMP(LLVMIntEQ, value, I32_CONST(GC_HMU_WO_UT_MB), cmp,
+               "cmp_obj_old");
+    BUILD_COND_BR(cmp, remember_obj, barrier_end);
+
+    SET_BUILDER_POS(remember_obj);
+
+    param_types[0] = INT8_PTR_TYPE;
+    ret_type = VOID_TYPE;
+
+    GET_AOT_FUNCTION(wasm_obj_write_barrier, 1);
+
+    param_values[0] = obj;
+    if (!LLVMBuildCall2(comp_ctx->builder, func_type, func, param_values, 1,
+                        "")) {
+        aot_set_last_error("llvm build call failed.");
+        goto fail;
+    }
+    BUILD_BR(barrier_end);
+
+    SET_BUILDER_POS(barrier_end);
+    return true;
+fail:
+    return false;
+}
+
+/* Objects whose HMU is larger than this are allocated by the runtime,
+   so as not to use up the nursery of the GC heap too quickly */
+#define AOT_GC_INLINE_ALLOC_SIZE_MAX 256
+
+static bool
+aot_gc_can_alloc_inline(const AOTCompContext *comp_ctx, uint32 obj_size)
+{
+    /* The nursery isn't referenced by the module instance in
+       LLVM JIT mode */
+    return !comp_ctx->is_jit_mode
+           && GC_HMU_HEADER_SIZE + obj_size <= AOT_GC_INLINE_ALLOC_SIZE_MAX;
+}
+
+static bool
+aot_gc_load_inst_extra_ptr(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
+                           uint32 field_offset, const char *name,
+                           LLVMValueRef *p_value)
+{
+    LLVMValueRef offset, value_ptr;
+
+    offset = I32_CONST(get_module_inst_extra_offset(comp_ctx) + field_offset);
+    if (!(value_ptr = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE,
+                                            func_ctx->aot_inst, &offset, 1,
+                                            "inst_extra_field_p"))) {
+        aot_set_last_error("llvm build in bounds gep failed.");
+        return false;
+    }
+    if (!(value_ptr = LLVMBuildBitCast(comp_ctx->builder, value_ptr,
+                                       comp_ctx->basic_types.int8_pptr_type,
+                                       "inst_extra_field_pp"))
+        || !(*p_value = LLVMBuildLoad2(comp_ctx->builder, INT8_PTR_TYPE,
+                                       value_ptr, name))) {
+        aot_set_last_error("llvm build load failed.");
+        return false;
+    }
+    return true;
+}
+
+/* Load a pointer field of the nursery of the GC heap */
+static bool
+aot_gc_tlab_field_ptr(AOTCompContext *comp_ctx, LLVMValueRef tlab,
+                      uint32 field_idx, LLVMValueRef *p_field_ptr)
+{
+    LLVMValueRef offset = I32_CONST(field_idx * comp_ctx->pointer_size);
+
+    if (!(*p_field_ptr = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE,
+                                               tlab, &offset, 1, "tlab_field"))
+        || !(*p_field_ptr = LLVMBuildBitCast(
+                 comp_ctx->builder, *p_field_ptr,
+                 comp_ctx->basic_types.int8_pptr_type, "tlab_field_p"))) {
+        aot_set_last_error("llvm build gep failed.");
+        return false;
+    }
+    return true;
+}
+
+/* Pre write barrier of the incremental GC, the references in the slots
+   which are going to be overwritten are passed to the runtime while the
+   GC heap is being marked (see gc_pre_write_barrier()):
+     if (e->gc_tlab->is_marking)
+         wasm_obj_pre_write_barrier(slots, slot_num);
+   The runtime is always called in LLVM JIT mode, in which the nursery
+   isn't referenced by the module instance. */
+static bool
+aot_gc_pre_write_barrier(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
+                         LLVMValueRef slots, LLVMValueRef slot_num)
+{
+    LLVMValueRef tlab, offset, is_marking_ptr, is_marking, cmp;
+    LLVMValueRef param_values[2], func, value;
+    LLVMTypeRef param_types[2], ret_type, func_type, func_ptr_type;
+    LLVMBasicBlockRef call_barrier = NULL, barrier_end = NULL;
+
+    if (!comp_ctx->is_jit_mode) {
+        if (!aot_gc_load_inst_extra_ptr(comp_ctx, func_ctx,
+                                        AOT_INST_EXTRA_GC_TLAB_OFFSET,
+                                        "gc_tlab", &tlab))
+            goto fail;
+
+        /* is_marking follows the cur and end pointers */
+        offset = I32_CONST(2 * comp_ctx->pointer_size);
+        if (!(is_marking_ptr =
+                  LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE, tlab,
+                                        &offset, 1, "is_marking_i8p"))
+            || !(is_marking_ptr =
+                     LLVMBuildBitCast(comp_ctx->builder, is_marking_ptr,
+                                      INT32_PTR_TYPE, "is_marking_ptr"))) {
+            aot_set_last_error("llvm build gep failed.");
+            goto fail;
+        }
+        if (!(is_marking = LLVMBuildLoad2(comp_ctx->builder, I32_TYPE,
+                                          is_marking_ptr, "is_marking"))) {
+            aot_set_last_error("llvm build load failed.");
+            goto fail;
+        }
+
+        ADD_BASIC_BLOCK(call_barrier, "call_pre_write_barrier");
+        MOVE_BLOCK_AFTER_CURR(call_barrier);
+        ADD_BASIC_BLOCK(barrier_end, "pre_write_barrier_end");
+        MOVE_BLOCK_AFTER(barrier_end, call_barrier);
+
+        BUILD_ICMP(LLVMIntNE, is_marking, I32_ZERO, cmp, "cmp_is_marking");
+        BUILD_COND_BR(cmp, call_barrier, barrier_end);
+        SET_BUILDER_POS(call_barrier);
+    }
+
+    param_types[0] = INT8_PTR_TYPE;
+    param_types[1] = I32_TYPE;
+    ret_type = VOID_TYPE;
+
+    GET_AOT_FUNCTION(wasm_obj_pre_write_barrier, 2);
+
+    param_values[0] = slots;
+    param_values[1] = slot_num;
+    if (!LLVMBuildCall2(comp_ctx->builder, func_type, func, param_values, 2,
+                        "")) {
+        aot_set_last_error("llvm build call failed.");
+        goto fail;
+    }
+
+    if (!comp_ctx->is_jit_mode) {
+        BUILD_BR(barrier_end);
+        SET_BUILDER_POS(barrier_end);
+    }
+    return true;
+fail:
+    return false;
+}
+
+/* Bump allocate a GC object from the nursery of the GC heap (see
+   gc_get_tlab()) without calling into the runtime:
+     rtt_type = e->rtt_types[type_index];
+     tlab = e->gc_tlab;
+     if (!rtt_type || tlab->cur + hmu_size > tlab->end)
+         goto alloc_slow;
+     hmu = tlab->cur;
+     tlab->cur += hmu_size;
+     hmu->header = GC_HMU_WO_NEW | (hmu_size >> 3);
+     if (tlab->cur < tlab->end)
+         tlab->cur->header = GC_HMU_FM | ((tlab->end - tlab->cur) >> 3);
+     obj = hmu + 1;
+     obj->header = rtt_type;
+   The builder is positioned at the end of the fast path on return, the
+   fields of the object aren't initialized. */
+static bool
+aot_gc_alloc_obj_inline(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
+                        uint32 type_index, uint32 obj_size,
+                        LLVMBasicBlockRef alloc_slow, LLVMValueRef *p_obj)
+{
+    LLVMValueRef rtt_types, rtt_type, tlab, cur_ptr, end_ptr, cur, end;
+    LLVMValueRef new_cur, offset, cmp, cmp_rtt, header_ptr, value, obj;
+    LLVMValueRef rest_size;
+    LLVMBasicBlockRef alloc_fast, set_rest, alloc_fast_end;
+    uint32 hmu_size = align_uint(GC_HMU_HEADER_SIZE + obj_size, 8);
+
+    /* Get the rtt type, it is NULL if it hasn't been created yet */
+    if (!aot_gc_load_inst_extra_ptr(comp_ctx, func_ctx,
+                                    AOT_INST_EXTRA_RTT_TYPES_OFFSET,
+                                    "rtt_types", &rtt_types))
+        goto fail;
+
+    offset = I32_CONST(type_index * comp_ctx->pointer_size);
+    if (!(value = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE,
+                                        rtt_types, &offset, 1, "rtt_type_i8p"))
+        || !(value = LLVMBuildBitCast(comp_ctx->builder, value,
+                                      GC_REF_PTR_TYPE, "rtt_type_p"))) {
+        aot_set_last_error("llvm build gep failed.");
+        goto fail;
+    }
+    if (!(rtt_type = LLVMBuildLoad2(comp_ctx->builder, GC_REF_TYPE, value,
+                                    "rtt_type"))) {
+        aot_set_last_error("llvm build load failed.");
+        goto fail;
+    }
+
+    /* Get the nursery */
+    if (!aot_gc_load_inst_extra_ptr(comp_ctx, func_ctx,
+                                    AOT_INST_EXTRA_GC_TLAB_OFFSET,
+                                    "gc_tlab", &tlab)
+        || !aot_gc_tlab_field_ptr(comp_ctx, tlab, 0, &cur_ptr)
+        || !aot_gc_tlab_field_ptr(comp_ctx, tlab, 1, &end_ptr))
+        goto fail;
+
+    if (!(cur = LLVMBuildLoad2(comp_ctx->builder, INT8_PTR_TYPE, cur_ptr,
+                               "tlab_cur"))
+        || !(end = LLVMBuildLoad2(comp_ctx->builder, INT8_PTR_TYPE, end_ptr,
+                                  "tlab_end"))) {
+        aot_set_last_error("llvm build load failed.");
+        goto fail;
+    }
+
+    offset = I32_CONST(hmu_size);
+    if (!(new_cur = LLVMBuildGEP2(comp_ctx->builder, INT8_TYPE, cur, &offset,
+                                  1, "tlab_new_cur"))) {
+        aot_set_last_error("llvm build gep failed.");
+        goto fail;
+    }
+
+    BUILD_ISNOTNULL(rtt_type, cmp_rtt, "cmp_rtt_type");
+    BUILD_ICMP(LLVMIntULE, new_cur, end, cmp, "cmp_tlab_space");
+    if (!(cmp = LLVMBuildAnd(comp_ctx->builder, cmp_rtt, cmp,
+                             "can_alloc_inline"))) {
+        aot_set_last_error("llvm build and failed.");
+        goto fail;
+    }
+
+    ADD_BASIC_BLOCK(alloc_fast, "alloc_obj_fast");
+    MOVE_BLOCK_AFTER_CURR(alloc_fast);
+    ADD_BASIC_BLOCK(set_rest, "alloc_obj_set_rest");
+    MOVE_BLOCK_AFTER(set_rest, alloc_fast);
+    ADD_BASIC_BLOCK(alloc_fast_end, "alloc_obj_fast_end");
+    MOVE_BLOCK_AFTER(alloc_fast_end, set_rest);
+
+    BUILD_COND_BR(cmp, alloc_fast, alloc_slow);
+
+    /* Take the hmu and set its header */
+    SET_BUILDER_POS(alloc_fast);
+    if (!LLVMBuildStore(comp_ctx->builder, new_cur, cur_ptr)) {
+        aot_set_last_error("llvm build store failed.");
+        goto fail;
+    }
+    if (!(header_ptr = LLVMBuildBitCast(comp_ctx->builder, cur,
+                                        INT32_PTR_TYPE, "hmu_header_ptr"))
+        || !LLVMBuildStore(comp_ctx->builder,
+                           I32_CONST(GC_HMU_WO_NEW | (hmu_size >> 3)),
+                           header_ptr)) {
+        aot_set_last_error("llvm build store failed.");
+        goto fail;
+    }
+    BUILD_ICMP(LLVMIntULT, new_cur, end, cmp, "cmp_tlab_rest");
+    BUILD_COND_BR(cmp, set_rest, alloc_fast_end);
+
+    /* Keep the rest of the nursery as a HMU_FM block */
+    SET_BUILDER_POS(set_rest);
+    if (!(rest_size = LLVMBuildPtrToInt(comp_ctx->builder, end, I64_TYPE,
+                                        "tlab_end_i64"))
+        || !(value = LLVMBuildPtrToInt(comp_ctx->builder, new_cur, I64_TYPE,
+                                       "tlab_new_cur_i64"))
+        || !(rest_size = LLVMBuildSub(comp_ctx->builder, rest_size, value,
+                                      "tlab_rest_size"))
+        || !(rest_size = LLVMBuildTrunc(comp_ctx->builder, rest_size,
+                                        I32_TYPE, "tlab_rest_size_i32"))
+        || !(rest_size = LLVMBuildLShr(comp_ctx->builder, rest_size,
+                                       I32_CONST(3), "tlab_rest_size_8"))
+        || !(value = LLVMBuildOr(comp_ctx->builder, rest_size,
+                                 I32_CONST(GC_HMU_FM), "rest_header"))) {
+        aot_set_last_error("llvm build rest header failed.");
+        goto fail;
+    }
+    if (!(header_ptr = LLVMBuildBitCast(comp_ctx->builder, new_cur,
+                                        INT32_PTR_TYPE, "rest_header_ptr"))
+        || !LLVMBuildStore(comp_ctx->builder, value, header_ptr)) {
+        aot_set_last_error("llvm build store failed.");
+        goto fail;
+    }
+    BUILD_BR(alloc_fast_end);
+
+    /* Set the rtt type of the object */
+    SET_BUILDER_POS(alloc_fast_end);
+    offset = I32_CONST(GC_HMU_HEADER_SIZE);
+    if (!(obj = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE, cur,
+                                      &offset, 1, "gc_obj"))
+        || !(value = LLVMBuildBitCast(comp_ctx->builder, obj, GC_REF_PTR_TYPE,
+                                      "gc_obj_header_p"))) {
+        aot_set_last_error("llvm build gep failed.");
+        goto fail;
+    }
+    if (!(value = LLVMBuildStore(comp_ctx->builder, rtt_type, value))) {
+        aot_set_last_error("llvm build store failed.");
+        goto fail;
+    }
+    if (!is_target_x86(comp_ctx))
+        LLVMSetAlignment(value, 4);
+
+    *p_obj = obj;
+    return true;
+fail:
+    return false;
+}
+
 static void
 get_struct_field_data_types(const AOTCompContext *comp_ctx, uint8 field_type,
                             LLVMTypeRef *p_field_data_type,
@@ -527,12 +884,72 @@ fail:
     return false;
 }
 
+/* Size of the struct object of the target */
+static uint32
+aot_struct_obj_size(const AOTCompContext *comp_ctx,
+                    const WASMStructType *struct_type)
+{
+    const WASMStructFieldType *field;
+
+    if (struct_type->field_count == 0)
+        return comp_ctx->pointer_size;
+
+    field = struct_type->fields + struct_type->field_count - 1;
+    return comp_ctx->pointer_size == sizeof(uint64)
+               ? field->field_offset_64bit + field->field_size_64bit
+               : field->field_offset_32bit + field->field_size_32bit;
+}
+
+/* Initialize the fields of an inline allocated struct object with
+   default values, the runtime clears the objects it allocates */
+static bool
+struct_new_default_init_fields(AOTCompContext *comp_ctx, uint32 type_index,
+                               LLVMValueRef struct_obj)
+{
+    WASMStructType *compile_time_struct_type =
+        (WASMStructType *)comp_ctx->comp_data->types[type_index];
+    WASMStructFieldType *fields = compile_time_struct_type->fields;
+    LLVMValueRef field_value;
+    uint32 field_idx, field_offset;
+    uint8 field_type;
+
+    for (field_idx = 0; field_idx < compile_time_struct_type->field_count;
+         field_idx++) {
+        field_type = fields[field_idx].field_type;
+        field_offset = comp_ctx->pointer_size == sizeof(uint64)
+                           ? fields[field_idx].field_offset_64bit
+                           : fields[field_idx].field_offset_32bit;
+
+        if (wasm_is_type_reftype(field_type))
+            field_value = GC_REF_NULL;
+        else if (field_type == VALUE_TYPE_I64)
+            field_value = I64_ZERO;
+        else if (field_type == VALUE_TYPE_F32)
+            field_value = F32_ZERO;
+        else if (field_type == VALUE_TYPE_F64)
+            field_value = F64_ZERO;
+        else
+            field_value = I32_ZERO;
+
+        if (!aot_struct_obj_set_field(comp_ctx, struct_obj,
+                                      I32_CONST(field_offset), field_value,
+                                      field_type))
+            return false;
+    }
+
+    return true;
+}
+
 bool
 aot_compile_op_struct_new(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                           uint32 type_index, bool init_with_default)
 {
-    LLVMValueRef rtt_type, struct_obj, cmp;
+    LLVMValueRef rtt_type, struct_obj, cmp, struct_obj_inline = NULL, phi;
     LLVMBasicBlockRef check_rtt_type_succ, check_struct_obj_succ;
+    LLVMBasicBlockRef alloc_slow = NULL, alloc_end = NULL, alloc_fast_end;
+    uint32 obj_size = aot_struct_obj_size(
+        comp_ctx, (WASMStructType *)comp_ctx->comp_data->types[type_index]);
+    bool alloc_inline = aot_gc_can_alloc_inline(comp_ctx, obj_size);
 
     if (!aot_gen_commit_values(comp_ctx->aot_frame))
         return false;
@@ -540,6 +957,27 @@ aot_compile_op_struct_new(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     if (!aot_gen_commit_sp_ip(comp_ctx->aot_frame, true, true))
         return false;
 
+    if (alloc_inline) {
+        /* Try to allocate the object from the nursery first, and fall
+           back to the runtime if the nursery runs out */
+        ADD_BASIC_BLOCK(alloc_slow, "alloc_struct_obj_slow");
+        ADD_BASIC_BLOCK(alloc_end, "alloc_struct_obj_end");
+
+        if (!aot_gc_alloc_obj_inline(comp_ctx, func_ctx, type_index, obj_size,
+                                     alloc_slow, &struct_obj_inline))
+            goto fail;
+
+        if (init_with_default
+            && !struct_new_default_init_fields(comp_ctx, type_index,
+                                               struct_obj_inline))
+            goto fail;
+
+        alloc_fast_end = CURR_BLOCK();
+        MOVE_BLOCK_AFTER_CURR(alloc_slow);
+        BUILD_BR(alloc_end);
+        SET_BUILDER_POS(alloc_slow);
+    }
+
     /* Generate call wasm_rtt_type_new and check for exception */
     if (!aot_call_aot_rtt_type_new(comp_ctx, func_ctx, I32_CONST(type_index),
                                    &rtt_type))
@@ -569,6 +1007,21 @@ aot_compile_op_struct_new(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 
     SET_BUILDER_POS(check_struct_obj_succ);
 
+    if (alloc_inline) {
+        MOVE_BLOCK_AFTER_CURR(alloc_end);
+        BUILD_BR(alloc_end);
+        SET_BUILDER_POS(alloc_end);
+
+        if (!(phi = LLVMBuildPhi(comp_ctx->builder, GC_REF_TYPE,
+                                 "struct_obj"))) {
+            aot_set_last_error("llvm build phi failed.");
+            goto fail;
+        }
+        LLVMAddIncoming(phi, &struct_obj_inline, &alloc_fast_end, 1);
+        LLVMAddIncoming(phi, &struct_obj, &check_struct_obj_succ, 1);
+        struct_obj = phi;
+    }
+
     /* For WASM_OP_STRUCT_NEW, init field with poped value */
     if (!init_with_default
         && !struct_new_canon_init_fields(comp_ctx, func_ctx, type_index,
@@ -652,7 +1105,7 @@ bool
 aot_compile_op_struct_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                           uint32 type_index, uint32 field_idx)
 {
-    LLVMValueRef struct_obj, cmp, field_value = NULL;
+    LLVMValueRef struct_obj, cmp, field_value = NULL, field_data, offset;
     LLVMBasicBlockRef check_struct_obj_succ;
     /* Used in compile time, to distinguish what type of AOTValue POP,
      * field_data offset, size  */
@@ -703,10 +1156,29 @@ aot_compile_op_struct_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                             check_struct_obj_succ))
         goto fail;
 
+    if (wasm_is_type_reftype(field_type)) {
+        offset = I32_CONST(field_offset);
+        if (!(field_data = LLVMBuildBitCast(comp_ctx->builder, struct_obj,
+                                            INT8_PTR_TYPE, "struct_obj_i8p"))
+            || !(field_data = LLVMBuildInBoundsGEP2(
+                     comp_ctx->builder, INT8_TYPE, field_data, &offset, 1,
+                     "field_data_i8p"))) {
+            aot_set_last_error("llvm build gep failed.");
+            goto fail;
+        }
+        if (!aot_gc_pre_write_barrier(comp_ctx, func_ctx, field_data,
+                                      I32_ONE))
+            goto fail;
+    }
+
     if (!aot_struct_obj_set_field(comp_ctx, struct_obj, I32_CONST(field_offset),
                                   field_value, field_type))
         goto fail;
 
+    if (wasm_is_type_reftype(field_type)
+        && !aot_gc_write_barrier(comp_ctx, func_ctx, struct_obj))
+        goto fail;
+
     return true;
 fail:
     return false;
@@ -1117,12 +1589,23 @@ aot_compile_op_array_new(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                          bool fixed_size, uint32 array_len)
 {
     LLVMValueRef array_length, array_elem = NULL, array_obj;
-    LLVMValueRef rtt_type, cmp, elem_idx;
+    LLVMValueRef rtt_type, cmp, elem_idx, array_obj_inline = NULL, phi;
+    LLVMValueRef offset, length_ptr;
     LLVMBasicBlockRef check_rtt_type_succ, check_array_obj_succ;
+    LLVMBasicBlockRef alloc_slow = NULL, alloc_end = NULL, alloc_fast_end;
     /* Use for distinguish what type of AOTValue POP */
     WASMArrayType *compile_time_array_type =
         (WASMArrayType *)comp_ctx->comp_data->types[type_index];
     uint8 array_elem_type = compile_time_array_type->elem_type;
+    uint32 elem_size_log =
+        aot_array_obj_elem_size_log(comp_ctx, array_elem_type);
+    /* offsetof(WASMArrayObject, elem_data) + elem_size * array_len */
+    uint64 obj_size = (uint64)comp_ctx->pointer_size + sizeof(uint32)
+                      + ((uint64)array_len << elem_size_log);
+    /* Only the array.new_fixed objects are allocated inline, the
+       other arrays have a variable length */
+    bool alloc_inline = fixed_size && obj_size <= AOT_GC_INLINE_ALLOC_SIZE_MAX
+                        && aot_gc_can_alloc_inline(comp_ctx, (uint32)obj_size);
     uint32 i;
 
     if (!aot_gen_commit_values(comp_ctx->aot_frame))
@@ -1131,6 +1614,39 @@ aot_compile_op_array_new(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     if (!aot_gen_commit_sp_ip(comp_ctx->aot_frame, true, true))
         return false;
 
+    if (alloc_inline) {
+        ADD_BASIC_BLOCK(alloc_slow, "alloc_array_obj_slow");
+        ADD_BASIC_BLOCK(alloc_end, "alloc_array_obj_end");
+
+        if (!aot_gc_alloc_obj_inline(comp_ctx, func_ctx, type_index,
+                                     (uint32)obj_size, alloc_slow,
+                                     &array_obj_inline))
+            goto fail;
+
+        /* Set the length, the elements are set below */
+        offset = I32_CONST(comp_ctx->pointer_size);
+        if (!(length_ptr = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE,
+                                                 array_obj_inline, &offset, 1,
+                                                 "array_length_i8p"))
+            || !(length_ptr = LLVMBuildBitCast(comp_ctx->builder, length_ptr,
+                                               INT32_PTR_TYPE,
+                                               "array_length_p"))) {
+            aot_set_last_error("llvm build gep failed.");
+            goto fail;
+        }
+        if (!LLVMBuildStore(comp_ctx->builder,
+                            I32_CONST((array_len << 2) | elem_size_log),
+                            length_ptr)) {
+            aot_set_last_error("llvm build store failed.");
+            goto fail;
+        }
+
+        alloc_fast_end = CURR_BLOCK();
+        MOVE_BLOCK_AFTER_CURR(alloc_slow);
+        BUILD_BR(alloc_end);
+        SET_BUILDER_POS(alloc_slow);
+    }
+
     /* Generate call aot_rtt_type_new and check for exception */
     if (!aot_call_aot_rtt_type_new(comp_ctx, func_ctx, I32_CONST(type_index),
                                    &rtt_type))
@@ -1191,6 +1707,22 @@ aot_compile_op_array_new(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                             true, cmp, check_array_obj_succ))
         goto fail;
 
+    if (alloc_inline) {
+        SET_BUILDER_POS(check_array_obj_succ);
+        MOVE_BLOCK_AFTER_CURR(alloc_end);
+        BUILD_BR(alloc_end);
+        SET_BUILDER_POS(alloc_end);
+
+        if (!(phi =
+                  LLVMBuildPhi(comp_ctx->builder, GC_REF_TYPE, "array_obj"))) {
+            aot_set_last_error("llvm build phi failed.");
+            goto fail;
+        }
+        LLVMAddIncoming(phi, &array_obj_inline, &alloc_fast_end, 1);
+        LLVMAddIncoming(phi, &array_obj, &check_array_obj_succ, 1);
+        array_obj = phi;
+    }
+
     if (fixed_size) {
         for (i = 0; i < array_len; i++) {
             if (wasm_is_type_reftype(array_elem_type)) {
@@ -1388,6 +1920,7 @@ aot_compile_op_array_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                          uint32 type_index)
 {
     LLVMValueRef elem_idx, array_obj, cmp, array_len, array_elem = NULL;
+    LLVMValueRef elem_data;
     LLVMBasicBlockRef check_array_obj_succ, check_boundary_succ;
     /* Use for distinguish what type of AOTValue POP */
     WASMArrayType *compile_time_array_type =
@@ -1440,12 +1973,23 @@ aot_compile_op_array_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
 
     SET_BUILDER_POS(check_boundary_succ);
+    if (wasm_is_type_reftype(array_elem_type)
+        && (!aot_array_obj_elem_addr(comp_ctx, func_ctx, array_obj, elem_idx,
+                                     &elem_data, array_elem_type)
+            || !aot_gc_pre_write_barrier(comp_ctx, func_ctx, elem_data,
+                                         I32_ONE)))
+        goto fail;
+
     if (!aot_array_obj_set_elem(comp_ctx, func_ctx, array_obj, elem_idx,
                                 array_elem, array_elem_type)) {
         aot_set_last_error("llvm build alloca failed.");
         goto fail;
     }
 
+    if (wasm_is_type_reftype(array_elem_type)
+        && !aot_gc_write_barrier(comp_ctx, func_ctx, array_obj))
+        goto fail;
+
     return true;
 fail:
     return false;
@@ -1457,6 +2001,7 @@ aot_compile_op_array_fill(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 {
     LLVMValueRef len, array_obj, fill_value = NULL, offset, array_len, cmp[2],
                                  boundary, loop_counter_addr, loop_counter_val;
+    LLVMValueRef elem_data;
     LLVMBasicBlockRef check_obj_succ, len_gt_zero, len_le_zero, inner_else;
     LLVMBasicBlockRef fill_loop_header, fill_loop_body;
     WASMArrayType *compile_time_array_type =
@@ -1544,6 +2089,12 @@ aot_compile_op_array_fill(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                             cmp[0], inner_else))
         goto fail;
 
+    if (wasm_is_type_reftype(array_elem_type)
+        && (!aot_array_obj_elem_addr(comp_ctx, func_ctx, array_obj, offset,
+                                     &elem_data, array_elem_type)
+            || !aot_gc_pre_write_barrier(comp_ctx, func_ctx, elem_data, len)))
+        goto fail;
+
     if (!(loop_counter_addr = LLVMBuildAlloca(comp_ctx->builder, I32_TYPE,
                                               "fill_loop_counter"))) {
         aot_set_last_error("llvm build alloc failed.");
@@ -1595,6 +2146,10 @@ aot_compile_op_array_fill(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 
     SET_BUILDER_POS(len_le_zero);
 
+    if (wasm_is_type_reftype(array_elem_type)
+        && !aot_gc_write_barrier(comp_ctx, func_ctx, array_obj))
+        goto fail;
+
     return true;
 fail:
     return false;
@@ -1059,6 +1059,52 @@ create_aux_stack_frame(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
     return true;
 }
 
+static bool
+create_fuel_ptr(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    /* exec_env->fuel is 8-byte aligned after the wasm_stack fields,
+       which is checked by the static assert in wasm_exec_env.c */
+    LLVMValueRef offset = I32_CONST(align_uint(comp_ctx->pointer_size * 13, 8)
+                                    / comp_ctx->pointer_size),
+                 fuel;
+
+    if (!offset) {
+        aot_set_last_error("llvm build const failed");
+        return false;
+    }
+
+    if (!(func_ctx->fuel_ptr = LLVMBuildInBoundsGEP2(
+              comp_ctx->builder, OPQ_PTR_TYPE, func_ctx->exec_env, &offset, 1,
+              "fuel_addr"))) {
+        aot_set_last_error("llvm build in bounds gep failed");
+        return false;
+    }
+
+    if (!(func_ctx->fuel_ptr =
+              LLVMBuildBitCast(comp_ctx->builder, func_ctx->fuel_ptr,
+                               INT64_PTR_TYPE, "fuel_ptr"))) {
+        aot_set_last_error("llvm build bit cast failed");
+        return false;
+    }
+
+    /* Charge the fuel in a local variable which can be kept in a register,
+       it is committed to exec_env->fuel before the calls and the returns */
+    if (!(func_ctx->fuel =
+              LLVMBuildAlloca(comp_ctx->builder, I64_TYPE, "fuel"))) {
+        aot_set_last_error("llvm build alloca failed");
+        return false;
+    }
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE,
+                                func_ctx->fuel_ptr, "fuel_init"))
+        || !LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel)) {
+        aot_set_last_error("llvm build load or store failed");
+        return false;
+    }
+
+    return true;
+}
+
 static bool
 create_native_symbol(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
 {
@@ -1844,6 +1890,10 @@ aot_create_func_context(const AOTCompData *comp_data, AOTCompContext *comp_ctx,
         goto fail;
     }
 
+    if (comp_ctx->enable_fuel && !create_fuel_ptr(comp_ctx, func_ctx)) {
+        goto fail;
+    }
+
     /* Create local variables */
     if (!create_local_variables(comp_data, comp_ctx, func_ctx, func)) {
         goto fail;
@@ -2494,7 +2544,7 @@ orc_jit_create(AOTCompContext *comp_ctx)
         LLVMOrcObjectLayerRef obj_linking_layer =
             (LLVMOrcObjectLayerRef)LLVMOrcLLLazyJITGetObjLinkingLayer(orc_jit);
         LLVMOrcRTDyldObjectLinkingLayerRegisterJITEventListener(
-            obj_linking_layer, LLVMCreatePerfJITEventListener());
+            obj_linking_layer, LLVMCreateLinuxPerfJITEventListener());
     }
 #endif
 
@@ -2703,6 +2753,9 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
     if (option->enable_shared_heap)
         comp_ctx->enable_shared_heap = true;
 
+    if (option->enable_fuel)
+        comp_ctx->enable_fuel = true;
+
     comp_ctx->opt_level = option->opt_level;
     comp_ctx->size_level = option->size_level;
 
@@ -251,6 +251,13 @@ typedef struct AOTFuncContext {
     LLVMValueRef wasm_stack_top_bound;
     LLVMValueRef wasm_stack_top_ptr;
 
+    /* The address of exec_env->fuel, the local variable keeping the fuel
+       in the function, and the opcodes translated since the fuel was
+       charged last time */
+    LLVMValueRef fuel_ptr;
+    LLVMValueRef fuel;
+    uint32 fuel_cost;
+
     bool mem_space_unchanged;
     AOTCheckedAddrList checked_addr_list;
 
@@ -487,6 +494,9 @@ typedef struct AOTCompContext {
 
     bool enable_shared_heap;
 
+    /* Charge the fuel of the exec_env per basic block */
+    bool enable_fuel;
+
     uint32 opt_level;
     uint32 size_level;
 
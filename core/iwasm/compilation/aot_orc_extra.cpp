@@ -25,9 +25,16 @@
 #include "llvm/ExecutionEngine/Orc/RTDyldObjectLinkingLayer.h"
 #include "llvm/ExecutionEngine/SectionMemoryManager.h"
 #include "llvm/Support/CBindingWrapping.h"
+#if WASM_ENABLE_LINUX_PERF != 0
+#include "llvm/DebugInfo/DWARF/DWARFContext.h"
+#include "llvm/Object/SymbolSize.h"
+#endif
 
 #include "aot_orc_extra.h"
 #include "aot.h"
+#if WASM_ENABLE_LINUX_PERF != 0
+#include "../common/wasm_jit_perf.h"
+#endif
 
 #if LLVM_VERSION_MAJOR >= 17
 namespace llvm {
@@ -358,3 +365,84 @@ LLVMOrcLLLazyJITGetObjLinkingLayer(LLVMOrcLLLazyJITRef J)
 {
     return wrap(&unwrap(J)->getObjLinkingLayer());
 }
+
+#if WASM_ENABLE_LINUX_PERF != 0
+/* Tell linux perf about the functions linked by the ORC JIT, together
+   with their line info if the module has debug info. The listener created
+   by LLVMCreatePerfJITEventListener does nothing unless LLVM is built with
+   LLVM_USE_PERF, which isn't the case for most LLVM releases. */
+class LinuxPerfJITEventListener : public JITEventListener
+{
+  public:
+    void notifyObjectLoaded(ObjectKey K, const object::ObjectFile &Obj,
+                            const RuntimeDyld::LoadedObjectInfo &L) override
+    {
+        object::OwningBinary<object::ObjectFile> DebugObjOwner =
+            L.getObjectForDebug(Obj);
+        const object::ObjectFile *DebugObj = DebugObjOwner.getBinary();
+        DILineInfoSpecifier LineSpec(
+            DILineInfoSpecifier::FileLineInfoKind::AbsoluteFilePath);
+
+        /* the addresses in the debug object are the ones the code is
+           loaded at */
+        if (!DebugObj)
+            return;
+
+        std::unique_ptr<DIContext> Context = DWARFContext::create(*DebugObj);
+
+        for (const std::pair<object::SymbolRef, uint64_t> &P :
+             object::computeSymbolSizes(*DebugObj)) {
+            object::SymbolRef Sym = P.first;
+            uint64_t Size = P.second;
+            uint64_t SectionIndex = object::SectionedAddress::UndefSection;
+
+            Expected<object::SymbolRef::Type> Type = Sym.getType();
+            if (!Type) {
+                consumeError(Type.takeError());
+                continue;
+            }
+            if (*Type != object::SymbolRef::ST_Function || Size == 0)
+                continue;
+
+            Expected<StringRef> Name = Sym.getName();
+            if (!Name) {
+                consumeError(Name.takeError());
+                continue;
+            }
+
+            Expected<uint64_t> Addr = Sym.getAddress();
+            if (!Addr) {
+                consumeError(Addr.takeError());
+                continue;
+            }
+
+            Expected<object::section_iterator> Section = Sym.getSection();
+            if (!Section)
+                consumeError(Section.takeError());
+            else if (*Section != DebugObj->section_end())
+                SectionIndex = (*Section)->getIndex();
+
+            DILineInfoTable Lines = Context->getLineInfoForAddressRange(
+                { *Addr, SectionIndex }, Size, LineSpec);
+            std::vector<WASMJitPerfLineInfo> PerfLines;
+            for (const auto &Line : Lines)
+                PerfLines.push_back({ (uintptr_t)Line.first,
+                                      (uint32)Line.second.Line,
+                                      Line.second.FileName.c_str() });
+
+            wasm_jit_perf_add_code(Name->str().c_str(),
+                                   (const void *)(uintptr_t)*Addr,
+                                   (uint32)Size, PerfLines.data(),
+                                   (uint32)PerfLines.size());
+        }
+    }
+};
+
+LLVMJITEventListenerRef
+LLVMCreateLinuxPerfJITEventListener(void)
+{
+    /* the listener lives as long as the JITs it is registered in */
+    static LinuxPerfJITEventListener Listener;
+    return wrap(static_cast<JITEventListener *>(&Listener));
+}
+#endif
@@ -7,6 +7,7 @@
 #define _AOT_ORC_LAZINESS_H_
 
 #include "llvm-c/Error.h"
+#include "llvm-c/ExecutionEngine.h"
 #include "llvm-c/ExternC.h"
 #include "llvm-c/LLJIT.h"
 #include "llvm-c/Orc.h"
@@ -79,5 +80,10 @@ LLVMOrcLLJITBuilderSetCompileFunctionCreatorWithStackSizesCallback(
 LLVMOrcObjectLayerRef
 LLVMOrcLLLazyJITGetObjLinkingLayer(LLVMOrcLLLazyJITRef J);
 
+#if WASM_ENABLE_LINUX_PERF != 0
+LLVMJITEventListenerRef
+LLVMCreateLinuxPerfJITEventListener(void);
+#endif
+
 LLVM_C_EXTERN_C_END
 #endif
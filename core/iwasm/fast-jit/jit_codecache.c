@@ -6,6 +6,9 @@
 #include "jit_codecache.h"
 #include "mem_alloc.h"
 #include "jit_compiler.h"
+#if WASM_ENABLE_LINUX_PERF != 0
+#include "../common/wasm_jit_perf.h"
+#endif
 
 static void *code_cache_pool = NULL;
 static uint32 code_cache_pool_size = 0;
@@ -53,6 +56,65 @@ jit_code_cache_free(void *ptr)
         mem_allocator_free(code_cache_pool_allocator, ptr);
 }
 
+#if WASM_ENABLE_LINUX_PERF != 0
+static int
+compare_line_info(const void *l1, const void *l2)
+{
+    uintptr_t addr1 = ((const WASMJitPerfLineInfo *)l1)->addr;
+    uintptr_t addr2 = ((const WASMJitPerfLineInfo *)l2)->addr;
+
+    return addr1 < addr2 ? -1 : (addr1 > addr2 ? 1 : 0);
+}
+
+/* Tell linux perf about the jitted code of the function, the "line" of
+   each basic block is the offset of its first opcode in the function
+   body, so that perf annotates the code with the wasm bytecode */
+static void
+add_jitted_code_to_perf(JitCompContext *cc)
+{
+    WASMModule *module = cc->cur_wasm_module;
+    WASMFunction *func = cc->cur_wasm_func;
+    uint32 jit_func_idx = cc->cur_wasm_func_idx - module->import_function_count;
+    uint32 label_num = jit_cc_label_num(cc), line_count = 0, i;
+    const char *file_name =
+        module->name && module->name[0] ? module->name : "wasm";
+    WASMJitPerfLineInfo *lines;
+    JitReg label;
+    uint8 *bcip;
+    char name[128];
+
+    if (module->name && module->name[0])
+        snprintf(name, sizeof(name), "[%s]#fast_jit_func#%u", module->name,
+                 jit_func_idx);
+    else
+        snprintf(name, sizeof(name), "fast_jit_func#%u", jit_func_idx);
+
+    if ((lines = jit_calloc(sizeof(WASMJitPerfLineInfo) * label_num))) {
+        for (i = 0; i < label_num; i++) {
+            label = jit_reg_new(JIT_REG_KIND_L32, i);
+            bcip = *jit_annl_begin_bcip(cc, label);
+            if (bcip && *jit_annl_jitted_addr(cc, label)) {
+                lines[line_count].addr =
+                    (uintptr_t)*jit_annl_jitted_addr(cc, label);
+                lines[line_count].line = (uint32)(bcip - func->code);
+                lines[line_count].file_name = file_name;
+                line_count++;
+            }
+        }
+        qsort(lines, line_count, sizeof(WASMJitPerfLineInfo),
+              compare_line_info);
+    }
+
+    wasm_jit_perf_add_code(
+        name, cc->jitted_addr_begin,
+        (uint32)((uint8 *)cc->jitted_addr_end - (uint8 *)cc->jitted_addr_begin),
+        lines, line_count);
+
+    if (lines)
+        jit_free(lines);
+}
+#endif
+
 bool
 jit_pass_register_jitted_code(JitCompContext *cc)
 {
@@ -69,6 +131,11 @@ jit_pass_register_jitted_code(JitCompContext *cc)
     module->fast_jit_func_ptrs[jit_func_idx] = func->fast_jit_jitted_code =
         cc->jitted_addr_begin;
 
+#if WASM_ENABLE_LINUX_PERF != 0
+    if (wasm_runtime_get_linux_perf())
+        add_jitted_code_to_perf(cc);
+#endif
+
 #if WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT != 0 \
     && WASM_ENABLE_LAZY_JIT != 0
     instance = module->instance_list;
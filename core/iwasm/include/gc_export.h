@@ -155,6 +155,38 @@ typedef uintptr_t wasm_i31_obj_t;
 
 typedef void (*wasm_obj_finalizer_t)(const wasm_obj_t obj, void *data);
 
+/* Number of the buckets of pause_time_histogram of wasm_gc_stats_t */
+#define WASM_GC_PAUSE_HISTOGRAM_SIZE 24
+
+/* GC statistics of a module instance, the times are in microseconds and
+   the sizes in bytes */
+typedef struct wasm_gc_stats_t {
+    /* number of the pauses by the GCs, each slice of an incremental GC
+       is a pause */
+    uint64_t gc_count;
+    /* time the instance was paused by the GCs */
+    uint64_t total_pause_time;
+    uint64_t max_pause_time;
+    uint64_t last_pause_time;
+    /* time spent by the last GC in marking and sweeping */
+    uint64_t last_mark_time;
+    uint64_t last_sweep_time;
+    /* number of the threads which did the last GC, it is larger than 1
+       when the GC helper threads took part in it */
+    uint32_t last_gc_thread_num;
+    /* number of the pauses by their length: bucket 0 counts the pauses
+       shorter than 1us, bucket i the ones in [2^(i-1), 2^i) us, and the
+       last bucket all the longer ones */
+    uint64_t pause_time_histogram[WASM_GC_PAUSE_HISTOGRAM_SIZE];
+    /* total size allocated from the GC heap and freed since it was
+       created, including the object headers */
+    uint64_t size_allocated;
+    uint64_t size_freed;
+    /* current size of the GC heap and of the free space in it */
+    uint64_t heap_size;
+    uint64_t free_size;
+} wasm_gc_stats_t;
+
 /* Defined type related operations */
 
 /**
@@ -943,6 +975,39 @@ wasm_obj_set_gc_finalizer(wasm_exec_env_t exec_env, const wasm_obj_t obj,
 void
 wasm_obj_unset_gc_finalizer(wasm_exec_env_t exec_env, void *obj);
 
+/**
+ * Get the GC statistics of a module instance
+ *
+ * @param module_inst the module instance
+ * @param stats [out] the GC statistics
+ *
+ * @return true if success, false if the instance has no GC heap
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_get_gc_stats(wasm_module_inst_t module_inst,
+                          wasm_gc_stats_t *stats);
+
+/**
+ * Get the size of the objects of each defined type in the GC heap of a
+ * module instance. The heap is walked, so it is much slower than
+ * wasm_runtime_get_gc_stats, and the objects which became unreachable
+ * after the last GC are counted too, call it right after a GC to get
+ * the live sizes.
+ *
+ * @param module_inst the module instance
+ * @param sizes [out] sizes[i] is set to the total size of the objects of
+ *        the defined type i, including the object headers
+ * @param count the number of elements of sizes, usually
+ *        wasm_get_defined_type_count() of the module, the objects of the
+ *        types with larger indexes aren't counted
+ *
+ * @return true if success, false if the instance has no GC heap or the
+ *         heap is corrupted
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_get_gc_live_sizes(wasm_module_inst_t module_inst,
+                               uint64_t *sizes, uint32_t count);
+
 #ifdef __cplusplus
 }
 #endif
@@ -538,6 +538,10 @@ typedef struct LoadArgs {
        wasm_runtime_load_ex has to be followed by a wasm_runtime_resolve_symbols
        call */
     bool no_resolve;
+    /* NULL by default, the path of the module image to map the prepared
+       function bodies from, it is written if it doesn't match the binary,
+       only used when the runtime is built with WAMR_BUILD_MODULE_IMAGE=1 */
+    const char *module_image_path;
     /* TODO: more fields? */
 } LoadArgs;
 #endif /* LOAD_ARGS_OPTION_DEFINED */
@@ -67,6 +67,10 @@ struct WASMModuleCommon;
 typedef struct WASMModuleCommon *wasm_module_t;
 #endif
 
+/* A WASM module being loaded from a binary which arrives in pieces */
+struct WASMModuleStream;
+typedef struct WASMModuleStream *wasm_module_stream_t;
+
 typedef enum {
     WASM_IMPORT_EXPORT_KIND_FUNC,
     WASM_IMPORT_EXPORT_KIND_TABLE,
@@ -156,6 +160,10 @@ typedef struct wasm_section_t {
 struct WASMExecEnv;
 typedef struct WASMExecEnv *wasm_exec_env_t;
 
+/* A call of a wasm function prepared to be repeated */
+struct WASMPreparedCall;
+typedef struct WASMPreparedCall *wasm_prepared_call_t;
+
 struct WASMSharedHeap;
 typedef struct WASMSharedHeap *wasm_shared_heap_t;
 
@@ -209,6 +217,54 @@ typedef struct mem_alloc_info_t {
     uint32_t highmark_size;
 } mem_alloc_info_t;
 
+/* The WASI functions counted in wasm_instance_stats_t, by what they do */
+typedef enum {
+    WASI_CALL_ARGS_ENVIRON = 0, /* args_*, environ_* */
+    WASI_CALL_CLOCK,            /* clock_* */
+    WASI_CALL_FD_READ,          /* fd_read, fd_pread, fd_readdir */
+    WASI_CALL_FD_WRITE,         /* fd_write, fd_pwrite */
+    WASI_CALL_FD_OTHER,         /* the other fd_* */
+    WASI_CALL_PATH,             /* path_* */
+    WASI_CALL_POLL,             /* poll_oneoff, sched_yield */
+    WASI_CALL_RANDOM,           /* random_get */
+    WASI_CALL_SOCK,             /* sock_* */
+    WASI_CALL_PROC,             /* proc_* */
+    WASI_CALL_TYPE_NUM
+} wasi_call_type_t;
+
+/* Resources consumed by a module instance */
+typedef struct wasm_instance_stats_t {
+    /* Thread CPU time spent in the wasm code of the instance, and in the
+       host functions it imports, in microseconds */
+    uint64_t wasm_cpu_time_us;
+    uint64_t host_cpu_time_us;
+    /* Number of the host functions called */
+    uint64_t host_call_count;
+    /* Size of the linear memories, which is also their peak size as
+       they never shrink */
+    uint64_t linear_memory_size;
+    /* Size of the app heap, the bytes currently used in it, and the
+       peak of the bytes used */
+    uint32_t app_heap_size;
+    uint32_t app_heap_used;
+    uint32_t app_heap_peak_used;
+    /* Number of the WASI functions called, by wasi_call_type_t */
+    uint64_t wasi_call_counts[WASI_CALL_TYPE_NUM];
+    /* Bytes read and written by the WASI file and socket functions */
+    uint64_t wasi_bytes_read;
+    uint64_t wasi_bytes_written;
+    /* Number of the calls from the interpreter or the host into the
+       LLVM JIT code, and of the calls from the jitted code back into the
+       runtime, e.g. to the host functions, they aren't counted for Fast
+       JIT */
+    uint64_t jit_entry_count;
+    uint64_t jit_exit_count;
+    /* Number of the above calls whose arguments and results are passed
+       through the generic path (an interpreter frame or the generic
+       native invoker) instead of a per-signature quick entry */
+    uint64_t jit_slow_transition_count;
+} wasm_instance_stats_t;
+
 /* Running mode of runtime and module instance*/
 typedef enum RunningMode {
     Mode_Interp = 1,
@@ -242,6 +298,31 @@ typedef struct RuntimeInitArgs {
     /* Default GC heap size */
     uint32_t gc_heap_size;
 
+    /* Number of the GC helper threads, only used when
+       WASM_ENABLE_GC_PARALLEL is defined */
+    uint32_t gc_helper_thread_num;
+
+    /* Time budget of a slice of the incremental GC in microseconds, the
+       GC heaps are reclaimed stop-the-world if it is 0, only used when
+       WASM_ENABLE_GC_INCREMENTAL is defined */
+    uint32_t gc_slice_budget_us;
+
+    /* Maximum size of the GC heap of an instance, the GC heap starts with
+       gc_heap_size and grows on demand up to it if it is larger, only
+       used when WASM_ENABLE_GC_GROWABLE_HEAP is defined */
+    uint32_t gc_heap_max_size;
+    /* Percentage of a growable GC heap which is expected to be live after
+       a GC, the heap is grown or shrunk towards it, 0 means 50 */
+    uint32_t gc_heap_live_ratio;
+    /* A growable GC heap isn't grown by the live ratio while the last GC
+       pause is longer than it in microseconds, 0 means no limit */
+    uint32_t gc_heap_max_pause_us;
+
+    /* Number of the helper threads which validate the function bodies
+       of a module with the loading thread, only used when
+       WASM_ENABLE_PARALLEL_LOADER is defined */
+    uint32_t loader_helper_thread_num;
+
     /* Default running mode of the runtime */
     RunningMode running_mode;
 
@@ -277,6 +358,15 @@ typedef struct LoadArgs {
        wasm_runtime_load_ex has to be followed by a wasm_runtime_resolve_symbols
        call */
     bool no_resolve;
+    /* NULL by default, the path of the module image to map the prepared
+       function bodies from, it is written if it doesn't match the binary,
+       only used when the runtime is built with WAMR_BUILD_MODULE_IMAGE=1.
+       The code of the image is run without being validated again, so the
+       path must be trusted: the image and the directories above it must not
+       be writable by the others. The image is bound to the SHA-256 of the
+       binary, and isn't used if it isn't owned by the user of the process
+       or is writable by the group or the others. */
+    const char *module_image_path;
     /* TODO: more fields? */
 } LoadArgs;
 #endif /* LOAD_ARGS_OPTION_DEFINED */
@@ -618,6 +708,65 @@ WASM_RUNTIME_API_EXTERN wasm_module_t
 wasm_runtime_load_from_sections(wasm_section_list_t section_list, bool is_aot,
                                 char *error_buf, uint32_t error_buf_size);
 
+/**
+ * Begin to load a WASM module from a binary which arrives in pieces, e.g.
+ * from the network. Only WASM binaries are supported, and it requires the
+ * runtime to be built with WAMR_BUILD_STREAMING_LOADER=1.
+ *
+ * @param total_size the size of the binary. If it is given, each section is
+ *        loaded as soon as it is received, otherwise pass 0 and the module
+ *        is only loaded when the stream finishes
+ * @param args the load arguments, wasm_binary_freeable is ignored as the
+ *        runtime keeps its own copy of the binary
+ * @param error_buf output of the exception info
+ * @param error_buf_size the size of the exception string
+ *
+ * @return the stream created, NULL if failed
+ */
+WASM_RUNTIME_API_EXTERN wasm_module_stream_t
+wasm_runtime_load_stream_begin(uint32_t total_size, const LoadArgs *args,
+                               char *error_buf, uint32_t error_buf_size);
+
+/**
+ * Feed the next piece of the binary to a stream. The piece is copied and
+ * can be freed once it returns.
+ *
+ * @param stream the stream
+ * @param buf the piece of the binary
+ * @param size the size of the piece
+ * @param error_buf output of the exception info
+ * @param error_buf_size the size of the exception string
+ *
+ * @return true if success, false if the binary is found invalid, then the
+ *         stream must be aborted with wasm_runtime_load_stream_abort
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_load_stream_feed(wasm_module_stream_t stream, const uint8_t *buf,
+                              uint32_t size, char *error_buf,
+                              uint32_t error_buf_size);
+
+/**
+ * Finish loading a WASM module after the whole binary is fed. The stream
+ * is destroyed whether it succeeds or not.
+ *
+ * @param stream the stream
+ * @param error_buf output of the exception info
+ * @param error_buf_size the size of the exception string
+ *
+ * @return return WASM module loaded, NULL if failed
+ */
+WASM_RUNTIME_API_EXTERN wasm_module_t
+wasm_runtime_load_stream_finish(wasm_module_stream_t stream, char *error_buf,
+                                uint32_t error_buf_size);
+
+/**
+ * Abort loading a WASM module from a stream and destroy the stream.
+ *
+ * @param stream the stream
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_load_stream_abort(wasm_module_stream_t stream);
+
 /**
  * Unload a WASM module.
  *
@@ -1168,6 +1317,83 @@ wasm_runtime_call_wasm_v(wasm_exec_env_t exec_env,
                          wasm_function_inst_t function, uint32_t num_results,
                          wasm_val_t results[], uint32_t num_args, ...);
 
+/**
+ * Prepare the calls of a WASM function with an execution environment, for
+ * the hot calls from the host. The function type is resolved and the buffer
+ * of the arguments is allocated once, so that each call with
+ * wasm_runtime_call_prepared only stores the arguments and enters the
+ * function, the AoT function is entered through the quick AoT entry of its
+ * signature if there is one.
+ *
+ * @param exec_env the execution environment to call the function,
+ *   which must be created from wasm_create_exec_env()
+ * @param function the function to call
+ *
+ * @return the prepared call, NULL if failed, e.g. the function has v128
+ *   parameters or results, which aren't supported
+ */
+WASM_RUNTIME_API_EXTERN wasm_prepared_call_t
+wasm_runtime_create_prepared_call(wasm_exec_env_t exec_env,
+                                  wasm_function_inst_t function);
+
+/**
+ * Destroy a prepared call, it must be destroyed before the execution
+ * environment it is created with
+ *
+ * @param call the prepared call
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_destroy_prepared_call(wasm_prepared_call_t call);
+
+/**
+ * Call a prepared WASM function, with no allocation when the function has
+ * no externref parameters or results.
+ *
+ * Each argument and result takes a 64-bit slot whatever its type: an i32
+ * is in the low 32 bits, an f32 or f64 is the bits of the value, e.g.
+ * copied with memcpy, and an externref is the host pointer.
+ *
+ * @param call the prepared call
+ * @param args the arguments, one slot for each parameter
+ * @param results the buffer of the results, one slot for each result
+ *
+ * @return true if success, false otherwise and exception will be thrown,
+ *   the caller can call wasm_runtime_get_exception to get the exception
+ *   info.
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_call_prepared(wasm_prepared_call_t call, const uint64_t *args,
+                           uint64_t *results);
+
+/**
+ * Call the given WASM function once for each of many argument sets, the
+ * runtime is entered once for all the calls (bytecode and AoT).
+ *
+ * The arguments and results are laid out as in wasm_runtime_call_wasm,
+ * the cells of the calls one after another. A failed call doesn't stop
+ * the batch unless the instance exits or is terminated, then the
+ * remaining calls are marked failed and skipped.
+ *
+ * @param exec_env the execution environment to call the function,
+ *   which must be created from wasm_create_exec_env()
+ * @param function the function to call
+ * @param num_calls the number of calls
+ * @param args the arguments, the parameter cells of each call
+ * @param results the buffer of the results, the result cells of each
+ *   call, the cells of a failed call are left unchanged
+ * @param failed the buffer to return whether each call failed, can be
+ *   NULL
+ *
+ * @return the number of failed calls, if it isn't 0, the caller can call
+ *   wasm_runtime_get_exception to get the exception info of the last
+ *   failed call.
+ */
+WASM_RUNTIME_API_EXTERN uint32_t
+wasm_runtime_call_wasm_batch(wasm_exec_env_t exec_env,
+                             wasm_function_inst_t function, uint32_t num_calls,
+                             const uint32_t *args, uint32_t *results,
+                             bool *failed);
+
 /**
  * Call a function reference of a given WASM runtime instance with
  * arguments.
@@ -1841,6 +2067,92 @@ wasm_runtime_dump_mem_consumption(wasm_exec_env_t exec_env);
 WASM_RUNTIME_API_EXTERN void
 wasm_runtime_dump_perf_profiling(wasm_module_inst_t module_inst);
 
+/**
+ * Get the resources consumed by a module instance since it was created
+ * or wasm_runtime_reset_instance_stats was called. The instances run by
+ * the threads it spawned count into its stats, so they cover all of its
+ * threads, and the instance of a spawned thread returns the same stats.
+ *
+ * @param module_inst the module instance
+ * @param stats the stats returned
+ *
+ * @return true if success, false if the runtime isn't built with
+ *         WAMR_BUILD_INSTANCE_STATS
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_get_instance_stats(wasm_module_inst_t module_inst,
+                                wasm_instance_stats_t *stats);
+
+/**
+ * Reset the CPU time, call counts and I/O bytes of the stats of a module
+ * instance, the memory usage isn't affected
+ *
+ * @param module_inst the module instance
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_reset_instance_stats(wasm_module_inst_t module_inst);
+
+/* Fuel exhausted callback, it may refill the fuel, e.g. after yielding to
+   other work, and returns true to continue or false to trap */
+typedef bool (*wasm_fuel_exhausted_callback_t)(wasm_exec_env_t exec_env,
+                                               void *user_data);
+
+/**
+ * Set the fuel of an exec_env. The fuel is charged per basic block by one
+ * per wasm opcode, and checked at function entries and loop headers, so
+ * the execution can run over the fuel by the opcodes of a loop iteration
+ * at most. The fuel is unlimited if it is never set. A thread spawned
+ * from the exec_env starts with its fuel left and its fuel exhausted
+ * callback. The fuel is charged by the fast interpreter, and by the AOT
+ * files compiled with `wamrc --enable-fuel`.
+ *
+ * @param exec_env the execution environment
+ * @param fuel the fuel to set
+ *
+ * @return true if success, false if the runtime isn't built with
+ *         WAMR_BUILD_FUEL
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_set_fuel(wasm_exec_env_t exec_env, uint64_t fuel);
+
+/**
+ * Refill the fuel of an exec_env, which can be called by the fuel
+ * exhausted callback
+ *
+ * @param exec_env the execution environment
+ * @param fuel the fuel to add
+ *
+ * @return true if success, false if the runtime isn't built with
+ *         WAMR_BUILD_FUEL
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_add_fuel(wasm_exec_env_t exec_env, uint64_t fuel);
+
+/**
+ * Get the fuel left of an exec_env
+ *
+ * @param exec_env the execution environment
+ *
+ * @return the fuel left, 0 if it is exhausted or the runtime isn't built
+ *         with WAMR_BUILD_FUEL
+ */
+WASM_RUNTIME_API_EXTERN uint64_t
+wasm_runtime_get_fuel(wasm_exec_env_t exec_env);
+
+/**
+ * Set the callback called when the fuel of an exec_env is exhausted. The
+ * "fuel exhausted" exception is thrown if the callback isn't set, returns
+ * false or doesn't refill the fuel.
+ *
+ * @param exec_env the execution environment
+ * @param callback the callback, NULL to remove it
+ * @param user_data the user data passed to the callback
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_set_fuel_exhausted_callback(
+    wasm_exec_env_t exec_env, wasm_fuel_exhausted_callback_t callback,
+    void *user_data);
+
 /**
  * Return total wasm functions' execution time in ms
  *
@@ -1861,6 +2173,38 @@ WASM_RUNTIME_API_EXTERN double
 wasm_runtime_get_wasm_func_exec_time(wasm_module_inst_t inst,
                                      const char *func_name);
 
+/**
+ * Start the sampling profiler, it samples the wasm call stack of each
+ * exec_env running wasm code with SIGPROF every interval, until
+ * wasm_runtime_stop_sampling_profiler is called. The AOT modules must
+ * be compiled with the call stack frames, e.g. with
+ * `wamrc --enable-dump-call-stack`.
+ *
+ * @param interval_us the interval between two samples in microseconds,
+ *        0 means the default 10ms
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_start_sampling_profiler(uint32_t interval_us);
+
+/**
+ * Stop the sampling profiler, the samples are kept
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_stop_sampling_profiler(void);
+
+/**
+ * Write the samples taken by the sampling profiler to a file as folded
+ * stacks, which test-tools/flame-graph-helper and flamegraph.pl accept
+ *
+ * @param file_name the file to write
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_dump_sampling_profile(const char *file_name);
+
 /* wasm thread callback function type */
 typedef void *(*wasm_thread_callback_t)(wasm_exec_env_t, void *);
 /* wasm thread type */
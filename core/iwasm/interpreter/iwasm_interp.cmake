@@ -25,5 +25,9 @@ file (GLOB_RECURSE source_all
     ${IWASM_INTERP_DIR}/${INTERPRETER}
 )
 
+if (WAMR_BUILD_MODULE_IMAGE EQUAL 1)
+    list (APPEND source_all ${IWASM_INTERP_DIR}/wasm_module_image.c)
+endif ()
+
 set (IWASM_INTERP_SOURCE ${source_all})
 
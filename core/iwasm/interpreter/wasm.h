@@ -9,6 +9,9 @@
 #include "bh_platform.h"
 #include "bh_hashmap.h"
 #include "bh_assert.h"
+#if WASM_ENABLE_LAZY_LOADER != 0
+#include "bh_atomic.h"
+#endif
 #if WASM_ENABLE_GC != 0
 #include "gc_export.h"
 #endif
@@ -575,6 +578,13 @@ typedef struct WASMFunctionImport {
 #endif
     bool call_conv_raw;
     bool call_conv_wasm_c_api;
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+    /* whether the pointer params are converted for the quick entry */
+    bool quick_native_ptr_args;
+    /* the quick entry of the signature to call the linked native function,
+       NULL if it is called with wasm_runtime_invoke_native */
+    void *quick_native_entry;
+#endif
 #if WASM_ENABLE_MULTI_MODULE != 0
     WASMModule *import_module;
     WASMFunction *import_func_linked;
@@ -686,6 +696,21 @@ struct WASMFunction {
     uint32 exception_handler_count;
 #endif
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+    /* Whether the function body has been prepared, it is prepared when
+       the function is called the first time */
+    bh_atomic_32_t is_prepared;
+    /* The error of preparing it, NULL if it isn't invalid */
+    char *prepare_error;
+#endif
+
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    /* The offsets of the addresses in code_compiled, recorded to write
+       the module image and freed after that */
+    uint32 *code_relocs;
+    uint32 code_reloc_count;
+#endif
+
 #if WASM_ENABLE_FAST_JIT != 0 || WASM_ENABLE_JIT != 0 \
     || WASM_ENABLE_WAMR_COMPILER != 0
     /* Whether function has opcode memory.grow */
@@ -1092,6 +1117,24 @@ struct WASMModule {
     bool is_bulk_memory_used;
 #endif
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+    /* Lock for preparing the function bodies lazily */
+    korp_mutex lazy_prepare_lock;
+#endif
+
+#if WASM_ENABLE_STREAMING_LOADER != 0
+    /* The binary received by a streaming load, the module refers to it */
+    uint8 *stream_buf;
+#endif
+
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    /* The module image mapped, the function bodies are in it */
+    uint8 *image_addr;
+    uint32 image_size;
+    /* Whether to record the code relocations to write the module image */
+    bool record_code_relocs;
+#endif
+
     /* user defined name */
     char *name;
 
@@ -1192,6 +1192,13 @@ ALLOC_FRAME(WASMExecEnv *exec_env, uint32 size, WASMInterpFrame *prev_frame)
         frame->prev_frame = prev_frame;
 #if WASM_ENABLE_PERF_PROFILING != 0
         frame->time_started = os_time_thread_cputime_us();
+#endif
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        /* the caller ran until now */
+        wasm_hw_counters_attribute(&exec_env->hw_counters,
+                                   prev_frame && prev_frame->function
+                                       ? prev_frame->function->hw_counters
+                                       : NULL);
 #endif
     }
     else {
@@ -1215,6 +1222,10 @@ FREE_FRAME(WASMExecEnv *exec_env, WASMInterpFrame *frame)
 
         if (prev_frame && prev_frame->function)
             prev_frame->function->children_exec_time += time_elapsed;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        wasm_hw_counters_attribute(&exec_env->hw_counters,
+                                   frame->function->hw_counters);
+#endif
     }
 #endif
     wasm_exec_env_free_wasm_frame(exec_env, frame);
@@ -1236,6 +1247,9 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
     void *native_func_pointer = NULL;
     char buf[128];
     bool ret;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    uint8 prev_stats_state;
+#endif
 #if WASM_ENABLE_GC != 0
     WASMFuncType *func_type;
     uint8 *frame_ref;
@@ -1284,6 +1298,10 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
         return;
     }
 
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    prev_stats_state =
+        wasm_instance_stats_switch(exec_env, WASM_STATS_STATE_HOST);
+#endif
     if (func_import->call_conv_wasm_c_api) {
         ret = wasm_runtime_invoke_c_api_native(
             (WASMModuleInstanceCommon *)module_inst, native_func_pointer,
@@ -1294,6 +1312,15 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             argv_ret[1] = frame->lp[1];
         }
     }
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+    else if (func_import->quick_native_entry) {
+        ret = wasm_native_invoke_quick_native_entry(
+            exec_env, func_import->quick_native_entry, native_func_pointer,
+            func_import->func_type, func_import->signature,
+            func_import->quick_native_ptr_args, func_import->attachment,
+            frame->lp, argv_ret);
+    }
+#endif
     else if (!func_import->call_conv_raw) {
         ret = wasm_runtime_invoke_native(
             exec_env, native_func_pointer, func_import->func_type,
@@ -1306,6 +1333,9 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             func_import->signature, func_import->attachment, frame->lp,
             cur_func->param_cell_num, argv_ret);
     }
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
 
     if (!ret)
         return;
@@ -6639,6 +6669,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
     call_func_from_entry:
     {
+#if WASM_ENABLE_LAZY_LOADER != 0
+        if (!wasm_check_function_prepared(module, cur_func)) {
+            frame = prev_frame;
+            goto got_exception;
+        }
+#endif
         if (cur_func->is_import_func) {
 #if WASM_ENABLE_MULTI_MODULE != 0
             if (cur_func->import_func_inst) {
@@ -7053,6 +7089,12 @@ llvm_jit_alloc_frame(WASMExecEnv *exec_env, uint32 func_index)
 #if WASM_ENABLE_PERF_PROFILING != 0
     frame->time_started = os_time_thread_cputime_us();
 #endif
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    wasm_hw_counters_attribute(&exec_env->hw_counters,
+                               cur_frame && cur_frame->function
+                                   ? cur_frame->function->hw_counters
+                                   : NULL);
+#endif
 #if WASM_ENABLE_MEMORY_PROFILING != 0
     {
         uint32 wasm_stack_used =
@@ -7085,6 +7127,10 @@ llvm_jit_free_frame_internal(WASMExecEnv *exec_env)
         /* parent function */
         if (prev_frame)
             prev_frame->function->children_exec_time += time_elapsed;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        wasm_hw_counters_attribute(&exec_env->hw_counters,
+                                   frame->function->hw_counters);
+#endif
     }
 #endif
     exec_env->cur_frame = prev_frame;
@@ -7142,6 +7188,12 @@ llvm_jit_alloc_frame(WASMExecEnv *exec_env, uint32 func_index)
     frame->time_started = os_time_thread_cputime_us();
 #endif
     frame->prev_frame = wasm_exec_env_get_cur_frame(exec_env);
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    wasm_hw_counters_attribute(&exec_env->hw_counters,
+                               frame->prev_frame && frame->prev_frame->function
+                                   ? frame->prev_frame->function->hw_counters
+                                   : NULL);
+#endif
 
     /* No need to initialize ip, it will be committed in jitted code
        when needed */
@@ -7203,6 +7255,10 @@ llvm_jit_free_frame_internal(WASMExecEnv *exec_env)
         /* parent function */
         if (prev_frame)
             prev_frame->function->children_exec_time += time_elapsed;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        wasm_hw_counters_attribute(&exec_env->hw_counters,
+                                   frame->function->hw_counters);
+#endif
     }
 #endif
     wasm_exec_env_free_wasm_frame(exec_env, frame);
@@ -7224,6 +7280,13 @@ llvm_jit_frame_update_profile_info(WASMExecEnv *exec_env, bool alloc_frame)
 
     if (alloc_frame) {
         cur_frame->time_started = os_time_thread_cputime_us();
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        wasm_hw_counters_attribute(
+            &exec_env->hw_counters,
+            cur_frame->prev_frame && cur_frame->prev_frame->function
+                ? cur_frame->prev_frame->function->hw_counters
+                : NULL);
+#endif
     }
     else {
         if (cur_frame->function) {
@@ -7237,6 +7300,10 @@ llvm_jit_frame_update_profile_info(WASMExecEnv *exec_env, bool alloc_frame)
             /* parent function */
             if (prev_frame)
                 prev_frame->function->children_exec_time += time_elapsed;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+            wasm_hw_counters_attribute(&exec_env->hw_counters,
+                                       cur_frame->function->hw_counters);
+#endif
         }
     }
 #endif
@@ -7281,6 +7348,15 @@ llvm_jit_call_func_bytecode(WASMModuleInstance *module_inst,
     }
 #endif
 
+#if WASM_ENABLE_INSTANCE_STATS != 0
+#if WASM_ENABLE_QUICK_AOT_ENTRY != 0
+    wasm_instance_stats_add_jit_transition(
+        exec_env, false, ext_ret_count > 0 || !func_type->quick_aot_entry);
+#else
+    wasm_instance_stats_add_jit_transition(exec_env, false, true);
+#endif
+#endif
+
     if (ext_ret_count > 0) {
         uint32 cell_num = 0, i;
         uint8 *ext_ret_types = func_type->types + func_type->param_count + 1;
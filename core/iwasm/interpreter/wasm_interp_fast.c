@@ -10,6 +10,9 @@
 #include "wasm_loader.h"
 #include "wasm_memory.h"
 #include "../common/wasm_exec_env.h"
+#if WASM_ENABLE_FUEL != 0
+#include "../common/wasm_fuel.h"
+#endif
 #if WASM_ENABLE_GC != 0
 #include "../common/gc/gc_object.h"
 #include "mem_alloc.h"
@@ -1163,6 +1166,13 @@ ALLOC_FRAME(WASMExecEnv *exec_env, uint32 size, WASMInterpFrame *prev_frame)
         frame->prev_frame = prev_frame;
 #if WASM_ENABLE_PERF_PROFILING != 0
         frame->time_started = os_time_thread_cputime_us();
+#endif
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        /* the caller ran until now */
+        wasm_hw_counters_attribute(&exec_env->hw_counters,
+                                   prev_frame && prev_frame->function
+                                       ? prev_frame->function->hw_counters
+                                       : NULL);
 #endif
     }
     else {
@@ -1187,6 +1197,10 @@ FREE_FRAME(WASMExecEnv *exec_env, WASMInterpFrame *frame)
         /* parent function */
         if (prev_frame && prev_frame->function)
             prev_frame->function->children_exec_time += time_elapsed;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        wasm_hw_counters_attribute(&exec_env->hw_counters,
+                                   frame->function->hw_counters);
+#endif
     }
 #endif
     wasm_exec_env_free_wasm_frame(exec_env, frame);
@@ -1207,6 +1221,9 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
     uint32 argv_ret[2], cur_func_index;
     void *native_func_pointer = NULL;
     bool ret;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    uint8 prev_stats_state;
+#endif
 #if WASM_ENABLE_GC != 0
     WASMFuncType *func_type;
     uint8 *frame_ref;
@@ -1255,6 +1272,10 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
         return;
     }
 
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    prev_stats_state =
+        wasm_instance_stats_switch(exec_env, WASM_STATS_STATE_HOST);
+#endif
     if (func_import->call_conv_wasm_c_api) {
         ret = wasm_runtime_invoke_c_api_native(
             (WASMModuleInstanceCommon *)module_inst, native_func_pointer,
@@ -1265,6 +1286,15 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             argv_ret[1] = frame->lp[1];
         }
     }
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+    else if (func_import->quick_native_entry) {
+        ret = wasm_native_invoke_quick_native_entry(
+            exec_env, func_import->quick_native_entry, native_func_pointer,
+            func_import->func_type, func_import->signature,
+            func_import->quick_native_ptr_args, func_import->attachment,
+            frame->lp, argv_ret);
+    }
+#endif
     else if (!func_import->call_conv_raw) {
         ret = wasm_runtime_invoke_native(
             exec_env, native_func_pointer, func_import->func_type,
@@ -1277,6 +1307,9 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             func_import->signature, func_import->attachment, frame->lp,
             cur_func->param_cell_num, argv_ret);
     }
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
 
     if (!ret)
         return;
@@ -4938,6 +4971,25 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
+#if WASM_ENABLE_FUEL != 0
+            HANDLE_OP(EXT_OP_FUEL_CHARGE)
+            {
+                exec_env->fuel -= read_uint32(frame_ip);
+                HANDLE_OP_END();
+            }
+
+            HANDLE_OP(EXT_OP_FUEL_CHECK)
+            {
+                if (exec_env->fuel < 0) {
+                    /* the callback may refill the fuel or yield */
+                    SYNC_ALL_TO_FRAME();
+                    if (!wasm_fuel_exhausted(exec_env))
+                        goto got_exception;
+                }
+                HANDLE_OP_END();
+            }
+#endif
+
             HANDLE_OP(EXT_OP_COPY_STACK_TOP)
             {
                 addr1 = GET_OFFSET();
@@ -7545,6 +7597,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         uint32 *lp_base = NULL, *lp = NULL;
         int i;
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+        /* the const cells before the params are known after preparing */
+        if (!wasm_check_function_prepared(module, cur_func))
+            goto got_exception;
+#endif
+
         if (cur_func->param_cell_num > 0
             && !(lp_base = lp = wasm_runtime_malloc(cur_func->param_cell_num
                                                     * sizeof(uint32)))) {
@@ -7585,6 +7643,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         WASMInterpFrame *outs_area = wasm_exec_env_wasm_stack_top(exec_env);
         int i;
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+        /* the const cells before the params are known after preparing */
+        if (!wasm_check_function_prepared(module, cur_func))
+            goto got_exception;
+#endif
+
 #if WASM_ENABLE_MULTI_MODULE != 0
         if (cur_func->is_import_func) {
             outs_area->lp = outs_area->operand
@@ -7906,6 +7970,11 @@ wasm_interp_call_wasm(WASMModuleInstance *module_inst, WASMExecEnv *exec_env,
     }
     argc = function->param_cell_num;
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+    if (!wasm_check_function_prepared(module_inst, function))
+        return;
+#endif
+
 #if defined(OS_ENABLE_HW_BOUND_CHECK) && WASM_DISABLE_STACK_HW_BOUND_CHECK == 0
     /*
      * wasm_runtime_detect_native_stack_overflow is done by
@@ -10,6 +10,9 @@
 #include "wasm_runtime.h"
 #include "wasm_loader_common.h"
 #include "../common/wasm_native.h"
+#if WASM_ENABLE_MODULE_IMAGE != 0
+#include "wasm_module_image.h"
+#endif
 #include "../common/wasm_memory.h"
 #if WASM_ENABLE_GC != 0
 #include "../common/gc/gc_type.h"
@@ -36,6 +39,52 @@
 #define TEMPLATE_READ_VALUE(Type, p) \
     (p += sizeof(Type), *(Type *)(p - sizeof(Type)))
 
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+/* The helper threads which prepare the function bodies of a module with
+   the loading thread, they are shared by all the modules */
+typedef struct LoaderWorkerPool {
+    korp_mutex lock;
+    korp_cond task_cond;
+    korp_cond done_cond;
+    korp_tid *tids;
+    uint32 thread_num;
+    /* Increased when a module is given to the helpers */
+    uint32 task_id;
+    bool quit;
+    /* Whether the helpers are preparing a module */
+    bool is_busy;
+    /* Number of the helpers still preparing the module */
+    uint32 running_num;
+    WASMModule *module;
+    /* Index of the next function to prepare */
+    bh_atomic_32_t next_func;
+    /* Index of the first function failed to prepare, and its error, the
+       error of the first one is reported whatever the thread order is */
+    bh_atomic_32_t failed_func;
+    char error_buf[128];
+    /* Protects the lists and the ref type set of the module which the
+       functions add items to, the flags like module->is_simd_used are
+       only set to true by them and needn't be protected */
+    korp_mutex module_lock;
+} LoaderWorkerPool;
+
+static LoaderWorkerPool *loader_pool;
+
+static inline void
+lock_module(void)
+{
+    if (loader_pool)
+        os_mutex_lock(&loader_pool->module_lock);
+}
+
+static inline void
+unlock_module(void)
+{
+    if (loader_pool)
+        os_mutex_unlock(&loader_pool->module_lock);
+}
+#endif /* end of WASM_ENABLE_PARALLEL_LOADER != 0 */
+
 #if WASM_ENABLE_MEMORY64 != 0
 static bool
 has_module_memory64(WASMModule *module)
@@ -1460,7 +1509,15 @@ static WASMRefType *
 reftype_set_insert(HashMap *ref_type_set, const WASMRefType *ref_type,
                    char *error_buf, uint32 error_buf_size)
 {
-    WASMRefType *ret = wasm_reftype_set_insert(ref_type_set, ref_type);
+    WASMRefType *ret;
+
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+    lock_module();
+#endif
+    ret = wasm_reftype_set_insert(ref_type_set, ref_type);
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+    unlock_module();
+#endif
 
     if (!ret) {
         set_error_buf(error_buf, error_buf_size,
@@ -5806,159 +5863,377 @@ wasm_interp_get_handle_table(void);
 static void **handle_table;
 #endif
 
-static bool
-load_from_sections(WASMModule *module, WASMSection *sections,
-                   bool is_load_from_file_buf, bool wasm_binary_freeable,
-                   bool no_resolve, char *error_buf, uint32 error_buf_size)
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+/* The code sections smaller than it are prepared by the loading thread */
+#define PARALLEL_LOADER_CODE_SIZE_MIN (64 * 1024)
+
+static void
+prepare_bytecode_task(LoaderWorkerPool *pool)
 {
-    WASMExport *export;
-    WASMSection *section = sections;
-    const uint8 *buf, *buf_end, *buf_code = NULL, *buf_code_end = NULL,
-                                *buf_func = NULL, *buf_func_end = NULL;
-    WASMGlobal *aux_data_end_global = NULL, *aux_heap_base_global = NULL;
-    WASMGlobal *aux_stack_top_global = NULL, *global;
-    uint64 aux_data_end = (uint64)-1LL, aux_heap_base = (uint64)-1LL,
-           aux_stack_top = (uint64)-1LL;
-    uint32 global_index, func_index, i;
-    uint32 aux_data_end_global_index = (uint32)-1;
-    uint32 aux_heap_base_global_index = (uint32)-1;
-    WASMFuncType *func_type;
-    uint8 malloc_free_io_type = VALUE_TYPE_I32;
-    bool reuse_const_strings = is_load_from_file_buf && !wasm_binary_freeable;
-    bool clone_data_seg = is_load_from_file_buf && wasm_binary_freeable;
+    WASMModule *module = pool->module;
+    char error_buf[128];
+    uint32 i;
+
+    while ((i = BH_ATOMIC_32_FETCH_ADD(pool->next_func, 1))
+           < module->function_count) {
+        /* a function before it has failed, the module won't be loaded */
+        if (i > BH_ATOMIC_32_LOAD(pool->failed_func))
+            break;
+
+        if (!wasm_loader_prepare_bytecode(module, module->functions[i], i,
+                                          error_buf, sizeof(error_buf))) {
+            os_mutex_lock(&pool->lock);
+            if (i < BH_ATOMIC_32_LOAD(pool->failed_func)) {
+                BH_ATOMIC_32_STORE(pool->failed_func, i);
+                bh_strcpy_s(pool->error_buf, sizeof(pool->error_buf),
+                            error_buf);
+            }
+            os_mutex_unlock(&pool->lock);
+            /* the functions after it needn't be prepared */
+            break;
+        }
+    }
+}
+
+static void *
+loader_helper_thread_routine(void *arg)
+{
+    LoaderWorkerPool *pool = (LoaderWorkerPool *)arg;
+    uint32 task_id = 0;
+
+    os_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->task_id == task_id && !pool->quit)
+            os_cond_wait(&pool->task_cond, &pool->lock);
+        if (pool->quit)
+            break;
+        task_id = pool->task_id;
+
+        os_mutex_unlock(&pool->lock);
+        prepare_bytecode_task(pool);
+        os_mutex_lock(&pool->lock);
+
+        if (--pool->running_num == 0)
+            os_cond_signal(&pool->done_cond);
+    }
+    os_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/**
+ * Prepare the function bodies of a module with the helper threads
+ *
+ * @return 1 if success, 0 if failed, -1 if the helpers are busy with
+ *         another module and the loading thread should do it alone
+ */
+static int
+prepare_bytecode_in_parallel(WASMModule *module, char *error_buf,
+                             uint32 error_buf_size)
+{
+    LoaderWorkerPool *pool = loader_pool;
+    bool is_busy;
+
+    os_mutex_lock(&pool->lock);
+    is_busy = pool->is_busy;
+    if (!is_busy) {
+        pool->is_busy = true;
+        pool->module = module;
+        BH_ATOMIC_32_STORE(pool->next_func, 0);
+        BH_ATOMIC_32_STORE(pool->failed_func, module->function_count);
+        pool->task_id++;
+        pool->running_num = pool->thread_num;
+        os_cond_broadcast(&pool->task_cond);
+    }
+    os_mutex_unlock(&pool->lock);
+
+    if (is_busy)
+        return -1;
+
+    prepare_bytecode_task(pool);
+
+    os_mutex_lock(&pool->lock);
+    while (pool->running_num > 0)
+        os_cond_wait(&pool->done_cond, &pool->lock);
+    pool->module = NULL;
+    pool->is_busy = false;
+    os_mutex_unlock(&pool->lock);
+
+    if (BH_ATOMIC_32_LOAD(pool->failed_func) < module->function_count) {
+        snprintf(error_buf, error_buf_size, "%s", pool->error_buf);
+        return 0;
+    }
+    return 1;
+}
+
+/* Stop the first thread_num helpers and destroy the pool */
+static void
+destroy_loader_pool(LoaderWorkerPool *pool, uint32 thread_num)
+{
+    uint32 i;
+
+    os_mutex_lock(&pool->lock);
+    pool->quit = true;
+    os_cond_broadcast(&pool->task_cond);
+    os_mutex_unlock(&pool->lock);
+
+    for (i = 0; i < thread_num; i++)
+        os_thread_join(pool->tids[i], NULL);
+
+    os_mutex_destroy(&pool->module_lock);
+    os_cond_destroy(&pool->done_cond);
+    os_cond_destroy(&pool->task_cond);
+    os_mutex_destroy(&pool->lock);
+    wasm_runtime_free(pool->tids);
+    wasm_runtime_free(pool);
+}
+
+bool
+wasm_loader_init_helper_threads(uint32 num)
+{
+    LoaderWorkerPool *pool;
+    uint32 thread_num;
+
+    bh_assert(!loader_pool);
+
+    if (num == 0 || num >= UINT16_MAX)
+        return false;
+
+    if (!(pool = wasm_runtime_malloc(sizeof(LoaderWorkerPool))))
+        return false;
+    memset(pool, 0, sizeof(LoaderWorkerPool));
+
+    if (!(pool->tids = wasm_runtime_malloc(sizeof(korp_tid) * num)))
+        goto fail1;
+
+    if (os_mutex_init(&pool->lock) != BHT_OK)
+        goto fail2;
+    if (os_cond_init(&pool->task_cond) != BHT_OK)
+        goto fail3;
+    if (os_cond_init(&pool->done_cond) != BHT_OK)
+        goto fail4;
+    if (os_mutex_init(&pool->module_lock) != BHT_OK)
+        goto fail5;
+
+    for (thread_num = 0; thread_num < num; thread_num++) {
+        if (os_thread_create(&pool->tids[thread_num],
+                             loader_helper_thread_routine, pool,
+                             APP_THREAD_STACK_SIZE_DEFAULT)
+            != BHT_OK) {
+            LOG_ERROR("create loader helper thread failed");
+            destroy_loader_pool(pool, thread_num);
+            return false;
+        }
+    }
+    pool->thread_num = num;
+
+    loader_pool = pool;
+    return true;
+
+fail5:
+    os_cond_destroy(&pool->done_cond);
+fail4:
+    os_cond_destroy(&pool->task_cond);
+fail3:
+    os_mutex_destroy(&pool->lock);
+fail2:
+    wasm_runtime_free(pool->tids);
+fail1:
+    wasm_runtime_free(pool);
+    return false;
+}
+
+void
+wasm_loader_destroy_helper_threads(void)
+{
+    if (loader_pool) {
+        destroy_loader_pool(loader_pool, loader_pool->thread_num);
+        loader_pool = NULL;
+    }
+}
+#endif /* end of WASM_ENABLE_PARALLEL_LOADER != 0 */
+
+/* The state of loading the sections of a module, the sections may be
+   loaded one by one as they arrive, see wasm_loader_stream_feed */
+typedef struct SectionLoader {
+    WASMModule *module;
+    const uint8 *buf_code, *buf_code_end;
+    const uint8 *buf_func, *buf_func_end;
+    bool reuse_const_strings;
+    bool clone_data_seg;
+    bool no_resolve;
 #if WASM_ENABLE_BULK_MEMORY != 0
-    bool has_datacount_section = false;
+    bool has_datacount_section;
 #endif
+    bool aux_info_resolved;
+    bool functions_prepared;
+    WASMGlobal *aux_data_end_global;
+    WASMGlobal *aux_heap_base_global;
+    WASMGlobal *aux_stack_top_global;
+    uint64 aux_heap_base;
+} SectionLoader;
 
-    /* Find code and function sections if have */
-    while (section) {
-        if (section->section_type == SECTION_TYPE_CODE) {
-            buf_code = section->section_body;
-            buf_code_end = buf_code + section->section_body_size;
+static void
+init_section_loader(SectionLoader *loader, WASMModule *module,
+                    bool is_load_from_file_buf, bool wasm_binary_freeable,
+                    bool no_resolve)
+{
+    memset(loader, 0, sizeof(SectionLoader));
+    loader->module = module;
+    loader->reuse_const_strings =
+        is_load_from_file_buf && !wasm_binary_freeable;
+    loader->clone_data_seg = is_load_from_file_buf && wasm_binary_freeable;
+    loader->no_resolve = no_resolve;
+    loader->aux_heap_base = (uint64)-1LL;
+}
+
+/* Remember the code and function sections, the function and tag sections
+   are loaded with the code section */
+static void
+set_code_or_func_section(SectionLoader *loader, const WASMSection *section)
+{
+    if (section->section_type == SECTION_TYPE_CODE) {
+        loader->buf_code = section->section_body;
+        loader->buf_code_end = loader->buf_code + section->section_body_size;
 #if WASM_ENABLE_DEBUG_INTERP != 0 || WASM_ENABLE_DEBUG_AOT != 0
-            module->buf_code = (uint8 *)buf_code;
-            module->buf_code_size = section->section_body_size;
+        loader->module->buf_code = (uint8 *)loader->buf_code;
+        loader->module->buf_code_size = section->section_body_size;
 #endif
-        }
-        else if (section->section_type == SECTION_TYPE_FUNC) {
-            buf_func = section->section_body;
-            buf_func_end = buf_func + section->section_body_size;
-        }
-        section = section->next;
     }
+    else if (section->section_type == SECTION_TYPE_FUNC) {
+        loader->buf_func = section->section_body;
+        loader->buf_func_end = loader->buf_func + section->section_body_size;
+    }
+}
 
-    section = sections;
-    while (section) {
-        buf = section->section_body;
-        buf_end = buf + section->section_body_size;
-        switch (section->section_type) {
-            case SECTION_TYPE_USER:
-                /* unsupported user section, ignore it. */
-                if (!load_user_section(buf, buf_end, module,
-                                       reuse_const_strings, error_buf,
-                                       error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_TYPE:
-                if (!load_type_section(buf, buf_end, module, error_buf,
+static bool
+load_section(SectionLoader *loader, const WASMSection *section,
+             char *error_buf, uint32 error_buf_size)
+{
+    WASMModule *module = loader->module;
+    const uint8 *buf = section->section_body;
+    const uint8 *buf_end = buf + section->section_body_size;
+
+    switch (section->section_type) {
+        case SECTION_TYPE_USER:
+            /* unsupported user section, ignore it. */
+            if (!load_user_section(buf, buf_end, module,
+                                   loader->reuse_const_strings, error_buf,
+                                   error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_TYPE:
+            if (!load_type_section(buf, buf_end, module, error_buf,
+                                   error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_IMPORT:
+            if (!load_import_section(buf, buf_end, module,
+                                     loader->reuse_const_strings,
+                                     loader->no_resolve, error_buf,
+                                     error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_FUNC:
+            if (!load_function_section(buf, buf_end, loader->buf_code,
+                                       loader->buf_code_end, module, error_buf,
                                        error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_IMPORT:
-                if (!load_import_section(buf, buf_end, module,
-                                         reuse_const_strings, no_resolve,
-                                         error_buf, error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_FUNC:
-                if (!load_function_section(buf, buf_end, buf_code, buf_code_end,
-                                           module, error_buf, error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_TABLE:
-                if (!load_table_section(buf, buf_end, module, error_buf,
-                                        error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_MEMORY:
-                if (!load_memory_section(buf, buf_end, module, error_buf,
-                                         error_buf_size))
-                    return false;
-                break;
+                return false;
+            break;
+        case SECTION_TYPE_TABLE:
+            if (!load_table_section(buf, buf_end, module, error_buf,
+                                    error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_MEMORY:
+            if (!load_memory_section(buf, buf_end, module, error_buf,
+                                     error_buf_size))
+                return false;
+            break;
 #if WASM_ENABLE_TAGS != 0
-            case SECTION_TYPE_TAG:
-                /* load tag declaration section */
-                if (!load_tag_section(buf, buf_end, buf_code, buf_code_end,
-                                      module, error_buf, error_buf_size))
-                    return false;
-                break;
+        case SECTION_TYPE_TAG:
+            /* load tag declaration section */
+            if (!load_tag_section(buf, buf_end, loader->buf_code,
+                                  loader->buf_code_end, module, error_buf,
+                                  error_buf_size))
+                return false;
+            break;
 #endif
-            case SECTION_TYPE_GLOBAL:
-                if (!load_global_section(buf, buf_end, module, error_buf,
-                                         error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_EXPORT:
-                if (!load_export_section(buf, buf_end, module,
-                                         reuse_const_strings, error_buf,
-                                         error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_START:
-                if (!load_start_section(buf, buf_end, module, error_buf,
-                                        error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_ELEM:
-                if (!load_table_segment_section(buf, buf_end, module, error_buf,
-                                                error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_CODE:
-                if (!load_code_section(buf, buf_end, buf_func, buf_func_end,
-                                       module, error_buf, error_buf_size))
-                    return false;
-                break;
-            case SECTION_TYPE_DATA:
-                if (!load_data_segment_section(buf, buf_end, module,
+        case SECTION_TYPE_GLOBAL:
+            if (!load_global_section(buf, buf_end, module, error_buf,
+                                     error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_EXPORT:
+            if (!load_export_section(buf, buf_end, module,
+                                     loader->reuse_const_strings, error_buf,
+                                     error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_START:
+            if (!load_start_section(buf, buf_end, module, error_buf,
+                                    error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_ELEM:
+            if (!load_table_segment_section(buf, buf_end, module, error_buf,
+                                            error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_CODE:
+            if (!load_code_section(buf, buf_end, loader->buf_func,
+                                   loader->buf_func_end, module, error_buf,
+                                   error_buf_size))
+                return false;
+            break;
+        case SECTION_TYPE_DATA:
+            if (!load_data_segment_section(buf, buf_end, module,
 #if WASM_ENABLE_BULK_MEMORY != 0
-                                               has_datacount_section,
+                                           loader->has_datacount_section,
 #endif
-                                               clone_data_seg, error_buf,
-                                               error_buf_size))
-                    return false;
-                break;
+                                           loader->clone_data_seg, error_buf,
+                                           error_buf_size))
+                return false;
+            break;
 #if WASM_ENABLE_BULK_MEMORY != 0
-            case SECTION_TYPE_DATACOUNT:
-                if (!load_datacount_section(buf, buf_end, module, error_buf,
-                                            error_buf_size))
-                    return false;
-                has_datacount_section = true;
-                break;
+        case SECTION_TYPE_DATACOUNT:
+            if (!load_datacount_section(buf, buf_end, module, error_buf,
+                                        error_buf_size))
+                return false;
+            loader->has_datacount_section = true;
+            break;
 #endif
 #if WASM_ENABLE_STRINGREF != 0
-            case SECTION_TYPE_STRINGREF:
-                if (!load_stringref_section(buf, buf_end, module,
-                                            reuse_const_strings, error_buf,
-                                            error_buf_size))
-                    return false;
-                break;
-#endif
-            default:
-                set_error_buf(error_buf, error_buf_size, "invalid section id");
+        case SECTION_TYPE_STRINGREF:
+            if (!load_stringref_section(buf, buf_end, module,
+                                        loader->reuse_const_strings, error_buf,
+                                        error_buf_size))
                 return false;
-        }
-
-        section = section->next;
+            break;
+#endif
+        default:
+            set_error_buf(error_buf, error_buf_size, "invalid section id");
+            return false;
     }
 
-#if WASM_ENABLE_BULK_MEMORY != 0
-    if (!check_data_count_consistency(
-            has_datacount_section, module->data_seg_count1,
-            module->data_seg_count, error_buf, error_buf_size)) {
-        return false;
-    }
-#endif
+    return true;
+}
+
+/* Resolve the auxiliary data/stack/heap globals and the malloc/free
+   functions from the exports */
+static void
+resolve_aux_info(SectionLoader *loader)
+{
+    WASMModule *module = loader->module;
+    WASMExport *export;
+    WASMGlobal *aux_data_end_global = NULL, *aux_heap_base_global = NULL;
+    WASMGlobal *aux_stack_top_global = NULL, *global;
+    uint64 aux_data_end = (uint64)-1LL, aux_heap_base = (uint64)-1LL,
+           aux_stack_top = (uint64)-1LL;
+    uint32 global_index, func_index, i;
+    uint32 aux_data_end_global_index = (uint32)-1;
+    uint32 aux_heap_base_global_index = (uint32)-1;
+    WASMFuncType *func_type;
+    uint8 malloc_free_io_type = VALUE_TYPE_I32;
 
     module->aux_data_end_global_index = (uint32)-1;
     module->aux_heap_base_global_index = (uint32)-1;
@@ -6175,31 +6450,106 @@ load_from_sections(WASMModule *module, WASMSection *sections,
         }
     }
 
+    loader->aux_data_end_global = aux_data_end_global;
+    loader->aux_heap_base_global = aux_heap_base_global;
+    loader->aux_stack_top_global = aux_stack_top_global;
+    loader->aux_heap_base = aux_heap_base;
+    loader->aux_info_resolved = true;
+}
+
+static bool
+prepare_functions(SectionLoader *loader, char *error_buf,
+                  uint32 error_buf_size)
+{
+    WASMModule *module = loader->module;
+    uint32 i;
+
 #if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_LABELS_AS_VALUES != 0
     handle_table = wasm_interp_get_handle_table();
 #endif
 
-    for (i = 0; i < module->function_count; i++) {
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    if (module->image_addr) {
+        if (!wasm_module_image_apply(module, module->image_addr,
+                                     module->image_size, error_buf,
+                                     error_buf_size))
+            return false;
+        /* skip the loop below as they are in the module image */
+        i = module->function_count;
+    }
+    else
+#endif
+#if WASM_ENABLE_LAZY_LOADER != 0
+    /* the functions are prepared when they are called the first time, and
+       as it isn't known whether memory.grow is used, don't shrink the
+       memory */
+    i = module->function_count;
+    module->possible_memory_grow = true;
+#elif WASM_ENABLE_PARALLEL_LOADER != 0
+    if (loader_pool
+        && loader->buf_code_end - loader->buf_code
+               >= PARALLEL_LOADER_CODE_SIZE_MIN) {
+        int ret = prepare_bytecode_in_parallel(module, error_buf,
+                                               error_buf_size);
+        if (ret == 0)
+            return false;
+        /* skip the loop below if they are prepared */
+        i = ret > 0 ? module->function_count : 0;
+    }
+    else
+        i = 0;
+#else
+    i = 0;
+#endif
+
+    for (; i < module->function_count; i++) {
         WASMFunction *func = module->functions[i];
         if (!wasm_loader_prepare_bytecode(module, func, i, error_buf,
                                           error_buf_size)) {
             return false;
         }
+    }
 
-        if (i == module->function_count - 1
-            && func->code + func->code_size != buf_code_end) {
+    if (module->function_count > 0) {
+        WASMFunction *func = module->functions[module->function_count - 1];
+        if (func->code + func->code_size != loader->buf_code_end) {
             set_error_buf(error_buf, error_buf_size,
                           "code section size mismatch");
             return false;
         }
     }
 
+    loader->functions_prepared = true;
+    return true;
+}
+
+static bool
+load_sections_finish(SectionLoader *loader, char *error_buf,
+                     uint32 error_buf_size)
+{
+    WASMModule *module = loader->module;
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (!check_data_count_consistency(
+            loader->has_datacount_section, module->data_seg_count1,
+            module->data_seg_count, error_buf, error_buf_size)) {
+        return false;
+    }
+#endif
+
+    if (!loader->aux_info_resolved)
+        resolve_aux_info(loader);
+
+    if (!loader->functions_prepared
+        && !prepare_functions(loader, error_buf, error_buf_size))
+        return false;
+
     if (!module->possible_memory_grow) {
 #if WASM_ENABLE_SHRUNK_MEMORY != 0
-        if (aux_data_end_global && aux_heap_base_global
-            && aux_stack_top_global) {
+        if (loader->aux_data_end_global && loader->aux_heap_base_global
+            && loader->aux_stack_top_global) {
             uint64 init_memory_size;
-            uint64 shrunk_memory_size = align_uint64(aux_heap_base, 8);
+            uint64 shrunk_memory_size = align_uint64(loader->aux_heap_base, 8);
 
             /* Only resize(shrunk) the memory size if num_bytes_per_page is in
              * valid range of uint32 */
@@ -6320,6 +6670,29 @@ load_from_sections(WASMModule *module, WASMSection *sections,
     return true;
 }
 
+static bool
+load_from_sections(WASMModule *module, WASMSection *sections,
+                   bool is_load_from_file_buf, bool wasm_binary_freeable,
+                   bool no_resolve, char *error_buf, uint32 error_buf_size)
+{
+    SectionLoader loader;
+    WASMSection *section;
+
+    init_section_loader(&loader, module, is_load_from_file_buf,
+                        wasm_binary_freeable, no_resolve);
+
+    /* Find code and function sections if have */
+    for (section = sections; section; section = section->next)
+        set_code_or_func_section(&loader, section);
+
+    for (section = sections; section; section = section->next) {
+        if (!load_section(&loader, section, error_buf, error_buf_size))
+            return false;
+    }
+
+    return load_sections_finish(&loader, error_buf, error_buf_size);
+}
+
 static WASMModule *
 create_module(char *name, char *error_buf, uint32 error_buf_size)
 {
@@ -6379,6 +6752,14 @@ create_module(char *name, char *error_buf, uint32 error_buf_size)
     }
 #endif
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+    if (os_mutex_init(&module->lazy_prepare_lock) != 0) {
+        set_error_buf(error_buf, error_buf_size,
+                      "init lazy prepare lock failed");
+        goto fail4;
+    }
+#endif
+
 #if WASM_ENABLE_LIBC_WASI != 0
     module->wasi_args.stdio[0] = os_invalid_raw_handle();
     module->wasi_args.stdio[1] = os_invalid_raw_handle();
@@ -6388,6 +6769,14 @@ create_module(char *name, char *error_buf, uint32 error_buf_size)
     (void)ret;
     return module;
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+fail4:
+#if WASM_ENABLE_DEBUG_INTERP != 0                    \
+    || (WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT \
+        && WASM_ENABLE_LAZY_JIT != 0)
+    os_mutex_destroy(&module->instance_list_lock);
+#endif
+#endif
 #if WASM_ENABLE_DEBUG_INTERP != 0                    \
     || (WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT \
         && WASM_ENABLE_LAZY_JIT != 0)
@@ -6413,7 +6802,13 @@ record_fast_op(WASMModule *module, uint8 *pos, uint8 orig_op, char *error_buf,
     if (fast_op) {
         fast_op->offset = pos - module->load_addr;
         fast_op->orig_op = orig_op;
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+        lock_module();
+#endif
         bh_list_insert(&module->fast_opcode_list, fast_op);
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+        unlock_module();
+#endif
     }
     return fast_op ? true : false;
 }
@@ -6486,7 +6881,34 @@ get_section_index(uint8 section_type)
             return i;
     }
 
-    return (uint8)-1;
+    return (uint8)-1;
+}
+
+static bool
+check_section_order(uint8 section_type, uint8 *p_last_section_index,
+                    char *error_buf, uint32 error_buf_size)
+{
+    uint8 section_index = get_section_index(section_type);
+
+    if (section_index == (uint8)-1) {
+        set_error_buf(error_buf, error_buf_size, "invalid section id");
+        return false;
+    }
+
+    if (section_type != SECTION_TYPE_USER) {
+        /* Custom sections may be inserted at any place,
+           while other sections must occur at most once
+           and in prescribed order. */
+        if (*p_last_section_index != (uint8)-1
+            && (section_index <= *p_last_section_index)) {
+            set_error_buf(error_buf, error_buf_size,
+                          "unexpected content after last section or "
+                          "junk after last section");
+            return false;
+        }
+        *p_last_section_index = section_index;
+    }
+    return true;
 }
 
 static bool
@@ -6495,7 +6917,7 @@ create_sections(const uint8 *buf, uint32 size, WASMSection **p_section_list,
 {
     WASMSection *section_list_end = NULL, *section;
     const uint8 *p = buf, *p_end = buf + size;
-    uint8 section_type, section_index, last_section_index = (uint8)-1;
+    uint8 section_type, last_section_index = (uint8)-1;
     uint32 section_size;
 
     bh_assert(!*p_section_list);
@@ -6504,46 +6926,30 @@ create_sections(const uint8 *buf, uint32 size, WASMSection **p_section_list,
     while (p < p_end) {
         CHECK_BUF(p, p_end, 1);
         section_type = read_uint8(p);
-        section_index = get_section_index(section_type);
-        if (section_index != (uint8)-1) {
-            if (section_type != SECTION_TYPE_USER) {
-                /* Custom sections may be inserted at any place,
-                   while other sections must occur at most once
-                   and in prescribed order. */
-                if (last_section_index != (uint8)-1
-                    && (section_index <= last_section_index)) {
-                    set_error_buf(error_buf, error_buf_size,
-                                  "unexpected content after last section or "
-                                  "junk after last section");
-                    return false;
-                }
-                last_section_index = section_index;
-            }
-            read_leb_uint32(p, p_end, section_size);
-            CHECK_BUF1(p, p_end, section_size);
+        if (!check_section_order(section_type, &last_section_index, error_buf,
+                                 error_buf_size))
+            return false;
 
-            if (!(section = loader_malloc(sizeof(WASMSection), error_buf,
-                                          error_buf_size))) {
-                return false;
-            }
+        read_leb_uint32(p, p_end, section_size);
+        CHECK_BUF1(p, p_end, section_size);
 
-            section->section_type = section_type;
-            section->section_body = (uint8 *)p;
-            section->section_body_size = section_size;
+        if (!(section = loader_malloc(sizeof(WASMSection), error_buf,
+                                      error_buf_size))) {
+            return false;
+        }
 
-            if (!section_list_end)
-                *p_section_list = section_list_end = section;
-            else {
-                section_list_end->next = section;
-                section_list_end = section;
-            }
+        section->section_type = section_type;
+        section->section_body = (uint8 *)p;
+        section->section_body_size = section_size;
 
-            p += section_size;
-        }
+        if (!section_list_end)
+            *p_section_list = section_list_end = section;
         else {
-            set_error_buf(error_buf, error_buf_size, "invalid section id");
-            return false;
+            section_list_end->next = section;
+            section_list_end = section;
         }
+
+        p += section_size;
     }
 
     return true;
@@ -6571,14 +6977,11 @@ static union {
 #define is_little_endian() (__ue.b == 1)
 
 static bool
-load(const uint8 *buf, uint32 size, WASMModule *module,
-     bool wasm_binary_freeable, bool no_resolve, char *error_buf,
-     uint32 error_buf_size)
+check_magic_and_version(const uint8 *buf, uint32 size, WASMModule *module,
+                        char *error_buf, uint32 error_buf_size)
 {
-    const uint8 *buf_end = buf + size;
-    const uint8 *p = buf, *p_end = buf_end;
+    const uint8 *p = buf, *p_end = buf + size;
     uint32 magic_number, version;
-    WASMSection *section_list = NULL;
 
     CHECK_BUF1(p, p_end, sizeof(uint32));
     magic_number = read_uint32(p);
@@ -6601,8 +7004,20 @@ load(const uint8 *buf, uint32 size, WASMModule *module,
     }
 
     module->package_version = version;
+    return true;
+fail:
+    return false;
+}
+
+static bool
+load(const uint8 *buf, uint32 size, WASMModule *module,
+     bool wasm_binary_freeable, bool no_resolve, char *error_buf,
+     uint32 error_buf_size)
+{
+    WASMSection *section_list = NULL;
 
-    if (!create_sections(buf, size, &section_list, error_buf, error_buf_size)
+    if (!check_magic_and_version(buf, size, module, error_buf, error_buf_size)
+        || !create_sections(buf, size, &section_list, error_buf, error_buf_size)
         || !load_from_sections(module, section_list, true, wasm_binary_freeable,
                                no_resolve, error_buf, error_buf_size)) {
         destroy_sections(section_list);
@@ -6611,8 +7026,6 @@ load(const uint8 *buf, uint32 size, WASMModule *module,
 
     destroy_sections(section_list);
     return true;
-fail:
-    return false;
 }
 
 #if WASM_ENABLE_LIBC_WASI != 0
@@ -6769,11 +7182,25 @@ wasm_loader_load(uint8 *buf, uint32 size,
 #endif
                  const LoadArgs *args, char *error_buf, uint32 error_buf_size)
 {
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    uint8 binary_hash[MODULE_IMAGE_HASH_SIZE];
+    uint32 i;
+#endif
     WASMModule *module = create_module(args->name, error_buf, error_buf_size);
     if (!module) {
         return NULL;
     }
 
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    if (args->module_image_path) {
+        /* hash the binary before the loader modifies it */
+        wasm_module_image_hash(buf, size, binary_hash);
+        if (!wasm_module_image_map(args->module_image_path, binary_hash, size,
+                                   &module->image_addr, &module->image_size))
+            module->record_code_relocs = true;
+    }
+#endif
+
 #if WASM_ENABLE_DEBUG_INTERP != 0 || WASM_ENABLE_FAST_JIT != 0 \
     || WASM_ENABLE_DUMP_CALL_STACK != 0 || WASM_ENABLE_JIT != 0
     module->load_addr = (uint8 *)buf;
@@ -6796,6 +7223,23 @@ wasm_loader_load(uint8 *buf, uint32 size,
     }
 #endif
 
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    if (args->module_image_path && !module->image_addr) {
+        /* the next load maps it, and the module still works if it can't be
+           written */
+        if (module->record_code_relocs)
+            wasm_module_image_write(module, args->module_image_path,
+                                    binary_hash, size);
+        for (i = 0; i < module->function_count; i++) {
+            if (module->functions[i]->code_relocs) {
+                wasm_runtime_free(module->functions[i]->code_relocs);
+                module->functions[i]->code_relocs = NULL;
+            }
+        }
+        module->record_code_relocs = false;
+    }
+#endif
+
     LOG_VERBOSE("Load module success.\n");
     return module;
 
@@ -6804,6 +7248,306 @@ fail:
     return NULL;
 }
 
+#if WASM_ENABLE_STREAMING_LOADER != 0
+/* The initial size of the buffer if the size of the binary isn't known */
+#define STREAM_BUF_SIZE_MIN 4096
+
+struct WASMModuleStream {
+    WASMModule *module;
+    SectionLoader loader;
+    bool no_resolve;
+    /* The binary received. If its size is known, the buffer is allocated
+       once and the sections are loaded as soon as they arrive, otherwise
+       the buffer grows and the module is loaded when the stream finishes */
+    uint8 *buf;
+    uint32 buf_size;
+    uint32 total_size;
+    uint32 received_size;
+    /* The offset of the next section header to parse */
+    uint32 parse_offset;
+    uint8 last_section_index;
+    /* The sections parsed, and the first one of them not loaded yet */
+    WASMSection *sections, *sections_end, *section_to_load;
+};
+
+WASMModuleStream *
+wasm_loader_stream_begin(uint32 total_size, const LoadArgs *args,
+                         char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleStream *stream;
+
+    if (!(stream = loader_malloc(sizeof(WASMModuleStream), error_buf,
+                                 error_buf_size))) {
+        return NULL;
+    }
+
+    stream->buf_size = total_size > 0 ? total_size : STREAM_BUF_SIZE_MIN;
+    stream->total_size = total_size;
+    stream->no_resolve = args->no_resolve;
+    stream->last_section_index = (uint8)-1;
+
+    if (!(stream->buf = wasm_runtime_malloc(stream->buf_size))) {
+        set_error_buf(error_buf, error_buf_size,
+                      "allocate memory failed");
+        wasm_loader_stream_abort(stream);
+        return NULL;
+    }
+
+    if (!(stream->module =
+              create_module(args->name, error_buf, error_buf_size))) {
+        wasm_loader_stream_abort(stream);
+        return NULL;
+    }
+
+    /* The module keeps the buffer, so the strings and the function bodies
+       in it are used directly */
+    init_section_loader(&stream->loader, stream->module, true, false,
+                        args->no_resolve);
+    return stream;
+}
+
+static bool
+parse_stream_sections(WASMModuleStream *stream, char *error_buf,
+                      uint32 error_buf_size)
+{
+    const uint8 *p, *p_end = stream->buf + stream->received_size;
+    const uint8 *buf_end = stream->buf + stream->total_size, *p_leb;
+    WASMSection *section;
+    uint8 section_type;
+    uint32 section_size;
+
+    while (stream->parse_offset < stream->received_size) {
+        p = stream->buf + stream->parse_offset;
+        section_type = read_uint8(p);
+
+        for (p_leb = p; p_leb < p_end && (*p_leb & 0x80) && p_leb - p < 5;
+             p_leb++)
+            ;
+        if (p_leb == p_end && p_end < buf_end) {
+            /* wait for the rest of the section size */
+            return true;
+        }
+
+        if (!check_section_order(section_type, &stream->last_section_index,
+                                 error_buf, error_buf_size))
+            return false;
+
+        read_leb_uint32(p, p_end, section_size);
+        CHECK_BUF1(p, buf_end, section_size);
+
+        if (!(section = loader_malloc(sizeof(WASMSection), error_buf,
+                                      error_buf_size))) {
+            return false;
+        }
+
+        section->section_type = section_type;
+        section->section_body = (uint8 *)p;
+        section->section_body_size = section_size;
+
+        if (!stream->sections_end)
+            stream->sections = stream->sections_end = section;
+        else {
+            stream->sections_end->next = section;
+            stream->sections_end = section;
+        }
+        if (!stream->section_to_load)
+            stream->section_to_load = section;
+
+        set_code_or_func_section(&stream->loader, section);
+        stream->parse_offset = (uint32)(p + section_size - stream->buf);
+    }
+
+    return true;
+fail:
+    return false;
+}
+
+/* Prepare the function bodies once the code section arrives, which goes on
+   while the data section is being received */
+static bool
+prepare_stream_functions(WASMModuleStream *stream, char *error_buf,
+                         uint32 error_buf_size)
+{
+    bool ret;
+
+    /* The exports are in the sections before the code section */
+    resolve_aux_info(&stream->loader);
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    /* memory.init and data.drop are validated against the data segment
+       count of the datacount section, without it they are invalid anyway,
+       and the count is checked against the data section when it arrives */
+    stream->module->data_seg_count = stream->module->data_seg_count1;
+#endif
+    ret = prepare_functions(&stream->loader, error_buf, error_buf_size);
+#if WASM_ENABLE_BULK_MEMORY != 0
+    stream->module->data_seg_count = 0;
+#endif
+    return ret;
+}
+
+static bool
+load_stream_sections(WASMModuleStream *stream, char *error_buf,
+                     uint32 error_buf_size)
+{
+    SectionLoader *loader = &stream->loader;
+    const uint8 *p_end = stream->buf + stream->received_size;
+    bool code_received = loader->buf_code && loader->buf_code_end <= p_end;
+    WASMSection *section;
+
+    while ((section = stream->section_to_load)) {
+        if (section->section_body + section->section_body_size > p_end)
+            return true;
+
+        /* the function and tag sections are loaded with the code section,
+           wait for it unless the binary doesn't have it */
+        if ((section->section_type == SECTION_TYPE_FUNC
+#if WASM_ENABLE_TAGS != 0
+             || section->section_type == SECTION_TYPE_TAG
+#endif
+             )
+            && !code_received && stream->received_size < stream->total_size)
+            return true;
+
+        if (!load_section(loader, section, error_buf, error_buf_size))
+            return false;
+        stream->section_to_load = section->next;
+
+        if (section->section_type == SECTION_TYPE_CODE
+            && !prepare_stream_functions(stream, error_buf, error_buf_size))
+            return false;
+    }
+
+    return true;
+}
+
+bool
+wasm_loader_stream_feed(WASMModuleStream *stream, const uint8 *buf,
+                        uint32 size, char *error_buf, uint32 error_buf_size)
+{
+    uint64 buf_size;
+    uint8 *new_buf;
+
+    if (stream->total_size > 0) {
+        if (size > stream->total_size - stream->received_size) {
+            set_error_buf(error_buf, error_buf_size,
+                          "binary larger than the declared size");
+            return false;
+        }
+    }
+    else if ((uint64)stream->received_size + size > stream->buf_size) {
+        buf_size = stream->buf_size;
+        while (buf_size < (uint64)stream->received_size + size)
+            buf_size *= 2;
+        if (buf_size > UINT32_MAX)
+            buf_size = UINT32_MAX;
+        if ((uint64)stream->received_size + size > buf_size) {
+            set_error_buf(error_buf, error_buf_size, "binary too large");
+            return false;
+        }
+        if (!(new_buf = wasm_runtime_realloc(stream->buf, (uint32)buf_size))) {
+            set_error_buf(error_buf, error_buf_size,
+                          "allocate memory failed");
+            return false;
+        }
+        stream->buf = new_buf;
+        stream->buf_size = (uint32)buf_size;
+    }
+
+    bh_memcpy_s(stream->buf + stream->received_size,
+                stream->buf_size - stream->received_size, buf, size);
+    stream->received_size += size;
+
+    /* check the header as soon as it arrives */
+    if (stream->parse_offset == 0) {
+        if (stream->received_size < 8)
+            return true;
+        if (!check_magic_and_version(stream->buf, 8, stream->module,
+                                     error_buf, error_buf_size))
+            return false;
+        stream->parse_offset = 8;
+    }
+
+    /* the buffer may still move if the size isn't known */
+    if (stream->total_size == 0)
+        return true;
+
+    return parse_stream_sections(stream, error_buf, error_buf_size)
+           && load_stream_sections(stream, error_buf, error_buf_size);
+}
+
+WASMModule *
+wasm_loader_stream_finish(WASMModuleStream *stream,
+#if WASM_ENABLE_MULTI_MODULE != 0
+                          bool main_module,
+#endif
+                          char *error_buf, uint32 error_buf_size)
+{
+    WASMModule *module = stream->module;
+
+    if (stream->total_size == 0) {
+        if (!load(stream->buf, stream->received_size, module, false,
+                  stream->no_resolve, error_buf, error_buf_size))
+            goto fail;
+    }
+    else {
+        if (stream->received_size < stream->total_size) {
+            set_error_buf(error_buf, error_buf_size, "unexpected end");
+            goto fail;
+        }
+        /* the binary may be shorter than the header */
+        if ((stream->parse_offset == 0
+             && !check_magic_and_version(stream->buf, stream->received_size,
+                                         module, error_buf, error_buf_size))
+            || !load_stream_sections(stream, error_buf, error_buf_size)
+            || !load_sections_finish(&stream->loader, error_buf,
+                                     error_buf_size))
+            goto fail;
+    }
+
+#if WASM_ENABLE_LIBC_WASI != 0
+    /* Check the WASI application ABI */
+    if (!check_wasi_abi_compatibility(module,
+#if WASM_ENABLE_MULTI_MODULE != 0
+                                      main_module,
+#endif
+                                      error_buf, error_buf_size)) {
+        goto fail;
+    }
+#endif
+
+#if WASM_ENABLE_DEBUG_INTERP != 0 || WASM_ENABLE_FAST_JIT != 0 \
+    || WASM_ENABLE_DUMP_CALL_STACK != 0 || WASM_ENABLE_JIT != 0
+    module->load_addr = stream->buf;
+    module->load_size = stream->received_size;
+#endif
+
+    module->stream_buf = stream->buf;
+    stream->module = NULL;
+    stream->buf = NULL;
+    wasm_loader_stream_abort(stream);
+
+    LOG_VERBOSE("Load module from stream success.\n");
+    return module;
+
+fail:
+    wasm_loader_stream_abort(stream);
+    return NULL;
+}
+
+void
+wasm_loader_stream_abort(WASMModuleStream *stream)
+{
+    /* unload the module first as it may refer to the buffer */
+    if (stream->module)
+        wasm_loader_unload(stream->module);
+    if (stream->buf)
+        wasm_runtime_free(stream->buf);
+    destroy_sections(stream->sections);
+    wasm_runtime_free(stream);
+}
+#endif /* end of WASM_ENABLE_STREAMING_LOADER != 0 */
+
 void
 wasm_loader_unload(WASMModule *module)
 {
@@ -6851,10 +7595,22 @@ wasm_loader_unload(WASMModule *module)
                 if (module->functions[i]->local_offsets)
                     wasm_runtime_free(module->functions[i]->local_offsets);
 #if WASM_ENABLE_FAST_INTERP != 0
-                if (module->functions[i]->code_compiled)
-                    wasm_runtime_free(module->functions[i]->code_compiled);
-                if (module->functions[i]->consts)
-                    wasm_runtime_free(module->functions[i]->consts);
+#if WASM_ENABLE_MODULE_IMAGE != 0
+                if (module->functions[i]->code_relocs)
+                    wasm_runtime_free(module->functions[i]->code_relocs);
+                /* they are in the module image */
+                if (!module->image_addr)
+#endif
+                {
+                    if (module->functions[i]->code_compiled)
+                        wasm_runtime_free(module->functions[i]->code_compiled);
+                    if (module->functions[i]->consts)
+                        wasm_runtime_free(module->functions[i]->consts);
+                }
+#endif
+#if WASM_ENABLE_LAZY_LOADER != 0
+                if (module->functions[i]->prepare_error)
+                    wasm_runtime_free(module->functions[i]->prepare_error);
 #endif
 #if WASM_ENABLE_FAST_JIT != 0
                 if (module->functions[i]->fast_jit_jitted_code) {
@@ -7034,6 +7790,10 @@ wasm_loader_unload(WASMModule *module)
     }
 #endif
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+    os_mutex_destroy(&module->lazy_prepare_lock);
+#endif
+
 #if WASM_ENABLE_GC != 0
     os_mutex_destroy(&module->rtt_type_lock);
     bh_hash_map_destroy(module->ref_type_set);
@@ -7052,9 +7812,76 @@ wasm_loader_unload(WASMModule *module)
 #endif
 #endif
 
+#if WASM_ENABLE_STREAMING_LOADER != 0
+    if (module->stream_buf)
+        wasm_runtime_free(module->stream_buf);
+#endif
+
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    if (module->image_addr)
+        wasm_module_image_unmap(module->image_addr, module->image_size);
+#endif
+
     wasm_runtime_free(module);
 }
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+bool
+wasm_loader_prepare_function(WASMModule *module, uint32 func_idx,
+                             char *error_buf, uint32 error_buf_size)
+{
+    WASMFunction *func;
+    char msg[128];
+    const char *reason;
+    bool ret;
+
+    bh_assert(func_idx < module->function_count);
+    func = module->functions[func_idx];
+
+    if (BH_ATOMIC_32_LOAD(func->is_prepared))
+        return true;
+
+    os_mutex_lock(&module->lazy_prepare_lock);
+
+    /* it may be prepared by another thread meanwhile */
+    if (BH_ATOMIC_32_LOAD(func->is_prepared)) {
+        ret = true;
+    }
+    else if (func->prepare_error) {
+        snprintf(error_buf, error_buf_size, "%s", func->prepare_error);
+        ret = false;
+    }
+    else if (wasm_loader_prepare_bytecode(module, func, func_idx, msg,
+                                          sizeof(msg))) {
+        BH_ATOMIC_32_STORE(func->is_prepared, 1);
+        ret = true;
+    }
+    else {
+#if WASM_ENABLE_FAST_INTERP != 0
+        if (func->code_compiled) {
+            wasm_runtime_free(func->code_compiled);
+            func->code_compiled = NULL;
+        }
+        if (func->consts) {
+            wasm_runtime_free(func->consts);
+            func->consts = NULL;
+        }
+#endif
+        /* it is raised as an exception rather than a load failure */
+        reason = strstr(msg, "load failed: ");
+        reason = reason ? reason + strlen("load failed: ") : msg;
+        snprintf(error_buf, error_buf_size, "invalid function %u: %s",
+                 module->import_function_count + func_idx, reason);
+        /* remember the error, the function isn't prepared again */
+        func->prepare_error = bh_strdup(error_buf);
+        ret = false;
+    }
+
+    os_mutex_unlock(&module->lazy_prepare_lock);
+    return ret;
+}
+#endif /* end of WASM_ENABLE_LAZY_LOADER != 0 */
+
 bool
 wasm_loader_find_block_addr(WASMExecEnv *exec_env, BlockAddr *block_addr_cache,
                             const uint8 *start_addr, const uint8 *code_end_addr,
@@ -8027,6 +8854,15 @@ typedef struct WASMLoaderContext {
      * than the final code_compiled_size, we record the peak size to ensure
      * there will not be invalid memory access during second traverse */
     uint32 code_compiled_peak_size;
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    /* the offsets of the addresses emitted in the second traverse */
+    bool record_code_relocs;
+    bool code_relocs_failed;
+    uint8 *code_compiled_base;
+    uint32 *code_relocs;
+    uint32 code_reloc_count;
+    uint32 code_reloc_max_count;
+#endif
 #endif
 } WASMLoaderContext;
 
@@ -8253,6 +9089,10 @@ wasm_loader_ctx_destroy(WASMLoaderContext *ctx)
             wasm_runtime_free(ctx->i32_consts);
         if (ctx->v128_consts)
             wasm_runtime_free(ctx->v128_consts);
+#if WASM_ENABLE_MODULE_IMAGE != 0
+        if (ctx->code_relocs)
+            wasm_runtime_free(ctx->code_relocs);
+#endif
 #endif
         wasm_runtime_free(ctx);
     }
@@ -8874,6 +9714,7 @@ fail:
     do {                                                             \
         uint32 label_addr = (uint32)(uintptr_t)handle_table[opcode]; \
         /* emit uint32 label address in 32-bit target */             \
+        wasm_loader_record_code_reloc(loader_ctx);                   \
         wasm_loader_emit_uint32(loader_ctx, label_addr);             \
         LOG_OP("\nemit_op [%02x]\t", opcode);                        \
     } while (0)
@@ -9008,6 +9849,9 @@ wasm_loader_ctx_reinit(WASMLoaderContext *ctx)
         return false;
     ctx->p_code_compiled_end =
         ctx->p_code_compiled + ctx->code_compiled_peak_size;
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    ctx->code_compiled_base = ctx->p_code_compiled;
+#endif
 
     /* clean up frame ref */
     memset(ctx->frame_ref_bottom, 0, ctx->frame_ref_size);
@@ -9126,6 +9970,39 @@ wasm_loader_emit_uint8(WASMLoaderContext *ctx, uint8 value)
     }
 }
 
+/* Record the offset of an address to be emitted, which is relocated when
+   the module image is mapped elsewhere */
+static void
+wasm_loader_record_code_reloc(WASMLoaderContext *ctx)
+{
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    uint32 *code_relocs;
+    uint32 max_count;
+
+    if (!ctx->record_code_relocs || !ctx->p_code_compiled)
+        return;
+
+    if (ctx->code_reloc_count >= ctx->code_reloc_max_count) {
+        max_count = ctx->code_reloc_max_count > 0
+                        ? ctx->code_reloc_max_count * 2
+                        : 16;
+        if (!(code_relocs = wasm_runtime_realloc(
+                  ctx->code_relocs, sizeof(uint32) * max_count))) {
+            /* don't write the module image */
+            ctx->record_code_relocs = false;
+            ctx->code_relocs_failed = true;
+            return;
+        }
+        ctx->code_relocs = code_relocs;
+        ctx->code_reloc_max_count = max_count;
+    }
+    ctx->code_relocs[ctx->code_reloc_count++] =
+        (uint32)(ctx->p_code_compiled - ctx->code_compiled_base);
+#else
+    (void)ctx;
+#endif
+}
+
 static void
 wasm_loader_emit_ptr(WASMLoaderContext *ctx, void *value)
 {
@@ -9133,6 +10010,7 @@ wasm_loader_emit_ptr(WASMLoaderContext *ctx, void *value)
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0
         bh_assert(((uintptr_t)ctx->p_code_compiled & 1) == 0);
 #endif
+        wasm_loader_record_code_reloc(ctx);
         STORE_PTR(ctx->p_code_compiled, value);
         ctx->p_code_compiled += sizeof(void *);
     }
@@ -9154,6 +10032,14 @@ wasm_loader_emit_backspace(WASMLoaderContext *ctx, uint32 size)
             ctx->p_code_compiled--;
             bh_assert(((uintptr_t)ctx->p_code_compiled & 1) == 0);
         }
+#endif
+#if WASM_ENABLE_MODULE_IMAGE != 0
+        /* drop the addresses overwritten */
+        while (ctx->code_reloc_count > 0
+               && ctx->code_relocs[ctx->code_reloc_count - 1]
+                      >= (uint32)(ctx->p_code_compiled
+                                  - ctx->code_compiled_base))
+            ctx->code_reloc_count--;
 #endif
     }
     else {
@@ -11255,6 +12141,10 @@ wasm_loader_prepare_bytecode(WASMModule *module, WASMFunction *func,
     bool disable_emit, preserve_local = false, if_condition_available = true;
     float32 f32_const;
     float64 f64_const;
+#if WASM_ENABLE_FUEL != 0
+    /* the opcodes prepared since the last fuel charge */
+    uint32 fuel_cost;
+#endif
     /*
      * It means that the fast interpreter detected an exception while preparing,
      * typically near the block opcode, but it did not immediately trigger
@@ -11297,6 +12187,9 @@ wasm_loader_prepare_bytecode(WASMModule *module, WASMFunction *func,
     if (!(loader_ctx = wasm_loader_ctx_init(func, error_buf, error_buf_size))) {
         goto fail;
     }
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    loader_ctx->record_code_relocs = module->record_code_relocs;
+#endif
 #if WASM_ENABLE_GC != 0
     loader_ctx->module = module;
     loader_ctx->ref_type_set = module->ref_type_set;
@@ -11315,6 +12208,9 @@ wasm_loader_prepare_bytecode(WASMModule *module, WASMFunction *func,
     loader_ctx->preserved_local_offset = INT16_MAX;
 
 re_scan:
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL != 0
+    fuel_cost = 0;
+#endif
     if (loader_ctx->code_compiled_size > 0) {
         if (!wasm_loader_ctx_reinit(loader_ctx)) {
             set_error_buf(error_buf, error_buf_size, "allocate memory failed");
@@ -11423,9 +12319,27 @@ re_scan:
 
     PUSH_CSP(LABEL_TYPE_FUNCTION, func_block_type, p);
 
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL != 0
+    emit_label(EXT_OP_FUEL_CHECK);
+#endif
+
     while (p < p_end) {
         opcode = *p++;
 #if WASM_ENABLE_FAST_INTERP != 0
+#if WASM_ENABLE_FUEL != 0
+        /* Charge the basic block before the opcode which ends it, so a
+           branch to the end of a block lands after the charge. A virtual
+           else re-reads the end opcode, which is then charged on the else
+           path only, and each path pays for the end once. */
+        if (WASM_FUEL_IS_CHARGED(opcode)) {
+            fuel_cost++;
+            if (WASM_FUEL_IS_BLOCK_END(opcode)) {
+                emit_label(EXT_OP_FUEL_CHARGE);
+                emit_uint32(loader_ctx, fuel_cost);
+                fuel_cost = 0;
+            }
+        }
+#endif
         p_org = p;
         disable_emit = false;
         emit_label(opcode);
@@ -11692,6 +12606,10 @@ re_scan:
                     if (opcode == WASM_OP_LOOP) {
                         (loader_ctx->frame_csp - 1)->code_compiled =
                             loader_ctx->p_code_compiled;
+#if WASM_ENABLE_FUEL != 0
+                        /* check the fuel on each iteration */
+                        emit_label(EXT_OP_FUEL_CHECK);
+#endif
                     }
                 }
 #if WASM_ENABLE_EXCE_HANDLING != 0
@@ -12272,8 +13190,14 @@ re_scan:
                                 br_table_cache->br_depths[j] = p_depth_begin[j];
                             }
                             br_table_cache->br_depths[i] = depth;
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+                            lock_module();
+#endif
                             bh_list_insert(module->br_table_cache_list,
                                            br_table_cache);
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+                            unlock_module();
+#endif
                         }
                         else {
                             /* The depth can be stored in one byte, use the
@@ -16510,6 +17434,18 @@ re_scan:
     func->max_stack_cell_num = loader_ctx->max_stack_cell_num;
 #endif
     func->max_block_num = loader_ctx->max_csp_num;
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    if (loader_ctx->code_relocs_failed) {
+        module->record_code_relocs = false;
+    }
+    else if (loader_ctx->record_code_relocs) {
+        if (func->code_relocs)
+            wasm_runtime_free(func->code_relocs);
+        func->code_relocs = loader_ctx->code_relocs;
+        func->code_reloc_count = loader_ctx->code_reloc_count;
+        loader_ctx->code_relocs = NULL;
+    }
+#endif
     return_value = true;
 
 fail:
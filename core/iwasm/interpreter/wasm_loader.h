@@ -73,6 +73,91 @@ wasm_loader_find_block_addr(WASMExecEnv *exec_env, BlockAddr *block_addr_cache,
                             uint8 block_type, uint8 **p_else_addr,
                             uint8 **p_end_addr);
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+/**
+ * Prepare the body of a function if it hasn't been prepared, it is called
+ * when the function is called the first time.
+ *
+ * @param module the module of the function
+ * @param func_idx the index of the function, excluding the imports
+ * @param error_buf output of the exception info
+ * @param error_buf_size the size of the exception string
+ *
+ * @return true if success, false if the function is invalid
+ */
+bool
+wasm_loader_prepare_function(WASMModule *module, uint32 func_idx,
+                             char *error_buf, uint32 error_buf_size);
+#endif
+
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+/**
+ * Create the helper threads which prepare the function bodies of the
+ * modules loaded later with the loading thread.
+ *
+ * @param num the number of the helper threads
+ *
+ * @return true if success, false otherwise
+ */
+bool
+wasm_loader_init_helper_threads(uint32 num);
+
+/**
+ * Stop and destroy the loader helper threads.
+ */
+void
+wasm_loader_destroy_helper_threads(void);
+#endif
+
+#if WASM_ENABLE_STREAMING_LOADER != 0
+typedef struct WASMModuleStream WASMModuleStream;
+
+/**
+ * Begin to load a WASM module from a binary which arrives in pieces.
+ *
+ * @param total_size the size of the binary, 0 if it isn't known, then the
+ *        module is only loaded when the stream finishes
+ * @param args the load arguments
+ * @param error_buf output of the exception info
+ * @param error_buf_size the size of the exception string
+ *
+ * @return the stream created, NULL if failed
+ */
+WASMModuleStream *
+wasm_loader_stream_begin(uint32 total_size, const LoadArgs *args,
+                         char *error_buf, uint32 error_buf_size);
+
+/**
+ * Append a piece of the binary to the stream, and load the sections which
+ * are complete.
+ *
+ * @return true if success, false if the binary is invalid, and then the
+ *         stream must be aborted
+ */
+bool
+wasm_loader_stream_feed(WASMModuleStream *stream, const uint8 *buf,
+                        uint32 size, char *error_buf, uint32 error_buf_size);
+
+/**
+ * Finish loading the module after the whole binary is fed, the stream is
+ * destroyed whether it succeeds or not.
+ *
+ * @return the module loaded, NULL if failed
+ */
+WASMModule *
+wasm_loader_stream_finish(WASMModuleStream *stream,
+#if WASM_ENABLE_MULTI_MODULE != 0
+                          bool main_module,
+#endif
+                          char *error_buf, uint32 error_buf_size);
+
+/**
+ * Destroy a stream and the module partially loaded.
+ */
+void
+wasm_loader_stream_abort(WASMModuleStream *stream);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -656,6 +656,12 @@ load_function_import(const uint8 **p_buf, const uint8 *buf_end,
     function->signature = linked_signature;
     function->attachment = linked_attachment;
     function->call_conv_raw = linked_call_conv_raw;
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+    if (linked_func && !linked_call_conv_raw)
+        function->quick_native_entry = wasm_native_lookup_quick_native_entry(
+            declare_func_type, linked_signature,
+            &function->quick_native_ptr_args);
+#endif
     return true;
 }
 
@@ -6209,6 +6215,10 @@ wasm_loader_prepare_bytecode(WASMModule *module, WASMFunction *func,
     bool disable_emit, preserve_local = false, if_condition_available = true;
     float32 f32_const;
     float64 f64_const;
+#if WASM_ENABLE_FUEL != 0
+    /* the opcodes prepared since the last fuel charge */
+    uint32 fuel_cost;
+#endif
 
     LOG_OP("\nProcessing func | [%d] params | [%d] locals | [%d] return\n",
            func->param_cell_num, func->local_cell_num, func->ret_cell_num);
@@ -6249,6 +6259,9 @@ wasm_loader_prepare_bytecode(WASMModule *module, WASMFunction *func,
     loader_ctx->preserved_local_offset = INT16_MAX;
 
 re_scan:
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL != 0
+    fuel_cost = 0;
+#endif
     if (loader_ctx->code_compiled_size > 0) {
         if (!wasm_loader_ctx_reinit(loader_ctx)) {
             set_error_buf(error_buf, error_buf_size, "allocate memory failed");
@@ -6324,9 +6337,27 @@ re_scan:
 
     PUSH_CSP(LABEL_TYPE_FUNCTION, func_block_type, p);
 
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL != 0
+    emit_label(EXT_OP_FUEL_CHECK);
+#endif
+
     while (p < p_end) {
         opcode = *p++;
 #if WASM_ENABLE_FAST_INTERP != 0
+#if WASM_ENABLE_FUEL != 0
+        /* Charge the basic block before the opcode which ends it, so a
+           branch to the end of a block lands after the charge. A virtual
+           else re-reads the end opcode, which is then charged on the else
+           path only, and each path pays for the end once. */
+        if (WASM_FUEL_IS_CHARGED(opcode)) {
+            fuel_cost++;
+            if (WASM_FUEL_IS_BLOCK_END(opcode)) {
+                emit_label(EXT_OP_FUEL_CHARGE);
+                emit_uint32(loader_ctx, fuel_cost);
+                fuel_cost = 0;
+            }
+        }
+#endif
         p_org = p;
         disable_emit = false;
         emit_label(opcode);
@@ -6483,6 +6514,10 @@ re_scan:
                     if (opcode == WASM_OP_LOOP) {
                         (loader_ctx->frame_csp - 1)->code_compiled =
                             loader_ctx->p_code_compiled;
+#if WASM_ENABLE_FUEL != 0
+                        /* check the fuel on each iteration */
+                        emit_label(EXT_OP_FUEL_CHECK);
+#endif
                     }
                 }
                 else if (opcode == WASM_OP_IF) {
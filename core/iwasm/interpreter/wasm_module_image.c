@@ -0,0 +1,640 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_module_image.h"
+#include "wasm_opcode.h"
+#include "bh_log.h"
+#include "../../version.h"
+
+#if WASM_ENABLE_MODULE_IMAGE != 0
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * The image of a module holds the function bodies rewritten by the fast
+ * interpreter loader, their consts and the fields the loader sets when it
+ * prepares them. The rewritten code refers to the interpreter handlers and
+ * to the branch targets in it by address, the image is written for a
+ * preferred address and the slots of the addresses are listed, so that it
+ * is only relocated, i.e. copied on write, if it is mapped elsewhere or the
+ * interpreter is at another address.
+ *
+ * Layout: header, functions, code relocations, label relocations, and the
+ * consts and the code of each function.
+ *
+ * The code of the image is run as it is, only the layout of the tables is
+ * checked, so the image is bound to the SHA-256 of the binary and only
+ * mapped if it is owned by the user of the process and not writable by
+ * the others.
+ */
+
+#define MODULE_IMAGE_MAGIC 0x494D4157 /* "WAMI" */
+#define MODULE_IMAGE_VERSION 2
+
+#define MODULE_IMAGE_FLAG_MEMORY_GROW 1
+
+typedef struct ModuleImageHeader {
+    uint32 magic;
+    uint32 version;
+    /* Hash of the runtime version, features and interpreter layout */
+    uint64 feature_hash;
+    uint8 binary_hash[MODULE_IMAGE_HASH_SIZE];
+    uint32 binary_size;
+    uint32 image_size;
+    /* The address the image is written for */
+    uint64 base_addr;
+    /* The address of the first interpreter handler when it is written */
+    uint64 label_base;
+    uint32 function_count;
+    /* The slots of the addresses in the code of a function */
+    uint32 code_reloc_count;
+    /* The slots of the addresses of the interpreter handlers */
+    uint32 label_reloc_count;
+    uint32 flags;
+} ModuleImageHeader;
+
+typedef struct ModuleImageFunc {
+    uint32 code_offset;
+    uint32 code_size;
+    uint32 consts_offset;
+    uint32 const_cell_num;
+    uint32 max_stack_cell_num;
+    uint32 max_block_num;
+} ModuleImageFunc;
+
+enum { SLOT_NONE, SLOT_CODE, SLOT_LABEL, SLOT_INVALID };
+
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+void **
+wasm_interp_get_handle_table(void);
+#endif
+
+static const uint32 sha256_k[64] = {
+    0x428A2F98, 0x71374491, 0xB5C0FBCF, 0xE9B5DBA5, 0x3956C25B, 0x59F111F1,
+    0x923F82A4, 0xAB1C5ED5, 0xD807AA98, 0x12835B01, 0x243185BE, 0x550C7DC3,
+    0x72BE5D74, 0x80DEB1FE, 0x9BDC06A7, 0xC19BF174, 0xE49B69C1, 0xEFBE4786,
+    0x0FC19DC6, 0x240CA1CC, 0x2DE92C6F, 0x4A7484AA, 0x5CB0A9DC, 0x76F988DA,
+    0x983E5152, 0xA831C66D, 0xB00327C8, 0xBF597FC7, 0xC6E00BF3, 0xD5A79147,
+    0x06CA6351, 0x14292967, 0x27B70A85, 0x2E1B2138, 0x4D2C6DFC, 0x53380D13,
+    0x650A7354, 0x766A0ABB, 0x81C2C92E, 0x92722C85, 0xA2BFE8A1, 0xA81A664B,
+    0xC24B8B70, 0xC76C51A3, 0xD192E819, 0xD6990624, 0xF40E3585, 0x106AA070,
+    0x19A4C116, 0x1E376C08, 0x2748774C, 0x34B0BCB5, 0x391C0CB3, 0x4ED8AA4A,
+    0x5B9CCA4F, 0x682E6FF3, 0x748F82EE, 0x78A5636F, 0x84C87814, 0x8CC70208,
+    0x90BEFFFA, 0xA4506CEB, 0xBEF9A3F7, 0xC67178F2,
+};
+
+#define ROTR32(x, n) (((x) >> (n)) | ((x) << (32 - (n))))
+
+static void
+sha256_block(uint32 state[8], const uint8 *block)
+{
+    uint32 w[64], a, b, c, d, e, f, g, h, t1, t2;
+    uint32 i;
+
+    for (i = 0; i < 16; i++)
+        w[i] = ((uint32)block[i * 4] << 24) | ((uint32)block[i * 4 + 1] << 16)
+               | ((uint32)block[i * 4 + 2] << 8) | block[i * 4 + 3];
+    for (; i < 64; i++)
+        w[i] = w[i - 16]
+               + (ROTR32(w[i - 15], 7) ^ ROTR32(w[i - 15], 18)
+                  ^ (w[i - 15] >> 3))
+               + w[i - 7]
+               + (ROTR32(w[i - 2], 17) ^ ROTR32(w[i - 2], 19)
+                  ^ (w[i - 2] >> 10));
+
+    a = state[0];
+    b = state[1];
+    c = state[2];
+    d = state[3];
+    e = state[4];
+    f = state[5];
+    g = state[6];
+    h = state[7];
+
+    for (i = 0; i < 64; i++) {
+        t1 = h + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25))
+             + ((e & f) ^ (~e & g)) + sha256_k[i] + w[i];
+        t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22))
+             + ((a & b) ^ (a & c) ^ (b & c));
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+    state[5] += f;
+    state[6] += g;
+    state[7] += h;
+}
+
+void
+wasm_module_image_hash(const uint8 *buf, uint32 size,
+                       uint8 hash[MODULE_IMAGE_HASH_SIZE])
+{
+    uint32 state[8] = { 0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                        0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19 };
+    uint8 block[128] = { 0 };
+    uint64 bit_size = (uint64)size * 8;
+    uint32 i, rest = size % 64, tail_size;
+
+    for (i = 0; i + 64 <= size; i += 64)
+        sha256_block(state, buf + i);
+
+    /* the rest of the binary, the bit 1, the zeros and the bit size, in
+       one or two blocks */
+    bh_memcpy_s(block, sizeof(block), buf + i, rest);
+    block[rest] = 0x80;
+    tail_size = rest < 56 ? 64 : 128;
+    for (i = 0; i < 8; i++)
+        block[tail_size - 1 - i] = (uint8)(bit_size >> (i * 8));
+    sha256_block(state, block);
+    if (tail_size == 128)
+        sha256_block(state, block + 64);
+
+    for (i = 0; i < 8; i++) {
+        hash[i * 4] = (uint8)(state[i] >> 24);
+        hash[i * 4 + 1] = (uint8)(state[i] >> 16);
+        hash[i * 4 + 2] = (uint8)(state[i] >> 8);
+        hash[i * 4 + 3] = (uint8)state[i];
+    }
+}
+
+/* A fast hash of the features of the runtime, which isn't trusted */
+static uint64
+hash_bytes(uint64 hash, const uint8 *buf, uint32 size)
+{
+    uint64 word;
+    uint32 i;
+
+    for (i = 0; i + sizeof(uint64) <= size; i += sizeof(uint64)) {
+        bh_memcpy_s(&word, sizeof(uint64), buf + i, sizeof(uint64));
+        hash = (hash ^ word) * 0x100000001B3ULL;
+        hash ^= hash >> 29;
+    }
+    for (; i < size; i++)
+        hash = (hash ^ buf[i]) * 0x100000001B3ULL;
+    return hash;
+}
+
+static uint64
+get_feature_hash(void)
+{
+    uint32 features[] = {
+        MODULE_IMAGE_VERSION,
+        WAMR_VERSION_MAJOR,
+        WAMR_VERSION_MINOR,
+        WAMR_VERSION_PATCH,
+        (uint32)sizeof(void *),
+        WASM_ENABLE_LABELS_AS_VALUES,
+        WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS,
+        WASM_ENABLE_SIMD,
+        WASM_ENABLE_SIMDE,
+        WASM_ENABLE_REF_TYPES,
+        WASM_ENABLE_BULK_MEMORY,
+        WASM_ENABLE_MEMORY64,
+        WASM_ENABLE_MULTI_MEMORY,
+        WASM_ENABLE_TAIL_CALL,
+        WASM_ENABLE_SHARED_MEMORY,
+        WASM_ENABLE_EXCE_HANDLING,
+        WASM_ENABLE_TAGS,
+        WASM_ENABLE_MULTI_MODULE,
+        WASM_ENABLE_THREAD_MGR,
+    };
+    uint64 hash = hash_bytes(0xCBF29CE484222325ULL, (uint8 *)features,
+                             sizeof(features));
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+    void **handle_table = wasm_interp_get_handle_table();
+    uint64 offset;
+    uint32 i;
+
+    /* the labels are relocated by the same delta, which requires the same
+       interpreter build */
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++) {
+        /* the opcodes not used */
+        if (!handle_table[i])
+            continue;
+        offset = (uint64)((uint8 *)handle_table[i] - (uint8 *)handle_table[0]);
+        hash = hash_bytes(hash, (uint8 *)&offset, sizeof(uint64));
+    }
+#endif
+    return hash;
+}
+
+static uint64
+get_label_base(void)
+{
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+    return (uint64)(uintptr_t)wasm_interp_get_handle_table()[0];
+#else
+    return 0;
+#endif
+}
+
+static uintptr_t
+get_base_addr(const uint8 *binary_hash)
+{
+#if UINTPTR_MAX == UINT64_MAX
+    /* spread the images of different binaries, so that they are likely
+       mapped at their preferred addresses in the same process */
+    uint64 slot = ((uint64)binary_hash[0] << 4) | (binary_hash[1] >> 4);
+
+    return (uintptr_t)(0x100000000000ULL + (slot << 32));
+#else
+    (void)binary_hash;
+    return 0;
+#endif
+}
+
+static uintptr_t
+read_slot(const uint8 *p)
+{
+    uintptr_t value;
+    bh_memcpy_s(&value, sizeof(uintptr_t), p, sizeof(uintptr_t));
+    return value;
+}
+
+static void
+write_slot(uint8 *p, uintptr_t value)
+{
+    bh_memcpy_s(p, sizeof(uintptr_t), &value, sizeof(uintptr_t));
+}
+
+static bool
+relocate(uint8 *addr, const ModuleImageHeader *header, uintptr_t code_delta,
+         uintptr_t label_delta)
+{
+    const uint32 *code_relocs =
+        (const uint32 *)(addr + sizeof(ModuleImageHeader)
+                         + sizeof(ModuleImageFunc) * header->function_count);
+    const uint32 *label_relocs = code_relocs + header->code_reloc_count;
+    uint32 i;
+
+    if (mprotect(addr, header->image_size, PROT_READ | PROT_WRITE) != 0)
+        return false;
+
+    if (code_delta) {
+        for (i = 0; i < header->code_reloc_count; i++)
+            write_slot(addr + code_relocs[i],
+                       read_slot(addr + code_relocs[i]) + code_delta);
+    }
+    if (label_delta) {
+        for (i = 0; i < header->label_reloc_count; i++)
+            write_slot(addr + label_relocs[i],
+                       read_slot(addr + label_relocs[i]) + label_delta);
+    }
+
+    return mprotect(addr, header->image_size, PROT_READ) == 0;
+}
+
+static bool
+check_header(const ModuleImageHeader *header, const uint8 *binary_hash,
+             uint32 binary_size, uint32 file_size)
+{
+    const uint32 *relocs;
+    uint64 tables_size;
+    uint32 i, reloc_count;
+
+    if (header->magic != MODULE_IMAGE_MAGIC
+        || header->version != MODULE_IMAGE_VERSION
+        || header->feature_hash != get_feature_hash()
+        || memcmp(header->binary_hash, binary_hash, MODULE_IMAGE_HASH_SIZE)
+        || header->binary_size != binary_size
+        || header->image_size != file_size)
+        return false;
+
+    reloc_count = header->code_reloc_count + header->label_reloc_count;
+    tables_size = sizeof(ModuleImageHeader)
+                  + (uint64)sizeof(ModuleImageFunc) * header->function_count
+                  + (uint64)sizeof(uint32) * reloc_count;
+    if (tables_size > file_size
+        || reloc_count < header->code_reloc_count /* overflow */)
+        return false;
+
+    relocs = (const uint32 *)((const uint8 *)header + tables_size
+                              - sizeof(uint32) * reloc_count);
+    for (i = 0; i < reloc_count; i++) {
+        if (relocs[i] < tables_size
+            || (uint64)relocs[i] + sizeof(uintptr_t) > file_size)
+            return false;
+    }
+    return true;
+}
+
+bool
+wasm_module_image_map(const char *path, const uint8 *binary_hash,
+                      uint32 binary_size, uint8 **p_addr, uint32 *p_size)
+{
+    ModuleImageHeader *header;
+    uintptr_t base_addr = get_base_addr(binary_hash);
+    struct stat st;
+    uint8 *addr;
+    uint32 size;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return false;
+
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(ModuleImageHeader)
+        || st.st_size > UINT32_MAX) {
+        close(fd);
+        return false;
+    }
+
+    /* the others could replace the code that is run */
+    if (st.st_uid != geteuid() || (st.st_mode & (S_IWGRP | S_IWOTH))) {
+        LOG_WARNING("warning: module image %s isn't used, as it isn't owned "
+                    "by the user or is writable by the others",
+                    path);
+        close(fd);
+        return false;
+    }
+    size = (uint32)st.st_size;
+
+    addr = mmap((void *)base_addr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return false;
+
+    header = (ModuleImageHeader *)addr;
+    if (!check_header(header, binary_hash, binary_size, size)) {
+        LOG_VERBOSE("Module image %s doesn't match the binary or the runtime",
+                    path);
+        munmap(addr, size);
+        return false;
+    }
+
+    if (((uintptr_t)addr != header->base_addr
+         || get_label_base() != header->label_base)
+        && !relocate(addr, header, (uintptr_t)addr - (uintptr_t)header->base_addr,
+                     (uintptr_t)(get_label_base() - header->label_base))) {
+        munmap(addr, size);
+        return false;
+    }
+
+    *p_addr = addr;
+    *p_size = size;
+    return true;
+}
+
+void
+wasm_module_image_unmap(uint8 *addr, uint32 size)
+{
+    munmap(addr, size);
+}
+
+bool
+wasm_module_image_apply(WASMModule *module, const uint8 *addr, uint32 size,
+                        char *error_buf, uint32 error_buf_size)
+{
+    const ModuleImageHeader *header = (const ModuleImageHeader *)addr;
+    const ModuleImageFunc *image_funcs =
+        (const ModuleImageFunc *)(addr + sizeof(ModuleImageHeader));
+    WASMFunction *func;
+    uint32 i;
+
+    if (header->function_count != module->function_count) {
+        snprintf(error_buf, error_buf_size, "module image mismatch");
+        return false;
+    }
+
+    for (i = 0; i < module->function_count; i++) {
+        if ((uint64)image_funcs[i].code_offset + image_funcs[i].code_size
+                > size
+            || (uint64)image_funcs[i].consts_offset
+                       + sizeof(uint32) * (uint64)image_funcs[i].const_cell_num
+                   > size) {
+            snprintf(error_buf, error_buf_size, "module image mismatch");
+            return false;
+        }
+    }
+
+    for (i = 0; i < module->function_count; i++) {
+        func = module->functions[i];
+        func->code_compiled = (uint8 *)addr + image_funcs[i].code_offset;
+        func->code_compiled_size = image_funcs[i].code_size;
+        func->const_cell_num = image_funcs[i].const_cell_num;
+        func->consts = func->const_cell_num > 0
+                           ? (uint8 *)addr + image_funcs[i].consts_offset
+                           : NULL;
+        func->max_stack_cell_num = image_funcs[i].max_stack_cell_num;
+        func->max_block_num = image_funcs[i].max_block_num;
+    }
+
+    if (header->flags & MODULE_IMAGE_FLAG_MEMORY_GROW)
+        module->possible_memory_grow = true;
+    return true;
+}
+
+/* Tell what a recorded slot of the code of a function holds */
+static int
+get_slot_kind(const WASMFunction *func, uint32 offset, uintptr_t label_min,
+              uintptr_t label_max)
+{
+    uintptr_t value = read_slot(func->code_compiled + offset);
+
+    if (!value)
+        /* e.g. the label of an unreachable branch isn't patched */
+        return SLOT_NONE;
+    if (value >= (uintptr_t)func->code_compiled
+        && value <= (uintptr_t)func->code_compiled + func->code_compiled_size)
+        return SLOT_CODE;
+    if (value >= label_min && value <= label_max)
+        return SLOT_LABEL;
+    return SLOT_INVALID;
+}
+
+static bool
+write_file(const char *path, const uint8 *buf, uint32 size)
+{
+    char tmp_path[512];
+    FILE *file;
+    bool ret;
+    int fd;
+
+    /* write a temporary file and rename it, so that the processes which
+       load the module meanwhile never see a partial image */
+    if (snprintf(tmp_path, sizeof(tmp_path), "%s.%d.tmp", path, (int)getpid())
+        >= (int)sizeof(tmp_path))
+        return false;
+
+    /* a new file which only the user may write, see
+       wasm_module_image_map */
+    unlink(tmp_path);
+    if ((fd = open(tmp_path, O_WRONLY | O_CREAT | O_EXCL, 0644)) < 0)
+        return false;
+    if (!(file = fdopen(fd, "wb"))) {
+        close(fd);
+        unlink(tmp_path);
+        return false;
+    }
+
+    ret = fwrite(buf, 1, size, file) == size;
+    ret = fclose(file) == 0 && ret;
+    if (!ret || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        return false;
+    }
+    return true;
+}
+
+bool
+wasm_module_image_write(WASMModule *module, const char *path,
+                        const uint8 *binary_hash, uint32 binary_size)
+{
+    ModuleImageHeader *header;
+    ModuleImageFunc *image_funcs;
+    uint32 *code_relocs, *label_relocs;
+    uintptr_t base_addr = get_base_addr(binary_hash);
+    uintptr_t label_min = UINTPTR_MAX, label_max = 0, value;
+    uint32 code_reloc_count = 0, label_reloc_count = 0;
+    uint32 i, j, offset, slot;
+    uint64 image_size;
+    WASMFunction *func;
+    uint8 *buf;
+    bool ret;
+
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+    void **handle_table = wasm_interp_get_handle_table();
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++) {
+        if (!handle_table[i])
+            continue;
+        label_min = label_min < (uintptr_t)handle_table[i]
+                        ? label_min
+                        : (uintptr_t)handle_table[i];
+        label_max = label_max > (uintptr_t)handle_table[i]
+                        ? label_max
+                        : (uintptr_t)handle_table[i];
+    }
+#endif
+
+    /* classify the slots to lay out the tables */
+    for (i = 0; i < module->function_count; i++) {
+        func = module->functions[i];
+        for (j = 0; j < func->code_reloc_count; j++) {
+            switch (get_slot_kind(func, func->code_relocs[j], label_min,
+                                  label_max)) {
+                case SLOT_CODE:
+                    code_reloc_count++;
+                    break;
+                case SLOT_LABEL:
+                    label_reloc_count++;
+                    break;
+                case SLOT_INVALID:
+                    LOG_WARNING("warning: can't write module image, unknown "
+                                "address in function %u",
+                                i);
+                    return false;
+                default:
+                    break;
+            }
+        }
+    }
+
+    image_size = sizeof(ModuleImageHeader)
+                 + (uint64)sizeof(ModuleImageFunc) * module->function_count
+                 + (uint64)sizeof(uint32)
+                       * (code_reloc_count + (uint64)label_reloc_count);
+    for (i = 0; i < module->function_count; i++) {
+        func = module->functions[i];
+        image_size = align_uint64(image_size, 16)
+                     + (uint64)sizeof(uint32) * func->const_cell_num;
+        image_size = align_uint64(image_size, 16) + func->code_compiled_size;
+    }
+    if (image_size > UINT32_MAX
+        || !(buf = wasm_runtime_malloc((uint32)image_size))) {
+        LOG_WARNING("warning: can't write module image, allocate memory "
+                    "failed");
+        return false;
+    }
+    memset(buf, 0, (uint32)image_size);
+
+    header = (ModuleImageHeader *)buf;
+    header->magic = MODULE_IMAGE_MAGIC;
+    header->version = MODULE_IMAGE_VERSION;
+    header->feature_hash = get_feature_hash();
+    bh_memcpy_s(header->binary_hash, MODULE_IMAGE_HASH_SIZE, binary_hash,
+                MODULE_IMAGE_HASH_SIZE);
+    header->binary_size = binary_size;
+    header->image_size = (uint32)image_size;
+    header->base_addr = base_addr;
+    header->label_base = get_label_base();
+    header->function_count = module->function_count;
+    header->code_reloc_count = code_reloc_count;
+    header->label_reloc_count = label_reloc_count;
+    header->flags =
+        module->possible_memory_grow ? MODULE_IMAGE_FLAG_MEMORY_GROW : 0;
+
+    image_funcs = (ModuleImageFunc *)(buf + sizeof(ModuleImageHeader));
+    code_relocs = (uint32 *)(image_funcs + module->function_count);
+    label_relocs = code_relocs + code_reloc_count;
+    offset = (uint32)((uint8 *)(label_relocs + label_reloc_count) - buf);
+
+    for (i = 0; i < module->function_count; i++) {
+        func = module->functions[i];
+
+        offset = (uint32)align_uint(offset, 16);
+        image_funcs[i].consts_offset = offset;
+        image_funcs[i].const_cell_num = func->const_cell_num;
+        if (func->const_cell_num > 0)
+            bh_memcpy_s(buf + offset, (uint32)image_size - offset,
+                        func->consts, sizeof(uint32) * func->const_cell_num);
+        offset += sizeof(uint32) * func->const_cell_num;
+
+        offset = (uint32)align_uint(offset, 16);
+        image_funcs[i].code_offset = offset;
+        image_funcs[i].code_size = func->code_compiled_size;
+        image_funcs[i].max_stack_cell_num = func->max_stack_cell_num;
+        image_funcs[i].max_block_num = func->max_block_num;
+        bh_memcpy_s(buf + offset, (uint32)image_size - offset,
+                    func->code_compiled, func->code_compiled_size);
+
+        for (j = 0; j < func->code_reloc_count; j++) {
+            slot = offset + func->code_relocs[j];
+            switch (get_slot_kind(func, func->code_relocs[j], label_min,
+                                  label_max)) {
+                case SLOT_CODE:
+                    value = read_slot(buf + slot);
+                    write_slot(buf + slot, base_addr + offset
+                                               + (value
+                                                  - (uintptr_t)
+                                                        func->code_compiled));
+                    *code_relocs++ = slot;
+                    break;
+                case SLOT_LABEL:
+                    *label_relocs++ = slot;
+                    break;
+                default:
+                    break;
+            }
+        }
+        offset += func->code_compiled_size;
+    }
+    bh_assert(offset == image_size);
+
+    ret = write_file(path, buf, (uint32)image_size);
+    if (!ret)
+        LOG_WARNING("warning: can't write module image %s, because %s", path,
+                    strerror(errno));
+    else
+        LOG_VERBOSE("Write module image %s, size: %u", path,
+                    (uint32)image_size);
+
+    wasm_runtime_free(buf);
+    return ret;
+}
+
+#endif /* end of WASM_ENABLE_MODULE_IMAGE != 0 */
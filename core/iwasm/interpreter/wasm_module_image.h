@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_MODULE_IMAGE_H
+#define _WASM_MODULE_IMAGE_H
+
+#include "wasm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if WASM_ENABLE_MODULE_IMAGE != 0
+
+/* The size of the SHA-256 of a wasm binary */
+#define MODULE_IMAGE_HASH_SIZE 32
+
+/**
+ * Hash a wasm binary with SHA-256, the image of a module is only used with
+ * the binary it is written from.
+ */
+void
+wasm_module_image_hash(const uint8 *buf, uint32 size,
+                       uint8 hash[MODULE_IMAGE_HASH_SIZE]);
+
+/**
+ * Map the image of a module read-only, it is relocated if it can't be
+ * mapped at the address it is written for, or the interpreter is at
+ * another address. The image isn't used if it isn't owned by the user of
+ * the process or is writable by the others.
+ *
+ * @param path the path of the image file
+ * @param binary_hash the SHA-256 of the wasm binary
+ * @param binary_size the size of the wasm binary
+ * @param p_addr returns the address of the image
+ * @param p_size returns the size of the image
+ *
+ * @return true if success, false if there is no image matching the binary
+ *         and the runtime
+ */
+bool
+wasm_module_image_map(const char *path, const uint8 *binary_hash,
+                      uint32 binary_size, uint8 **p_addr, uint32 *p_size);
+
+void
+wasm_module_image_unmap(uint8 *addr, uint32 size);
+
+/**
+ * Set the prepared function bodies of a module from its image instead of
+ * validating and rewriting them.
+ *
+ * @return true if success, false if the image doesn't match the module
+ */
+bool
+wasm_module_image_apply(WASMModule *module, const uint8 *addr, uint32 size,
+                        char *error_buf, uint32 error_buf_size);
+
+/**
+ * Write the prepared function bodies of a module to its image, which
+ * replaces the old one atomically. The module must be loaded with the
+ * code relocations recorded.
+ *
+ * @return true if success, false otherwise
+ */
+bool
+wasm_module_image_write(WASMModule *module, const char *path,
+                        const uint8 *binary_hash, uint32 binary_size);
+
+#endif /* end of WASM_ENABLE_MODULE_IMAGE != 0 */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_MODULE_IMAGE_H */
@@ -288,6 +288,11 @@ typedef enum WASMOpcode {
     WASM_OP_SELECT_128 = 0xe2,
 #endif
 
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL != 0
+    EXT_OP_FUEL_CHARGE = 0xe3, /* charge the fuel of a basic block */
+    EXT_OP_FUEL_CHECK = 0xe4,  /* check the fuel at function or loop entry */
+#endif
+
     /* Post-MVP extend op prefix */
     WASM_OP_GC_PREFIX = 0xfb,
     WASM_OP_MISC_PREFIX = 0xfc,
@@ -810,6 +815,27 @@ typedef enum WASMAtomicEXTOpcode {
 #else
 #define DEF_EXT_V128_HANDLE()
 #endif
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL != 0
+#define DEF_FUEL_HANDLE()                                  \
+    SET_GOTO_TABLE_ELEM(EXT_OP_FUEL_CHARGE),    /* 0xe3 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_FUEL_CHECK), /* 0xe4 */
+#else
+#define DEF_FUEL_HANDLE()
+#endif
+
+#if WASM_ENABLE_FUEL != 0
+/* Each opcode but nop costs one fuel, which is charged when the basic
+   block ends at one of these opcodes, the same in all running modes */
+#define WASM_FUEL_IS_CHARGED(opcode) ((opcode) != WASM_OP_NOP)
+#define WASM_FUEL_IS_BLOCK_END(opcode)                             \
+    ((opcode) == WASM_OP_LOOP || (opcode) == WASM_OP_IF            \
+     || (opcode) == WASM_OP_ELSE || (opcode) == WASM_OP_END        \
+     || (opcode) == WASM_OP_BR || (opcode) == WASM_OP_BR_IF        \
+     || (opcode) == WASM_OP_BR_TABLE || (opcode) == WASM_OP_RETURN \
+     || (opcode) == EXT_OP_LOOP || (opcode) == EXT_OP_IF           \
+     || (opcode) == EXT_OP_BR_TABLE_CACHE)
+#endif
+
 /*
  * Macro used to generate computed goto tables for the C interpreter.
  */
@@ -1042,6 +1068,7 @@ typedef enum WASMAtomicEXTOpcode {
         SET_GOTO_TABLE_SIMD_PREFIX_ELEM()            /* 0xfd */ \
         SET_GOTO_TABLE_ELEM(WASM_OP_ATOMIC_PREFIX),  /* 0xfe */ \
         DEF_DEBUG_BREAK_HANDLE() DEF_EXT_V128_HANDLE()          \
+            DEF_FUEL_HANDLE()                                   \
     };
 
 #ifdef __cplusplus
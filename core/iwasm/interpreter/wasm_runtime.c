@@ -171,6 +171,13 @@ wasm_resolve_import_func(const WASMModule *module, WASMFunctionImport *function)
         &function->signature, &function->attachment, &function->call_conv_raw);
 
     if (function->func_ptr_linked) {
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+        if (!function->call_conv_raw)
+            function->quick_native_entry =
+                wasm_native_lookup_quick_native_entry(
+                    function->func_type, function->signature,
+                    &function->quick_native_ptr_args);
+#endif
         return true;
     }
 
@@ -2426,6 +2433,10 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
     module_inst->module = module;
     module_inst->e =
         (WASMModuleInstanceExtra *)((uint8 *)module_inst + extra_info_offset);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_init((WASMModuleInstanceCommon *)module_inst,
+                             (WASMModuleInstanceCommon *)parent);
+#endif
 
 #if WASM_ENABLE_MULTI_MODULE != 0
     module_inst->e->sub_module_inst_list =
@@ -2476,21 +2487,41 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
 #if WASM_ENABLE_GC != 0
     if (!is_sub_inst) {
         uint32 gc_heap_size = wasm_runtime_get_gc_heap_size_default();
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+        uint32 gc_heap_max_size = wasm_runtime_get_gc_heap_max_size_default();
+#endif
 
         if (gc_heap_size < GC_HEAP_SIZE_MIN)
             gc_heap_size = GC_HEAP_SIZE_MIN;
         if (gc_heap_size > GC_HEAP_SIZE_MAX)
             gc_heap_size = GC_HEAP_SIZE_MAX;
 
-        module_inst->e->common.gc_heap_pool =
-            runtime_malloc(gc_heap_size, error_buf, error_buf_size);
-        if (!module_inst->e->common.gc_heap_pool)
-            goto fail;
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+        if (gc_heap_max_size > gc_heap_size) {
+            if (gc_heap_max_size > GC_HEAP_SIZE_MAX)
+                gc_heap_max_size = GC_HEAP_SIZE_MAX;
+            /* the heap reserves its own address range, no pool is used */
+            module_inst->e->common.gc_heap_handle =
+                mem_allocator_create_growable(gc_heap_size, gc_heap_max_size);
+            if (!module_inst->e->common.gc_heap_handle) {
+                set_error_buf(error_buf, error_buf_size,
+                              "create growable gc heap failed");
+                goto fail;
+            }
+        }
+        else
+#endif
+        {
+            module_inst->e->common.gc_heap_pool =
+                runtime_malloc(gc_heap_size, error_buf, error_buf_size);
+            if (!module_inst->e->common.gc_heap_pool)
+                goto fail;
 
-        module_inst->e->common.gc_heap_handle = mem_allocator_create(
-            module_inst->e->common.gc_heap_pool, gc_heap_size);
-        if (!module_inst->e->common.gc_heap_handle)
-            goto fail;
+            module_inst->e->common.gc_heap_handle = mem_allocator_create(
+                module_inst->e->common.gc_heap_pool, gc_heap_size);
+            if (!module_inst->e->common.gc_heap_handle)
+                goto fail;
+        }
     }
 #endif
 
@@ -3606,12 +3637,52 @@ call_wasm_with_hw_bound_check(WASMModuleInstance *module_inst,
 #define interp_call_wasm wasm_interp_call_wasm
 #endif
 
+#if WASM_ENABLE_LAZY_LOADER != 0
+bool
+wasm_lazy_prepare_function(WASMModuleInstance *module_inst,
+                           WASMFunctionInstance *function)
+{
+    WASMModuleInstance *func_module_inst = module_inst;
+    WASMFunctionInstance *func_inst = function;
+    char error_buf[128];
+
+#if WASM_ENABLE_MULTI_MODULE != 0
+    if (function->is_import_func && function->import_func_inst) {
+        func_module_inst = function->import_module_inst;
+        func_inst = function->import_func_inst;
+    }
+#endif
+
+    if (!func_inst->is_import_func && !func_inst->is_prepared) {
+        if (!wasm_loader_prepare_function(
+                func_module_inst->module,
+                (uint32)(func_inst - func_module_inst->e->functions)
+                    - func_module_inst->module->import_function_count,
+                error_buf, sizeof(error_buf))) {
+            wasm_set_exception(module_inst, error_buf);
+            return false;
+        }
+#if WASM_ENABLE_FAST_INTERP != 0
+        /* the consts are unknown when the instance is created */
+        func_inst->const_cell_num = (uint16)func_inst->u.func->const_cell_num;
+#endif
+        func_inst->is_prepared = true;
+    }
+
+    function->is_prepared = true;
+    return true;
+}
+#endif /* end of WASM_ENABLE_LAZY_LOADER != 0 */
+
 bool
 wasm_call_function(WASMExecEnv *exec_env, WASMFunctionInstance *function,
                    unsigned argc, uint32 argv[])
 {
     WASMModuleInstance *module_inst =
         (WASMModuleInstance *)exec_env->module_inst;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    uint8 prev_stats_state;
+#endif
 
 #ifndef OS_ENABLE_HW_BOUND_CHECK
     /* Set thread handle and stack boundary */
@@ -3624,10 +3695,153 @@ wasm_call_function(WASMExecEnv *exec_env, WASMFunctionInstance *function,
     /* Set exec env, so it can be later retrieved from instance */
     module_inst->cur_exec_env = exec_env;
 
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    prev_stats_state =
+        wasm_instance_stats_switch(exec_env, WASM_STATS_STATE_WASM);
+#endif
     interp_call_wasm(module_inst, exec_env, function, argc, argv);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
     return !wasm_copy_exception(module_inst, NULL);
 }
 
+#if defined(OS_ENABLE_HW_BOUND_CHECK) && !defined(BH_PLATFORM_WINDOWS)
+static void
+call_wasm_batch_with_hw_bound_check(WASMModuleInstance *module_inst,
+                                    WASMExecEnv *exec_env,
+                                    WASMFunctionInstance *function,
+                                    WASMBatchCall *batch)
+{
+    WASMExecEnv *exec_env_tls = wasm_runtime_get_exec_env_tls();
+    WASMJmpBuf jmpbuf_node = { 0 }, *jmpbuf_node_pop;
+    WASMRuntimeFrame *prev_frame = wasm_exec_env_get_cur_frame(exec_env);
+    uint8 *prev_top = exec_env->wasm_stack.top;
+    /* they are changed after os_setjmp and read after os_longjmp */
+    volatile uint32 i = 0;
+    volatile bool stopped = false;
+
+    if (!exec_env_tls) {
+        if (!os_thread_signal_inited()) {
+            wasm_set_exception(module_inst, "thread signal env not inited");
+            goto fail;
+        }
+
+        /* Set thread handle and stack boundary if they haven't been set */
+        wasm_exec_env_set_thread_info(exec_env);
+
+        wasm_runtime_set_exec_env_tls(exec_env);
+    }
+    else {
+        if (exec_env_tls != exec_env) {
+            wasm_set_exception(module_inst, "invalid exec env");
+            goto fail;
+        }
+    }
+
+    if (!wasm_runtime_detect_native_stack_overflow(exec_env)) {
+        if (!exec_env->jmpbuf_stack_top)
+            wasm_runtime_set_exec_env_tls(NULL);
+        goto fail;
+    }
+
+    /* Push the jmpbuf once, it is set again only after a trap */
+    wasm_exec_env_push_jmpbuf(exec_env, &jmpbuf_node);
+
+    while (i < batch->num_calls && !stopped) {
+        if (os_setjmp(jmpbuf_node.jmpbuf) == 0) {
+            for (; i < batch->num_calls; i++) {
+                wasm_runtime_batch_call_begin(batch, i);
+                wasm_interp_call_wasm(module_inst, exec_env, function,
+                                      batch->param_cell_num, batch->argv);
+                if (!wasm_runtime_batch_call_end(
+                        (WASMModuleInstanceCommon *)module_inst, batch, i,
+                        !wasm_copy_exception(module_inst, NULL))) {
+                    stopped = true;
+                    break;
+                }
+            }
+        }
+        else {
+            /* Exception has been set in signal handler before calling
+               longjmp */
+#if WASM_ENABLE_DUMP_CALL_STACK != 0
+            if (wasm_interp_create_call_stack(exec_env)) {
+                wasm_interp_dump_call_stack(exec_env, true, NULL, 0);
+            }
+#endif
+            /* Restore operand frames */
+            wasm_exec_env_set_cur_frame(exec_env, prev_frame);
+            exec_env->wasm_stack.top = prev_top;
+            os_sigreturn();
+            os_signal_unmask();
+
+            if (!wasm_runtime_batch_call_end(
+                    (WASMModuleInstanceCommon *)module_inst, batch, i, false))
+                stopped = true;
+            i++;
+        }
+    }
+
+    jmpbuf_node_pop = wasm_exec_env_pop_jmpbuf(exec_env);
+    bh_assert(&jmpbuf_node == jmpbuf_node_pop);
+    if (!exec_env->jmpbuf_stack_top) {
+        wasm_runtime_set_exec_env_tls(NULL);
+    }
+    (void)jmpbuf_node_pop;
+    return;
+
+fail:
+    /* none of the calls is made */
+    wasm_runtime_batch_call_abort(batch, 0);
+}
+#endif /* end of defined(OS_ENABLE_HW_BOUND_CHECK) \
+          && !defined(BH_PLATFORM_WINDOWS) */
+
+void
+wasm_call_function_batch(WASMExecEnv *exec_env, WASMFunctionInstance *function,
+                         WASMBatchCall *batch)
+{
+    WASMModuleInstance *module_inst =
+        (WASMModuleInstance *)exec_env->module_inst;
+#if !defined(OS_ENABLE_HW_BOUND_CHECK) || defined(BH_PLATFORM_WINDOWS)
+    uint32 i;
+#endif
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    uint8 prev_stats_state;
+#endif
+
+#ifndef OS_ENABLE_HW_BOUND_CHECK
+    /* Set thread handle and stack boundary */
+    wasm_exec_env_set_thread_info(exec_env);
+#endif
+
+    /* Set exec env, so it can be later retrieved from instance */
+    module_inst->cur_exec_env = exec_env;
+
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    prev_stats_state =
+        wasm_instance_stats_switch(exec_env, WASM_STATS_STATE_WASM);
+#endif
+#if defined(OS_ENABLE_HW_BOUND_CHECK) && !defined(BH_PLATFORM_WINDOWS)
+    call_wasm_batch_with_hw_bound_check(module_inst, exec_env, function,
+                                        batch);
+#else
+    for (i = 0; i < batch->num_calls; i++) {
+        wasm_runtime_batch_call_begin(batch, i);
+        interp_call_wasm(module_inst, exec_env, function, batch->param_cell_num,
+                         batch->argv);
+        if (!wasm_runtime_batch_call_end(
+                (WASMModuleInstanceCommon *)module_inst, batch, i,
+                !wasm_copy_exception(module_inst, NULL)))
+            break;
+    }
+#endif
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
+}
+
 #if WASM_ENABLE_PERF_PROFILING != 0 || WASM_ENABLE_DUMP_CALL_STACK != 0
 /* look for the function name */
 static char *
@@ -3692,6 +3906,9 @@ wasm_dump_perf_profiling(const WASMModuleInstance *module_inst)
                       i, func_inst->total_exec_time / 1000.0f,
                       func_inst->total_exec_cnt,
                       func_inst->children_exec_time / 1000.0f);
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+        wasm_hw_counters_dump(func_inst->hw_counters);
+#endif
     }
 }
 
@@ -3934,17 +4151,15 @@ wasm_enlarge_table(WASMModuleInstance *module_inst, uint32 table_idx,
 }
 #endif /* end of WASM_ENABLE_REF_TYPES != 0 || WASM_ENABLE_GC != 0 */
 
-static bool
-call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 tbl_elem_idx,
-              uint32 argc, uint32 argv[], bool check_type_idx, uint32 type_idx)
+static WASMFunctionInstance *
+lookup_indirect_func(WASMModuleInstance *module_inst, uint32 tbl_idx,
+                     uint32 tbl_elem_idx, bool check_type_idx, uint32 type_idx)
 {
-    WASMModuleInstance *module_inst = NULL;
     WASMTableInstance *table_inst = NULL;
     table_elem_type_t tbl_elem_val = NULL_REF;
     uint32 func_idx = 0;
     WASMFunctionInstance *func_inst = NULL;
 
-    module_inst = (WASMModuleInstance *)exec_env->module_inst;
     bh_assert(module_inst);
 
     table_inst = module_inst->tables[tbl_idx];
@@ -3996,12 +4211,27 @@ call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 tbl_elem_idx,
         }
     }
 
+    return func_inst;
+
+got_exception:
+    return NULL;
+}
+
+static bool
+call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 tbl_elem_idx,
+              uint32 argc, uint32 argv[], bool check_type_idx, uint32 type_idx)
+{
+    WASMModuleInstance *module_inst =
+        (WASMModuleInstance *)exec_env->module_inst;
+    WASMFunctionInstance *func_inst;
+
+    if (!(func_inst = lookup_indirect_func(module_inst, tbl_idx, tbl_elem_idx,
+                                           check_type_idx, type_idx)))
+        return false;
+
     interp_call_wasm(module_inst, exec_env, func_inst, argc, argv);
 
     return !wasm_copy_exception(module_inst, NULL);
-
-got_exception:
-    return false;
 }
 
 bool
@@ -4510,11 +4740,42 @@ bool
 llvm_jit_call_indirect(WASMExecEnv *exec_env, uint32 tbl_idx, uint32 elem_idx,
                        uint32 argc, uint32 *argv)
 {
-    bool ret;
+    WASMModuleInstance *module_inst =
+        (WASMModuleInstance *)exec_env->module_inst;
+    WASMFunctionInstance *func_inst;
+    bool ret = false;
 
-    bh_assert(exec_env->module_inst->module_type == Wasm_Module_Bytecode);
+    bh_assert(module_inst->module_type == Wasm_Module_Bytecode);
+
+    /* The jitted code calls the wasm functions of the table directly, and
+       only the import functions through here */
+    if (!(func_inst = lookup_indirect_func(module_inst, tbl_idx, elem_idx,
+                                           false, 0)))
+        goto fail;
+
+    /* Call the host function like a direct call from the jitted code,
+       instead of entering the interpreter, which sets up another signal
+       handler context and an interpreter frame, and copies the arguments
+       and results into and out of it. The extra results are returned by
+       address by the native invoker, and a function of another module
+       is run in that module, leave them to the interpreter. */
+    if (func_inst->is_import_func
+#if WASM_ENABLE_MULTI_MODULE != 0
+        && !func_inst->import_func_inst
+#endif
+        && func_inst->u.func_import->func_type->result_count <= 1) {
+        return llvm_jit_invoke_native(
+            exec_env, (uint32)(func_inst - module_inst->e->functions), argc,
+            argv);
+    }
 
-    ret = call_indirect(exec_env, tbl_idx, elem_idx, argc, argv, false, 0);
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_add_jit_transition(exec_env, true, true);
+#endif
+    interp_call_wasm(module_inst, exec_env, func_inst, argc, argv);
+    ret = !wasm_copy_exception(module_inst, NULL);
+
+fail:
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     if (!ret)
         wasm_runtime_access_exce_check_guard_page();
@@ -4538,6 +4799,9 @@ llvm_jit_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
     void *attachment;
     char buf[96];
     bool ret = false;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    uint8 prev_stats_state;
+#endif
 
     bh_assert(exec_env->module_inst->module_type == Wasm_Module_Bytecode);
 
@@ -4571,11 +4835,30 @@ llvm_jit_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
     }
 
     attachment = import_func->attachment;
+#if WASM_ENABLE_INSTANCE_STATS != 0
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+    wasm_instance_stats_add_jit_transition(
+        exec_env, true,
+        import_func->call_conv_wasm_c_api || !import_func->quick_native_entry);
+#else
+    wasm_instance_stats_add_jit_transition(exec_env, true, true);
+#endif
+    prev_stats_state =
+        wasm_instance_stats_switch(exec_env, WASM_STATS_STATE_HOST);
+#endif
     if (import_func->call_conv_wasm_c_api) {
         ret = wasm_runtime_invoke_c_api_native(
             (WASMModuleInstanceCommon *)module_inst, func_ptr, func_type, argc,
             argv, c_api_func_import->with_env_arg, c_api_func_import->env_arg);
     }
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+    else if (import_func->quick_native_entry) {
+        ret = wasm_native_invoke_quick_native_entry(
+            exec_env, import_func->quick_native_entry, func_ptr, func_type,
+            import_func->signature, import_func->quick_native_ptr_args,
+            attachment, argv, argv);
+    }
+#endif
     else if (!import_func->call_conv_raw) {
         signature = import_func->signature;
         ret =
@@ -4588,6 +4871,9 @@ llvm_jit_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
                                              signature, attachment, argv, argc,
                                              argv);
     }
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    wasm_instance_stats_switch(exec_env, prev_stats_state);
+#endif
 
 fail:
 #ifdef OS_ENABLE_HW_BOUND_CHECK
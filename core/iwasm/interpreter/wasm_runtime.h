@@ -12,6 +12,9 @@
 #include "bh_hashmap.h"
 #include "../common/wasm_runtime_common.h"
 #include "../common/wasm_exec_env.h"
+#if WASM_ENABLE_INSTANCE_STATS != 0
+#include "../common/wasm_instance_stats.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -232,6 +235,11 @@ struct WASMFunctionInstance {
     WASMModuleInstance *import_module_inst;
     WASMFunctionInstance *import_func_inst;
 #endif
+#if WASM_ENABLE_LAZY_LOADER != 0
+    /* Whether the function (or the function of another module it is
+       linked to) has been prepared and the fields above are updated */
+    bool is_prepared;
+#endif
 #if WASM_ENABLE_PERF_PROFILING != 0
     /* total execution time */
     uint64 total_exec_time;
@@ -239,6 +247,10 @@ struct WASMFunctionInstance {
     uint32 total_exec_cnt;
     /* children execution time */
     uint64 children_exec_time;
+#if WASM_ENABLE_HW_PERF_COUNTERS != 0
+    /* hardware counters, excluding the children's */
+    uint64 hw_counters[WASM_HW_COUNTER_NUM];
+#endif
 #endif
 };
 
@@ -325,6 +337,13 @@ typedef struct WASMModuleInstanceExtraCommon {
     /* The gc heap created */
     void *gc_heap_handle;
 #endif
+
+#if WASM_ENABLE_INSTANCE_STATS != 0
+    WASMInstanceStats stats;
+    /* The stats counted into, the ones of the instance which spawned
+       the thread of this instance if any, see wasm_instance_stats_init */
+    WASMInstanceStats *counted_stats;
+#endif
 } WASMModuleInstanceExtraCommon;
 
 /* Extra info of WASM module instance for interpreter/jit mode */
@@ -591,6 +610,29 @@ bool
 wasm_call_function(WASMExecEnv *exec_env, WASMFunctionInstance *function,
                    unsigned argc, uint32 argv[]);
 
+/* Call a function over the argument sets of a batch in one runtime entry */
+void
+wasm_call_function_batch(WASMExecEnv *exec_env, WASMFunctionInstance *function,
+                         WASMBatchCall *batch);
+
+#if WASM_ENABLE_LAZY_LOADER != 0
+/**
+ * Prepare the body of a function when it is called the first time, and
+ * set the exception of the module instance if it is invalid
+ */
+bool
+wasm_lazy_prepare_function(WASMModuleInstance *module_inst,
+                           WASMFunctionInstance *function);
+
+static inline bool
+wasm_check_function_prepared(WASMModuleInstance *module_inst,
+                             WASMFunctionInstance *function)
+{
+    return function->is_prepared
+           || wasm_lazy_prepare_function(module_inst, function);
+}
+#endif
+
 void
 wasm_set_exception(WASMModuleInstance *module, const char *exception);
 
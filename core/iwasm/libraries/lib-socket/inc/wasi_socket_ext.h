@@ -197,6 +197,12 @@ getaddrinfo(const char *node, const char *service, const struct addrinfo *hints,
 
 void
 freeaddrinfo(struct addrinfo *res);
+
+/* Copies count bytes from in_fd to out_fd without going through the linear
+   memory. If offset is not NULL, reads from *offset, which is updated, and
+   leaves the file position of in_fd unchanged. */
+ssize_t
+sendfile(int out_fd, int in_fd, off_t *offset, size_t count);
 #endif
 
 /**
@@ -335,6 +341,28 @@ __wasi_sock_send_to(__wasi_fd_t fd, const __wasi_ciovec_t *si_data,
         (uint32_t)dest_addr, (uint32_t)so_data_len);
 }
 
+/**
+ * Copies data from a file or a socket to another descriptor, in the host
+ * Note: This is similar to `sendfile` in Linux, except that an offset of
+ * UINT64_MAX uses the current file position of `in_fd`
+ */
+int32_t
+__imported_wasi_snapshot_preview1_sock_sendfile(int32_t arg0, int32_t arg1,
+                                                int64_t arg2, int32_t arg3,
+                                                int32_t arg4)
+    __attribute__((__import_module__("wasi_snapshot_preview1"),
+                   __import_name__("sock_sendfile")));
+
+static inline __wasi_errno_t
+__wasi_sock_sendfile(__wasi_fd_t out_fd, __wasi_fd_t in_fd,
+                     __wasi_filesize_t offset, __wasi_size_t count,
+                     __wasi_size_t *nsent)
+{
+    return (__wasi_errno_t)__imported_wasi_snapshot_preview1_sock_sendfile(
+        (int32_t)out_fd, (int32_t)in_fd, (int64_t)offset, (int32_t)count,
+        (int32_t)nsent);
+}
+
 /**
  * Receives data from a socket
  * Note: This is similar to `recvfrom` in POSIX
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <unistd.h>
 #include <wasi/api.h>
 #include <wasi_socket_ext.h>
 
@@ -338,6 +339,68 @@ recvfrom(int sockfd, void *buf, size_t len, int flags,
     return so_datalen;
 }
 
+/* Used when the runtime can't copy the data by itself. Copies until count
+   bytes are sent or a read comes back short, like sendfile() would */
+static ssize_t
+sendfile_fallback(int out_fd, int in_fd, off_t *offset, size_t count)
+{
+    char buf[4096];
+    size_t total = 0, len;
+    ssize_t nread = 0, nwritten, n;
+
+    while (total < count) {
+        len = count - total < sizeof(buf) ? count - total : sizeof(buf);
+        if (offset)
+            nread = pread(in_fd, buf, len, *offset);
+        else
+            nread = read(in_fd, buf, len);
+        if (nread <= 0)
+            break;
+
+        for (nwritten = 0; nwritten < nread; nwritten += n) {
+            if ((n = write(out_fd, buf + nwritten, nread - nwritten)) < 0)
+                break;
+        }
+
+        if (offset)
+            *offset += nwritten;
+        total += (size_t)nwritten;
+        if (nwritten < nread)
+            return total > 0 ? (ssize_t)total : -1;
+        if ((size_t)nread < len)
+            break;
+    }
+
+    /* Report an error only if nothing was sent */
+    if (total == 0 && nread < 0)
+        return -1;
+    return (ssize_t)total;
+}
+
+ssize_t
+sendfile(int out_fd, int in_fd, off_t *offset, size_t count)
+{
+    __wasi_filesize_t wasi_offset = offset ? (__wasi_filesize_t)*offset
+                                           : (__wasi_filesize_t)UINT64_MAX;
+    __wasi_size_t nsent = 0;
+    __wasi_errno_t error;
+
+    if (offset && *offset < 0) {
+        HANDLE_ERROR(__WASI_ERRNO_INVAL)
+    }
+
+    // Perform system call.
+    error = __wasi_sock_sendfile(out_fd, in_fd, wasi_offset, count, &nsent);
+    if (error == __WASI_ERRNO_NOSYS) {
+        return sendfile_fallback(out_fd, in_fd, offset, count);
+    }
+    HANDLE_ERROR(error)
+
+    if (offset)
+        *offset += nsent;
+    return nsent;
+}
+
 int
 socket(int domain, int type, int protocol)
 {
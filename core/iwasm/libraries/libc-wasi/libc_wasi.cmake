@@ -8,6 +8,8 @@ add_definitions (-DWASM_ENABLE_LIBC_WASI=1)
 include_directories(${LIBC_WASI_DIR}/sandboxed-system-primitives/include
                     ${LIBC_WASI_DIR}/sandboxed-system-primitives/src)
 
-file (GLOB_RECURSE source_all ${LIBC_WASI_DIR}/*.c )
+# test/ holds wasm applications of the WASI test suite
+file (GLOB_RECURSE source_all
+      ${LIBC_WASI_DIR}/sandboxed-system-primitives/*.c)
 
-set (LIBC_WASI_SOURCE ${source_all})
+set (LIBC_WASI_SOURCE ${LIBC_WASI_DIR}/libc_wasi_wrapper.c ${source_all})
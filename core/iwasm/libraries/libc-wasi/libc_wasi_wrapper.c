@@ -8,6 +8,9 @@
 #include "wasm_export.h"
 #include "wasm_runtime_common.h"
 #include "wasmtime_ssp.h"
+#if WASM_ENABLE_INSTANCE_STATS != 0
+#include "wasm_instance_stats.h"
+#endif
 
 #if WASM_ENABLE_THREAD_MGR != 0
 #include "../../../thread-mgr/thread_manager.h"
@@ -40,6 +43,18 @@ wasm_runtime_set_exception(wasm_module_inst_t module, const char *exception);
 
 #define module_free(offset) \
     wasm_runtime_module_free(module_inst, offset)
+
+#if WASM_ENABLE_INSTANCE_STATS != 0
+#define wasi_stats_count(type) \
+    wasm_instance_stats_add_wasi_call(exec_env, type)
+
+#define wasi_stats_add_io(bytes_read, bytes_written) \
+    wasm_instance_stats_add_wasi_io(exec_env, bytes_read, bytes_written)
+#else
+#define wasi_stats_count(type) (void)0
+
+#define wasi_stats_add_io(bytes_read, bytes_written) (void)0
+#endif
 /* clang-format on */
 
 typedef struct wasi_prestat_app {
@@ -123,6 +138,8 @@ wasi_args_get(wasm_exec_env_t exec_env, uint32 *argv_offsets, char *argv_buf)
     uint64 total_size;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_ARGS_ENVIRON);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -165,6 +182,8 @@ wasi_args_sizes_get(wasm_exec_env_t exec_env, uint32 *argc_app,
     size_t argc, argv_buf_size;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_ARGS_ENVIRON);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -190,6 +209,8 @@ wasi_clock_res_get(wasm_exec_env_t exec_env,
 {
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
 
+    wasi_stats_count(WASI_CALL_CLOCK);
+
     if (!validate_native_addr(resolution, (uint64)sizeof(wasi_timestamp_t)))
         return (wasi_errno_t)-1;
 
@@ -204,6 +225,8 @@ wasi_clock_time_get(wasm_exec_env_t exec_env,
 {
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
 
+    wasi_stats_count(WASI_CALL_CLOCK);
+
     if (!validate_native_addr(time, (uint64)sizeof(wasi_timestamp_t)))
         return (wasi_errno_t)-1;
 
@@ -223,6 +246,8 @@ wasi_environ_get(wasm_exec_env_t exec_env, uint32 *environ_offsets,
     char **environs;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_ARGS_ENVIRON);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -268,6 +293,8 @@ wasi_environ_sizes_get(wasm_exec_env_t exec_env, uint32 *environ_count_app,
     size_t environ_count, environ_buf_size;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_ARGS_ENVIRON);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -296,6 +323,8 @@ wasi_fd_prestat_get(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_prestat_t prestat;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -319,6 +348,8 @@ wasi_fd_prestat_dir_name(wasm_exec_env_t exec_env, wasi_fd_t fd, char *path,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_prestats *prestats = wasi_ctx_get_prestats(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -333,6 +364,8 @@ wasi_fd_close(wasm_exec_env_t exec_env, wasi_fd_t fd)
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
     struct fd_prestats *prestats = wasi_ctx_get_prestats(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -346,12 +379,90 @@ wasi_fd_datasync(wasm_exec_env_t exec_env, wasi_fd_t fd)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
     return wasmtime_ssp_fd_datasync(exec_env, curfds, fd);
 }
 
+/* iovec lists up to this length are translated into a buffer on the
+   native stack, so that small reads and writes don't hit the allocator */
+#define IOVEC_STACK_BUF_COUNT 8
+
+/**
+ * Convert a list of app iovecs into native iovecs. The buffers are bound
+ * checked against the default linear memory in a single pass, only those
+ * not fully inside of it (e.g. in the shared heap) go through the generic
+ * address validation. The native iovecs are written to stack_buf if it is
+ * large enough, otherwise they are allocated and must be released with
+ * free_native_iovec.
+ */
+static wasi_errno_t
+convert_iovec_app_to_native(wasm_module_inst_t module_inst,
+                            const iovec_app_t *iovec_app, uint32 iovs_len,
+                            wasi_iovec_t *stack_buf, wasi_iovec_t **p_iovec)
+{
+    wasm_memory_inst_t memory;
+    wasi_iovec_t *iovec, *iovec_begin;
+    uint8 *memory_data = NULL;
+    uint64 total_size, memory_data_size = 0;
+    uint32 i;
+
+    total_size = sizeof(iovec_app_t) * (uint64)iovs_len;
+    if (total_size >= UINT32_MAX
+        || !validate_native_addr((void *)iovec_app, total_size))
+        return (wasi_errno_t)-1;
+
+    if (iovs_len <= IOVEC_STACK_BUF_COUNT) {
+        iovec_begin = stack_buf;
+    }
+    else {
+        total_size = sizeof(wasi_iovec_t) * (uint64)iovs_len;
+        if (total_size >= UINT32_MAX
+            || !(iovec_begin = wasm_runtime_malloc((uint32)total_size)))
+            return (wasi_errno_t)-1;
+    }
+
+    /* Linear memory only grows during the call, and shared memory, which
+       may be grown by other threads, never moves */
+    if ((memory = wasm_runtime_get_default_memory(module_inst))) {
+        memory_data = wasm_memory_get_base_address(memory);
+        memory_data_size = wasm_memory_get_cur_page_count(memory)
+                           * wasm_memory_get_bytes_per_page(memory);
+    }
+
+    iovec = iovec_begin;
+    for (i = 0; i < iovs_len; i++, iovec_app++, iovec++) {
+        uint64 buf_offset = iovec_app->buf_offset;
+        uint64 buf_len = iovec_app->buf_len;
+
+        if (buf_offset + buf_len <= memory_data_size) {
+            iovec->buf = memory_data + buf_offset;
+        }
+        else if (validate_app_addr(buf_offset, buf_len)) {
+            iovec->buf = (void *)addr_app_to_native(buf_offset);
+        }
+        else {
+            if (iovec_begin != stack_buf)
+                wasm_runtime_free(iovec_begin);
+            return (wasi_errno_t)-1;
+        }
+        iovec->buf_len = (size_t)buf_len;
+    }
+
+    *p_iovec = iovec_begin;
+    return 0;
+}
+
+static void
+free_native_iovec(wasi_iovec_t *iovec, wasi_iovec_t *stack_buf)
+{
+    if (iovec != stack_buf)
+        wasm_runtime_free(iovec);
+}
+
 static wasi_errno_t
 wasi_fd_pread(wasm_exec_env_t exec_env, wasi_fd_t fd, iovec_app_t *iovec_app,
               uint32 iovs_len, wasi_filesize_t offset, uint32 *nread_app)
@@ -359,50 +470,36 @@ wasi_fd_pread(wasm_exec_env_t exec_env, wasi_fd_t fd, iovec_app_t *iovec_app,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_iovec_t *iovec, *iovec_begin;
-    uint64 total_size;
+    wasi_iovec_t iovec_buf[IOVEC_STACK_BUF_COUNT], *iovec;
     size_t nread;
-    uint32 i;
     wasi_errno_t err;
 
-    if (!wasi_ctx)
-        return (wasi_errno_t)-1;
+    wasi_stats_count(WASI_CALL_FD_READ);
 
-    total_size = sizeof(iovec_app_t) * (uint64)iovs_len;
-    if (!validate_native_addr(nread_app, (uint64)sizeof(uint32))
-        || total_size >= UINT32_MAX
-        || !validate_native_addr(iovec_app, total_size))
+    if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_iovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(iovec_begin = wasm_runtime_malloc((uint32)total_size)))
+    if (!validate_native_addr(nread_app, (uint64)sizeof(uint32)))
         return (wasi_errno_t)-1;
 
-    iovec = iovec_begin;
-
-    for (i = 0; i < iovs_len; i++, iovec_app++, iovec++) {
-        if (!validate_app_addr((uint64)iovec_app->buf_offset,
-                               (uint64)iovec_app->buf_len)) {
-            err = (wasi_errno_t)-1;
-            goto fail;
-        }
-        iovec->buf = (void *)addr_app_to_native((uint64)iovec_app->buf_offset);
-        iovec->buf_len = iovec_app->buf_len;
-    }
+    err = convert_iovec_app_to_native(module_inst, iovec_app, iovs_len,
+                                      iovec_buf, &iovec);
+    if (err)
+        return err;
 
-    err = wasmtime_ssp_fd_pread(exec_env, curfds, fd, iovec_begin, iovs_len,
-                                offset, &nread);
+    err = wasmtime_ssp_fd_pread(exec_env, curfds, fd, iovec, iovs_len, offset,
+                                &nread);
     if (err)
         goto fail;
 
     *nread_app = (uint32)nread;
+    wasi_stats_add_io(nread, 0);
 
     /* success */
     err = 0;
 
 fail:
-    wasm_runtime_free(iovec_begin);
+    free_native_iovec(iovec, iovec_buf);
     return err;
 }
 
@@ -414,50 +511,37 @@ wasi_fd_pwrite(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_ciovec_t *ciovec, *ciovec_begin;
-    uint64 total_size;
+    wasi_iovec_t iovec_buf[IOVEC_STACK_BUF_COUNT], *iovec;
     size_t nwritten;
-    uint32 i;
     wasi_errno_t err;
 
-    if (!wasi_ctx)
-        return (wasi_errno_t)-1;
+    wasi_stats_count(WASI_CALL_FD_WRITE);
 
-    total_size = sizeof(iovec_app_t) * (uint64)iovs_len;
-    if (!validate_native_addr(nwritten_app, (uint64)sizeof(uint32))
-        || total_size >= UINT32_MAX
-        || !validate_native_addr((void *)iovec_app, total_size))
+    if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_ciovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(ciovec_begin = wasm_runtime_malloc((uint32)total_size)))
+    if (!validate_native_addr(nwritten_app, (uint64)sizeof(uint32)))
         return (wasi_errno_t)-1;
 
-    ciovec = ciovec_begin;
-
-    for (i = 0; i < iovs_len; i++, iovec_app++, ciovec++) {
-        if (!validate_app_addr((uint64)iovec_app->buf_offset,
-                               (uint64)iovec_app->buf_len)) {
-            err = (wasi_errno_t)-1;
-            goto fail;
-        }
-        ciovec->buf = (char *)addr_app_to_native((uint64)iovec_app->buf_offset);
-        ciovec->buf_len = iovec_app->buf_len;
-    }
+    err = convert_iovec_app_to_native(module_inst, iovec_app, iovs_len,
+                                      iovec_buf, &iovec);
+    if (err)
+        return err;
 
-    err = wasmtime_ssp_fd_pwrite(exec_env, curfds, fd, ciovec_begin, iovs_len,
+    err = wasmtime_ssp_fd_pwrite(exec_env, curfds, fd,
+                                 (const wasi_ciovec_t *)iovec, iovs_len,
                                  offset, &nwritten);
     if (err)
         goto fail;
 
     *nwritten_app = (uint32)nwritten;
+    wasi_stats_add_io(0, nwritten);
 
     /* success */
     err = 0;
 
 fail:
-    wasm_runtime_free(ciovec_begin);
+    free_native_iovec(iovec, iovec_buf);
     return err;
 }
 
@@ -468,50 +552,35 @@ wasi_fd_read(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_iovec_t *iovec, *iovec_begin;
-    uint64 total_size;
+    wasi_iovec_t iovec_buf[IOVEC_STACK_BUF_COUNT], *iovec;
     size_t nread;
-    uint32 i;
     wasi_errno_t err;
 
-    if (!wasi_ctx)
-        return (wasi_errno_t)-1;
+    wasi_stats_count(WASI_CALL_FD_READ);
 
-    total_size = sizeof(iovec_app_t) * (uint64)iovs_len;
-    if (!validate_native_addr(nread_app, (uint64)sizeof(uint32))
-        || total_size >= UINT32_MAX
-        || !validate_native_addr((void *)iovec_app, total_size))
+    if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_iovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(iovec_begin = wasm_runtime_malloc((uint32)total_size)))
+    if (!validate_native_addr(nread_app, (uint64)sizeof(uint32)))
         return (wasi_errno_t)-1;
 
-    iovec = iovec_begin;
-
-    for (i = 0; i < iovs_len; i++, iovec_app++, iovec++) {
-        if (!validate_app_addr((uint64)iovec_app->buf_offset,
-                               (uint64)iovec_app->buf_len)) {
-            err = (wasi_errno_t)-1;
-            goto fail;
-        }
-        iovec->buf = (void *)addr_app_to_native((uint64)iovec_app->buf_offset);
-        iovec->buf_len = iovec_app->buf_len;
-    }
+    err = convert_iovec_app_to_native(module_inst, iovec_app, iovs_len,
+                                      iovec_buf, &iovec);
+    if (err)
+        return err;
 
-    err = wasmtime_ssp_fd_read(exec_env, curfds, fd, iovec_begin, iovs_len,
-                               &nread);
+    err = wasmtime_ssp_fd_read(exec_env, curfds, fd, iovec, iovs_len, &nread);
     if (err)
         goto fail;
 
     *nread_app = (uint32)nread;
+    wasi_stats_add_io(nread, 0);
 
     /* success */
     err = 0;
 
 fail:
-    wasm_runtime_free(iovec_begin);
+    free_native_iovec(iovec, iovec_buf);
     return err;
 }
 
@@ -523,6 +592,8 @@ wasi_fd_renumber(wasm_exec_env_t exec_env, wasi_fd_t from, wasi_fd_t to)
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
     struct fd_prestats *prestats = wasi_ctx_get_prestats(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -537,6 +608,8 @@ wasi_fd_seek(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_filedelta_t offset,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -554,6 +627,8 @@ wasi_fd_tell(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_filesize_t *newoffset)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -573,6 +648,8 @@ wasi_fd_fdstat_get(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_fdstat_t fdstat;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -595,6 +672,8 @@ wasi_fd_fdstat_set_flags(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -610,6 +689,8 @@ wasi_fd_fdstat_set_rights(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -624,6 +705,8 @@ wasi_fd_sync(wasm_exec_env_t exec_env, wasi_fd_t fd)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -638,50 +721,37 @@ wasi_fd_write(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
-    wasi_ciovec_t *ciovec, *ciovec_begin;
-    uint64 total_size;
+    wasi_iovec_t iovec_buf[IOVEC_STACK_BUF_COUNT], *iovec;
     size_t nwritten;
-    uint32 i;
     wasi_errno_t err;
 
-    if (!wasi_ctx)
-        return (wasi_errno_t)-1;
+    wasi_stats_count(WASI_CALL_FD_WRITE);
 
-    total_size = sizeof(iovec_app_t) * (uint64)iovs_len;
-    if (!validate_native_addr(nwritten_app, (uint64)sizeof(uint32))
-        || total_size >= UINT32_MAX
-        || !validate_native_addr((void *)iovec_app, total_size))
+    if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
-    total_size = sizeof(wasi_ciovec_t) * (uint64)iovs_len;
-    if (total_size >= UINT32_MAX
-        || !(ciovec_begin = wasm_runtime_malloc((uint32)total_size)))
+    if (!validate_native_addr(nwritten_app, (uint64)sizeof(uint32)))
         return (wasi_errno_t)-1;
 
-    ciovec = ciovec_begin;
-
-    for (i = 0; i < iovs_len; i++, iovec_app++, ciovec++) {
-        if (!validate_app_addr((uint64)iovec_app->buf_offset,
-                               (uint64)iovec_app->buf_len)) {
-            err = (wasi_errno_t)-1;
-            goto fail;
-        }
-        ciovec->buf = (char *)addr_app_to_native((uint64)iovec_app->buf_offset);
-        ciovec->buf_len = iovec_app->buf_len;
-    }
+    err = convert_iovec_app_to_native(module_inst, iovec_app, iovs_len,
+                                      iovec_buf, &iovec);
+    if (err)
+        return err;
 
-    err = wasmtime_ssp_fd_write(exec_env, curfds, fd, ciovec_begin, iovs_len,
+    err = wasmtime_ssp_fd_write(exec_env, curfds, fd,
+                                (const wasi_ciovec_t *)iovec, iovs_len,
                                 &nwritten);
     if (err)
         goto fail;
 
     *nwritten_app = (uint32)nwritten;
+    wasi_stats_add_io(0, nwritten);
 
     /* success */
     err = 0;
 
 fail:
-    wasm_runtime_free(ciovec_begin);
+    free_native_iovec(iovec, iovec_buf);
     return err;
 }
 
@@ -693,6 +763,8 @@ wasi_fd_advise(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_filesize_t offset,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -707,12 +779,116 @@ wasi_fd_allocate(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_filesize_t offset,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
     return wasmtime_ssp_fd_allocate(exec_env, curfds, fd, offset, len);
 }
 
+#if CONFIG_HAS_FD_MAP != 0
+/* Check that [buf, buf + len) can be replaced by a host mapping: it must
+   cover whole host pages of the linear memory of the instance, and the
+   memory backing it must never be moved (e.g. by mremap when the linear
+   memory grows), as that would fail or leave the mapping behind. The
+   shared heap is rejected, as other instances allocate from it too. */
+static wasi_errno_t
+check_map_range(wasm_module_inst_t module_inst, void *buf, uint32 len)
+{
+    wasm_memory_inst_t memory;
+    uintptr_t page_size = (uintptr_t)os_getpagesize();
+    uint8 *memory_data;
+    uint64 memory_data_size;
+
+    if (len == 0 || ((uintptr_t)buf & (page_size - 1)) != 0
+        || (len & (page_size - 1)) != 0)
+        return (wasi_errno_t)__WASI_EINVAL;
+
+#if WASM_MEM_ALLOC_WITH_USAGE != 0
+    /* The linear memory may come from a user allocator */
+    return (wasi_errno_t)__WASI_ENOTSUP;
+#else
+    if (!(memory = wasm_runtime_get_default_memory(module_inst)))
+        return (wasi_errno_t)__WASI_EINVAL;
+
+    memory_data = wasm_memory_get_base_address(memory);
+    memory_data_size = wasm_memory_get_cur_page_count(memory)
+                       * wasm_memory_get_bytes_per_page(memory);
+    if ((uint8 *)buf < memory_data
+        || (uint64)((uint8 *)buf - memory_data) + len > memory_data_size)
+        return (wasi_errno_t)__WASI_EINVAL;
+
+#ifndef OS_ENABLE_HW_BOUND_CHECK
+    /* Without the hardware bound check, only shared memory, which is
+       allocated with its maximum size, keeps its address when growing */
+    if (!wasm_memory_get_shared(memory))
+        return (wasi_errno_t)__WASI_ENOTSUP;
+#endif
+    return 0;
+#endif /* end of WASM_MEM_ALLOC_WITH_USAGE != 0 */
+}
+#endif /* end of CONFIG_HAS_FD_MAP != 0 */
+
+static wasi_errno_t
+wasi_fd_map(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_filesize_t offset,
+            void *buf, uint32 len)
+{
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
+    struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
+#if CONFIG_HAS_FD_MAP != 0
+    wasi_errno_t err;
+#endif
+
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
+    if (!wasi_ctx)
+        return (wasi_errno_t)-1;
+
+#if CONFIG_HAS_FD_MAP != 0
+    if ((err = check_map_range(module_inst, buf, len)) != 0)
+        return err;
+
+    return wasmtime_ssp_fd_map(exec_env, curfds, fd, offset, buf, len);
+#else
+    (void)curfds;
+    (void)fd;
+    (void)offset;
+    (void)buf;
+    (void)len;
+    return (wasi_errno_t)__WASI_ENOSYS;
+#endif
+}
+
+static wasi_errno_t
+wasi_fd_unmap(wasm_exec_env_t exec_env, void *buf, uint32 len)
+{
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
+    struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
+#if CONFIG_HAS_FD_MAP != 0
+    wasi_errno_t err;
+#endif
+
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
+    if (!wasi_ctx)
+        return (wasi_errno_t)-1;
+
+#if CONFIG_HAS_FD_MAP != 0
+    if ((err = check_map_range(module_inst, buf, len)) != 0)
+        return err;
+
+    return wasmtime_ssp_fd_unmap(exec_env, curfds, buf, len);
+#else
+    (void)curfds;
+    (void)buf;
+    (void)len;
+    return (wasi_errno_t)__WASI_ENOSYS;
+#endif
+}
+
 static wasi_errno_t
 wasi_path_create_directory(wasm_exec_env_t exec_env, wasi_fd_t fd,
                            const char *path, uint32 path_len)
@@ -721,6 +897,8 @@ wasi_path_create_directory(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -739,6 +917,8 @@ wasi_path_link(wasm_exec_env_t exec_env, wasi_fd_t old_fd,
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
     struct fd_prestats *prestats = wasi_ctx_get_prestats(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -760,6 +940,8 @@ wasi_path_open(wasm_exec_env_t exec_env, wasi_fd_t dirfd,
     wasi_fd_t fd = (wasi_fd_t)-1; /* set fd_app -1 if path open failed */
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -784,6 +966,8 @@ wasi_fd_readdir(wasm_exec_env_t exec_env, wasi_fd_t fd, void *buf,
     size_t bufused;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_FD_READ);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -810,6 +994,8 @@ wasi_path_readlink(wasm_exec_env_t exec_env, wasi_fd_t fd, const char *path,
     size_t bufused;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -834,6 +1020,8 @@ wasi_path_rename(wasm_exec_env_t exec_env, wasi_fd_t old_fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -850,6 +1038,8 @@ wasi_fd_filestat_get(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -868,6 +1058,8 @@ wasi_fd_filestat_set_times(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -883,6 +1075,8 @@ wasi_fd_filestat_set_size(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_FD_OTHER);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -898,6 +1092,8 @@ wasi_path_filestat_get(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -918,6 +1114,8 @@ wasi_path_filestat_set_times(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -936,6 +1134,8 @@ wasi_path_symlink(wasm_exec_env_t exec_env, const char *old_path,
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
     struct fd_prestats *prestats = wasi_ctx_get_prestats(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -951,6 +1151,8 @@ wasi_path_unlink_file(wasm_exec_env_t exec_env, wasi_fd_t fd, const char *path,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -965,6 +1167,8 @@ wasi_path_remove_directory(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_PATH);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -1085,6 +1289,8 @@ wasi_poll_oneoff(wasm_exec_env_t exec_env, const wasi_subscription_t *in,
     size_t nevents = 0;
     wasi_errno_t err;
 
+    wasi_stats_count(WASI_CALL_POLL);
+
     if (!wasi_ctx)
         return (wasi_errno_t)-1;
 
@@ -1112,6 +1318,9 @@ wasi_proc_exit(wasm_exec_env_t exec_env, wasi_exitcode_t rval)
 {
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
+
+    wasi_stats_count(WASI_CALL_PROC);
+
     /* Here throwing exception is just to let wasm app exit,
        the upper layer should clear the exception and return
        as normal */
@@ -1124,6 +1333,9 @@ wasi_proc_raise(wasm_exec_env_t exec_env, wasi_signal_t sig)
 {
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     char buf[32];
+
+    wasi_stats_count(WASI_CALL_PROC);
+
     snprintf(buf, sizeof(buf), "%s%d", "wasi proc raise ", sig);
     wasm_runtime_set_exception(module_inst, buf);
 
@@ -1135,6 +1347,8 @@ wasi_random_get(wasm_exec_env_t exec_env, void *buf, uint32 buf_len)
 {
     (void)exec_env;
 
+    wasi_stats_count(WASI_CALL_RANDOM);
+
     return wasmtime_ssp_random_get(buf, buf_len);
 }
 
@@ -1146,6 +1360,8 @@ wasi_sock_accept(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_fdflags_t flags,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1162,6 +1378,8 @@ wasi_sock_addr_local(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1181,6 +1399,8 @@ wasi_sock_addr_remote(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1204,6 +1424,8 @@ wasi_sock_addr_resolve(wasm_exec_env_t exec_env, const char *host,
     struct fd_table *curfds = NULL;
     char **ns_lookup_list = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1223,6 +1445,8 @@ wasi_sock_bind(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_addr_t *addr)
     struct fd_table *curfds = NULL;
     struct addr_pool *addr_pool = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1238,6 +1462,8 @@ wasi_sock_close(wasm_exec_env_t exec_env, wasi_fd_t fd)
     (void)exec_env;
     (void)fd;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     return __WASI_ENOSYS;
 }
 
@@ -1249,6 +1475,8 @@ wasi_sock_connect(wasm_exec_env_t exec_env, wasi_fd_t fd, wasi_addr_t *addr)
     struct fd_table *curfds = NULL;
     struct addr_pool *addr_pool = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1266,6 +1494,8 @@ wasi_sock_get_broadcast(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1285,6 +1515,8 @@ wasi_sock_get_keep_alive(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1304,6 +1536,8 @@ wasi_sock_get_linger(wasm_exec_env_t exec_env, wasi_fd_t fd, bool *is_enabled,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1325,6 +1559,8 @@ wasi_sock_get_recv_buf_size(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1344,6 +1580,8 @@ wasi_sock_get_recv_timeout(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1363,6 +1601,8 @@ wasi_sock_get_reuse_addr(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1382,6 +1622,8 @@ wasi_sock_get_reuse_port(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1401,6 +1643,8 @@ wasi_sock_get_send_buf_size(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1420,6 +1664,8 @@ wasi_sock_get_send_timeout(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1439,6 +1685,8 @@ wasi_sock_get_tcp_fastopen_connect(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1459,6 +1707,8 @@ wasi_sock_get_tcp_no_delay(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1478,6 +1728,8 @@ wasi_sock_get_tcp_quick_ack(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1498,6 +1750,8 @@ wasi_sock_get_tcp_keep_idle(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1517,6 +1771,8 @@ wasi_sock_get_tcp_keep_intvl(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1536,6 +1792,8 @@ wasi_sock_get_ip_multicast_loop(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1555,6 +1813,8 @@ wasi_sock_get_ip_ttl(wasm_exec_env_t exec_env, wasi_fd_t fd, uint8_t *ttl_s)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1574,6 +1834,8 @@ wasi_sock_get_ip_multicast_ttl(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1593,6 +1855,8 @@ wasi_sock_get_ipv6_only(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1611,6 +1875,8 @@ wasi_sock_listen(wasm_exec_env_t exec_env, wasi_fd_t fd, uint32 backlog)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1628,6 +1894,8 @@ wasi_sock_open(wasm_exec_env_t exec_env, wasi_fd_t poolfd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1643,6 +1911,8 @@ wasi_sock_set_broadcast(wasm_exec_env_t exec_env, wasi_fd_t fd, bool is_enabled)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1659,6 +1929,8 @@ wasi_sock_set_keep_alive(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1675,6 +1947,8 @@ wasi_sock_set_linger(wasm_exec_env_t exec_env, wasi_fd_t fd, bool is_enabled,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1691,6 +1965,8 @@ wasi_sock_set_recv_buf_size(wasm_exec_env_t exec_env, wasi_fd_t fd, size_t size)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1707,6 +1983,8 @@ wasi_sock_set_recv_timeout(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1723,6 +2001,8 @@ wasi_sock_set_reuse_addr(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1739,6 +2019,8 @@ wasi_sock_set_reuse_port(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1754,6 +2036,8 @@ wasi_sock_set_send_buf_size(wasm_exec_env_t exec_env, wasi_fd_t fd, size_t size)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1770,6 +2054,8 @@ wasi_sock_set_send_timeout(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1786,6 +2072,8 @@ wasi_sock_set_tcp_fastopen_connect(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1803,6 +2091,8 @@ wasi_sock_set_tcp_no_delay(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1819,6 +2109,8 @@ wasi_sock_set_tcp_quick_ack(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1836,6 +2128,8 @@ wasi_sock_set_tcp_keep_idle(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1852,6 +2146,8 @@ wasi_sock_set_tcp_keep_intvl(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1868,6 +2164,8 @@ wasi_sock_set_ip_multicast_loop(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1886,6 +2184,8 @@ wasi_sock_set_ip_add_membership(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1907,6 +2207,8 @@ wasi_sock_set_ip_drop_membership(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1926,6 +2228,8 @@ wasi_sock_set_ip_ttl(wasm_exec_env_t exec_env, wasi_fd_t fd, uint8_t ttl_s)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1942,6 +2246,8 @@ wasi_sock_set_ip_multicast_ttl(wasm_exec_env_t exec_env, wasi_fd_t fd,
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -1957,6 +2263,8 @@ wasi_sock_set_ipv6_only(wasm_exec_env_t exec_env, wasi_fd_t fd, bool is_enabled)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = NULL;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EACCES;
 
@@ -2048,6 +2356,26 @@ copy_buffer_to_iovec_app(wasm_module_inst_t module_inst, uint8 *buf_begin,
     return __WASI_ESUCCESS;
 }
 
+/* A single-entry iovec list is passed to the socket functions directly
+   instead of going through a bounce buffer. Returns false if the list
+   doesn't qualify, in which case the generic path reports any error. */
+static bool
+get_single_iovec_app_native(wasm_module_inst_t module_inst,
+                            const iovec_app_t *data, uint32 data_len,
+                            wasi_iovec_t *p_iovec)
+{
+    wasi_iovec_t iovec_buf[IOVEC_STACK_BUF_COUNT], *iovec;
+
+    if (data_len != 1
+        || convert_iovec_app_to_native(module_inst, data, data_len, iovec_buf,
+                                       &iovec)
+               != 0)
+        return false;
+
+    *p_iovec = *iovec;
+    return p_iovec->buf_len > 0;
+}
+
 static wasi_errno_t
 wasi_sock_recv_from(wasm_exec_env_t exec_env, wasi_fd_t sock,
                     iovec_app_t *ri_data, uint32 ri_data_len,
@@ -2061,11 +2389,14 @@ wasi_sock_recv_from(wasm_exec_env_t exec_env, wasi_fd_t sock,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
+    wasi_iovec_t iovec;
     uint64 total_size;
     uint8 *buf_begin = NULL;
     wasi_errno_t err;
     size_t recv_bytes = 0;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx) {
         return __WASI_EINVAL;
     }
@@ -2073,6 +2404,19 @@ wasi_sock_recv_from(wasm_exec_env_t exec_env, wasi_fd_t sock,
     if (!validate_native_addr(ro_data_len, (uint64)sizeof(uint32)))
         return __WASI_EINVAL;
 
+    if (get_single_iovec_app_native(module_inst, ri_data, ri_data_len,
+                                    &iovec)) {
+        *ro_data_len = 0;
+        err = wasmtime_ssp_sock_recv_from(exec_env, curfds, sock, iovec.buf,
+                                          iovec.buf_len, ri_flags, src_addr,
+                                          &recv_bytes);
+        if (err == __WASI_ESUCCESS) {
+            *ro_data_len = (uint32)recv_bytes;
+            wasi_stats_add_io(recv_bytes, 0);
+        }
+        return err;
+    }
+
     err = allocate_iovec_app_buffer(module_inst, ri_data, ri_data_len,
                                     &buf_begin, &total_size);
     if (err != __WASI_ESUCCESS) {
@@ -2089,6 +2433,7 @@ wasi_sock_recv_from(wasm_exec_env_t exec_env, wasi_fd_t sock,
         goto fail;
     }
     *ro_data_len = (uint32)recv_bytes;
+    wasi_stats_add_io(recv_bytes, 0);
 
     err = copy_buffer_to_iovec_app(module_inst, buf_begin, (uint32)total_size,
                                    ri_data, ri_data_len, (uint32)recv_bytes);
@@ -2166,11 +2511,14 @@ wasi_sock_send(wasm_exec_env_t exec_env, wasi_fd_t sock,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
+    wasi_iovec_t iovec;
     uint64 buf_size = 0;
     uint8 *buf = NULL;
     wasi_errno_t err;
     size_t send_bytes = 0;
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx) {
         return __WASI_EINVAL;
     }
@@ -2178,6 +2526,16 @@ wasi_sock_send(wasm_exec_env_t exec_env, wasi_fd_t sock,
     if (!validate_native_addr(so_data_len, (uint64)sizeof(uint32)))
         return __WASI_EINVAL;
 
+    if (get_single_iovec_app_native(module_inst, si_data, si_data_len,
+                                    &iovec)) {
+        *so_data_len = 0;
+        err = wasmtime_ssp_sock_send(exec_env, curfds, sock, iovec.buf,
+                                     iovec.buf_len, &send_bytes);
+        *so_data_len = (uint32)send_bytes;
+        wasi_stats_add_io(0, send_bytes);
+        return err;
+    }
+
     err = convert_iovec_app_to_buffer(module_inst, si_data, si_data_len, &buf,
                                       &buf_size);
     if (err != __WASI_ESUCCESS)
@@ -2187,12 +2545,57 @@ wasi_sock_send(wasm_exec_env_t exec_env, wasi_fd_t sock,
     err = wasmtime_ssp_sock_send(exec_env, curfds, sock, buf, buf_size,
                                  &send_bytes);
     *so_data_len = (uint32)send_bytes;
+    wasi_stats_add_io(0, send_bytes);
 
     wasm_runtime_free(buf);
 
     return err;
 }
 
+static wasi_errno_t
+wasi_sock_sendfile(wasm_exec_env_t exec_env, wasi_fd_t out_fd, wasi_fd_t in_fd,
+                   wasi_filesize_t offset, uint32 count, uint32 *nsent)
+{
+    /**
+     * Copies count bytes from in_fd to out_fd without going through the
+     * linear memory. offset is UINT64_MAX to read from, and advance, the
+     * current position of in_fd. nsent is the number of bytes copied
+     **/
+    wasm_module_inst_t module_inst = get_module_inst(exec_env);
+    wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
+    struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
+#if CONFIG_HAS_SENDFILE != 0
+    size_t sent_bytes = 0;
+    wasi_errno_t err;
+#endif
+
+    wasi_stats_count(WASI_CALL_SOCK);
+
+    if (!wasi_ctx) {
+        return __WASI_EINVAL;
+    }
+
+    if (!validate_native_addr(nsent, (uint64)sizeof(uint32)))
+        return __WASI_EINVAL;
+
+    *nsent = 0;
+#if CONFIG_HAS_SENDFILE != 0
+    err = wasmtime_ssp_sock_sendfile(exec_env, curfds, out_fd, in_fd, offset,
+                                     count, &sent_bytes);
+    *nsent = (uint32)sent_bytes;
+    wasi_stats_add_io(0, sent_bytes);
+    return err;
+#else
+    (void)curfds;
+    (void)out_fd;
+    (void)in_fd;
+    (void)offset;
+    (void)count;
+    /* Let the application fall back to reading and writing the data */
+    return __WASI_ENOSYS;
+#endif
+}
+
 static wasi_errno_t
 wasi_sock_send_to(wasm_exec_env_t exec_env, wasi_fd_t sock,
                   const iovec_app_t *si_data, uint32 si_data_len,
@@ -2206,12 +2609,15 @@ wasi_sock_send_to(wasm_exec_env_t exec_env, wasi_fd_t sock,
     wasm_module_inst_t module_inst = get_module_inst(exec_env);
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
+    wasi_iovec_t iovec;
     uint64 buf_size = 0;
     uint8 *buf = NULL;
     wasi_errno_t err;
     size_t send_bytes = 0;
     struct addr_pool *addr_pool = wasi_ctx_get_addr_pool(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx) {
         return __WASI_EINVAL;
     }
@@ -2219,6 +2625,17 @@ wasi_sock_send_to(wasm_exec_env_t exec_env, wasi_fd_t sock,
     if (!validate_native_addr(so_data_len, (uint64)sizeof(uint32)))
         return __WASI_EINVAL;
 
+    if (get_single_iovec_app_native(module_inst, si_data, si_data_len,
+                                    &iovec)) {
+        *so_data_len = 0;
+        err = wasmtime_ssp_sock_send_to(exec_env, curfds, addr_pool, sock,
+                                        iovec.buf, iovec.buf_len, si_flags,
+                                        dest_addr, &send_bytes);
+        *so_data_len = (uint32)send_bytes;
+        wasi_stats_add_io(0, send_bytes);
+        return err;
+    }
+
     err = convert_iovec_app_to_buffer(module_inst, si_data, si_data_len, &buf,
                                       &buf_size);
     if (err != __WASI_ESUCCESS)
@@ -2228,6 +2645,7 @@ wasi_sock_send_to(wasm_exec_env_t exec_env, wasi_fd_t sock,
     err = wasmtime_ssp_sock_send_to(exec_env, curfds, addr_pool, sock, buf,
                                     buf_size, si_flags, dest_addr, &send_bytes);
     *so_data_len = (uint32)send_bytes;
+    wasi_stats_add_io(0, send_bytes);
 
     wasm_runtime_free(buf);
 
@@ -2241,6 +2659,8 @@ wasi_sock_shutdown(wasm_exec_env_t exec_env, wasi_fd_t sock, wasi_sdflags_t how)
     wasi_ctx_t wasi_ctx = get_wasi_ctx(module_inst);
     struct fd_table *curfds = wasi_ctx_get_curfds(wasi_ctx);
 
+    wasi_stats_count(WASI_CALL_SOCK);
+
     if (!wasi_ctx)
         return __WASI_EINVAL;
 
@@ -2252,6 +2672,8 @@ wasi_sched_yield(wasm_exec_env_t exec_env)
 {
     (void)exec_env;
 
+    wasi_stats_count(WASI_CALL_POLL);
+
     return wasmtime_ssp_sched_yield();
 }
 
@@ -2284,6 +2706,8 @@ static NativeSymbol native_symbols_libc_wasi[] = {
     REG_NATIVE_FUNC(fd_write, "(i*i*)i"),
     REG_NATIVE_FUNC(fd_advise, "(iIIi)i"),
     REG_NATIVE_FUNC(fd_allocate, "(iII)i"),
+    REG_NATIVE_FUNC(fd_map, "(iI*~)i"),
+    REG_NATIVE_FUNC(fd_unmap, "(*~)i"),
     REG_NATIVE_FUNC(path_create_directory, "(i*~)i"),
     REG_NATIVE_FUNC(path_link, "(ii*~i*~)i"),
     REG_NATIVE_FUNC(path_open, "(ii*~iIIi*)i"),
@@ -2332,6 +2756,7 @@ static NativeSymbol native_symbols_libc_wasi[] = {
     REG_NATIVE_FUNC(sock_recv, "(i*ii**)i"),
     REG_NATIVE_FUNC(sock_recv_from, "(i*ii**)i"),
     REG_NATIVE_FUNC(sock_send, "(i*ii*)i"),
+    REG_NATIVE_FUNC(sock_sendfile, "(iiIi*)i"),
     REG_NATIVE_FUNC(sock_send_to, "(i*ii**)i"),
     REG_NATIVE_FUNC(sock_set_broadcast, "(ii)i"),
     REG_NATIVE_FUNC(sock_set_keep_alive, "(ii)i"),
@@ -148,6 +148,15 @@ wasmtime_ssp_fd_allocate(wasm_exec_env_t exec_env, struct fd_table *curfds,
                          __wasi_filesize_t len)
     WASMTIME_SSP_SYSCALL_NAME(fd_allocate) WARN_UNUSED;
 
+__wasi_errno_t
+wasmtime_ssp_fd_map(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                    __wasi_fd_t fd, __wasi_filesize_t offset, void *buf,
+                    size_t len) WARN_UNUSED;
+
+__wasi_errno_t
+wasmtime_ssp_fd_unmap(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                      void *buf, size_t len) WARN_UNUSED;
+
 __wasi_errno_t
 wasmtime_ssp_path_create_directory(wasm_exec_env_t exec_env,
                                    struct fd_table *curfds, __wasi_fd_t fd,
@@ -350,6 +359,12 @@ wasmtime_ssp_sock_send(wasm_exec_env_t exec_env, struct fd_table *curfds,
                        size_t *sent_len)
     WASMTIME_SSP_SYSCALL_NAME(sock_send) WARN_UNUSED;
 
+__wasi_errno_t
+wasmtime_ssp_sock_sendfile(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                           __wasi_fd_t out_fd, __wasi_fd_t in_fd,
+                           __wasi_filesize_t offset, size_t count,
+                           size_t *ntransferred) WARN_UNUSED;
+
 __wasi_errno_t
 wasmtime_ssp_sock_send_to(wasm_exec_env_t exec_env, struct fd_table *curfds,
                           struct addr_pool *addr_pool, __wasi_fd_t sock,
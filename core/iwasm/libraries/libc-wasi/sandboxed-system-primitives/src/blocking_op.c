@@ -3,6 +3,10 @@
  * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
  */
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE /* for splice() */
+#endif
+
 #include <errno.h>
 
 #include "ssp_config.h"
@@ -191,3 +195,59 @@ blocking_op_poll(wasm_exec_env_t exec_env, struct pollfd *pfds, nfds_t nfds,
     return 0;
 }
 #endif
+
+#if CONFIG_HAS_EPOLL
+__wasi_errno_t
+blocking_op_epoll_wait(wasm_exec_env_t exec_env, int epfd,
+                       struct epoll_event *events, int maxevents,
+                       int timeout_ms, int *retp)
+{
+    int ret;
+    if (!wasm_runtime_begin_blocking_op(exec_env)) {
+        return __WASI_EINTR;
+    }
+    ret = epoll_wait(epfd, events, maxevents, timeout_ms);
+    wasm_runtime_end_blocking_op(exec_env);
+    if (ret == -1) {
+        return convert_errno(errno);
+    }
+    *retp = ret;
+    return 0;
+}
+#endif
+
+#if CONFIG_HAS_SENDFILE
+__wasi_errno_t
+blocking_op_sendfile(wasm_exec_env_t exec_env, int out_fd, int in_fd,
+                     off_t *offset, size_t count, size_t *retp)
+{
+    ssize_t ret;
+    if (!wasm_runtime_begin_blocking_op(exec_env)) {
+        return __WASI_EINTR;
+    }
+    ret = sendfile(out_fd, in_fd, offset, count);
+    wasm_runtime_end_blocking_op(exec_env);
+    if (ret == -1) {
+        return convert_errno(errno);
+    }
+    *retp = (size_t)ret;
+    return 0;
+}
+
+__wasi_errno_t
+blocking_op_splice(wasm_exec_env_t exec_env, int in_fd, int out_fd,
+                   size_t count, size_t *retp)
+{
+    ssize_t ret;
+    if (!wasm_runtime_begin_blocking_op(exec_env)) {
+        return __WASI_EINTR;
+    }
+    ret = splice(in_fd, NULL, out_fd, NULL, count, SPLICE_F_MOVE);
+    wasm_runtime_end_blocking_op(exec_env);
+    if (ret == -1) {
+        return convert_errno(errno);
+    }
+    *retp = (size_t)ret;
+    return 0;
+}
+#endif
@@ -8,6 +8,14 @@
 
 #include "bh_platform.h"
 #include "wasm_export.h"
+#include "ssp_config.h"
+
+#if CONFIG_HAS_EPOLL
+#include <sys/epoll.h>
+#endif
+#if CONFIG_HAS_SENDFILE
+#include <sys/sendfile.h>
+#endif
 
 __wasi_errno_t
 blocking_op_close(wasm_exec_env_t exec_env, os_file_handle handle,
@@ -61,4 +69,21 @@ blocking_op_poll(wasm_exec_env_t exec_env, struct pollfd *pfds, nfds_t nfds,
                  int timeout, int *retp);
 #endif
 
+#if CONFIG_HAS_EPOLL
+__wasi_errno_t
+blocking_op_epoll_wait(wasm_exec_env_t exec_env, int epfd,
+                       struct epoll_event *events, int maxevents,
+                       int timeout_ms, int *retp);
+#endif
+
+#if CONFIG_HAS_SENDFILE
+__wasi_errno_t
+blocking_op_sendfile(wasm_exec_env_t exec_env, int out_fd, int in_fd,
+                     off_t *offset, size_t count, size_t *retp);
+
+__wasi_errno_t
+blocking_op_splice(wasm_exec_env_t exec_env, int in_fd, int out_fd,
+                   size_t count, size_t *retp);
+#endif
+
 #endif /* end of _BLOCKING_OP_H_ */
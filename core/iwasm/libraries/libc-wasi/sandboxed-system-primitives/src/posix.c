@@ -321,6 +321,17 @@ struct fd_object {
     // Keep track of whether this fd object refers to a stdio stream so we know
     // whether to close the underlying file handle when releasing the object.
     bool is_stdio;
+#if CONFIG_HAS_EPOLL
+    // Identifies the object in the poll_oneoff() interest set, so that a
+    // registration isn't mistaken for one of a reused host descriptor.
+    // Zero until the object is polled for the first time.
+    uint64 poll_id;
+#endif
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+    // Table the object was created for. Once released, the object is put
+    // on the free list of the table instead of being freed.
+    struct fd_table *table;
+#endif
     union {
         // Data associated with directory file descriptors.
         struct {
@@ -328,6 +339,10 @@ struct fd_object {
             os_dir_stream handle;      // Directory handle.
             __wasi_dircookie_t offset; // Offset of the directory.
         } directory;
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        // Next object on the free list of the table.
+        struct fd_object *next_free;
+#endif
     };
 };
 
@@ -337,11 +352,127 @@ struct fd_entry {
     __wasi_rights_t rights_inheriting;
 };
 
+#if CONFIG_HAS_EPOLL
+// Registration of a host file descriptor in the poll_oneoff() interest set.
+struct fd_poll_reg {
+    uint64 object_id;  // Object the registration was made for.
+    uint32 registered; // Events registered with epoll, 0 if not registered.
+    uint32 wanted;     // Events requested by the current call.
+    uint32 generation; // Call that last subscribed to the descriptor.
+    uint32 first_sub;  // Subscriptions of the current call, linked through
+                       // the next_sub array of the poller.
+    bool unpollable;   // Regular files can't be added to an epoll set.
+};
+
+#define FD_POLL_NO_SUB UINT32_MAX
+
+static bool
+fd_poller_init(struct fd_poller *fp)
+{
+    if (!mutex_init(&fp->lock))
+        return false;
+    fp->busy = false;
+    fp->epfd = -1;
+    fp->generation = 0;
+    fp->last_id = 0;
+    fp->regs = NULL;
+    fp->regs_size = 0;
+    fp->fos = NULL;
+    fp->next_sub = NULL;
+    fp->subs_size = 0;
+    return true;
+}
+
+static void
+fd_poller_destroy(struct fd_poller *fp)
+{
+    if (fp->epfd >= 0)
+        close(fp->epfd);
+    if (fp->regs)
+        wasm_runtime_free(fp->regs);
+    if (fp->fos)
+        wasm_runtime_free(fp->fos);
+    if (fp->next_sub)
+        wasm_runtime_free(fp->next_sub);
+    mutex_destroy(&fp->lock);
+}
+#endif
+
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+// Entry array of the table, allocated with its capacity in front of it.
+// Lock-free lookups load the entries pointer once and bound the file
+// descriptor by the capacity of the array they got, which is never
+// smaller than the table size they may have read. Arrays replaced by a
+// larger one are chained on the retired list, as racing lookups may still
+// read them.
+struct fd_entry_array {
+    struct fd_entry_array *next_retired;
+    size_t size;
+    struct fd_entry entries[1];
+};
+
+#define FD_ENTRY_ARRAY(e) \
+    ((struct fd_entry_array *)((uint8 *)(e)                               \
+                               - offsetof(struct fd_entry_array, entries)))
+
+// Marks the start of a modification of the table entries visible to
+// lock-free lookups.
+static void
+fd_table_write_begin(struct fd_table *ft) REQUIRES_EXCLUSIVE(ft->lock)
+{
+    __atomic_store_n(&ft->seq, ft->seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static void
+fd_table_write_end(struct fd_table *ft) REQUIRES_EXCLUSIVE(ft->lock)
+{
+    __atomic_store_n(&ft->seq, ft->seq + 1, __ATOMIC_RELEASE);
+}
+#else
+#define fd_table_write_begin(ft) (void)0
+#define fd_table_write_end(ft) (void)0
+#endif
+
 bool
 fd_table_init(struct fd_table *ft)
 {
     if (!rwlock_initialize(&ft->lock))
         return false;
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+    if (!mutex_init(&ft->free_objects_lock)) {
+        rwlock_destroy(&ft->lock);
+        return false;
+    }
+    ft->seq = 0;
+    ft->retired = NULL;
+    ft->free_objects = NULL;
+#endif
+#if CONFIG_HAS_EPOLL
+    if (!fd_poller_init(&ft->poller)) {
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        mutex_destroy(&ft->free_objects_lock);
+#endif
+        rwlock_destroy(&ft->lock);
+        return false;
+    }
+#endif
+#if CONFIG_HAS_FD_MAP
+    if (!mutex_init(&ft->mappings_lock)) {
+#if CONFIG_HAS_EPOLL
+        fd_poller_destroy(&ft->poller);
+#endif
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        mutex_destroy(&ft->free_objects_lock);
+#endif
+        rwlock_destroy(&ft->lock);
+        return false;
+    }
+    ft->mappings = NULL;
+#endif
+#if CONFIG_HAS_SENDFILE
+    ft->splice_pipe = -1;
+#endif
     ft->entries = NULL;
     ft->size = 0;
     ft->used = 0;
@@ -383,40 +514,92 @@ fd_table_grow(struct fd_table *ft, size_t min, size_t incr)
             size *= 2;
 
         // Grow the file descriptor table's allocation.
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        struct fd_entry_array *array = wasm_runtime_malloc(
+            (uint32)(offsetof(struct fd_entry_array, entries)
+                     + sizeof(struct fd_entry) * size));
+        if (array == NULL)
+            return false;
+        array->next_retired = NULL;
+        array->size = size;
+        struct fd_entry *entries = array->entries;
+#else
         struct fd_entry *entries =
             wasm_runtime_malloc((uint32)(sizeof(*entries) * size));
         if (entries == NULL)
             return false;
+#endif
 
         if (ft->entries && ft->size > 0) {
             bh_memcpy_s(entries, (uint32)(sizeof(*entries) * size), ft->entries,
                         (uint32)(sizeof(*entries) * ft->size));
         }
 
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        // Lock-free lookups may still read the old entries, keep them
+        // until the table is destroyed.
+        if (ft->entries) {
+            struct fd_entry_array *retired = FD_ENTRY_ARRAY(ft->entries);
+            retired->next_retired = ft->retired;
+            ft->retired = retired;
+        }
+#else
         if (ft->entries)
             wasm_runtime_free(ft->entries);
+#endif
 
         // Mark all new file descriptors as unused.
         for (size_t i = ft->size; i < size; ++i)
             entries[i].object = NULL;
+        fd_table_write_begin(ft);
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        // Publishes the initialized array together with its capacity.
+        __atomic_store_n(&ft->entries, entries, __ATOMIC_RELEASE);
+#else
         ft->entries = entries;
+#endif
         ft->size = size;
+        fd_table_write_end(ft);
     }
     return true;
 }
 
 // Allocates a new file descriptor object.
 static __wasi_errno_t
-fd_object_new(__wasi_filetype_t type, bool is_stdio, struct fd_object **fo)
-    TRYLOCKS_SHARED(0, (*fo)->refcount)
+fd_object_new(struct fd_table *ft, __wasi_filetype_t type, bool is_stdio,
+              struct fd_object **fo) TRYLOCKS_SHARED(0, (*fo)->refcount)
 {
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+    // Reuse a released object if possible. Its reference counter starts a
+    // new generation, so that lookups which read it as the object of the
+    // closed file descriptor can't take a reference on it anymore.
+    mutex_lock(&ft->free_objects_lock);
+    *fo = ft->free_objects;
+    if (*fo != NULL)
+        ft->free_objects = (*fo)->next_free;
+    mutex_unlock(&ft->free_objects_lock);
+    if (*fo != NULL) {
+        refcount_reinit(&(*fo)->refcount, 1);
+    }
+    else {
+        if ((*fo = wasm_runtime_malloc(sizeof(**fo))) == NULL)
+            return __WASI_ENOMEM;
+        refcount_init(&(*fo)->refcount, 1);
+    }
+    (*fo)->table = ft;
+#else
+    (void)ft;
     *fo = wasm_runtime_malloc(sizeof(**fo));
     if (*fo == NULL)
         return __WASI_ENOMEM;
     refcount_init(&(*fo)->refcount, 1);
+#endif
     (*fo)->type = type;
     (*fo)->file_handle = os_get_invalid_handle();
     (*fo)->is_stdio = is_stdio;
+#if CONFIG_HAS_EPOLL
+    (*fo)->poll_id = 0;
+#endif
     return 0;
 }
 
@@ -430,9 +613,11 @@ fd_table_attach(struct fd_table *ft, __wasi_fd_t fd, struct fd_object *fo,
     struct fd_entry *fe = &ft->entries[fd];
     assert(fe->object == NULL
            && "Attempted to overwrite an existing descriptor");
+    fd_table_write_begin(ft);
     fe->object = fo;
     fe->rights_base = rights_base;
     fe->rights_inheriting = rights_inheriting;
+    fd_table_write_end(ft);
     ++ft->used;
     assert(ft->size >= ft->used * 2 && "File descriptor too full");
 }
@@ -446,7 +631,9 @@ fd_table_detach(struct fd_table *ft, __wasi_fd_t fd, struct fd_object **fo)
     struct fd_entry *fe = &ft->entries[fd];
     *fo = fe->object;
     assert(*fo != NULL && "Attempted to detach nonexistent descriptor");
+    fd_table_write_begin(ft);
     fe->object = NULL;
+    fd_table_write_end(ft);
     assert(ft->used > 0 && "Reference count mismatch");
     --ft->used;
 }
@@ -575,7 +762,17 @@ fd_object_release(wasm_exec_env_t env, struct fd_object *fo)
                                                           fo->is_stdio);
                 break;
         }
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        // Lock-free lookups may still try to take a reference, keep the
+        // memory of the object alive for the lifetime of the table.
+        struct fd_table *ft = fo->table;
+        mutex_lock(&ft->free_objects_lock);
+        fo->next_free = ft->free_objects;
+        ft->free_objects = fo;
+        mutex_unlock(&ft->free_objects_lock);
+#else
         wasm_runtime_free(fo);
+#endif
         errno = saved_errno;
     }
     return error;
@@ -607,7 +804,7 @@ fd_table_insert_existing(struct fd_table *ft, __wasi_fd_t in,
 #endif
     }
 
-    error = fd_object_new(type, is_stdio, &fo);
+    error = fd_object_new(ft, type, is_stdio, &fo);
     if (error != 0)
         return false;
     fo->file_handle = out;
@@ -689,7 +886,7 @@ fd_table_insert_fd(wasm_exec_env_t exec_env, struct fd_table *ft,
 {
     struct fd_object *fo;
 
-    __wasi_errno_t error = fd_object_new(type, false, &fo);
+    __wasi_errno_t error = fd_object_new(ft, type, false, &fo);
     if (error != 0) {
         os_close(in, false);
         return error;
@@ -814,14 +1011,57 @@ fd_object_get_locked(struct fd_object **fo, struct fd_table *ft, __wasi_fd_t fd,
     return 0;
 }
 
-// Temporarily locks the file descriptor table to look up a file
-// descriptor object, increases its reference count and drops the lock.
+// Looks up a file descriptor object and increases its reference count.
 static __wasi_errno_t
 fd_object_get(struct fd_table *curfds, struct fd_object **fo, __wasi_fd_t fd,
               __wasi_rights_t rights_base, __wasi_rights_t rights_inheriting)
     TRYLOCKS_EXCLUSIVE(0, (*fo)->refcount)
 {
     struct fd_table *ft = curfds;
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+    // Read the entry without taking the lock, so that threads doing I/O on
+    // different file descriptors don't contend on it. The read is retried
+    // if the table got modified meanwhile.
+    for (;;) {
+        unsigned int seq = __atomic_load_n(&ft->seq, __ATOMIC_ACQUIRE);
+        if ((seq & 1) != 0)
+            // Modification in progress, wait for it on the lock.
+            break;
+
+        struct fd_entry *entries =
+            __atomic_load_n(&ft->entries, __ATOMIC_ACQUIRE);
+        struct fd_object *object = NULL;
+        __wasi_rights_t base = 0, inheriting = 0;
+        unsigned long long count = 0;
+        if (entries != NULL && fd < FD_ENTRY_ARRAY(entries)->size) {
+            object = __atomic_load_n(&entries[fd].object, __ATOMIC_RELAXED);
+            base = __atomic_load_n(&entries[fd].rights_base, __ATOMIC_RELAXED);
+            inheriting = __atomic_load_n(&entries[fd].rights_inheriting,
+                                         __ATOMIC_RELAXED);
+            if (object != NULL)
+                count = refcount_load(&object->refcount);
+        }
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&ft->seq, __ATOMIC_RELAXED) != seq)
+            continue;
+
+        // Test for file descriptor existence and validate rights.
+        if (object == NULL)
+            return __WASI_EBADF;
+        if ((~base & rights_base) != 0 || (~inheriting & rights_inheriting) != 0)
+            return __WASI_ENOTCAPABLE;
+
+        // The object was referenced by the table when its counter was read.
+        // If the counter neither dropped to zero nor got reinitialized
+        // since, the object stayed alive and the lookup is ordered before
+        // the modification. Otherwise nothing was taken, so nothing needs
+        // to be released here.
+        if (!refcount_acquire_if_unchanged(&object->refcount, count))
+            continue;
+        *fo = object;
+        return 0;
+    }
+#endif
     rwlock_rdlock(&ft->lock);
     __wasi_errno_t error =
         fd_object_get_locked(fo, ft, fd, rights_base, rights_inheriting);
@@ -943,7 +1183,6 @@ wasmtime_ssp_fd_renumber(wasm_exec_env_t exec_env, struct fd_table *curfds,
     // Remove the old fd from the file descriptor table.
     fd_table_detach(ft, from, &fo);
     fd_object_release(exec_env, fo);
-    --ft->used;
 
     // Handle renumbering of any preopened resources
     struct fd_prestat *prestat_from;
@@ -1110,8 +1349,10 @@ wasmtime_ssp_fd_fdstat_set_rights(wasm_exec_env_t exec_env,
     }
 
     // Restrict the rights on the file descriptor.
+    fd_table_write_begin(ft);
     fe->rights_base = fs_rights_base;
     fe->rights_inheriting = fs_rights_inheriting;
+    fd_table_write_end(ft);
     rwlock_unlock(&ft->lock);
     return 0;
 }
@@ -1214,6 +1455,130 @@ wasmtime_ssp_fd_allocate(wasm_exec_env_t exec_env, struct fd_table *curfds,
     return error;
 }
 
+#if CONFIG_HAS_FD_MAP
+// Range of the linear memory mapped by fd_map().
+struct fd_mapping {
+    struct fd_mapping *next;
+    uint8 *buf;
+    size_t len;
+};
+
+__wasi_errno_t
+wasmtime_ssp_fd_map(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                    __wasi_fd_t fd, __wasi_filesize_t offset, void *buf,
+                    size_t len)
+{
+    struct fd_object *fo;
+    struct fd_mapping *mapping;
+    struct stat sb;
+    uint64 page_size = (uint64)os_getpagesize();
+    uint64 mapped_end;
+    void *ret;
+
+    // The destination is validated and page aligned by the caller.
+    if (len == 0 || offset % page_size != 0)
+        return __WASI_EINVAL;
+
+    __wasi_errno_t error =
+        fd_object_get(curfds, &fo, fd, __WASI_RIGHT_FD_READ, 0);
+    if (error != __WASI_ESUCCESS)
+        return error;
+
+    if (fo->type != __WASI_FILETYPE_REGULAR_FILE) {
+        error = __WASI_EBADF;
+        goto fail;
+    }
+
+    if (fstat(fo->file_handle, &sb) < 0) {
+        error = convert_errno(errno);
+        goto fail;
+    }
+
+    // Touching a page that lies entirely beyond the end of the file raises
+    // SIGBUS, so only allow mapping up to the page holding the last byte.
+    // The tail of that page reads as zeroes.
+    mapped_end = ((uint64)sb.st_size + page_size - 1) & ~(page_size - 1);
+    if (offset > mapped_end || len > mapped_end - offset) {
+        error = __WASI_EINVAL;
+        goto fail;
+    }
+
+    if (!(mapping = wasm_runtime_malloc(sizeof(*mapping)))) {
+        error = __WASI_ENOMEM;
+        goto fail;
+    }
+    mapping->buf = buf;
+    mapping->len = len;
+
+    mutex_lock(&curfds->mappings_lock);
+    // A range can only be mapped once, so that fd_unmap() always puts
+    // back what a single fd_map() replaced.
+    for (struct fd_mapping *m = curfds->mappings; m != NULL; m = m->next) {
+        if (mapping->buf < m->buf + m->len && m->buf < mapping->buf + len) {
+            mutex_unlock(&curfds->mappings_lock);
+            wasm_runtime_free(mapping);
+            error = __WASI_EINVAL;
+            goto fail;
+        }
+    }
+
+    // Private mappings are copy-on-write, so writes made by the instance
+    // never reach the file or other instances sharing its page cache.
+    ret = mmap(buf, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+               fo->file_handle, (off_t)offset);
+    if (ret == MAP_FAILED) {
+        error = convert_errno(errno);
+        wasm_runtime_free(mapping);
+    }
+    else {
+        mapping->next = curfds->mappings;
+        curfds->mappings = mapping;
+    }
+    mutex_unlock(&curfds->mappings_lock);
+
+fail:
+    fd_object_release(exec_env, fo);
+    return error;
+}
+
+__wasi_errno_t
+wasmtime_ssp_fd_unmap(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                      void *buf, size_t len)
+{
+    struct fd_mapping **link, *mapping;
+    __wasi_errno_t error = __WASI_ESUCCESS;
+    void *ret;
+
+    (void)exec_env;
+
+    mutex_lock(&curfds->mappings_lock);
+    // Only a range mapped by fd_map() can be unmapped, as a whole.
+    for (link = &curfds->mappings; (mapping = *link) != NULL;
+         link = &mapping->next) {
+        if (mapping->buf == buf && mapping->len == len)
+            break;
+    }
+    if (mapping == NULL) {
+        error = __WASI_EINVAL;
+        goto unlock;
+    }
+
+    // Put back zeroed anonymous pages, as if the region had been cleared.
+    ret = mmap(buf, len, PROT_READ | PROT_WRITE,
+               MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    if (ret == MAP_FAILED) {
+        error = convert_errno(errno);
+        goto unlock;
+    }
+    *link = mapping->next;
+    wasm_runtime_free(mapping);
+
+unlock:
+    mutex_unlock(&curfds->mappings_lock);
+    return error;
+}
+#endif
+
 // Reads the entire contents of a symbolic link, returning the contents
 // in an allocated buffer. The allocated buffer is large enough to fit
 // at least one extra byte, so the caller may append a trailing slash to
@@ -2083,6 +2448,378 @@ wasmtime_ssp_path_remove_directory(wasm_exec_env_t exec_env,
     return error;
 }
 
+#if CONFIG_HAS_EPOLL
+// Looks up the registration of a host file descriptor, growing the
+// registration table if needed.
+static struct fd_poll_reg *
+fd_poller_get_reg(struct fd_poller *fp, os_file_handle handle)
+{
+    if (handle < 0)
+        return NULL;
+
+    if ((size_t)handle >= fp->regs_size) {
+        size_t size = fp->regs_size == 0 ? 64 : fp->regs_size;
+        while (size <= (size_t)handle)
+            size *= 2;
+
+        struct fd_poll_reg *regs =
+            wasm_runtime_malloc((uint32)(sizeof(*regs) * size));
+        if (regs == NULL)
+            return NULL;
+
+        memset(regs, 0, sizeof(*regs) * size);
+        if (fp->regs) {
+            bh_memcpy_s(regs, (uint32)(sizeof(*regs) * size), fp->regs,
+                        (uint32)(sizeof(*regs) * fp->regs_size));
+            wasm_runtime_free(fp->regs);
+        }
+        fp->regs = regs;
+        fp->regs_size = size;
+    }
+    return &fp->regs[handle];
+}
+
+// Makes sure the per-call scratch arrays can hold all subscriptions.
+static bool
+fd_poller_reserve_subs(struct fd_poller *fp, size_t nsubscriptions)
+{
+    if (nsubscriptions <= fp->subs_size)
+        return true;
+
+    size_t size = fp->subs_size == 0 ? 16 : fp->subs_size;
+    while (size < nsubscriptions)
+        size *= 2;
+
+    struct fd_object **fos =
+        wasm_runtime_malloc((uint32)(sizeof(*fos) * size));
+    uint32 *next_sub = wasm_runtime_malloc((uint32)(sizeof(*next_sub) * size));
+    if (fos == NULL || next_sub == NULL) {
+        if (fos)
+            wasm_runtime_free(fos);
+        if (next_sub)
+            wasm_runtime_free(next_sub);
+        return false;
+    }
+
+    if (fp->fos)
+        wasm_runtime_free(fp->fos);
+    if (fp->next_sub)
+        wasm_runtime_free(fp->next_sub);
+    fp->fos = fos;
+    fp->next_sub = next_sub;
+    fp->subs_size = size;
+    return true;
+}
+
+// Brings the epoll registration of a host file descriptor in line with
+// the events requested by the current call.
+static __wasi_errno_t
+fd_poller_update(struct fd_poller *fp, struct fd_poll_reg *reg,
+                 os_file_handle handle)
+{
+    struct epoll_event ev = { .events = reg->wanted, .data.fd = handle };
+    int op = reg->registered == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD;
+
+    if (epoll_ctl(fp->epfd, op, handle, &ev) != 0) {
+        // The kernel drops the registration when a descriptor is closed,
+        // while a registration made for a previous object with the same
+        // descriptor number may still be around.
+        if (errno == ENOENT)
+            op = EPOLL_CTL_ADD;
+        else if (errno == EEXIST)
+            op = EPOLL_CTL_MOD;
+        else
+            return convert_errno(errno);
+        if (epoll_ctl(fp->epfd, op, handle, &ev) != 0)
+            return convert_errno(errno);
+    }
+    reg->registered = reg->wanted;
+    return 0;
+}
+
+// Emits an event for every subscription on a descriptor that is ready.
+static void
+fd_poller_report(struct fd_poller *fp, struct fd_poll_reg *reg,
+                 uint32 revents, const __wasi_subscription_t *in,
+                 __wasi_event_t *out, size_t *nevents)
+{
+    for (uint32 i = reg->first_sub; i != FD_POLL_NO_SUB;
+         i = fp->next_sub[i]) {
+        bool is_read = in[i].u.type == __WASI_EVENTTYPE_FD_READ;
+        uint32 mask = (is_read ? EPOLLIN : EPOLLOUT) | EPOLLERR | EPOLLHUP;
+        if ((revents & mask) == 0)
+            continue;
+
+        __wasi_filesize_t nbytes = 0;
+        if (is_read) {
+            int l;
+            if (ioctl(fp->fos[i]->file_handle, FIONREAD, &l) == 0)
+                nbytes = (__wasi_filesize_t)l;
+        }
+
+        if ((revents & EPOLLERR) != 0) {
+            // File descriptor is in an error state.
+            out[(*nevents)++] = (__wasi_event_t){
+                .userdata = in[i].userdata,
+                .error = __WASI_EIO,
+                .type = in[i].u.type,
+            };
+        }
+        else if ((revents & EPOLLHUP) != 0) {
+            // End-of-file.
+            out[(*nevents)++] = (__wasi_event_t){
+                .userdata = in[i].userdata,
+                .type = in[i].u.type,
+                .u.fd_readwrite.nbytes = nbytes,
+                .u.fd_readwrite.flags = __WASI_EVENT_FD_READWRITE_HANGUP,
+            };
+        }
+        else {
+            // Read or write possible.
+            out[(*nevents)++] = (__wasi_event_t){
+                .userdata = in[i].userdata,
+                .type = in[i].u.type,
+                .u.fd_readwrite.nbytes = nbytes,
+            };
+        }
+    }
+    reg->first_sub = FD_POLL_NO_SUB;
+}
+
+// Waits for file descriptor events using the persistent epoll interest
+// set of the file descriptor table. Descriptors stay registered across
+// calls and are only dropped once they report readiness nobody asked for,
+// so the kernel side of a call no longer scales with the number of idle
+// subscriptions. Returns false if the interest set can't be used, e.g.
+// because another thread is polling already, and the caller should fall
+// back to poll().
+static bool
+poll_oneoff_epoll(wasm_exec_env_t exec_env, struct fd_table *ft,
+                  const __wasi_subscription_t *in, __wasi_event_t *out,
+                  size_t nsubscriptions, size_t *nevents,
+                  __wasi_errno_t *errorp) NO_LOCK_ANALYSIS
+{
+    struct fd_poller *fp = &ft->poller;
+
+    if (nsubscriptions == 0 || nsubscriptions >= FD_POLL_NO_SUB)
+        return false;
+
+    mutex_lock(&fp->lock);
+    if (fp->busy) {
+        mutex_unlock(&fp->lock);
+        return false;
+    }
+    if (fp->epfd < 0 && (fp->epfd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        mutex_unlock(&fp->lock);
+        return false;
+    }
+    fp->busy = true;
+    mutex_unlock(&fp->lock);
+
+    if (!fd_poller_reserve_subs(fp, nsubscriptions)) {
+        *errorp = __WASI_ENOMEM;
+        goto done;
+    }
+
+    if (++fp->generation == 0) {
+        for (size_t i = 0; i < fp->regs_size; ++i)
+            fp->regs[i].generation = 0;
+        fp->generation = 1;
+    }
+    uint32 generation = fp->generation;
+
+    // Convert subscriptions to registrations. Increase the reference
+    // count on the file descriptors to ensure they remain valid across
+    // the call to epoll_wait().
+    struct fd_object **fos = fp->fos;
+    rwlock_rdlock(&ft->lock);
+    *nevents = 0;
+    const __wasi_subscription_t *clock_subscription = NULL;
+    for (size_t i = 0; i < nsubscriptions; ++i) {
+        const __wasi_subscription_t *s = &in[i];
+        fos[i] = NULL;
+        switch (s->u.type) {
+            case __WASI_EVENTTYPE_FD_READ:
+            case __WASI_EVENTTYPE_FD_WRITE:
+            {
+                struct fd_poll_reg *reg = NULL;
+                __wasi_errno_t error =
+                    fd_object_get_locked(&fos[i], ft, s->u.u.fd_readwrite.fd,
+                                         __WASI_RIGHT_POLL_FD_READWRITE, 0);
+                if (error == 0
+                    && !(reg = fd_poller_get_reg(fp, fos[i]->file_handle))) {
+                    fd_object_release(exec_env, fos[i]);
+                    fos[i] = NULL;
+                    error = __WASI_ENOMEM;
+                }
+                if (error != 0) {
+                    // Invalid file descriptor or rights missing.
+                    out[(*nevents)++] = (__wasi_event_t){
+                        .userdata = s->userdata,
+                        .error = error,
+                        .type = s->u.type,
+                    };
+                    break;
+                }
+
+                if (fos[i]->poll_id == 0)
+                    fos[i]->poll_id = ++fp->last_id;
+                if (reg->object_id != fos[i]->poll_id) {
+                    reg->object_id = fos[i]->poll_id;
+                    reg->registered = 0;
+                    reg->unpollable = false;
+                }
+                if (reg->generation != generation) {
+                    reg->generation = generation;
+                    reg->wanted = 0;
+                    reg->first_sub = FD_POLL_NO_SUB;
+                }
+                reg->wanted |=
+                    s->u.type == __WASI_EVENTTYPE_FD_READ ? EPOLLIN : EPOLLOUT;
+                fp->next_sub[i] = reg->first_sub;
+                reg->first_sub = (uint32)i;
+                break;
+            }
+            case __WASI_EVENTTYPE_CLOCK:
+                if (clock_subscription == NULL
+                    && (s->u.u.clock.flags & __WASI_SUBSCRIPTION_CLOCK_ABSTIME)
+                           == 0) {
+                    // Relative timeout.
+                    clock_subscription = s;
+                    break;
+                }
+            // Fallthrough.
+            default:
+                // Unsupported event.
+                out[(*nevents)++] = (__wasi_event_t){
+                    .userdata = s->userdata,
+                    .error = __WASI_ENOSYS,
+                    .type = s->u.type,
+                };
+                break;
+        }
+    }
+    rwlock_unlock(&ft->lock);
+
+    // Only touch the kernel interest set for descriptors whose interest
+    // changed since the previous call. Every registration is visited once,
+    // through the last subscription that refers to it.
+    for (size_t i = 0; i < nsubscriptions; ++i) {
+        if (fos[i] == NULL)
+            continue;
+        struct fd_poll_reg *reg = &fp->regs[fos[i]->file_handle];
+        if (reg->first_sub != (uint32)i)
+            continue;
+
+        if (!reg->unpollable && reg->registered != reg->wanted) {
+            __wasi_errno_t error =
+                fd_poller_update(fp, reg, fos[i]->file_handle);
+            if (error == __WASI_EPERM) {
+                reg->unpollable = true;
+            }
+            else if (error != 0) {
+                for (uint32 j = reg->first_sub; j != FD_POLL_NO_SUB;
+                     j = fp->next_sub[j]) {
+                    out[(*nevents)++] = (__wasi_event_t){
+                        .userdata = in[j].userdata,
+                        .error = error,
+                        .type = in[j].u.type,
+                    };
+                }
+                reg->first_sub = FD_POLL_NO_SUB;
+                continue;
+            }
+        }
+        if (reg->unpollable) {
+            // Like poll(), treat regular files as always ready.
+            fd_poller_report(fp, reg, EPOLLIN | EPOLLOUT, in, out, nevents);
+        }
+    }
+
+    // Use a zero-second timeout in case we've already generated events in
+    // the loops above.
+    int timeout;
+    if (*nevents != 0) {
+        timeout = 0;
+    }
+    else if (clock_subscription != NULL) {
+        __wasi_timestamp_t ts = clock_subscription->u.u.clock.timeout / 1000000;
+        timeout = ts > INT_MAX ? -1 : (int)ts;
+    }
+    else {
+        timeout = -1;
+    }
+    uint64 deadline =
+        timeout > 0 ? os_time_get_boot_us() + (uint64)timeout * 1000 : 0;
+
+    struct epoll_event events[64];
+    for (;;) {
+        int ret;
+        __wasi_errno_t error = blocking_op_epoll_wait(
+            exec_env, fp->epfd, events, sizeof(events) / sizeof(events[0]),
+            timeout, &ret);
+        if (error != 0) {
+            *errorp = error;
+            break;
+        }
+
+        size_t reported = *nevents;
+        for (int k = 0; k < ret; ++k) {
+            os_file_handle handle = events[k].data.fd;
+            struct fd_poll_reg *reg = (size_t)handle < fp->regs_size
+                                          ? &fp->regs[handle]
+                                          : NULL;
+            if (reg == NULL || reg->generation != generation) {
+                // Left over from an earlier call. Drop it now rather than
+                // on every call, to keep the interest set stable for
+                // descriptors that are polled repeatedly.
+                epoll_ctl(fp->epfd, EPOLL_CTL_DEL, handle, NULL);
+                if (reg != NULL)
+                    reg->registered = 0;
+                continue;
+            }
+            if ((events[k].events & (reg->wanted | EPOLLERR | EPOLLHUP))
+                == 0) {
+                // Only ready for events requested by an earlier call.
+                (void)fd_poller_update(fp, reg, handle);
+                continue;
+            }
+            fd_poller_report(fp, reg, events[k].events, in, out, nevents);
+        }
+
+        if (*nevents != reported || timeout == 0
+            || (ret == 0 && timeout > 0)) {
+            break;
+        }
+        if (timeout > 0) {
+            // Only stale registrations became ready, wait for the rest
+            // of the timeout.
+            uint64 now = os_time_get_boot_us();
+            timeout =
+                now >= deadline ? 0 : (int)((deadline - now + 999) / 1000);
+        }
+    }
+
+    if (*errorp == 0 && *nevents == 0 && clock_subscription != NULL) {
+        // No events triggered. Trigger the clock event.
+        out[(*nevents)++] = (__wasi_event_t){
+            .userdata = clock_subscription->userdata,
+            .type = __WASI_EVENTTYPE_CLOCK,
+        };
+    }
+
+    for (size_t i = 0; i < nsubscriptions; ++i)
+        if (fos[i] != NULL)
+            fd_object_release(exec_env, fos[i]);
+
+done:
+    mutex_lock(&fp->lock);
+    fp->busy = false;
+    mutex_unlock(&fp->lock);
+    return true;
+}
+#endif
+
 __wasi_errno_t
 wasmtime_ssp_poll_oneoff(wasm_exec_env_t exec_env, struct fd_table *curfds,
                          const __wasi_subscription_t *in, __wasi_event_t *out,
@@ -2172,6 +2909,13 @@ wasmtime_ssp_poll_oneoff(wasm_exec_env_t exec_env, struct fd_table *curfds,
         return 0;
     }
 
+#if CONFIG_HAS_EPOLL
+    __wasi_errno_t epoll_error = 0;
+    if (poll_oneoff_epoll(exec_env, curfds, in, out, nsubscriptions, nevents,
+                          &epoll_error))
+        return epoll_error;
+#endif
+
     // Last option: call into poll(). This can only be done in case all
     // subscriptions consist of __WASI_EVENTTYPE_FD_READ and
     // __WASI_EVENTTYPE_FD_WRITE entries. There may be up to one
@@ -2884,6 +3628,128 @@ wasmtime_ssp_sock_send(wasm_exec_env_t exec_env, struct fd_table *curfds,
     return __WASI_ESUCCESS;
 }
 
+#if CONFIG_HAS_SENDFILE
+// Takes the pipe kept by the table, or creates one if another thread is
+// using it.
+static bool
+splice_pipe_get(struct fd_table *ft, int pipefd[2])
+{
+    int64 cached = __atomic_exchange_n(&ft->splice_pipe, -1, __ATOMIC_ACQUIRE);
+
+    if (cached != -1) {
+        pipefd[0] = (int)(cached >> 32);
+        pipefd[1] = (int)(uint32)cached;
+        return true;
+    }
+    return pipe2(pipefd, O_CLOEXEC) == 0;
+}
+
+// Gives the pipe back to the table if it is empty and the table has none,
+// closes it otherwise.
+static void
+splice_pipe_put(struct fd_table *ft, int pipefd[2], bool empty)
+{
+    int64 expected = -1;
+    int64 packed = (int64)(((uint64)(uint32)pipefd[0] << 32)
+                           | (uint64)(uint32)pipefd[1]);
+
+    if (empty
+        && __atomic_compare_exchange_n(&ft->splice_pipe, &expected, packed,
+                                       false, __ATOMIC_RELEASE,
+                                       __ATOMIC_RELAXED))
+        return;
+    close(pipefd[0]);
+    close(pipefd[1]);
+}
+
+// Moves up to count bytes from a socket or a pipe to out_fd through a
+// pipe, so that the data stays in the kernel. Whatever has been read from
+// in_fd is written out before returning, waiting for out_fd to become
+// writable if needed, as it couldn't be put back otherwise. If writing
+// fails after some of it was written, the count written so far is
+// returned, and the rest, which can't be delivered, is dropped with the
+// pipe.
+static __wasi_errno_t
+sendfile_splice(wasm_exec_env_t exec_env, struct fd_table *ft, int out_fd,
+                int in_fd, size_t count, size_t *ntransferred)
+{
+    int pipefd[2];
+    size_t nread = 0, nwritten = 0, n;
+    __wasi_errno_t error;
+
+    if (!splice_pipe_get(ft, pipefd))
+        return convert_errno(errno);
+
+    error = blocking_op_splice(exec_env, in_fd, pipefd[1], count, &nread);
+
+    while (error == __WASI_ESUCCESS && nwritten < nread) {
+        error = blocking_op_splice(exec_env, pipefd[0], out_fd,
+                                   nread - nwritten, &n);
+        if (error == __WASI_EAGAIN) {
+            struct pollfd pfd = { .fd = out_fd, .events = POLLOUT };
+            int ret;
+
+            error = blocking_op_poll(exec_env, &pfd, 1, -1, &ret);
+        }
+        else if (error == __WASI_ESUCCESS) {
+            nwritten += n;
+        }
+    }
+
+    splice_pipe_put(ft, pipefd, nwritten == nread);
+
+    if (error != __WASI_ESUCCESS && nwritten == 0)
+        return error;
+    *ntransferred = nwritten;
+    return __WASI_ESUCCESS;
+}
+
+__wasi_errno_t
+wasmtime_ssp_sock_sendfile(wasm_exec_env_t exec_env, struct fd_table *curfds,
+                           __wasi_fd_t out_fd, __wasi_fd_t in_fd,
+                           __wasi_filesize_t offset, size_t count,
+                           size_t *ntransferred)
+{
+    struct fd_object *fo_out, *fo_in;
+    __wasi_errno_t error;
+
+    error = fd_object_get(curfds, &fo_in, in_fd, __WASI_RIGHT_FD_READ, 0);
+    if (error != __WASI_ESUCCESS)
+        return error;
+
+    error = fd_object_get(curfds, &fo_out, out_fd, __WASI_RIGHT_FD_WRITE, 0);
+    if (error != __WASI_ESUCCESS) {
+        fd_object_release(exec_env, fo_in);
+        return error;
+    }
+
+    if (fo_in->type == __WASI_FILETYPE_REGULAR_FILE) {
+        // Like pread(), an explicit offset leaves the file position alone.
+        off_t off = (off_t)offset;
+
+        if (offset != UINT64_MAX
+            && (off < 0 || (__wasi_filesize_t)off != offset))
+            error = __WASI_EINVAL;
+        else
+            error = blocking_op_sendfile(exec_env, fo_out->file_handle,
+                                         fo_in->file_handle,
+                                         offset != UINT64_MAX ? &off : NULL,
+                                         count, ntransferred);
+    }
+    else if (offset != UINT64_MAX) {
+        error = __WASI_ESPIPE;
+    }
+    else {
+        error = sendfile_splice(exec_env, curfds, fo_out->file_handle,
+                                fo_in->file_handle, count, ntransferred);
+    }
+
+    fd_object_release(exec_env, fo_out);
+    fd_object_release(exec_env, fo_in);
+    return error;
+}
+#endif
+
 __wasi_errno_t
 wasmtime_ssp_sock_send_to(wasm_exec_env_t exec_env, struct fd_table *curfds,
                           struct addr_pool *addr_pool, __wasi_fd_t sock,
@@ -3034,8 +3900,43 @@ fd_table_destroy(struct fd_table *ft)
                 fd_object_release(NULL, ft->entries[i].object);
             }
         }
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+        wasm_runtime_free(FD_ENTRY_ARRAY(ft->entries));
+#else
         wasm_runtime_free(ft->entries);
+#endif
+    }
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+    while (ft->retired != NULL) {
+        struct fd_entry_array *retired = ft->retired;
+        ft->retired = retired->next_retired;
+        wasm_runtime_free(retired);
+    }
+    while (ft->free_objects != NULL) {
+        struct fd_object *fo = ft->free_objects;
+        ft->free_objects = fo->next_free;
+        wasm_runtime_free(fo);
     }
+    mutex_destroy(&ft->free_objects_lock);
+#endif
+#if CONFIG_HAS_EPOLL
+    fd_poller_destroy(&ft->poller);
+#endif
+#if CONFIG_HAS_FD_MAP
+    // The mappings go away with the linear memory
+    while (ft->mappings != NULL) {
+        struct fd_mapping *mapping = ft->mappings;
+        ft->mappings = mapping->next;
+        wasm_runtime_free(mapping);
+    }
+    mutex_destroy(&ft->mappings_lock);
+#endif
+#if CONFIG_HAS_SENDFILE
+    if (ft->splice_pipe != -1) {
+        close((int)(ft->splice_pipe >> 32));
+        close((int)(uint32)ft->splice_pipe);
+    }
+#endif
     rwlock_destroy(&ft->lock);
 }
 
@@ -15,17 +15,67 @@
 #define POSIX_H
 
 #include "bh_platform.h"
+#include "ssp_config.h"
 #include "locking.h"
 
 struct fd_entry;
+struct fd_object;
 struct fd_prestat;
+struct fd_poll_reg;
+struct fd_entry_array;
+struct fd_mapping;
 struct syscalls;
 
+#if CONFIG_HAS_EPOLL
+// Persistent epoll interest set used by poll_oneoff(). Host file
+// descriptors stay registered across calls, so that a call only issues
+// epoll_ctl() for subscriptions whose interest changed.
+struct fd_poller {
+    struct mutex lock; // Lock to protect members below.
+    bool busy;         // Set while a thread owns the interest set.
+    int epfd;          // Created lazily, -1 until the first poll.
+    uint32 generation; // Incremented on every poll_oneoff() call.
+    uint64 last_id;    // Last identifier handed out to an fd object.
+    struct fd_poll_reg *regs; // Registrations indexed by host fd.
+    size_t regs_size;
+    struct fd_object **fos; // Scratch space sized by subscriptions.
+    uint32 *next_sub;
+    size_t subs_size;
+};
+#endif
+
 struct fd_table {
     struct rwlock lock;
     struct fd_entry *entries;
     size_t size;
     size_t used;
+#if CONFIG_HAS_LOCKFREE_FD_TABLE
+    // Lookups read the table without taking the lock and use the sequence
+    // number to detect concurrent modifications. It is odd while the table
+    // is being modified. Entry arrays replaced by a larger one and released
+    // fd objects are kept around until the table is destroyed, so that a
+    // racing lookup never touches freed memory. Released fd objects are
+    // reused for new file descriptors.
+    unsigned int seq;
+    struct fd_entry_array *retired;
+    struct mutex free_objects_lock;
+    struct fd_object *free_objects;
+#endif
+#if CONFIG_HAS_EPOLL
+    struct fd_poller poller;
+#endif
+#if CONFIG_HAS_FD_MAP
+    // Ranges of the linear memory mapped by fd_map(), the only ones that
+    // fd_unmap() accepts.
+    struct mutex mappings_lock;
+    struct fd_mapping *mappings;
+#endif
+#if CONFIG_HAS_SENDFILE
+    // Empty pipe kept by sock_sendfile() to splice through, with both ends
+    // packed in one word, so that a thread can take it with an atomic
+    // exchange. -1 when there is none.
+    int64 splice_pipe;
+#endif
 };
 
 struct fd_prestats {
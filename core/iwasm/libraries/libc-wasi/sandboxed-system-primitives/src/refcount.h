@@ -25,11 +25,18 @@
 
 #include <stdatomic.h>
 
-/* Simple reference counter. */
+/* Simple reference counter. The upper 32 bits of the counter hold a
+   generation number, which refcount_reinit() increments, so that a
+   reference can be taken on an object only if it wasn't recycled after it
+   was looked up. With a 32-bit generation, a lookup could only be fooled
+   by an object recycled 2^32 times while the lookup is preempted. */
 struct LOCKABLE refcount {
-    atomic_uint count;
+    atomic_ullong count;
 };
 
+#define REFCOUNT_MASK 0xFFFFFFFFull
+#define REFCOUNT_GENERATION_ONE (REFCOUNT_MASK + 1)
+
 /* Initialize the reference counter. */
 static inline void
 refcount_init(struct refcount *r, unsigned int count) PRODUCES(*r)
@@ -37,6 +44,28 @@ refcount_init(struct refcount *r, unsigned int count) PRODUCES(*r)
     atomic_init(&r->count, count);
 }
 
+/* Initialize a reference counter that dropped to zero for reuse, starting
+   a new generation. */
+static inline void
+refcount_reinit(struct refcount *r, unsigned int count) PRODUCES(*r)
+{
+    unsigned long long old =
+        atomic_load_explicit(&r->count, memory_order_relaxed);
+    bh_assert((old & REFCOUNT_MASK) == 0 && "Reinitializing a used counter");
+    atomic_store_explicit(&r->count,
+                          (old & ~REFCOUNT_MASK) + REFCOUNT_GENERATION_ONE
+                              + count,
+                          memory_order_release);
+}
+
+/* Read the reference counter, to be passed to
+   refcount_acquire_if_unchanged(). */
+static inline unsigned long long
+refcount_load(struct refcount *r)
+{
+    return atomic_load_explicit(&r->count, memory_order_relaxed);
+}
+
 /* Increment the reference counter. */
 static inline void
 refcount_acquire(struct refcount *r) PRODUCES(*r)
@@ -44,15 +73,35 @@ refcount_acquire(struct refcount *r) PRODUCES(*r)
     atomic_fetch_add_explicit(&r->count, 1, memory_order_acquire);
 }
 
+/* Increment the reference counter unless it dropped to zero or was
+   reinitialized since `seen` was read, returning whether a reference was
+   taken. */
+static inline bool
+refcount_acquire_if_unchanged(struct refcount *r,
+                              unsigned long long seen) NO_LOCK_ANALYSIS
+{
+    unsigned long long count =
+        atomic_load_explicit(&r->count, memory_order_relaxed);
+    do {
+        if ((count & REFCOUNT_MASK) == 0
+            || ((count ^ seen) & ~REFCOUNT_MASK) != 0)
+            return false;
+    } while (!atomic_compare_exchange_weak_explicit(
+        &r->count, &count, count + 1, memory_order_acquire,
+        memory_order_relaxed));
+    return true;
+}
+
 /* Decrement the reference counter, returning whether the reference
    dropped to zero. */
 static inline bool
 refcount_release(struct refcount *r) CONSUMES(*r)
 {
-    int old =
-        (int)atomic_fetch_sub_explicit(&r->count, 1, memory_order_release);
-    bh_assert(old != 0 && "Reference count becoming negative");
-    return old == 1;
+    unsigned long long old =
+        atomic_fetch_sub_explicit(&r->count, 1, memory_order_release);
+    bh_assert((old & REFCOUNT_MASK) != 0
+              && "Reference count becoming negative");
+    return (old & REFCOUNT_MASK) == 1;
 }
 
 #elif defined(BH_PLATFORM_LINUX_SGX)
@@ -56,6 +56,33 @@
 #define CONFIG_HAS_CLOCK_NANOSLEEP 0
 #endif
 
+// Use a persistent epoll interest set for poll_oneoff() on Linux, so the
+// cost of a call doesn't grow with the number of idle subscriptions.
+#if defined(__linux__) && !defined(BH_PLATFORM_LINUX_SGX) \
+    && !defined(DISABLE_EPOLL)
+#define CONFIG_HAS_EPOLL 1
+#else
+#define CONFIG_HAS_EPOLL 0
+#endif
+
+// Allow fd_map() to map regular files into the linear memory of an instance
+// with MAP_PRIVATE|MAP_FIXED, instead of copying their contents in.
+#if (defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__)) \
+    && !defined(BH_PLATFORM_LINUX_SGX) && !defined(DISABLE_FD_MAP)
+#define CONFIG_HAS_FD_MAP 1
+#else
+#define CONFIG_HAS_FD_MAP 0
+#endif
+
+// Let sock_sendfile() move data between two descriptors in the kernel with
+// sendfile() and splice(), instead of bouncing it through linear memory.
+#if defined(__linux__) && !defined(BH_PLATFORM_LINUX_SGX) \
+    && !defined(DISABLE_SENDFILE)
+#define CONFIG_HAS_SENDFILE 1
+#else
+#define CONFIG_HAS_SENDFILE 0
+#endif
+
 #if defined(__APPLE__) || defined(__CloudABI__)
 #define CONFIG_HAS_PTHREAD_COND_TIMEDWAIT_RELATIVE_NP 1
 #else
@@ -110,4 +137,14 @@ https://gcc.gnu.org/bugzilla/show_bug.cgi?id=58016 */
 
 #endif /* end of !defined(BH_PLATFORM_LINUX_SGX) */
 
+/* Look up file descriptors without taking the fd table lock. This relies
+   on C11 atomics for the reference counters and on the GCC atomic builtins
+   for the table itself. */
+#if CONFIG_HAS_STD_ATOMIC != 0 && (defined(__GNUC__) || defined(__clang__)) \
+    && !defined(DISABLE_LOCKFREE_FD_TABLE)
+#define CONFIG_HAS_LOCKFREE_FD_TABLE 1
+#else
+#define CONFIG_HAS_LOCKFREE_FD_TABLE 0
+#endif
+
 #endif /* end of SSP_CONFIG_H */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#ifdef __wasi__
+#include <wasi/api.h>
+#include <wasi_socket_ext.h>
+#endif
+
+/* Listen on a port of the loopback address picked by the host */
+static int
+listen_loopback(struct sockaddr_in *addr)
+{
+    socklen_t addr_len = sizeof(*addr);
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+
+    assert(sock >= 0);
+    memset(addr, 0, sizeof(*addr));
+    addr->sin_family = AF_INET;
+    addr->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    assert(bind(sock, (struct sockaddr *)addr, sizeof(*addr)) == 0);
+    assert(listen(sock, 8) == 0);
+    assert(getsockname(sock, (struct sockaddr *)addr, &addr_len) == 0);
+    return sock;
+}
+
+/* Connect a new socket to the listener, and return it together with the
+   accepted end of the connection */
+static int
+connect_loopback(int listener, const struct sockaddr_in *addr, int *accepted)
+{
+    struct sockaddr_in peer;
+    socklen_t peer_len = sizeof(peer);
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+
+    assert(sock >= 0);
+    assert(connect(sock, (const struct sockaddr *)addr, sizeof(*addr)) == 0);
+    *accepted = accept(listener, (struct sockaddr *)&peer, &peer_len);
+    assert(*accepted >= 0);
+    return sock;
+}
+
+/* Whether fd becomes readable within timeout_ms */
+static int
+poll_in(int fd, int timeout_ms)
+{
+    struct pollfd pfd = { .fd = fd, .events = POLLIN };
+    int ret = poll(&pfd, 1, timeout_ms);
+
+    assert(ret >= 0);
+    return ret > 0 && (pfd.revents & POLLIN);
+}
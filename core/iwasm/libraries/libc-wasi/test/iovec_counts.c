@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <sys/uio.h>
+#include "common.h"
+
+/* One more than the iovecs the host translates on its stack */
+#define IOV_COUNT 9
+#define IOV_TOTAL (IOV_COUNT * (IOV_COUNT + 1) / 2)
+
+static char send_bufs[IOV_COUNT][IOV_COUNT];
+static char recv_bufs[IOV_COUNT][IOV_COUNT];
+
+/* Gather entries of 1..9 bytes, the stream holds 'a', 'b', ... */
+static void
+init_send_iovecs(struct iovec *iov)
+{
+    int i, j, k = 0;
+
+    for (i = 0; i < IOV_COUNT; i++) {
+        for (j = 0; j <= i; j++)
+            send_bufs[i][j] = 'a' + k++ % 26;
+        iov[i].iov_base = send_bufs[i];
+        iov[i].iov_len = i + 1;
+    }
+}
+
+/* Scatter entries of 9..1 bytes, so that no entry matches a sent one */
+static void
+init_recv_iovecs(struct iovec *iov)
+{
+    int i;
+
+    memset(recv_bufs, 0, sizeof(recv_bufs));
+    for (i = 0; i < IOV_COUNT; i++) {
+        iov[i].iov_base = recv_bufs[i];
+        iov[i].iov_len = IOV_COUNT - i;
+    }
+}
+
+static void
+check_recv_iovecs(void)
+{
+    int i, j, k = 0;
+
+    for (i = 0; i < IOV_COUNT; i++)
+        for (j = 0; j < IOV_COUNT - i; j++)
+            assert(recv_bufs[i][j] == 'a' + k++ % 26);
+}
+
+int
+main()
+{
+    struct sockaddr_in addr;
+    struct iovec send_iov[IOV_COUNT], recv_iov[IOV_COUNT];
+    struct msghdr send_msg = { .msg_iov = send_iov, .msg_iovlen = IOV_COUNT };
+    struct msghdr recv_msg = { .msg_iov = recv_iov, .msg_iovlen = IOV_COUNT };
+    int listener, client, server;
+    char c;
+
+    listener = listen_loopback(&addr);
+    client = connect_loopback(listener, &addr, &server);
+
+    /* Empty lists transfer nothing */
+    init_send_iovecs(send_iov);
+    init_recv_iovecs(recv_iov);
+    assert(writev(client, send_iov, 0) == 0);
+    assert(!poll_in(server, 10));
+    assert(readv(server, recv_iov, 0) == 0);
+
+    /* fd_write and fd_read with lists longer than the stack buffer */
+    assert(writev(client, send_iov, IOV_COUNT) == IOV_TOTAL);
+    assert(poll_in(server, 1000));
+    assert(readv(server, recv_iov, IOV_COUNT) == IOV_TOTAL);
+    check_recv_iovecs();
+
+    /* The same through sock_send and sock_recv */
+    init_recv_iovecs(recv_iov);
+    assert(sendmsg(client, &send_msg, 0) == IOV_TOTAL);
+    assert(poll_in(server, 1000));
+    assert(recvmsg(server, &recv_msg, 0) == IOV_TOTAL);
+    check_recv_iovecs();
+
+    /* Single entries take the direct path of the socket functions */
+    send_msg.msg_iov = &send_iov[1];
+    send_msg.msg_iovlen = 1;
+    recv_msg.msg_iov = &recv_iov[8];
+    recv_msg.msg_iovlen = 1;
+    assert(sendmsg(client, &send_msg, 0) == 2);
+    assert(poll_in(server, 1000));
+    assert(recvmsg(server, &recv_msg, 0) == 1);
+    assert(read(server, &c, 1) == 1);
+    assert(recv_bufs[8][0] == 'b' && c == 'c');
+
+    close(server);
+    close(client);
+    close(listener);
+    return 0;
+}
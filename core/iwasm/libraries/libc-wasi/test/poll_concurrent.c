@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <pthread.h>
+
+#include "common.h"
+
+static void *
+poll_long(void *arg)
+{
+    int fd = *(int *)arg;
+
+    /* Holds the interest set of poll_oneoff while it waits */
+    assert(poll_in(fd, 10000));
+    return NULL;
+}
+
+/* A thread polling while another one holds the interest set falls back to
+   poll(), both must see their events */
+int
+main()
+{
+    struct sockaddr_in addr;
+    int listener, client_a, server_a, client_b, server_b;
+    pthread_t tid;
+    char c;
+
+    listener = listen_loopback(&addr);
+    client_a = connect_loopback(listener, &addr, &server_a);
+    client_b = connect_loopback(listener, &addr, &server_b);
+
+    assert(pthread_create(&tid, NULL, poll_long, &server_a) == 0);
+    /* Let the thread start waiting */
+    usleep(100 * 1000);
+
+    assert(!poll_in(server_b, 10));
+    assert(write(client_b, "b", 1) == 1);
+    assert(poll_in(server_b, 1000));
+    assert(read(server_b, &c, 1) == 1 && c == 'b');
+
+    assert(write(client_a, "a", 1) == 1);
+    assert(pthread_join(tid, NULL) == 0);
+    assert(read(server_a, &c, 1) == 1 && c == 'a');
+
+    /* The interest set is used again once the thread is done */
+    assert(!poll_in(server_b, 10));
+    assert(write(client_b, "b", 1) == 1);
+    assert(poll_in(server_b, 1000));
+    assert(read(server_b, &c, 1) == 1 && c == 'b');
+
+    close(server_b);
+    close(client_b);
+    close(server_a);
+    close(client_a);
+    close(listener);
+    return 0;
+}
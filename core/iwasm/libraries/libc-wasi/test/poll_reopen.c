@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "common.h"
+
+/* Descriptors stay in the interest set of poll_oneoff across calls,
+   closing or replacing them mustn't leak their readiness to the new
+   objects behind the same descriptor numbers */
+int
+main()
+{
+    struct sockaddr_in addr;
+    int listener, client1, server1, client2, server2, client3, server3;
+    char c;
+
+    listener = listen_loopback(&addr);
+
+    /* Register server1 in the interest set, with data left unread */
+    client1 = connect_loopback(listener, &addr, &server1);
+    assert(!poll_in(server1, 10));
+    assert(write(client1, "1", 1) == 1);
+    assert(poll_in(server1, 1000));
+
+    /* Close it while it is registered, the host reuses its descriptor
+       for the next connection */
+    close(server1);
+    close(client1);
+    client2 = connect_loopback(listener, &addr, &server2);
+    assert(!poll_in(server2, 10));
+    assert(write(client2, "2", 1) == 1);
+    assert(poll_in(server2, 1000));
+    assert(read(server2, &c, 1) == 1 && c == '2');
+    assert(!poll_in(server2, 10));
+
+    /* Replace the registered object of the same fd with fd_renumber */
+    assert(write(client2, "2", 1) == 1);
+    assert(poll_in(server2, 1000));
+    client3 = connect_loopback(listener, &addr, &server3);
+    assert(__wasi_fd_renumber(server3, server2) == 0);
+    assert(!poll_in(server2, 10));
+    assert(write(client3, "3", 1) == 1);
+    assert(poll_in(server2, 1000));
+    assert(read(server2, &c, 1) == 1 && c == '3');
+
+    close(server2);
+    close(client3);
+    close(client2);
+    close(listener);
+    return 0;
+}
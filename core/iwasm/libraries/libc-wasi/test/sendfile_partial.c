@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include "common.h"
+
+#define FILE_PATH "fs-tests.dir/sendfile_partial.txt"
+/* More than the send and receive buffers of a loopback connection hold */
+#define LARGE_SIZE (32 * 1024 * 1024)
+#define CHUNK_SIZE (64 * 1024)
+
+static char buf[CHUNK_SIZE];
+
+static char
+pattern(size_t pos)
+{
+    return (char)(pos * 7 + pos / 251);
+}
+
+static int
+create_file(size_t size)
+{
+    size_t pos, i, len;
+    int fd = open(FILE_PATH, O_CREAT | O_TRUNC | O_RDWR, 0644);
+
+    assert(fd >= 0);
+    for (pos = 0; pos < size; pos += len) {
+        len = size - pos < CHUNK_SIZE ? size - pos : CHUNK_SIZE;
+        for (i = 0; i < len; i++)
+            buf[i] = pattern(pos + i);
+        assert(write(fd, buf, len) == (ssize_t)len);
+    }
+    assert(lseek(fd, 0, SEEK_SET) == 0);
+    return fd;
+}
+
+/* Read what is available from fd, which must continue the pattern at
+   *pos, without blocking if block is 0 */
+static size_t
+receive(int fd, size_t *pos, int block)
+{
+    size_t total = 0, i;
+    ssize_t n;
+
+    while (poll_in(fd, block && total == 0 ? 1000 : 0)) {
+        assert((n = read(fd, buf, sizeof(buf))) > 0);
+        for (i = 0; i < (size_t)n; i++)
+            assert(buf[i] == pattern(*pos + i));
+        *pos += n;
+        total += n;
+    }
+    return total;
+}
+
+/* Receive exactly size bytes */
+static void
+receive_all(int fd, size_t *pos, size_t size)
+{
+    size_t end = *pos + size;
+
+    while (*pos < end)
+        assert(receive(fd, pos, 1) > 0);
+    assert(*pos == end);
+}
+
+int
+main()
+{
+    struct sockaddr_in addr;
+    int listener, client, server, client2, server2, file;
+    size_t sent, received;
+    ssize_t n;
+    off_t offset;
+    int partial = 0;
+
+    listener = listen_loopback(&addr);
+    client = connect_loopback(listener, &addr, &server);
+
+    /* A count past the end of the file sends the rest, then nothing */
+    file = create_file(1000);
+    received = 0;
+    assert(sendfile(client, file, NULL, 4096) == 1000);
+    assert(sendfile(client, file, NULL, 4096) == 0);
+    receive_all(server, &received, 1000);
+    assert(!poll_in(server, 10));
+
+    /* An explicit offset is advanced instead of the file position */
+    assert(lseek(file, 100, SEEK_SET) == 100);
+    offset = 500;
+    received = 500;
+    assert(sendfile(client, file, &offset, 200) == 200);
+    assert(offset == 700);
+    assert(lseek(file, 0, SEEK_CUR) == 100);
+    receive_all(server, &received, 200);
+    offset = 900;
+    received = 900;
+    assert(sendfile(client, file, &offset, 200) == 100);
+    assert(offset == 1000);
+    receive_all(server, &received, 100);
+    close(file);
+
+    /* Between sockets, only the bytes available are moved */
+    client2 = connect_loopback(listener, &addr, &server2);
+    received = 0;
+    for (sent = 0; sent < 10; sent++)
+        buf[sent] = pattern(sent);
+    assert(write(client2, buf, 10) == 10);
+    assert(poll_in(server2, 1000));
+    assert(sendfile(client, server2, NULL, 4096) == 10);
+    receive_all(server, &received, 10);
+
+    /* A nonblocking socket whose peer doesn't read takes only a part of a
+       large file, every byte counted is delivered */
+    file = create_file(LARGE_SIZE);
+    assert(fcntl(client, F_SETFL, O_NONBLOCK) == 0);
+    sent = received = 0;
+    while (sent < LARGE_SIZE) {
+        n = sendfile(client, file, NULL, LARGE_SIZE - sent);
+        if (n < 0) {
+            assert(errno == EAGAIN);
+            assert(receive(server, &received, 1) > 0);
+            continue;
+        }
+        assert(n > 0);
+        if ((size_t)n < LARGE_SIZE - sent)
+            partial = 1;
+        sent += n;
+        assert(lseek(file, 0, SEEK_CUR) == (off_t)sent);
+        receive(server, &received, 0);
+    }
+    assert(partial);
+    receive_all(server, &received, sent - received);
+    assert(received == LARGE_SIZE);
+    assert(!poll_in(server, 10));
+    close(file);
+    unlink(FILE_PATH);
+
+    close(server2);
+    close(client2);
+    close(server);
+    close(client);
+    close(listener);
+    return 0;
+}
@@ -489,6 +489,19 @@ wasm_clusters_search_exec_env(WASMModuleInstanceCommon *module_inst)
     return NULL;
 }
 
+#if WASM_ENABLE_FUEL != 0
+/* A new thread starts with the fuel left of its parent and is refilled by
+   the same callback, so that the guest can't escape the metering by
+   spawning threads */
+static void
+inherit_fuel(WASMExecEnv *new_exec_env, WASMExecEnv *exec_env)
+{
+    new_exec_env->fuel = exec_env->fuel;
+    new_exec_env->fuel_exhausted_callback = exec_env->fuel_exhausted_callback;
+    new_exec_env->fuel_exhausted_user_data = exec_env->fuel_exhausted_user_data;
+}
+#endif
+
 WASMExecEnv *
 wasm_cluster_spawn_exec_env(WASMExecEnv *exec_env)
 {
@@ -564,6 +577,10 @@ wasm_cluster_spawn_exec_env(WASMExecEnv *exec_env)
     new_exec_env->suspend_flags.flags =
         (exec_env->suspend_flags.flags & WASM_SUSPEND_FLAG_INHERIT_MASK);
 
+#if WASM_ENABLE_FUEL != 0
+    inherit_fuel(new_exec_env, exec_env);
+#endif
+
     if (!wasm_cluster_add_exec_env(cluster, new_exec_env)) {
         goto fail3;
     }
@@ -741,6 +758,10 @@ wasm_cluster_create_thread(WASMExecEnv *exec_env,
     new_exec_env->suspend_flags.flags =
         (exec_env->suspend_flags.flags & WASM_SUSPEND_FLAG_INHERIT_MASK);
 
+#if WASM_ENABLE_FUEL != 0
+    inherit_fuel(new_exec_env, exec_env);
+#endif
+
     if (!wasm_cluster_add_exec_env(cluster, new_exec_env))
         goto fail2;
 
@@ -26,6 +26,20 @@
 #define UNLOCK_HEAP(heap) os_mutex_unlock(&heap->lock)
 #endif
 
+/* The pinuse bit of a WO is never checked, don't update it so that the
+   header of a WO isn't written while the write barrier may be setting its
+   remembered bit */
+#define hmu_mark_pinuse_if_not_wo(hmu)  \
+    do {                                \
+        if (hmu_get_ut(hmu) != HMU_WO)  \
+            hmu_mark_pinuse(hmu);       \
+    } while (0)
+#define hmu_unmark_pinuse_if_not_wo(hmu) \
+    do {                                 \
+        if (hmu_get_ut(hmu) != HMU_WO)   \
+            hmu_unmark_pinuse(hmu);      \
+    } while (0)
+
 static inline bool
 hmu_is_in_heap(void *hmu, gc_uint8 *heap_base_addr, gc_uint8 *heap_end_addr)
 {
@@ -170,8 +184,8 @@ fail:
     return false;
 }
 
-static bool
-unlink_hmu(gc_heap_t *heap, hmu_t *hmu)
+bool
+gci_unlink_hmu(gc_heap_t *heap, hmu_t *hmu)
 {
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
     gc_uint8 *base_addr, *end_addr;
@@ -182,6 +196,11 @@ unlink_hmu(gc_heap_t *heap, hmu_t *hmu)
     bh_assert(hmu && (gc_uint8 *)hmu >= heap->base_addr
               && (gc_uint8 *)hmu < heap->base_addr + heap->current_size);
 
+#if WASM_ENABLE_GC != 0
+    /* the free chunk is unlinked to be merged with its neighbour */
+    gc_invalidate_sweep_regions(heap);
+#endif
+
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
     if (hmu_get_ut(hmu) != HMU_FC) {
         heap->is_heap_corrupted = true;
@@ -230,16 +249,6 @@ unlink_hmu(gc_heap_t *heap, hmu_t *hmu)
     return true;
 }
 
-static void
-hmu_set_free_size(hmu_t *hmu)
-{
-    gc_size_t size;
-    bh_assert(hmu && hmu_get_ut(hmu) == HMU_FC);
-
-    size = hmu_get_size(hmu);
-    *((uint32 *)((char *)hmu + size) - 1) = size;
-}
-
 /**
  * Add free chunk back to KFC
  *
@@ -408,10 +417,13 @@ alloc_hmu(gc_heap_t *heap, gc_size_t size)
                 size = node_idx << 3;
                 next = (hmu_t *)((char *)p + size);
                 if (hmu_is_in_heap(next, base_addr, end_addr))
-                    hmu_mark_pinuse(next);
+                    hmu_mark_pinuse_if_not_wo(next);
             }
 
             heap->total_free_size -= size;
+#if WASM_ENABLE_GC != 0
+            heap->pause_stat.size_allocated += size;
+#endif
             if ((heap->current_size - heap->total_free_size)
                 > heap->highmark_size)
                 heap->highmark_size =
@@ -465,10 +477,13 @@ alloc_hmu(gc_heap_t *heap, gc_size_t size)
             size = last_tp->size;
             next = (hmu_t *)((char *)last_tp + size);
             if (hmu_is_in_heap(next, base_addr, end_addr))
-                hmu_mark_pinuse(next);
+                hmu_mark_pinuse_if_not_wo(next);
         }
 
         heap->total_free_size -= size;
+#if WASM_ENABLE_GC != 0
+        heap->pause_stat.size_allocated += size;
+#endif
         if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
             heap->highmark_size = heap->current_size - heap->total_free_size;
 
@@ -488,7 +503,7 @@ do_gc_heap(gc_heap_t *heap)
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
     uint64 start = 0, end = 0, time = 0;
 
-    start = os_time_get_boot_microsecond();
+    start = os_time_get_boot_us();
 #endif
     if (heap->is_reclaim_enabled) {
         UNLOCK_HEAP(heap);
@@ -496,7 +511,7 @@ do_gc_heap(gc_heap_t *heap)
         LOCK_HEAP(heap);
     }
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
-    end = os_time_get_boot_microsecond();
+    end = os_time_get_boot_us();
     time = end - start;
     heap->total_gc_time += time;
     if (time > heap->max_gc_time) {
@@ -506,6 +521,97 @@ do_gc_heap(gc_heap_t *heap)
 #endif
     return ret;
 }
+
+#if GC_INCREMENTAL != 0
+static int
+start_incremental_gc(gc_heap_t *heap)
+{
+    int ret = GC_ERROR;
+
+    if (heap->is_reclaim_enabled && gci_is_incremental_gc_enabled(heap)) {
+        UNLOCK_HEAP(heap);
+        ret = gci_start_incremental_gc(heap);
+        LOCK_HEAP(heap);
+    }
+    return ret;
+}
+
+/**
+ * Allocate a HMU while the heap is reclaimed incrementally, a slice of
+ * the reclaim is done after every GC_SLICE_ALLOC_SIZE allocated, and more
+ * slices are done if the blocks swept so far can't satisfy the request
+ *
+ * @return hmu allocated if success, NULL if the reclaim is finished
+ *         and the heap is still exhausted
+ */
+static hmu_t *
+alloc_hmu_incrementally(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *ret;
+
+    heap->size_allocated_since_slice += size;
+    if (heap->size_allocated_since_slice >= GC_SLICE_ALLOC_SIZE) {
+        heap->size_allocated_since_slice = 0;
+        gci_gc_slice(heap, false);
+    }
+
+    while (!(ret = alloc_hmu(heap, size))
+           && heap->gc_phase != GC_PHASE_IDLE) {
+        gci_gc_slice(heap, true);
+    }
+    return ret;
+}
+#endif
+#endif
+
+#if WASM_ENABLE_GC != 0
+#if GC_GROWABLE_HEAP != 0
+/**
+ * Grow the heap and allocate a HMU from it, called when the request
+ * can't be satisfied after a GC
+ *
+ * @return hmu allocated if success, NULL if the heap can't grow enough
+ */
+static hmu_t *
+grow_heap_and_alloc_hmu(gc_heap_t *heap, gc_size_t size)
+{
+    uint64 live_size, new_size;
+
+    if (heap->reserved_size == 0)
+        return NULL;
+
+    /* grow to the size which the policy expects for the live blocks
+       plus this request, and at least enough for the request */
+    live_size = (uint64)heap->current_size - heap->total_free_size + size;
+    if (live_size > heap->max_size)
+        return NULL;
+    new_size = gci_get_target_heap_size(heap, (gc_size_t)live_size);
+    if (new_size < (uint64)heap->current_size + size)
+        new_size = (uint64)heap->current_size + size;
+    if (new_size > heap->max_size)
+        new_size = heap->max_size;
+
+    if (!gci_grow_heap(heap, (gc_size_t)new_size))
+        return NULL;
+    return alloc_hmu(heap, size);
+}
+#endif
+
+/**
+ * Allocate a HMU after the heap has been reclaimed, a growable heap
+ * is grown if it still can't satisfy the request
+ */
+static hmu_t *
+alloc_hmu_after_gc(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *ret = alloc_hmu(heap, size);
+
+#if GC_GROWABLE_HEAP != 0
+    if (!ret)
+        ret = grow_heap_and_alloc_hmu(heap, size);
+#endif
+    return ret;
+}
 #endif
 
 /**
@@ -518,7 +624,8 @@ do_gc_heap(gc_heap_t *heap)
  *   1. Find a proper on available HMUs.
  *   2. GC will be triggered if 1 failed.
  *   3. Find a proper on available HMUS.
- *   4. Return NULL if 3 failed
+ *   4. Grow the heap if 3 failed and the heap is growable.
+ *   5. Return NULL if 4 failed
  *
  * @return hmu allocated if success, which will be aligned to 8 bytes,
  *         NULL otherwise
@@ -534,23 +641,117 @@ alloc_hmu_ex(gc_heap_t *heap, gc_size_t size)
     if (GC_SUCCESS != do_gc_heap(heap))
         return NULL;
 #else
+    hmu_t *ret = NULL;
+
+#if GC_INCREMENTAL != 0
+    if (heap->gc_phase != GC_PHASE_IDLE
+        || (heap->total_free_size < heap->gc_threshold
+            && start_incremental_gc(heap) == GC_SUCCESS)) {
+        if ((ret = alloc_hmu_incrementally(heap, size)))
+            return ret;
+        /* the incremental reclaim didn't free enough memory, fall back
+           to the stop-the-world reclaim */
+        if (GC_SUCCESS != do_gc_heap(heap))
+            return NULL;
+        return alloc_hmu_after_gc(heap, size);
+    }
+#endif
+
     if (heap->total_free_size < heap->gc_threshold) {
         if (GC_SUCCESS != do_gc_heap(heap))
             return NULL;
     }
     else {
-        hmu_t *ret = NULL;
         if ((ret = alloc_hmu(heap, size))) {
             return ret;
         }
         if (GC_SUCCESS != do_gc_heap(heap))
             return NULL;
     }
+
+#if GC_GENERATIONAL != 0
+    if (!(ret = alloc_hmu(heap, size)) && heap->is_doing_minor_gc) {
+        /* the minor GC didn't free enough memory, also collect
+           the old generation */
+        heap->is_full_gc_required = 1;
+        if (GC_SUCCESS != do_gc_heap(heap))
+            return NULL;
+    }
+    else if (ret) {
+        return ret;
+    }
 #endif
 #endif
 
+    return alloc_hmu_after_gc(heap, size);
+#else
     return alloc_hmu(heap, size);
+#endif
+}
+
+#if GC_NURSERY_SIZE != 0
+/**
+ * Bump allocate a WO from the nursery, and refill the nursery with
+ * a new chunk when it runs out
+ *
+ * @param heap should not be NULL and should be a valid heap
+ * @param size should cover the header and should be 8 bytes aligned
+ *
+ * @return hmu allocated if success, NULL if the WO should be allocated
+ *         by alloc_hmu_ex
+ */
+static hmu_t *
+alloc_hmu_from_nursery(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *hmu, *rest;
+    gc_size_t nursery_size = GC_NURSERY_SIZE;
+
+    if (nursery_size > heap->current_size / 8)
+        nursery_size = (heap->current_size / 8) & (gc_size_t)~7;
+
+    if (size > nursery_size / 8)
+        return NULL;
+
+#if GC_INCREMENTAL != 0
+    /* The WOs allocated during an incremental reclaim must be marked
+       or be allocated from the swept blocks, leave it to alloc_hmu_ex.
+       The nursery is kept empty so the compiled code doesn't bump
+       allocate from it either. */
+    if (heap->gc_phase != GC_PHASE_IDLE)
+        return NULL;
+#endif
+
+    if ((gc_size_t)(heap->nursery.end - heap->nursery.cur) < size) {
+        /* The space left in the nursery is merged into the free chunks
+           by the next sweep. Don't refill it if GC should be triggered,
+           leave it to alloc_hmu_ex. */
+        if (heap->total_free_size < heap->gc_threshold + nursery_size
+            || !(hmu = alloc_hmu(heap, nursery_size)))
+            return NULL;
+        gc_reset_nursery(heap);
+        heap->nursery.cur = (gc_uint8 *)hmu;
+        heap->nursery.end = (gc_uint8 *)hmu + hmu_get_size(hmu);
+#if GC_GENERATIONAL != 0
+        gci_add_young_range(heap, hmu, hmu_get_size(hmu));
+#endif
+    }
+
+    hmu = (hmu_t *)heap->nursery.cur;
+    heap->nursery.cur += size;
+    hmu->header = 0;
+    hmu_set_size(hmu, size);
+    hmu_mark_pinuse(hmu);
+
+    if (heap->nursery.cur < heap->nursery.end) {
+        rest = (hmu_t *)heap->nursery.cur;
+        rest->header = 0;
+        hmu_set_ut(rest, HMU_FM);
+        hmu_set_size(rest,
+                     (gc_size_t)(heap->nursery.end - heap->nursery.cur));
+    }
+    return hmu;
 }
+#endif
 
 #if BH_ENABLE_GC_VERIFY == 0
 gc_object_t
@@ -662,13 +863,18 @@ gc_realloc_vo_internal(void *vheap, void *ptr, gc_size_t size, const char *file,
         if (hmu_is_in_heap(hmu_next, base_addr, end_addr)) {
             ut = hmu_get_ut(hmu_next);
             tot_size_next = hmu_get_size(hmu_next);
-            if (ut == HMU_FC && tot_size <= tot_size_old + tot_size_next) {
+            if (ut == HMU_FC && tot_size <= tot_size_old + tot_size_next
+                && gc_is_hmu_swept(heap, hmu_next)) {
                 /* current node and next node meets requirement */
-                if (!unlink_hmu(heap, hmu_next)) {
+                if (!gci_unlink_hmu(heap, hmu_next)) {
                     UNLOCK_HEAP(heap);
                     return NULL;
                 }
                 hmu_set_size(hmu_old, tot_size);
+                heap->total_free_size -= tot_size - tot_size_old;
+#if WASM_ENABLE_GC != 0
+                heap->pause_stat.size_allocated += tot_size - tot_size_old;
+#endif
                 memset((char *)hmu_old + tot_size_old, 0,
                        tot_size - tot_size_old);
 #if BH_ENABLE_GC_VERIFY != 0
@@ -781,7 +987,16 @@ gc_alloc_wo_internal(void *vheap, gc_size_t size, const char *file, int line)
 
     LOCK_HEAP(heap);
 
-    hmu = alloc_hmu_ex(heap, tot_size);
+#if GC_NURSERY_SIZE != 0
+    if (!(hmu = alloc_hmu_from_nursery(heap, tot_size)))
+#endif
+    {
+        hmu = alloc_hmu_ex(heap, tot_size);
+#if GC_GENERATIONAL != 0
+        if (hmu)
+            gci_add_young_range(heap, hmu, hmu_get_size(hmu));
+#endif
+    }
     if (!hmu)
         goto finish;
 
@@ -803,6 +1018,13 @@ gc_alloc_wo_internal(void *vheap, gc_size_t size, const char *file, int line)
 #else
     hmu_unmark_wo(hmu);
 #endif
+    hmu_forget_wo(hmu);
+#if GC_INCREMENTAL != 0
+    /* allocate black during the incremental marking, the new WO isn't
+       in the snapshot of the rootset */
+    if (heap->gc_phase == GC_PHASE_MARK)
+        hmu_mark_wo(hmu);
+#endif
 
 #if BH_ENABLE_GC_VERIFY != 0
     hmu_init_prefix_and_suffix(hmu, tot_size, file, line);
@@ -882,11 +1104,27 @@ gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
 
             size = hmu_get_size(hmu);
 
+            if (!gc_is_hmu_swept(heap, hmu)) {
+                /* leave it to the lazy sweep, which also merges it with
+                   the free blocks around it */
+                hmu_free_vo(hmu);
+#if GC_STAT_DATA != 0
+                heap->total_size_freed += size;
+#endif
+#if WASM_ENABLE_GC != 0
+                heap->pause_stat.size_freed += size;
+#endif
+                goto out;
+            }
+
             heap->total_free_size += size;
 
 #if GC_STAT_DATA != 0
             heap->total_size_freed += size;
 #endif
+#if WASM_ENABLE_GC != 0
+            heap->pause_stat.size_freed += size;
+#endif
 
             if (!hmu_get_pinuse(hmu)) {
                 prev = (hmu_t *)((char *)hmu - *((int *)hmu - 1));
@@ -895,7 +1133,7 @@ gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
                     && hmu_get_ut(prev) == HMU_FC) {
                     size += hmu_get_size(prev);
                     hmu = prev;
-                    if (!unlink_hmu(heap, prev)) {
+                    if (!gci_unlink_hmu(heap, prev)) {
                         ret = GC_ERROR;
                         goto out;
                     }
@@ -903,10 +1141,11 @@ gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
             }
 
             next = (hmu_t *)((char *)hmu + size);
-            if (hmu_is_in_heap(next, base_addr, end_addr)) {
+            if (hmu_is_in_heap(next, base_addr, end_addr)
+                && gc_is_hmu_swept(heap, next)) {
                 if (hmu_get_ut(next) == HMU_FC) {
                     size += hmu_get_size(next);
-                    if (!unlink_hmu(heap, next)) {
+                    if (!gci_unlink_hmu(heap, next)) {
                         ret = GC_ERROR;
                         goto out;
                     }
@@ -920,7 +1159,7 @@ gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
             }
 
             if (hmu_is_in_heap(next, base_addr, end_addr)) {
-                hmu_unmark_pinuse(next);
+                hmu_unmark_pinuse_if_not_wo(next);
             }
         }
         else {
@@ -5,6 +5,7 @@
 
 #include "ems_gc.h"
 #include "ems_gc_internal.h"
+#include "bh_atomic.h"
 
 #define GB (1 << 30UL)
 
@@ -58,6 +59,974 @@ free_mark_node(mark_node_t *node)
     BH_FREE((gc_object_t)node);
 }
 
+/* Whether the sweep keeps the mark bits of the live WOs, which are the
+   old generation of the generational GC */
+static inline bool
+is_mark_sticky(gc_heap_t *heap)
+{
+#if GC_GENERATIONAL != 0 && GC_INCREMENTAL != 0
+    /* the incremental reclaims always mark the whole heap */
+    return !gci_is_incremental_gc_enabled(heap);
+#else
+    (void)heap;
+    return GC_GENERATIONAL != 0;
+#endif
+}
+
+/* Invoke the finalizer registered for a dead WO */
+static void
+finalize_wo(gc_heap_t *heap, hmu_t *hmu)
+{
+    gc_object_t obj = hmu_to_obj(hmu);
+
+    if (gct_vm_get_extra_info_flag(obj)) {
+        extra_info_node_t *node =
+            gc_search_extra_info_node((gc_handle_t)heap, obj, NULL);
+        bh_assert(node);
+        node->finalizer(node->obj, node->data);
+        gc_unset_finalizer((gc_handle_t)heap, obj);
+    }
+}
+
+/* Update the total size freed after a sweep: all the blocks allocated
+   and not live any more have been freed, the nursery is empty now */
+static inline void
+update_size_freed(gc_heap_t *heap)
+{
+    heap->pause_stat.size_freed =
+        heap->pause_stat.size_allocated
+        - (heap->current_size - heap->total_free_size);
+}
+
+/**
+ * Link the free run at the end of the heap found by a sweep into the
+ * free lists. A growable heap is shrunk first if it is larger than what
+ * the growth policy expects, and the pages after its new end are
+ * decommitted.
+ *
+ * @param heap the heap being swept
+ * @param last the first block of the free run
+ * @param free_size the size of the other free blocks found by the sweep
+ *
+ * @return the size of the free chunk linked
+ */
+static gc_size_t
+add_tail_run(gc_heap_t *heap, hmu_t *last, gc_size_t free_size)
+{
+    gc_size_t used_size = (gc_size_t)((gc_uint8 *)last - heap->base_addr);
+    gc_size_t size = heap->current_size - used_size;
+#if GC_GROWABLE_HEAP != 0
+    gc_size_t target;
+
+    if (heap->reserved_size > 0) {
+        target = gci_get_target_heap_size(heap, used_size - free_size);
+        /* keep some slack so that the heap isn't shrunk and grown back
+           by every GC */
+        if (heap->current_size > target + target / 4) {
+            gci_shrink_heap(heap, target > used_size ? target : used_size);
+            size = heap->current_size - used_size;
+        }
+    }
+#else
+    (void)free_size;
+#endif
+
+    if (size > 0) {
+        gci_add_fc(heap, last, size);
+        hmu_mark_pinuse(last);
+    }
+    return size;
+}
+
+#if GC_GROWABLE_HEAP != 0
+/* Resize the heap after a GC by the growth policy: grow it if the live
+   blocks take a larger part of it than expected, or decommit the pages
+   of its large free chunks if it is still too large after the free run
+   at its end has been trimmed, see add_tail_run() */
+static void
+resize_heap_after_gc(gc_heap_t *heap)
+{
+    gc_size_t target;
+
+    if (heap->reserved_size == 0)
+        return;
+
+    target = gci_get_target_heap_size(
+        heap, heap->current_size - heap->total_free_size);
+    if (target > heap->current_size) {
+        if (!gci_is_pause_too_long(heap))
+            gci_grow_heap(heap, target);
+    }
+    else if (heap->current_size > target + target / 4) {
+        gci_decommit_free_chunks(heap);
+    }
+}
+#endif
+
+#if GC_PARALLEL != 0
+#if BH_ATOMIC_32_IS_ATOMIC == 0
+#error "parallel GC requires atomic operations"
+#endif
+
+/* Heaps smaller than this are reclaimed by the collector thread alone,
+   waking up the helper threads would cost more than what they save */
+#define GC_PARALLEL_HEAP_SIZE_MIN (4 * 1024 * 1024)
+
+typedef enum gc_task_kind {
+    GC_TASK_MARK = 0,
+    GC_TASK_SWEEP,
+    GC_TASK_QUIT,
+} gc_task_kind_t;
+
+/* State of a thread which marks and sweeps a heap, the first worker
+   of the pool is used by the collector thread */
+typedef struct gc_worker {
+    struct gc_worker_pool *pool;
+    korp_tid tid;
+
+    /* protects shared */
+    korp_mutex lock;
+
+    /* the to-expand nodes which the other workers can steal */
+    mark_node_t *shared;
+
+    /* the node which the wos marked by this worker are added to */
+    mark_node_t *local;
+
+    /* the free chunks of normal sizes found by the sweep, they are
+       linked into the kfc lists of the heap after the sweep */
+    hmu_normal_node_t *fc_heads[HMU_NORMAL_NODE_CNT];
+    hmu_normal_node_t *fc_tails[HMU_NORMAL_NODE_CNT];
+
+    gc_size_t tot_free;
+} gc_worker_t;
+
+typedef struct gc_worker_pool {
+    /* protects the fields below except the atomic ones, and the kfc tree
+       of the heap during the sweep */
+    korp_mutex lock;
+    /* signaled when a task is posted */
+    korp_cond task_cond;
+    /* signaled when all the helpers have finished the task */
+    korp_cond done_cond;
+    /* signaled when there are nodes to steal or the marking is done */
+    korp_cond idle_cond;
+
+    gc_worker_t *workers;
+    /* number of the helper threads plus the collector thread */
+    uint32 worker_num;
+
+    /* whether a heap is being reclaimed with the pool */
+    bool is_busy;
+
+    gc_heap_t *heap;
+    gc_task_kind_t task;
+    uint32 task_id;
+    /* number of the helpers which haven't finished the task */
+    uint32 running_num;
+
+    /* number of the workers which have found nothing to mark */
+    bh_atomic_32_t idle_num;
+    /* number of the nodes which can be stolen */
+    bh_atomic_32_t shared_node_num;
+    bh_atomic_32_t is_mark_failed;
+
+    /* the next region to sweep */
+    bh_atomic_32_t next_region;
+    /* the free run at the end of the heap, it is linked into the free
+       lists by the collector thread after the sweep */
+    hmu_t *tail_run;
+    /* region offsets recorded by this sweep for the next one */
+    gc_size_t region_offsets[GC_SWEEP_REGION_NUM];
+} gc_worker_pool_t;
+
+static gc_worker_pool_t *gc_pool;
+
+static void
+publish_mark_node(gc_worker_pool_t *pool, gc_worker_t *worker,
+                  mark_node_t *node)
+{
+    os_mutex_lock(&worker->lock);
+    node->next = worker->shared;
+    worker->shared = node;
+    os_mutex_unlock(&worker->lock);
+
+    BH_ATOMIC_32_FETCH_ADD(pool->shared_node_num, 1);
+    if (BH_ATOMIC_32_LOAD(pool->idle_num) > 0) {
+        os_mutex_lock(&pool->lock);
+        os_cond_broadcast(&pool->idle_cond);
+        os_mutex_unlock(&pool->lock);
+    }
+}
+
+static mark_node_t *
+steal_mark_node(gc_worker_pool_t *pool, gc_worker_t *worker)
+{
+    mark_node_t *node;
+
+    os_mutex_lock(&worker->lock);
+    node = worker->shared;
+    if (node)
+        worker->shared = node->next;
+    os_mutex_unlock(&worker->lock);
+
+    if (node)
+        BH_ATOMIC_32_FETCH_SUB(pool->shared_node_num, 1);
+    return node;
+}
+
+static void
+fail_parallel_marking(gc_worker_pool_t *pool)
+{
+    os_mutex_lock(&pool->lock);
+    BH_ATOMIC_32_STORE(pool->is_mark_failed, 1);
+    os_cond_broadcast(&pool->idle_cond);
+    os_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Get the next node to expand for a worker, which is the node filled by
+ * itself, or one stolen from the workers
+ *
+ * @return the node to expand, NULL if the marking is done or failed
+ */
+static mark_node_t *
+get_mark_node_to_expand(gc_worker_pool_t *pool, gc_worker_t *worker)
+{
+    mark_node_t *node = worker->local, *half;
+    uint32 self = (uint32)(worker - pool->workers), i;
+
+    if (BH_ATOMIC_32_LOAD(pool->is_mark_failed))
+        return NULL;
+
+    if (node && node->idx > 0) {
+        worker->local = NULL;
+        /* give half of the wos to the idle workers */
+        if (node->idx > 1 && BH_ATOMIC_32_LOAD(pool->idle_num) > 0
+            && (half = alloc_mark_node())) {
+            half->idx = node->idx / 2;
+            node->idx -= half->idx;
+            bh_memcpy_s(half->set, (uint32)sizeof(half->set),
+                        node->set + node->idx,
+                        (uint32)(sizeof(gc_object_t) * half->idx));
+            publish_mark_node(pool, worker, half);
+        }
+        return node;
+    }
+
+    for (;;) {
+        for (i = 0; i < pool->worker_num; i++) {
+            node = steal_mark_node(
+                pool, &pool->workers[(self + i) % pool->worker_num]);
+            if (node)
+                return node;
+        }
+
+        os_mutex_lock(&pool->lock);
+        BH_ATOMIC_32_FETCH_ADD(pool->idle_num, 1);
+        for (;;) {
+            if (BH_ATOMIC_32_LOAD(pool->is_mark_failed)
+                || BH_ATOMIC_32_LOAD(pool->idle_num) == pool->worker_num) {
+                /* the nodes are only published by the busy workers,
+                   so there is nothing left when all are idle */
+                os_cond_broadcast(&pool->idle_cond);
+                os_mutex_unlock(&pool->lock);
+                return NULL;
+            }
+            if (BH_ATOMIC_32_LOAD(pool->shared_node_num) > 0) {
+                BH_ATOMIC_32_FETCH_SUB(pool->idle_num, 1);
+                break;
+            }
+            os_cond_wait(&pool->idle_cond, &pool->lock);
+        }
+        os_mutex_unlock(&pool->lock);
+    }
+}
+
+/**
+ * Mark a WO and add it to the local node of a worker if it isn't marked
+ * by any worker yet
+ *
+ * @return GC_ERROR if there is no more resource for marking,
+ *         GC_SUCCESS if success
+ */
+static int
+add_wo_to_expand_in_parallel(gc_worker_pool_t *pool, gc_worker_t *worker,
+                             gc_object_t obj)
+{
+    mark_node_t *mark_node = worker->local;
+    hmu_t *hmu = obj_to_hmu(obj);
+    uint32 mark_bit = (uint32)1 << HMU_WO_MB_OFFSET;
+
+    bh_assert(hmu_get_ut(hmu) == HMU_WO);
+
+    if ((BH_ATOMIC_32_LOAD(hmu->header) & mark_bit)
+        || (BH_ATOMIC_32_FETCH_OR(hmu->header, mark_bit) & mark_bit))
+        return GC_SUCCESS; /* already marked */
+
+    if (!mark_node || mark_node->idx == mark_node->cnt) {
+        if (mark_node)
+            publish_mark_node(pool, worker, mark_node);
+        if (!(mark_node = alloc_mark_node())) {
+            worker->local = NULL;
+            return GC_ERROR;
+        }
+        worker->local = mark_node;
+    }
+
+    mark_node->set[mark_node->idx++] = obj;
+    return GC_SUCCESS;
+}
+
+/* Same as add_wo_refs_to_expand, but the refs are added to a worker */
+static int
+add_wo_refs_to_expand_in_parallel(gc_worker_pool_t *pool, gc_worker_t *worker,
+                                  gc_object_t obj)
+{
+    bool is_compact_mode = false;
+    gc_object_t ref = NULL;
+    gc_uint32 ref_num = 0, ref_start_offset = 0, offset = 0, j;
+    gc_uint16 *ref_list = NULL;
+
+    if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode, &ref_num,
+                                         &ref_list, &ref_start_offset)
+        || ref_num >= 2U * GB) {
+        LOG_ERROR("mark process failed because failed "
+                  "vm_get_wasm_object_ref_list");
+        return GC_ERROR;
+    }
+
+    for (j = 0; j < ref_num; j++) {
+        if (is_compact_mode)
+            offset = ref_start_offset + j * sizeof(void *);
+        else
+            offset = ref_list[j];
+
+        ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
+        if (ref == NULL_REF || ((uintptr_t)ref & 1))
+            continue; /* null object or i31 object */
+        if (add_wo_to_expand_in_parallel(pool, worker, ref) == GC_ERROR) {
+            LOG_ERROR("mark process failed");
+            return GC_ERROR;
+        }
+    }
+
+    return GC_SUCCESS;
+}
+
+static void
+mark_task(gc_worker_pool_t *pool, gc_worker_t *worker)
+{
+    mark_node_t *mark_node;
+    uint32 idx;
+
+    while ((mark_node = get_mark_node_to_expand(pool, worker))) {
+        for (idx = 0; idx < mark_node->idx; idx++) {
+            if (add_wo_refs_to_expand_in_parallel(pool, worker,
+                                                  mark_node->set[idx])
+                != GC_SUCCESS) {
+                fail_parallel_marking(pool);
+                break;
+            }
+        }
+        free_mark_node(mark_node);
+    }
+}
+
+/* Add a free chunk found by the parallel sweep to the heap */
+static void
+add_fc_in_parallel(gc_worker_pool_t *pool, gc_worker_t *worker,
+                   gc_heap_t *heap, hmu_t *hmu, gc_size_t size)
+{
+    hmu_normal_node_t *np = (hmu_normal_node_t *)hmu;
+    uint32 node_idx = size >> 3;
+
+    if (!HMU_IS_FC_NORMAL(size)) {
+        os_mutex_lock(&pool->lock);
+        gci_add_fc(heap, hmu, size);
+        os_mutex_unlock(&pool->lock);
+        return;
+    }
+
+    hmu_set_ut(hmu, HMU_FC);
+    hmu_set_size(hmu, size);
+    hmu_set_free_size(hmu);
+
+    set_hmu_normal_node_next(np, worker->fc_heads[node_idx]);
+    if (!worker->fc_heads[node_idx])
+        worker->fc_tails[node_idx] = np;
+    worker->fc_heads[node_idx] = np;
+}
+
+/* Record the blocks which the next sweep splits the heap at, the first
+   block at or after each split point */
+#define RECORD_SWEEP_REGIONS(offsets, region_idx, region_idx_end, region_size, \
+                             offset)                                           \
+    do {                                                                       \
+        while (region_idx < region_idx_end                                     \
+               && region_idx * region_size <= offset)                          \
+            offsets[region_idx++] = offset;                                    \
+    } while (0)
+
+/**
+ * Sweep a region of the heap, a free chunk is never merged with the
+ * blocks of the next region
+ */
+static void
+sweep_region(gc_worker_pool_t *pool, gc_worker_t *worker, gc_heap_t *heap,
+             uint32 region)
+{
+    gc_size_t region_size = heap->current_size / GC_SWEEP_REGION_NUM;
+    gc_size_t start_offset = heap->sweep_region_offsets[region];
+    gc_size_t end_offset = region + 1 < GC_SWEEP_REGION_NUM
+                               ? heap->sweep_region_offsets[region + 1]
+                               : heap->current_size;
+    hmu_t *cur = (hmu_t *)(heap->base_addr + start_offset);
+    hmu_t *end = (hmu_t *)(heap->base_addr + end_offset);
+    hmu_t *last = NULL;
+    hmu_type_t ut;
+    gc_size_t size, tot_free = 0;
+    uint32 region_idx, region_idx_end;
+
+    /* the split points in [start_offset, end_offset) are recorded by
+       this region */
+    region_idx = (start_offset + region_size - 1) / region_size;
+    region_idx_end = (end_offset + region_size - 1) / region_size;
+    if (region_idx_end > GC_SWEEP_REGION_NUM)
+        region_idx_end = GC_SWEEP_REGION_NUM;
+
+    while (cur < end) {
+        ut = hmu_get_ut(cur);
+        size = hmu_get_size(cur);
+        bh_assert(size > 0);
+
+        if (ut == HMU_FC || ut == HMU_FM
+            || (ut == HMU_VO && hmu_is_vo_freed(cur))
+            || (ut == HMU_WO && !hmu_is_wo_marked(cur))) {
+            /* there is no finalizer when the heap is swept in parallel */
+            bh_assert(ut != HMU_WO
+                      || !gct_vm_get_extra_info_flag(hmu_to_obj(cur)));
+            if (!last) {
+                last = cur;
+                RECORD_SWEEP_REGIONS(pool->region_offsets, region_idx,
+                                     region_idx_end, region_size,
+                                     (gc_size_t)((gc_uint8 *)cur
+                                                 - heap->base_addr));
+            }
+        }
+        else {
+            if (last) {
+                tot_free += (gc_size_t)((char *)cur - (char *)last);
+                add_fc_in_parallel(pool, worker, heap, last,
+                                   (gc_size_t)((char *)cur - (char *)last));
+                hmu_mark_pinuse(last);
+                last = NULL;
+            }
+            RECORD_SWEEP_REGIONS(pool->region_offsets, region_idx,
+                                 region_idx_end, region_size,
+                                 (gc_size_t)((gc_uint8 *)cur
+                                             - heap->base_addr));
+
+            if (ut == HMU_WO && !is_mark_sticky(heap)) {
+                /* unmark it */
+                hmu_unmark_wo(cur);
+            }
+        }
+
+        cur = (hmu_t *)((char *)cur + size);
+    }
+
+    bh_assert(cur == end);
+
+    if (last) {
+        if (end_offset == heap->current_size) {
+            pool->tail_run = last;
+        }
+        else {
+            tot_free += (gc_size_t)((char *)cur - (char *)last);
+            add_fc_in_parallel(pool, worker, heap, last,
+                               (gc_size_t)((char *)cur - (char *)last));
+            hmu_mark_pinuse(last);
+        }
+    }
+
+    /* the next region starts with a block after the sweep */
+    RECORD_SWEEP_REGIONS(pool->region_offsets, region_idx, region_idx_end,
+                         region_size, end_offset);
+
+    worker->tot_free += tot_free;
+}
+
+static void
+sweep_task(gc_worker_pool_t *pool, gc_worker_t *worker)
+{
+    uint32 region;
+
+    while ((region = BH_ATOMIC_32_FETCH_ADD(pool->next_region, 1))
+           < GC_SWEEP_REGION_NUM)
+        sweep_region(pool, worker, pool->heap, region);
+}
+
+static void
+do_gc_task(gc_worker_pool_t *pool, gc_worker_t *worker, gc_task_kind_t task)
+{
+    if (task == GC_TASK_MARK)
+        mark_task(pool, worker);
+    else
+        sweep_task(pool, worker);
+}
+
+static void *
+gc_helper_thread_routine(void *arg)
+{
+    gc_worker_t *worker = (gc_worker_t *)arg;
+    gc_worker_pool_t *pool = worker->pool;
+    uint32 task_id = 0;
+    gc_task_kind_t task;
+
+    os_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->task_id == task_id)
+            os_cond_wait(&pool->task_cond, &pool->lock);
+        task_id = pool->task_id;
+        task = pool->task;
+        if (task == GC_TASK_QUIT)
+            break;
+
+        os_mutex_unlock(&pool->lock);
+        do_gc_task(pool, worker, task);
+        os_mutex_lock(&pool->lock);
+
+        if (--pool->running_num == 0)
+            os_cond_signal(&pool->done_cond);
+    }
+    os_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* Run a task with the collector thread and all the helpers */
+static void
+run_gc_task(gc_worker_pool_t *pool, gc_heap_t *heap, gc_task_kind_t task)
+{
+    os_mutex_lock(&pool->lock);
+    pool->heap = heap;
+    pool->task = task;
+    pool->task_id++;
+    pool->running_num = pool->worker_num - 1;
+    os_cond_broadcast(&pool->task_cond);
+    os_mutex_unlock(&pool->lock);
+
+    do_gc_task(pool, &pool->workers[0], task);
+
+    os_mutex_lock(&pool->lock);
+    while (pool->running_num > 0)
+        os_cond_wait(&pool->done_cond, &pool->lock);
+    os_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Get the helper threads to reclaim a heap
+ *
+ * @return the pool if the heap is reclaimed in parallel, NULL otherwise
+ */
+static gc_worker_pool_t *
+acquire_worker_pool(gc_heap_t *heap)
+{
+    gc_worker_pool_t *pool = gc_pool;
+    bool is_busy;
+
+    if (!pool || heap->current_size < GC_PARALLEL_HEAP_SIZE_MIN)
+        return NULL;
+
+    os_mutex_lock(&pool->lock);
+    /* the helpers may be reclaiming another heap */
+    is_busy = pool->is_busy;
+    pool->is_busy = true;
+    os_mutex_unlock(&pool->lock);
+    return is_busy ? NULL : pool;
+}
+
+static void
+release_worker_pool(gc_worker_pool_t *pool)
+{
+    os_mutex_lock(&pool->lock);
+    pool->is_busy = false;
+    os_mutex_unlock(&pool->lock);
+}
+
+/**
+ * Expand the to-expand list of a heap with all the workers
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+static int
+mark_in_parallel(gc_worker_pool_t *pool, gc_heap_t *heap)
+{
+    mark_node_t *mark_node, *next;
+    gc_worker_t *worker;
+    uint32 i = 0;
+
+    BH_ATOMIC_32_STORE(pool->idle_num, 0);
+    BH_ATOMIC_32_STORE(pool->shared_node_num, 0);
+    BH_ATOMIC_32_STORE(pool->is_mark_failed, 0);
+
+    /* deal the to-expand nodes out to the workers */
+    mark_node = (mark_node_t *)heap->root_set;
+    heap->root_set = NULL;
+    while (mark_node) {
+        next = mark_node->next;
+        worker = &pool->workers[i++ % pool->worker_num];
+        mark_node->next = worker->shared;
+        worker->shared = mark_node;
+        BH_ATOMIC_32_FETCH_ADD(pool->shared_node_num, 1);
+        mark_node = next;
+    }
+
+    run_gc_task(pool, heap, GC_TASK_MARK);
+
+    if (!BH_ATOMIC_32_LOAD(pool->is_mark_failed))
+        return GC_SUCCESS;
+
+    /* free the nodes left */
+    for (i = 0; i < pool->worker_num; i++) {
+        worker = &pool->workers[i];
+        while ((mark_node = worker->shared)) {
+            worker->shared = mark_node->next;
+            free_mark_node(mark_node);
+        }
+        if (worker->local) {
+            free_mark_node(worker->local);
+            worker->local = NULL;
+        }
+    }
+    return GC_ERROR;
+}
+
+/**
+ * Sweep the heap with all the workers, the kfc lists and the nursery
+ * of the heap should have been reset
+ *
+ * @return the total size of the free chunks
+ */
+static gc_size_t
+sweep_in_parallel(gc_worker_pool_t *pool, gc_heap_t *heap)
+{
+    gc_worker_t *worker;
+    gc_size_t tot_free = 0;
+    uint32 i, j;
+
+    for (i = 0; i < pool->worker_num; i++) {
+        worker = &pool->workers[i];
+        memset(worker->fc_heads, 0, sizeof(worker->fc_heads));
+        worker->tot_free = 0;
+    }
+    BH_ATOMIC_32_STORE(pool->next_region, 0);
+    pool->tail_run = NULL;
+
+    run_gc_task(pool, heap, GC_TASK_SWEEP);
+
+    /* link the normal free chunks found by the workers to the heap */
+    for (i = 0; i < pool->worker_num; i++) {
+        worker = &pool->workers[i];
+        for (j = 0; j < HMU_NORMAL_NODE_CNT; j++) {
+            if (worker->fc_heads[j]) {
+                set_hmu_normal_node_next(worker->fc_tails[j],
+                                         heap->kfc_normal_list[j].next);
+                heap->kfc_normal_list[j].next = worker->fc_heads[j];
+            }
+        }
+        tot_free += worker->tot_free;
+    }
+
+    if (pool->tail_run)
+        tot_free += add_tail_run(heap, pool->tail_run, tot_free);
+
+    for (i = 0; i < GC_SWEEP_REGION_NUM; i++) {
+        /* the heap may have been shrunk */
+        if (pool->region_offsets[i] > heap->current_size)
+            pool->region_offsets[i] = heap->current_size;
+    }
+    bh_memcpy_s(heap->sweep_region_offsets,
+                (uint32)sizeof(heap->sweep_region_offsets),
+                pool->region_offsets, (uint32)sizeof(pool->region_offsets));
+    return tot_free;
+}
+
+/* Stop the first thread_num helpers and destroy the pool */
+static void
+destroy_worker_pool(gc_worker_pool_t *pool, uint32 thread_num)
+{
+    uint32 i;
+
+    os_mutex_lock(&pool->lock);
+    pool->task = GC_TASK_QUIT;
+    pool->task_id++;
+    os_cond_broadcast(&pool->task_cond);
+    os_mutex_unlock(&pool->lock);
+
+    for (i = 1; i <= thread_num; i++)
+        os_thread_join(pool->workers[i].tid, NULL);
+
+    for (i = 0; i < pool->worker_num; i++)
+        os_mutex_destroy(&pool->workers[i].lock);
+    os_cond_destroy(&pool->idle_cond);
+    os_cond_destroy(&pool->done_cond);
+    os_cond_destroy(&pool->task_cond);
+    os_mutex_destroy(&pool->lock);
+    BH_FREE(pool->workers);
+    BH_FREE(pool);
+}
+
+/* Check ems_gc.h for description */
+int
+gc_init_helper_threads(gc_uint32 num)
+{
+    gc_worker_pool_t *pool;
+    uint32 i, thread_num = 0;
+
+    bh_assert(!gc_pool);
+
+    if (num == 0 || num >= UINT16_MAX)
+        return GC_ERROR;
+
+    if (!(pool = (gc_worker_pool_t *)BH_MALLOC(sizeof(gc_worker_pool_t))))
+        return GC_ERROR;
+    memset(pool, 0, sizeof(gc_worker_pool_t));
+
+    if (!(pool->workers =
+              (gc_worker_t *)BH_MALLOC(sizeof(gc_worker_t) * (num + 1))))
+        goto fail1;
+    memset(pool->workers, 0, sizeof(gc_worker_t) * (num + 1));
+    pool->worker_num = num + 1;
+
+    if (os_mutex_init(&pool->lock) != BHT_OK)
+        goto fail2;
+    if (os_cond_init(&pool->task_cond) != BHT_OK)
+        goto fail3;
+    if (os_cond_init(&pool->done_cond) != BHT_OK)
+        goto fail4;
+    if (os_cond_init(&pool->idle_cond) != BHT_OK)
+        goto fail5;
+
+    for (i = 0; i < pool->worker_num; i++) {
+        if (os_mutex_init(&pool->workers[i].lock) != BHT_OK)
+            goto fail6;
+        pool->workers[i].pool = pool;
+    }
+
+    for (thread_num = 0; thread_num < num; thread_num++) {
+        if (os_thread_create(&pool->workers[thread_num + 1].tid,
+                             gc_helper_thread_routine,
+                             &pool->workers[thread_num + 1],
+                             APP_THREAD_STACK_SIZE_DEFAULT)
+            != BHT_OK) {
+            LOG_ERROR("create GC helper thread failed");
+            destroy_worker_pool(pool, thread_num);
+            return GC_ERROR;
+        }
+    }
+
+    gc_pool = pool;
+    return GC_SUCCESS;
+
+fail6:
+    while (i > 0)
+        os_mutex_destroy(&pool->workers[--i].lock);
+    os_cond_destroy(&pool->idle_cond);
+fail5:
+    os_cond_destroy(&pool->done_cond);
+fail4:
+    os_cond_destroy(&pool->task_cond);
+fail3:
+    os_mutex_destroy(&pool->lock);
+fail2:
+    BH_FREE(pool->workers);
+fail1:
+    BH_FREE(pool);
+    return GC_ERROR;
+}
+
+/* Check ems_gc.h for description */
+void
+gc_destroy_helper_threads(void)
+{
+    if (gc_pool) {
+        destroy_worker_pool(gc_pool, gc_pool->worker_num - 1);
+        gc_pool = NULL;
+    }
+}
+#endif /* end of GC_PARALLEL != 0 */
+
+#if GC_GENERATIONAL != 0
+#define YOUNG_RANGE_NODE_CNT 128
+
+/* node of the list of the address ranges of the young blocks */
+typedef struct young_range_node {
+    /* the first unused index */
+    uint32 idx;
+
+    /* next node on the node list */
+    struct young_range_node *next;
+
+    /* the start and end addresses of the ranges */
+    gc_uint8 *ranges[YOUNG_RANGE_NODE_CNT][2];
+} young_range_node_t;
+
+static void
+free_young_ranges(gc_heap_t *heap)
+{
+    young_range_node_t *node = (young_range_node_t *)heap->young_ranges, *next;
+
+    while (node) {
+        next = node->next;
+        BH_FREE(node);
+        node = next;
+    }
+    heap->young_ranges = NULL;
+    heap->is_young_range_overflowed = 0;
+}
+
+static void
+free_remembered_set(gc_heap_t *heap)
+{
+    mark_node_t *node = (mark_node_t *)heap->remembered_set, *next;
+
+    while (node) {
+        next = node->next;
+        free_mark_node(node);
+        node = next;
+    }
+    heap->remembered_set = NULL;
+    heap->is_remembered_set_overflowed = 0;
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_add_young_range(gc_heap_t *heap, hmu_t *hmu, gc_size_t size)
+{
+    young_range_node_t *node = (young_range_node_t *)heap->young_ranges;
+    gc_uint8 *start = (gc_uint8 *)hmu;
+
+    if (heap->is_young_range_overflowed || heap->is_minor_gc_disabled)
+        return;
+
+    /* blocks are often carved from the same free chunk one after
+       another, extend the last range if so */
+    if (node && node->idx > 0 && node->ranges[node->idx - 1][1] == start) {
+        node->ranges[node->idx - 1][1] = start + size;
+        return;
+    }
+
+    if (!node || node->idx == YOUNG_RANGE_NODE_CNT) {
+        if (!(node = BH_MALLOC(sizeof(young_range_node_t)))) {
+            /* sweep the whole heap in the next minor GC instead */
+            free_young_ranges(heap);
+            heap->is_young_range_overflowed = 1;
+            return;
+        }
+        node->idx = 0;
+        node->next = (young_range_node_t *)heap->young_ranges;
+        heap->young_ranges = node;
+    }
+
+    node->ranges[node->idx][0] = start;
+    node->ranges[node->idx][1] = start + size;
+    node->idx++;
+}
+
+/**
+ * Link a free run found in a young range into the free lists, it is
+ * merged with the free chunk after it if the chunk is in the KFC tree.
+ * The normal free chunks aren't merged, finding them in their lists
+ * would take longer than the minor GC itself. The blocks before the run
+ * aren't merged either, they are merged by the next full GC.
+ *
+ * @return the size of the blocks freed by the run
+ */
+static gc_size_t
+add_young_free_run(gc_heap_t *heap, hmu_t *last, hmu_t *end)
+{
+    gc_size_t size = (gc_size_t)((gc_uint8 *)end - (gc_uint8 *)last);
+    gc_size_t freed = size;
+
+    if ((gc_uint8 *)end < heap->base_addr + heap->current_size
+        && hmu_get_ut(end) == HMU_FC && !HMU_IS_FC_NORMAL(hmu_get_size(end))
+        && gci_unlink_hmu(heap, end))
+        size += hmu_get_size(end);
+
+    gci_add_fc(heap, last, size);
+    hmu_mark_pinuse(last);
+    return freed;
+}
+
+/**
+ * Sweep the blocks in a young range: the unmarked WOs and the space left
+ * in the nursery chunks are freed, the marked WOs are promoted to the old
+ * generation
+ *
+ * @return the size of the blocks freed
+ */
+static gc_size_t
+sweep_young_range(gc_heap_t *heap, hmu_t *cur, hmu_t *end)
+{
+    hmu_t *last = NULL;
+    hmu_type_t ut;
+    gc_size_t size, tot_free = 0;
+
+    while (cur < end) {
+        ut = hmu_get_ut(cur);
+        size = hmu_get_size(cur);
+        bh_assert(size > 0 && size <= (gc_size_t)((char *)end - (char *)cur));
+        /* only WOs are allocated in the range */
+        bh_assert(ut == HMU_WO || ut == HMU_FM);
+
+        if (ut == HMU_FM || !hmu_is_wo_marked(cur)) {
+            if (!last)
+                last = cur;
+            if (ut == HMU_WO)
+                finalize_wo(heap, cur);
+        }
+        else if (last) {
+            tot_free += add_young_free_run(heap, last, cur);
+            last = NULL;
+        }
+
+        cur = (hmu_t *)((char *)cur + size);
+    }
+
+    bh_assert(cur == end);
+
+    if (last)
+        tot_free += add_young_free_run(heap, last, end);
+    return tot_free;
+}
+
+/**
+ * Sweep phase of the minor GC, only the blocks allocated since the last
+ * GC are swept, the free lists are kept
+ *
+ * @return the total free size of the heap after the sweep
+ */
+static gc_size_t
+sweep_young_ranges(gc_heap_t *heap)
+{
+    young_range_node_t *node = (young_range_node_t *)heap->young_ranges;
+    gc_size_t tot_free = heap->total_free_size;
+    uint32 i;
+
+    for (; node; node = node->next) {
+        for (i = 0; i < node->idx; i++)
+            tot_free += sweep_young_range(heap, (hmu_t *)node->ranges[i][0],
+                                          (hmu_t *)node->ranges[i][1]);
+    }
+    free_young_ranges(heap);
+
+    /* the dead blocks have been merged */
+    gc_invalidate_sweep_regions(heap);
+    return tot_free;
+}
+#endif
+
 /**
  * Sweep phase of mark_sweep algorithm
  * @param heap the heap to sweep, should be a valid instance heap
@@ -71,9 +1040,27 @@ sweep_instance_heap(gc_heap_t *heap)
     gc_size_t size;
     int i, lsize;
     gc_size_t tot_free = 0;
+#if GC_PARALLEL != 0
+    gc_worker_pool_t *pool = NULL;
+    gc_size_t region_size = heap->current_size / GC_SWEEP_REGION_NUM;
+    uint32 region_idx = 0;
+#endif
 
     bh_assert(gci_is_heap_valid(heap));
 
+    heap->root_set = NULL;
+    gc_reset_nursery(heap);
+
+#if GC_GENERATIONAL != 0
+    if (heap->is_doing_minor_gc && !heap->is_young_range_overflowed) {
+        /* the old WOs are all marked, and the dead ones have been
+           freed by the previous sweeps */
+        tot_free = sweep_young_ranges(heap);
+        goto sweep_done;
+    }
+    free_young_ranges(heap);
+#endif
+
     cur = (hmu_t *)heap->base_addr;
     last = NULL;
     end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
@@ -85,7 +1072,17 @@ sweep_instance_heap(gc_heap_t *heap)
         heap->kfc_normal_list[i].next = NULL;
     }
     heap->kfc_tree_root->right = NULL;
-    heap->root_set = NULL;
+
+#if GC_PARALLEL != 0
+    /* the finalizers are called by the collector thread */
+    if (heap->is_sweep_region_valid && heap->extra_info_node_cnt == 0
+        && (pool = acquire_worker_pool(heap))) {
+        tot_free = sweep_in_parallel(pool, heap);
+        release_worker_pool(pool);
+        heap->pause_stat.last_thread_num = pool->worker_num;
+        goto sweep_done;
+    }
+#endif
 
     while (cur < end) {
         ut = hmu_get_ut(cur);
@@ -96,20 +1093,18 @@ sweep_instance_heap(gc_heap_t *heap)
             || (ut == HMU_VO && hmu_is_vo_freed(cur))
             || (ut == HMU_WO && !hmu_is_wo_marked(cur))) {
             /* merge previous free areas with current one */
-            if (!last)
+            if (!last) {
                 last = cur;
-
-            if (ut == HMU_WO) {
-                /* Invoke registered finalizer */
-                gc_object_t cur_obj = hmu_to_obj(cur);
-                if (gct_vm_get_extra_info_flag(cur_obj)) {
-                    extra_info_node_t *node = gc_search_extra_info_node(
-                        (gc_handle_t)heap, cur_obj, NULL);
-                    bh_assert(node);
-                    node->finalizer(node->obj, node->data);
-                    gc_unset_finalizer((gc_handle_t)heap, cur_obj);
-                }
+#if GC_PARALLEL != 0
+                RECORD_SWEEP_REGIONS(heap->sweep_region_offsets, region_idx,
+                                     GC_SWEEP_REGION_NUM, region_size,
+                                     (gc_size_t)((gc_uint8 *)cur
+                                                 - heap->base_addr));
+#endif
             }
+
+            if (ut == HMU_WO)
+                finalize_wo(heap, cur);
         }
         else {
             /* current block is still live */
@@ -119,11 +1114,19 @@ sweep_instance_heap(gc_heap_t *heap)
                 hmu_mark_pinuse(last);
                 last = NULL;
             }
+#if GC_PARALLEL != 0
+            RECORD_SWEEP_REGIONS(heap->sweep_region_offsets, region_idx,
+                                 GC_SWEEP_REGION_NUM, region_size,
+                                 (gc_size_t)((gc_uint8 *)cur
+                                             - heap->base_addr));
+#endif
 
-            if (ut == HMU_WO) {
+            if (ut == HMU_WO && !is_mark_sticky(heap)) {
                 /* unmark it */
                 hmu_unmark_wo(cur);
             }
+            /* else keep the mark bit, the WO is promoted to the
+               old generation */
         }
 
         cur = (hmu_t *)((char *)cur + size);
@@ -132,18 +1135,45 @@ sweep_instance_heap(gc_heap_t *heap)
     bh_assert(cur == end);
 
     if (last) {
-        tot_free += (gc_size_t)((char *)cur - (char *)last);
-        gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
-        hmu_mark_pinuse(last);
+        tot_free += add_tail_run(heap, last, tot_free);
     }
 
+#if GC_PARALLEL != 0
+    RECORD_SWEEP_REGIONS(heap->sweep_region_offsets, region_idx,
+                         GC_SWEEP_REGION_NUM, region_size,
+                         heap->current_size);
+    heap->is_sweep_region_valid = 1;
+#endif
+
+#if GC_PARALLEL != 0 || GC_GENERATIONAL != 0
+sweep_done:
+#endif
     heap->total_free_size = tot_free;
 
+#if GC_GENERATIONAL != 0
+    if (!heap->is_doing_minor_gc) {
+        heap->live_size_after_full_gc = heap->current_size - tot_free;
+        heap->total_full_gc_count++;
+    }
+    else {
+        /* Do a full GC next time if the old generation has taken
+           more than half of the space left by the last full GC */
+        if (heap->current_size - tot_free - heap->live_size_after_full_gc
+            > (heap->current_size - heap->live_size_after_full_gc) / 2)
+            heap->is_full_gc_required = 1;
+        heap->total_minor_gc_count++;
+    }
+#endif
+
 #if GC_STAT_DATA != 0
     heap->total_gc_count++;
     if ((heap->current_size - tot_free) > heap->highmark_size)
         heap->highmark_size = heap->current_size - tot_free;
 
+#endif
+    update_size_freed(heap);
+#if GC_GROWABLE_HEAP != 0
+    resize_heap_after_gc(heap);
 #endif
     gc_update_threshold(heap);
 }
@@ -223,57 +1253,686 @@ gc_add_root(void *heap_p, gc_object_t obj)
         return GC_ERROR;
     }
 
-    if (add_wo_to_expand(heap, obj) != GC_SUCCESS) {
-        heap->is_fast_marking_failed = 1;
-        return GC_ERROR;
+    if (add_wo_to_expand(heap, obj) != GC_SUCCESS) {
+        heap->is_fast_marking_failed = 1;
+        return GC_ERROR;
+    }
+
+    return GC_SUCCESS;
+}
+
+/**
+ * Unmark all marked objects to do rollback
+ *
+ * @param heap the heap to do rollback, should be a valid instance heap
+ */
+static void
+rollback_mark(gc_heap_t *heap)
+{
+    mark_node_t *mark_node = NULL, *next_mark_node = NULL;
+    hmu_t *cur = NULL, *end = NULL;
+    hmu_type_t ut;
+    gc_size_t size;
+
+    bh_assert(gci_is_heap_valid(heap));
+
+    /* roll back*/
+    mark_node = (mark_node_t *)heap->root_set;
+    while (mark_node) {
+        next_mark_node = mark_node->next;
+        free_mark_node(mark_node);
+        mark_node = next_mark_node;
+    }
+
+    heap->root_set = NULL;
+
+    /* then traverse the heap to unmark all marked wos*/
+
+    cur = (hmu_t *)heap->base_addr;
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
+    while (cur < end) {
+        ut = hmu_get_ut(cur);
+        size = hmu_get_size(cur);
+
+        if (ut == HMU_WO && hmu_is_wo_marked(cur)) {
+            hmu_unmark_wo(cur);
+        }
+
+        cur = (hmu_t *)((char *)cur + size);
+    }
+
+    bh_assert(cur == end);
+
+#if GC_GENERATIONAL != 0
+    /* the old generation is lost, rebuild it with a full GC */
+    heap->is_full_gc_required = 1;
+    free_remembered_set(heap);
+#endif
+}
+
+/**
+ * Add the objects referred by a WO to the to-expand list
+ *
+ * @param heap should be a valid instance heap
+ * @param obj should be a valid wo inside @heap
+ *
+ * @return GC_ERROR if there is no more resource for marking,
+ *         GC_SUCCESS if success
+ */
+static int
+add_wo_refs_to_expand(gc_heap_t *heap, gc_object_t obj)
+{
+    bool is_compact_mode = false;
+    gc_object_t ref = NULL;
+    gc_uint32 ref_num = 0, ref_start_offset = 0, size = 0, offset = 0, j;
+    gc_uint16 *ref_list = NULL;
+
+    size = hmu_get_size(obj_to_hmu(obj));
+
+    if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode, &ref_num,
+                                         &ref_list, &ref_start_offset)) {
+        LOG_ERROR("mark process failed because failed "
+                  "vm_get_wasm_object_ref_list");
+        return GC_ERROR;
+    }
+
+    if (ref_num >= 2U * GB) {
+        LOG_ERROR("Invalid ref_num returned");
+        return GC_ERROR;
+    }
+
+    for (j = 0; j < ref_num; j++) {
+        if (is_compact_mode)
+            offset = ref_start_offset + j * sizeof(void *);
+        else
+            offset = ref_list[j];
+        bh_assert(offset + sizeof(void *) < size);
+
+        ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
+        if (ref == NULL_REF || ((uintptr_t)ref & 1))
+            continue; /* null object or i31 object */
+        if (add_wo_to_expand(heap, ref) == GC_ERROR) {
+            LOG_ERROR("mark process failed");
+            return GC_ERROR;
+        }
+    }
+
+    (void)size;
+    return GC_SUCCESS;
+}
+
+#if GC_GENERATIONAL != 0
+/* Maximum number of the generational heaps whose remembered WOs are
+   tracked by the write barrier, the minor GC of the others scans the
+   whole heap for the remembered WOs */
+#define GC_GENERATIONAL_HEAP_NUM 32
+
+/* Registry of the generational heaps, so that the write barrier can find
+   the heap of an object: bit i of generational_heap_mask is set after
+   the address range and the heap are stored in slot i, the slots are
+   allocated with generational_heap_slots */
+static gc_uint8 *generational_heap_ranges[GC_GENERATIONAL_HEAP_NUM][2];
+static gc_heap_t *generational_heaps[GC_GENERATIONAL_HEAP_NUM];
+static uint32 generational_heap_slots;
+static uint32 generational_heap_mask;
+
+/* Check ems_gc_internal.h for description */
+void
+gci_init_generations(gc_heap_t *heap)
+{
+    gc_uint8 *end = heap->base_addr + heap->current_size;
+    uint32 i, bit;
+
+    if (heap->is_remembered_set_tracked)
+        return;
+
+#if GC_GROWABLE_HEAP != 0
+    /* the range which the heap can grow to */
+    if (heap->reserved_size > 0)
+        end = heap->base_addr + heap->max_size;
+#endif
+
+    for (i = 0; i < GC_GENERATIONAL_HEAP_NUM; i++) {
+        bit = (uint32)1 << i;
+        if (!(BH_ATOMIC_32_FETCH_OR(generational_heap_slots, bit) & bit)) {
+            generational_heap_ranges[i][0] = heap->base_addr;
+            generational_heap_ranges[i][1] = end;
+            generational_heaps[i] = heap;
+            heap->generational_slot = i;
+            heap->is_remembered_set_tracked = 1;
+            BH_ATOMIC_32_FETCH_OR(generational_heap_mask, bit);
+            return;
+        }
+    }
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_destroy_generations(gc_heap_t *heap)
+{
+    uint32 bit = (uint32)1 << heap->generational_slot;
+
+    if (heap->is_remembered_set_tracked) {
+        BH_ATOMIC_32_FETCH_AND(generational_heap_mask, ~bit);
+        BH_ATOMIC_32_FETCH_AND(generational_heap_slots, ~bit);
+        heap->is_remembered_set_tracked = 0;
+    }
+    free_remembered_set(heap);
+    free_young_ranges(heap);
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_reset_generations(gc_heap_t *heap)
+{
+    bool is_tracked = heap->is_remembered_set_tracked;
+
+    /* the remembered bits are cleared by the full GC */
+    gci_destroy_generations(heap);
+    heap->is_full_gc_required = 1;
+    if (is_tracked)
+        gci_init_generations(heap);
+}
+
+/* Find the generational heap which a block is in from the registry */
+static gc_heap_t *
+find_generational_heap(hmu_t *hmu)
+{
+    uint32 mask = BH_ATOMIC_32_LOAD(generational_heap_mask), i;
+
+    for (i = 0; mask; i++, mask >>= 1) {
+        if ((mask & 1) && (gc_uint8 *)hmu >= generational_heap_ranges[i][0]
+            && (gc_uint8 *)hmu < generational_heap_ranges[i][1])
+            return generational_heaps[i];
+    }
+    return NULL;
+}
+
+/**
+ * Add an old WO to the remembered set of the heap
+ *
+ * @return GC_ERROR if there is no more resource, GC_SUCCESS if success
+ */
+static int
+add_wo_to_remembered_set(gc_heap_t *heap, gc_object_t obj)
+{
+    mark_node_t *mark_node = (mark_node_t *)heap->remembered_set;
+
+    if (!mark_node || mark_node->idx == mark_node->cnt) {
+        if (!(mark_node = alloc_mark_node()))
+            return GC_ERROR;
+        mark_node->next = (mark_node_t *)heap->remembered_set;
+        heap->remembered_set = mark_node;
+    }
+
+    mark_node->set[mark_node->idx++] = obj;
+    return GC_SUCCESS;
+}
+
+/**
+ * Unmark all wos to start a full GC
+ *
+ * @param heap the heap to unmark, should be a valid instance heap
+ */
+static void
+unmark_all_wos(gc_heap_t *heap)
+{
+    hmu_t *cur = (hmu_t *)heap->base_addr;
+    hmu_t *end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
+    free_remembered_set(heap);
+
+    while (cur < end) {
+        if (hmu_get_ut(cur) == HMU_WO) {
+            hmu_unmark_wo(cur);
+            hmu_forget_wo(cur);
+        }
+        cur = (hmu_t *)((char *)cur + hmu_get_size(cur));
+    }
+
+    bh_assert(cur == end);
+}
+
+/**
+ * Add the young objects referred by the remembered old wos to the
+ * to-expand list, and clear the remembered bits. The wos are taken
+ * from the remembered set, the whole heap is scanned for them only if
+ * the remembered set isn't complete.
+ *
+ * @param heap the heap to scan, should be a valid instance heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+static int
+add_remembered_wos_to_expand(gc_heap_t *heap)
+{
+    mark_node_t *node = (mark_node_t *)heap->remembered_set;
+    hmu_t *cur, *end;
+    int ret = GC_SUCCESS;
+    uint32 i;
+
+    if (heap->is_remembered_set_tracked
+        && !heap->is_remembered_set_overflowed) {
+        for (; node && ret == GC_SUCCESS; node = node->next) {
+            for (i = 0; i < node->idx; i++) {
+                cur = obj_to_hmu(node->set[i]);
+                hmu_forget_wo(cur);
+                if (hmu_is_wo_marked(cur)
+                    && add_wo_refs_to_expand(heap, node->set[i])
+                           != GC_SUCCESS) {
+                    /* the remembered bits left are cleared by the
+                       full GC after the rollback */
+                    ret = GC_ERROR;
+                    break;
+                }
+            }
+        }
+        free_remembered_set(heap);
+        return ret;
+    }
+
+    free_remembered_set(heap);
+    cur = (hmu_t *)heap->base_addr;
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
+    while (cur < end) {
+        if (hmu_get_ut(cur) == HMU_WO && hmu_is_wo_remembered(cur)) {
+            hmu_forget_wo(cur);
+            if (hmu_is_wo_marked(cur)
+                && add_wo_refs_to_expand(heap, hmu_to_obj(cur))
+                       != GC_SUCCESS)
+                return GC_ERROR;
+        }
+        cur = (hmu_t *)((char *)cur + hmu_get_size(cur));
+    }
+
+    bh_assert(cur == end);
+    return GC_SUCCESS;
+}
+#endif
+
+/**
+ * Record a pause of the mutators caused by the GC, the heap lock
+ * should be held
+ */
+static void
+record_pause(gc_heap_t *heap, uint64 time)
+{
+    uint32 i = 0;
+
+    while (i < GC_PAUSE_HISTOGRAM_SIZE - 1 && time >= ((uint64)1 << i))
+        i++;
+    heap->pause_stat.pause_time_histogram[i]++;
+
+    heap->pause_stat.count++;
+    heap->pause_stat.total_time += time;
+    heap->pause_stat.last_time = time;
+    if (time > heap->pause_stat.max_time)
+        heap->pause_stat.max_time = time;
+}
+
+#if GC_INCREMENTAL != 0
+#if BH_ATOMIC_32_IS_ATOMIC == 0
+#error "Incremental GC requires atomic operations"
+#endif
+
+/* Maximum number of the heaps which are marked incrementally at the
+   same time, the others are reclaimed stop-the-world */
+#define GC_MARKING_HEAP_NUM 32
+
+/* The time is checked after this number of WOs are expanded or blocks
+   are swept */
+#define GC_SLICE_CHECK_INTERVAL 64
+
+/* Time budget of a slice in microseconds, see gc_set_slice_budget() */
+static gc_uint32 gc_slice_budget;
+
+/* Registry of the heaps being marked, so that the pre write barrier can
+   find the heap of an object: bit i of marking_heap_mask is set after
+   the address range and the heap are stored in slot i, the slots are
+   allocated with marking_heap_slots */
+static gc_uint8 *marking_heap_ranges[GC_MARKING_HEAP_NUM][2];
+static gc_heap_t *marking_heaps[GC_MARKING_HEAP_NUM];
+static uint32 marking_heap_slots;
+static uint32 marking_heap_mask;
+
+static bool
+register_marking_heap(gc_heap_t *heap)
+{
+    uint32 i, bit;
+
+    for (i = 0; i < GC_MARKING_HEAP_NUM; i++) {
+        bit = (uint32)1 << i;
+        if (!(BH_ATOMIC_32_FETCH_OR(marking_heap_slots, bit) & bit)) {
+            marking_heap_ranges[i][0] = heap->base_addr;
+            marking_heap_ranges[i][1] = heap->base_addr + heap->current_size;
+            marking_heaps[i] = heap;
+            heap->marking_slot = i;
+            BH_ATOMIC_32_FETCH_OR(marking_heap_mask, bit);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void
+unregister_marking_heap(gc_heap_t *heap)
+{
+    uint32 bit = (uint32)1 << heap->marking_slot;
+
+    BH_ATOMIC_32_FETCH_AND(marking_heap_mask, ~bit);
+    BH_ATOMIC_32_FETCH_AND(marking_heap_slots, ~bit);
+}
+
+/**
+ * Add a WO which is going to be unreferenced to the to-expand list of
+ * its heap if the heap is being marked
+ */
+static void
+shade_wo(gc_object_t obj)
+{
+    gc_uint8 *hmu = (gc_uint8 *)obj_to_hmu(obj);
+    uint32 mask = BH_ATOMIC_32_LOAD(marking_heap_mask), i;
+    gc_heap_t *heap;
+
+    for (i = 0; mask; i++, mask >>= 1) {
+        if (!(mask & 1) || hmu < marking_heap_ranges[i][0]
+            || hmu >= marking_heap_ranges[i][1])
+            continue;
+
+        heap = marking_heaps[i];
+        gct_vm_mutex_lock(&heap->lock);
+        if (heap->gc_phase == GC_PHASE_MARK
+            && add_wo_to_expand(heap, obj) != GC_SUCCESS)
+            /* the reclaim is aborted by the next slice */
+            heap->is_fast_marking_failed = 1;
+        gct_vm_mutex_unlock(&heap->lock);
+        return;
+    }
+}
+
+bool
+gci_is_incremental_gc_enabled(gc_heap_t *heap)
+{
+    return gc_slice_budget != 0 && heap->is_incremental_gc_enabled;
+}
+
+/**
+ * Abort the incremental marking, all the marked WOs are unmarked and
+ * the heap can be reclaimed stop-the-world, the heap lock should be held
+ */
+static void
+abort_incremental_marking(gc_heap_t *heap)
+{
+    unregister_marking_heap(heap);
+    heap->nursery.is_marking = 0;
+#if GC_GENERATIONAL != 0
+    /* the live WOs are unmarked by the lazy sweep, so the generations
+       are rebuilt by a full GC if the heap is reclaimed stop-the-world
+       later */
+    free_young_ranges(heap);
+    heap->is_full_gc_required = 1;
+#endif
+    heap->gc_phase = GC_PHASE_IDLE;
+    heap->is_fast_marking_failed = 0;
+    rollback_mark(heap);
+}
+
+/* Check ems_gc_internal.h for description */
+int
+gci_start_incremental_gc(gc_heap_t *heap)
+{
+    int ret = GC_ERROR;
+    bool is_enumerated;
+    uint64 start_time, time;
+
+    start_time = os_time_get_boot_us();
+
+    gct_vm_gc_prepare(NULL);
+    gct_vm_mutex_lock(&heap->lock);
+
+    if (heap->gc_phase != GC_PHASE_IDLE) {
+        /* started by another thread */
+        ret = GC_SUCCESS;
+        goto unlock;
+    }
+
+#if WASM_ENABLE_THREAD_MGR == 0
+    if (!heap->exec_env)
+        goto unlock;
+#else
+    if (!heap->cluster)
+        goto unlock;
+#endif
+
+    if (!register_marking_heap(heap))
+        goto unlock;
+
+    heap->root_set = NULL;
+    heap->pause_stat.last_mark_time = heap->pause_stat.last_sweep_time = 0;
+    heap->pause_stat.last_thread_num = 1;
+    heap->size_allocated_since_slice = 0;
+    /* the space left in the nursery is merged into free chunks by the
+       sweep, and the compiled code calls the pre write barrier from now
+       on */
+    gc_reset_nursery(heap);
+    heap->nursery.is_marking = 1;
+    heap->gc_phase = GC_PHASE_MARK;
+
+    /* The snapshot of the heap: the WOs referred by the rootset now and
+       the WOs they refer to are marked by the following slices, while the
+       references overwritten are shaded by the pre write barrier, so the
+       rootset needn't be enumerated again */
+#if WASM_ENABLE_THREAD_MGR == 0
+    is_enumerated = gct_vm_begin_rootset_enumeration(heap->exec_env, heap);
+#else
+    is_enumerated = gct_vm_begin_rootset_enumeration(heap->cluster, heap);
+#endif
+    if (!is_enumerated || heap->is_fast_marking_failed) {
+        LOG_ERROR("enumerate rootset failed");
+        abort_incremental_marking(heap);
+        goto unlock;
+    }
+
+    time = os_time_get_boot_us() - start_time;
+    heap->pause_stat.last_mark_time += time;
+    record_pause(heap, time);
+    ret = GC_SUCCESS;
+
+unlock:
+    gct_vm_mutex_unlock(&heap->lock);
+    gct_vm_gc_finished(NULL);
+    return ret;
+}
+
+/**
+ * Expand the to-expand list until it is empty or the deadline is reached
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if there is no more resource
+ *         for marking
+ */
+static int
+mark_slice(gc_heap_t *heap, uint64 deadline)
+{
+    mark_node_t *mark_node;
+    gc_object_t obj;
+    gc_uint32 num = 0;
+
+    while ((mark_node = (mark_node_t *)heap->root_set)) {
+        if (mark_node->idx == 0) {
+            heap->root_set = mark_node->next;
+            free_mark_node(mark_node);
+            continue;
+        }
+
+        /* the WOs obj refers to are pushed to the top node */
+        obj = mark_node->set[--mark_node->idx];
+        if (add_wo_refs_to_expand(heap, obj) != GC_SUCCESS)
+            return GC_ERROR;
+
+        if (++num % GC_SLICE_CHECK_INTERVAL == 0
+            && os_time_get_boot_us() >= deadline)
+            break;
     }
-
     return GC_SUCCESS;
 }
 
 /**
- * Unmark all marked objects to do rollback
- *
- * @param heap the heap to do rollback, should be a valid instance heap
+ * Start the lazy sweep after the marking is finished: the free lists
+ * are reset, and rebuilt by the sweep slices from the start of the heap
  */
 static void
-rollback_mark(gc_heap_t *heap)
+start_lazy_sweep(gc_heap_t *heap)
 {
-    mark_node_t *mark_node = NULL, *next_mark_node = NULL;
-    hmu_t *cur = NULL, *end = NULL;
-    hmu_type_t ut;
-    gc_size_t size;
+    int i, lsize;
 
-    bh_assert(gci_is_heap_valid(heap));
+    unregister_marking_heap(heap);
+    heap->nursery.is_marking = 0;
 
-    /* roll back*/
-    mark_node = (mark_node_t *)heap->root_set;
-    while (mark_node) {
-        next_mark_node = mark_node->next;
-        free_mark_node(mark_node);
-        mark_node = next_mark_node;
+    lsize =
+        (int)(sizeof(heap->kfc_normal_list) / sizeof(heap->kfc_normal_list[0]));
+    for (i = 0; i < lsize; i++) {
+        heap->kfc_normal_list[i].next = NULL;
     }
+    heap->kfc_tree_root->right = NULL;
+    gc_invalidate_sweep_regions(heap);
 
-    heap->root_set = NULL;
+    heap->total_free_size = 0;
+    heap->sweep_cursor = (hmu_t *)heap->base_addr;
+    heap->gc_phase = GC_PHASE_SWEEP;
+}
 
-    /* then traverse the heap to unmark all marked wos*/
+/**
+ * Sweep the heap from the sweep cursor until the end of the heap or the
+ * deadline is reached, the free blocks found are linked into the free
+ * lists and the live WOs are unmarked. A slice always stops after a live
+ * block, so that the free blocks before it are merged.
+ */
+static void
+sweep_slice(gc_heap_t *heap, uint64 deadline)
+{
+    hmu_t *cur = heap->sweep_cursor, *last = NULL, *end;
+    hmu_type_t ut;
+    gc_size_t size;
+    gc_uint32 num = 0;
 
-    cur = (hmu_t *)heap->base_addr;
-    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+    end = (hmu_t *)(heap->base_addr + heap->current_size);
 
     while (cur < end) {
         ut = hmu_get_ut(cur);
         size = hmu_get_size(cur);
+        bh_assert(size > 0);
 
-        if (ut == HMU_WO && hmu_is_wo_marked(cur)) {
-            hmu_unmark_wo(cur);
+        if (ut == HMU_FC || ut == HMU_FM
+            || (ut == HMU_VO && hmu_is_vo_freed(cur))
+            || (ut == HMU_WO && !hmu_is_wo_marked(cur))) {
+            if (!last)
+                last = cur;
+
+            if (ut == HMU_WO)
+                finalize_wo(heap, cur);
+        }
+        else {
+            if (last) {
+                heap->total_free_size +=
+                    (gc_size_t)((char *)cur - (char *)last);
+                gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
+                hmu_mark_pinuse(last);
+                last = NULL;
+            }
+
+            if (ut == HMU_WO) {
+                hmu_unmark_wo(cur);
+                hmu_forget_wo(cur);
+            }
         }
 
         cur = (hmu_t *)((char *)cur + size);
+
+        if (!last && ++num % GC_SLICE_CHECK_INTERVAL == 0
+            && os_time_get_boot_us() >= deadline)
+            break;
     }
 
-    bh_assert(cur == end);
+    if (last) {
+        /* the slice has reached the end of the heap */
+        heap->total_free_size +=
+            add_tail_run(heap, last, heap->total_free_size);
+        cur = (hmu_t *)(heap->base_addr + heap->current_size);
+    }
+
+    heap->sweep_cursor = cur;
+}
+
+static void
+finish_lazy_sweep(gc_heap_t *heap)
+{
+    heap->gc_phase = GC_PHASE_IDLE;
+
+#if GC_GENERATIONAL != 0
+    heap->live_size_after_full_gc =
+        heap->current_size - heap->total_free_size;
+    heap->total_full_gc_count++;
+#endif
+
+#if GC_STAT_DATA != 0
+    heap->total_gc_count++;
+    if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - heap->total_free_size;
+#endif
+    update_size_freed(heap);
+#if GC_GROWABLE_HEAP != 0
+    resize_heap_after_gc(heap);
+#endif
+    gc_update_threshold(heap);
+}
+
+/* Check ems_gc_internal.h for description */
+void
+gci_gc_slice(gc_heap_t *heap, bool is_mark_unbounded)
+{
+    uint64 start_time = os_time_get_boot_us(), time;
+    uint64 deadline = start_time + gc_slice_budget;
+
+    if (heap->gc_phase == GC_PHASE_MARK) {
+        if (heap->is_fast_marking_failed
+            || mark_slice(heap, is_mark_unbounded ? UINT64_MAX : deadline)
+                   != GC_SUCCESS) {
+            LOG_ERROR("mark process is not successfully finished");
+            abort_incremental_marking(heap);
+        }
+        else if (!heap->root_set) {
+            start_lazy_sweep(heap);
+        }
+        time = os_time_get_boot_us() - start_time;
+        heap->pause_stat.last_mark_time += time;
+    }
+    else if (heap->gc_phase == GC_PHASE_SWEEP) {
+        sweep_slice(heap, deadline);
+        if ((gc_uint8 *)heap->sweep_cursor
+            == heap->base_addr + heap->current_size)
+            finish_lazy_sweep(heap);
+        time = os_time_get_boot_us() - start_time;
+        heap->pause_stat.last_sweep_time += time;
+    }
+    else {
+        return;
+    }
+
+    record_pause(heap, time);
+}
+
+/**
+ * Finish the running incremental reclaim, the heap lock should be held
+ */
+static void
+finish_incremental_gc(gc_heap_t *heap)
+{
+    while (heap->gc_phase != GC_PHASE_IDLE)
+        gci_gc_slice(heap, true);
 }
+#endif /* end of GC_INCREMENTAL != 0 */
 
 /**
  * Reclaim GC instance heap
@@ -286,24 +1945,50 @@ static int
 reclaim_instance_heap(gc_heap_t *heap)
 {
     mark_node_t *mark_node = NULL;
-    int idx = 0, j = 0;
-    bool ret, is_compact_mode = false;
-    gc_object_t obj = NULL, ref = NULL;
+    int idx = 0;
+    bool ret;
+    gc_object_t obj = NULL;
+    uint64 mark_start_time, sweep_start_time;
+#if BH_ENABLE_GC_VERIFY != 0
     hmu_t *hmu = NULL;
-    gc_uint32 ref_num = 0, ref_start_offset = 0, size = 0, offset = 0;
-    gc_uint16 *ref_list = NULL;
+#endif
+#if GC_PARALLEL != 0
+    gc_worker_pool_t *pool;
+    int mark_ret;
+#endif
 
     bh_assert(gci_is_heap_valid(heap));
 
     heap->root_set = NULL;
+    heap->pause_stat.last_mark_time = heap->pause_stat.last_sweep_time = 0;
+    heap->pause_stat.last_thread_num = 1;
 
 #if WASM_ENABLE_THREAD_MGR == 0
     if (!heap->exec_env)
         return GC_SUCCESS;
-    ret = gct_vm_begin_rootset_enumeration(heap->exec_env, heap);
 #else
     if (!heap->cluster)
         return GC_SUCCESS;
+#endif
+
+#if GC_GENERATIONAL != 0
+    /* Do a minor GC unless a full GC is required: the marked (old) wos
+       aren't expanded again, and only the remembered ones are scanned
+       for references to young wos */
+    heap->is_doing_minor_gc = !heap->is_minor_gc_disabled
+                              && !heap->is_full_gc_required
+                              && is_mark_sticky(heap);
+    if (!heap->is_doing_minor_gc) {
+        heap->is_full_gc_required = 0;
+        unmark_all_wos(heap);
+    }
+#endif
+
+    mark_start_time = os_time_get_boot_us();
+
+#if WASM_ENABLE_THREAD_MGR == 0
+    ret = gct_vm_begin_rootset_enumeration(heap->exec_env, heap);
+#else
     ret = gct_vm_begin_rootset_enumeration(heap->cluster, heap);
 #endif
     if (!ret)
@@ -345,6 +2030,33 @@ reclaim_instance_heap(gc_heap_t *heap)
         return GC_ERROR;
     }
 
+#if GC_GENERATIONAL != 0
+    if (heap->is_doing_minor_gc
+        && add_remembered_wos_to_expand(heap) != GC_SUCCESS) {
+        LOG_ERROR("scan remembered set failed");
+        rollback_mark(heap);
+        heap->is_fast_marking_failed = 0;
+        return GC_ERROR;
+    }
+#endif
+
+#if GC_PARALLEL != 0
+    /* expand the to-expand list with the helper threads, the workers
+       steal the nodes filled by each other */
+    if ((pool = acquire_worker_pool(heap))) {
+        mark_ret = mark_in_parallel(pool, heap);
+        release_worker_pool(pool);
+        if (mark_ret != GC_SUCCESS) {
+            LOG_ERROR("mark process is not successfully finished");
+            rollback_mark(heap);
+            return GC_ERROR;
+        }
+        /* the sweep may still be done by the collector thread alone */
+        heap->pause_stat.last_thread_num = pool->worker_num;
+        goto mark_done;
+    }
+#endif
+
     /* the algorithm we use to mark all objects */
     /* 1. mark rootset and organize them into a mark_node list (last marked
      * roots at list header, i.e. stack top) */
@@ -358,53 +2070,8 @@ reclaim_instance_heap(gc_heap_t *heap)
         /* note that mark_node->idx may change in each loop */
         for (idx = 0; idx < (int)mark_node->idx; idx++) {
             obj = mark_node->set[idx];
-            hmu = obj_to_hmu(obj);
-            size = hmu_get_size(hmu);
-
-            if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode,
-                                                 &ref_num, &ref_list,
-                                                 &ref_start_offset)) {
-                LOG_ERROR("mark process failed because failed "
-                          "vm_get_wasm_object_ref_list");
-                break;
-            }
-
-            if (ref_num >= 2U * GB) {
-                LOG_ERROR("Invalid ref_num returned");
+            if (add_wo_refs_to_expand(heap, obj) != GC_SUCCESS)
                 break;
-            }
-
-            if (is_compact_mode) {
-                for (j = 0; j < (int)ref_num; j++) {
-                    offset = ref_start_offset + j * sizeof(void *);
-                    bh_assert(offset + sizeof(void *) < size);
-                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
-                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
-                        continue; /* null object or i31 object */
-                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
-                        LOG_ERROR("add_wo_to_expand failed");
-                        break;
-                    }
-                }
-                if (j < (int)ref_num)
-                    break;
-            }
-            else {
-                for (j = 0; j < (int)ref_num; j++) {
-                    offset = ref_list[j];
-                    bh_assert(offset + sizeof(void *) < size);
-
-                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
-                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
-                        continue; /* null object or i31 object */
-                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
-                        LOG_ERROR("mark process failed");
-                        break;
-                    }
-                }
-                if (j < (int)ref_num)
-                    break;
-            }
         }
         if (idx < (int)mark_node->idx)
             break; /* not yet done */
@@ -424,10 +2091,17 @@ reclaim_instance_heap(gc_heap_t *heap)
         return GC_ERROR;
     }
 
+#if GC_PARALLEL != 0
+mark_done:
+#endif
+    sweep_start_time = os_time_get_boot_us();
+    heap->pause_stat.last_mark_time = sweep_start_time - mark_start_time;
+
     /* now sweep */
     sweep_instance_heap(heap);
 
-    (void)size;
+    heap->pause_stat.last_sweep_time =
+        os_time_get_boot_us() - sweep_start_time;
 
     return GC_SUCCESS;
 }
@@ -444,16 +2118,29 @@ gci_gc_heap(void *h)
 {
     int ret = GC_ERROR;
     gc_heap_t *heap = (gc_heap_t *)h;
+    uint64 start_time, time;
 
     bh_assert(gci_is_heap_valid(heap));
 
     LOG_VERBOSE("#reclaim instance heap %p", heap);
 
+    start_time = os_time_get_boot_us();
+
     /* TODO: get exec_env of current thread when GC multi-threading
        is enabled, and pass it to runtime */
     gct_vm_gc_prepare(NULL);
 
     gct_vm_mutex_lock(&heap->lock);
+#if GC_INCREMENTAL != 0
+    if (heap->gc_phase != GC_PHASE_IDLE) {
+        /* finish the running incremental reclaim instead, the pauses
+           are recorded by its slices */
+        finish_incremental_gc(heap);
+        gct_vm_mutex_unlock(&heap->lock);
+        gct_vm_gc_finished(NULL);
+        return GC_SUCCESS;
+    }
+#endif
     heap->is_doing_reclaim = 1;
 
     ret = reclaim_instance_heap(heap);
@@ -465,6 +2152,12 @@ gci_gc_heap(void *h)
        is enabled, and pass it to runtime */
     gct_vm_gc_finished(NULL);
 
+    /* the world is stopped from gct_vm_gc_prepare to gct_vm_gc_finished */
+    time = os_time_get_boot_us() - start_time;
+    gct_vm_mutex_lock(&heap->lock);
+    record_pause(heap, time);
+    gct_vm_mutex_unlock(&heap->lock);
+
     LOG_VERBOSE("#reclaim instance heap %p done", heap);
 
 #if BH_ENABLE_GC_VERIFY != 0
@@ -485,6 +2178,190 @@ gc_is_dead_object(void *obj)
     return !hmu_is_wo_marked(obj_to_hmu(obj));
 }
 
+/* Check ems_gc.h for description*/
+void
+gc_write_barrier(gc_object_t obj)
+{
+#if GC_GENERATIONAL != 0
+    hmu_t *hmu = obj_to_hmu(obj);
+
+    gc_heap_t *heap;
+
+    /* only the old wos need to be remembered, the young ones
+       are always scanned by the minor GC */
+    if (!hmu_is_wo_marked(hmu) || hmu_is_wo_remembered(hmu))
+        return;
+
+    if (!(heap = find_generational_heap(hmu))) {
+        /* the minor GC scans the whole heap for the remembered bits */
+        BH_ATOMIC_32_FETCH_OR(hmu->header, (uint32)1 << HMU_WO_RB_OFFSET);
+        return;
+    }
+
+    gct_vm_mutex_lock(&heap->lock);
+    if (hmu_is_wo_marked(hmu) && !hmu_is_wo_remembered(hmu)) {
+        BH_ATOMIC_32_FETCH_OR(hmu->header, (uint32)1 << HMU_WO_RB_OFFSET);
+        if (add_wo_to_remembered_set(heap, obj) != GC_SUCCESS) {
+            LOG_ERROR("add obj to the remembered set failed");
+            heap->is_remembered_set_overflowed = 1;
+        }
+    }
+    gct_vm_mutex_unlock(&heap->lock);
+#else
+    (void)obj;
+#endif
+}
+
+/* Check ems_gc.h for description*/
+void
+gc_disable_minor_gc(gc_handle_t handle)
+{
+#if GC_GENERATIONAL != 0
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+    heap->is_minor_gc_disabled = 1;
+#else
+    (void)handle;
+#endif
+}
+
+/* Check ems_gc.h for description*/
+void
+gc_pre_write_barrier(gc_object_t *slots, gc_uint32 num)
+{
+#if GC_INCREMENTAL != 0
+    gc_object_t obj;
+    gc_uint32 i;
+
+    if (!BH_ATOMIC_32_LOAD(marking_heap_mask))
+        return;
+
+    for (i = 0; i < num; i++) {
+        obj = slots[i];
+        /* skip the null objects, the i31 objects and the marked WOs */
+        if (obj == NULL_REF || ((uintptr_t)obj & 1)
+            || hmu_is_wo_marked(obj_to_hmu(obj)))
+            continue;
+        shade_wo(obj);
+    }
+#else
+    (void)slots;
+    (void)num;
+#endif
+}
+
+/* Check ems_gc.h for description*/
+void
+gc_disable_incremental_gc(gc_handle_t handle)
+{
+#if GC_INCREMENTAL != 0
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+    gct_vm_mutex_lock(&heap->lock);
+    if (heap->gc_phase == GC_PHASE_MARK)
+        abort_incremental_marking(heap);
+    finish_incremental_gc(heap);
+    heap->is_incremental_gc_enabled = 0;
+    gct_vm_mutex_unlock(&heap->lock);
+#else
+    (void)handle;
+#endif
+}
+
+/* The compiled code accesses the HMU header and the fields of the
+   nursery with the layout in ems_gc.h */
+bh_static_assert(sizeof(hmu_t) == GC_HMU_HEADER_SIZE);
+bh_static_assert(offsetof(gc_tlab_t, cur) == 0);
+bh_static_assert(offsetof(gc_tlab_t, end) == sizeof(void *));
+bh_static_assert(offsetof(gc_tlab_t, is_marking) == 2 * sizeof(void *));
+
+gc_tlab_t *
+gc_get_tlab(gc_handle_t handle)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+    return &heap->nursery;
+}
+
+/* Check ems_gc.h for description*/
+void
+gc_get_pause_stat(gc_handle_t handle, gc_pause_stat_t *stat)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+    gct_vm_mutex_lock(&heap->lock);
+    *stat = heap->pause_stat;
+    /* the space left in the nursery isn't allocated yet */
+    stat->size_allocated -= (gc_uint64)(heap->nursery.end - heap->nursery.cur);
+    stat->heap_size = heap->current_size;
+    stat->free_size = heap->total_free_size;
+    gct_vm_mutex_unlock(&heap->lock);
+}
+
+/* Check ems_gc.h for description*/
+int
+gc_traverse_objects(gc_handle_t handle, gc_object_visitor_t visitor,
+                    void *user_data)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+    hmu_t *cur, *end;
+    gc_size_t size;
+    int ret = GC_SUCCESS;
+
+    gct_vm_mutex_lock(&heap->lock);
+
+    cur = (hmu_t *)heap->base_addr;
+    end = (hmu_t *)(heap->base_addr + heap->current_size);
+    while (cur < end) {
+        size = hmu_get_size(cur);
+        if (size == 0
+            || size > (gc_size_t)((gc_uint8 *)end - (gc_uint8 *)cur)) {
+            ret = GC_ERROR;
+            break;
+        }
+
+        if (hmu_get_ut(cur) == HMU_WO
+#if GC_INCREMENTAL != 0
+            /* the unmarked WOs not swept yet are garbage */
+            && !(heap->gc_phase == GC_PHASE_SWEEP && cur >= heap->sweep_cursor
+                 && !hmu_is_wo_marked(cur))
+#endif
+        )
+            visitor(hmu_to_obj(cur), size, user_data);
+
+        cur = (hmu_t *)((gc_uint8 *)cur + size);
+    }
+
+    gct_vm_mutex_unlock(&heap->lock);
+    return ret;
+}
+
+#if GC_PARALLEL == 0
+int
+gc_init_helper_threads(gc_uint32 num)
+{
+    (void)num;
+    return GC_ERROR;
+}
+
+void
+gc_destroy_helper_threads(void)
+{}
+#endif
+
+/* Check ems_gc.h for description*/
+int
+gc_set_slice_budget(gc_uint32 budget_us)
+{
+#if GC_INCREMENTAL != 0
+    gc_slice_budget = budget_us;
+    return GC_SUCCESS;
+#else
+    (void)budget_us;
+    return GC_ERROR;
+#endif
+}
+
 #else
 
 int
@@ -494,4 +2371,71 @@ gci_gc_heap(void *h)
     return GC_ERROR;
 }
 
+void
+gc_write_barrier(gc_object_t obj)
+{
+    (void)obj;
+}
+
+void
+gc_disable_minor_gc(gc_handle_t handle)
+{
+    (void)handle;
+}
+
+void
+gc_pre_write_barrier(gc_object_t *slots, gc_uint32 num)
+{
+    (void)slots;
+    (void)num;
+}
+
+void
+gc_disable_incremental_gc(gc_handle_t handle)
+{
+    (void)handle;
+}
+
+gc_tlab_t *
+gc_get_tlab(gc_handle_t handle)
+{
+    (void)handle;
+    return NULL;
+}
+
+void
+gc_get_pause_stat(gc_handle_t handle, gc_pause_stat_t *stat)
+{
+    (void)handle;
+    memset(stat, 0, sizeof(gc_pause_stat_t));
+}
+
+int
+gc_traverse_objects(gc_handle_t handle, gc_object_visitor_t visitor,
+                    void *user_data)
+{
+    (void)handle;
+    (void)visitor;
+    (void)user_data;
+    return GC_ERROR;
+}
+
+int
+gc_init_helper_threads(gc_uint32 num)
+{
+    (void)num;
+    return GC_ERROR;
+}
+
+void
+gc_destroy_helper_threads(void)
+{}
+
+int
+gc_set_slice_budget(gc_uint32 budget_us)
+{
+    (void)budget_us;
+    return GC_ERROR;
+}
+
 #endif /* end of WASM_ENABLE_GC != 0 */
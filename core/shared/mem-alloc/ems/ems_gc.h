@@ -35,6 +35,62 @@ extern "C" {
 #define GC_MANUALLY 0
 #endif
 
+/* Generational GC: the mark bits of the WOs which survive a GC are kept
+   as the old generation, and a minor GC only marks and sweeps the young
+   objects allocated since the last GC */
+#ifndef GC_GENERATIONAL
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_GENERATIONAL != 0 \
+    && GC_MANUALLY == 0 && BH_ENABLE_GC_VERIFY == 0
+#define GC_GENERATIONAL 1
+#else
+#define GC_GENERATIONAL 0
+#endif
+#endif
+
+/* Parallel GC: the heap is marked and swept by the collector thread
+   together with the GC helper threads, see gc_init_helper_threads() */
+#ifndef GC_PARALLEL
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_PARALLEL != 0 \
+    && GC_MANUALLY == 0 && BH_ENABLE_GC_VERIFY == 0
+#define GC_PARALLEL 1
+#else
+#define GC_PARALLEL 0
+#endif
+#endif
+
+/* Incremental GC: the heap is marked and swept in slices interleaved
+   with the allocations, see gc_set_slice_budget() */
+#ifndef GC_INCREMENTAL
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_INCREMENTAL != 0 \
+    && GC_MANUALLY == 0 && BH_ENABLE_GC_VERIFY == 0
+#define GC_INCREMENTAL 1
+#else
+#define GC_INCREMENTAL 0
+#endif
+#endif
+
+/* Growable heap: the heap reserves an address range and commits more
+   of it on demand, the pages at its end are decommitted again after the
+   collections, see gc_init_growable() */
+#ifndef GC_GROWABLE_HEAP
+#if WASM_ENABLE_GC != 0 && WASM_ENABLE_GC_GROWABLE_HEAP != 0
+#define GC_GROWABLE_HEAP 1
+#else
+#define GC_GROWABLE_HEAP 0
+#endif
+#endif
+
+/* Size of the chunk which small WOs are bump allocated from,
+   0 means the nursery is disabled */
+#ifndef GC_NURSERY_SIZE
+#if WASM_ENABLE_GC != 0 && GC_MANUALLY == 0 && BH_ENABLE_GC_VERIFY == 0 \
+    && GC_IN_EVERY_ALLOCATION == 0
+#define GC_NURSERY_SIZE (32 * 1024)
+#else
+#define GC_NURSERY_SIZE 0
+#endif
+#endif
+
 #define GC_HEAD_PADDING 4
 
 #ifndef NULL_REF
@@ -75,10 +131,83 @@ typedef enum {
 typedef void (*gc_finalizer_t)(void *obj, void *data);
 #endif
 
+#ifndef GC_OBJECT_VISITOR_T_DEFINED
+#define GC_OBJECT_VISITOR_T_DEFINED
+typedef void (*gc_object_visitor_t)(void *obj, gc_uint32 size,
+                                    void *user_data);
+#endif
+
 #ifndef EXTRA_INFO_NORMAL_NODE_CNT
 #define EXTRA_INFO_NORMAL_NODE_CNT 32
 #endif
 
+/**
+ * Layout of the 4-byte HMU (heap memory unit) header before each object,
+ * the compiled code allocates WOs and checks their bits inline with it,
+ * see aot_emit_gc.c: bits [31..30] are the unit type, bit 29 is the
+ * pinuse bit, bits 28 and 27 are the mark and remembered bits of a WO,
+ * and the low bits keep the size of the unit divided by 8.
+ */
+#define GC_HMU_HEADER_SIZE 4
+#define GC_HMU_UT_OFFSET 30
+#define GC_HMU_P_OFFSET 29
+#define GC_HMU_WO_MB_OFFSET 28
+#define GC_HMU_WO_RB_OFFSET 27
+#define GC_HMU_UT_WO 3
+#define GC_HMU_UT_FM 0
+
+/* Header of a newly allocated WO with the pinuse bit set, and of the
+   free block kept in the rest of the nursery, the size is or'ed in */
+#define GC_HMU_WO_NEW                                                          \
+    (((gc_uint32)GC_HMU_UT_WO << GC_HMU_UT_OFFSET) | (1U << GC_HMU_P_OFFSET))
+#define GC_HMU_FM ((gc_uint32)GC_HMU_UT_FM << GC_HMU_UT_OFFSET)
+
+/* A WO is old and not remembered yet if its header masked with
+   GC_HMU_WO_UT_MB_RB_MASK equals GC_HMU_WO_UT_MB */
+#define GC_HMU_WO_UT_MB_RB_MASK                                                \
+    ((3U << GC_HMU_UT_OFFSET) | (1U << GC_HMU_WO_MB_OFFSET)                    \
+     | (1U << GC_HMU_WO_RB_OFFSET))
+#define GC_HMU_WO_UT_MB                                                        \
+    (((gc_uint32)GC_HMU_UT_WO << GC_HMU_UT_OFFSET)                             \
+     | (1U << GC_HMU_WO_MB_OFFSET))
+
+/* The unused part [cur, end) of the nursery of a heap, small WOs are
+   bump allocated from it, see gc_get_tlab() */
+typedef struct gc_tlab {
+    gc_uint8 *cur;
+    gc_uint8 *end;
+    /* whether the heap is being marked incrementally, the references
+       overwritten should be passed to gc_pre_write_barrier() */
+    gc_uint32 is_marking;
+} gc_tlab_t;
+
+/* Number of the buckets of the pause time histogram: bucket 0 counts the
+   pauses shorter than 1us, bucket i the ones in [2^(i-1), 2^i) us, and
+   the last bucket all the longer ones */
+#define GC_PAUSE_HISTOGRAM_SIZE 24
+
+/* Statistics of the reclaims and the allocations of a heap, the times are
+   in microseconds, the layout should be kept the same as wasm_gc_stats_t
+   in gc_export.h */
+typedef struct gc_pause_stat {
+    gc_uint64 count;
+    gc_uint64 total_time;
+    gc_uint64 max_time;
+    gc_uint64 last_time;
+    /* time spent by the last reclaim in marking and sweeping */
+    gc_uint64 last_mark_time;
+    gc_uint64 last_sweep_time;
+    /* number of the threads which did the last reclaim */
+    gc_uint32 last_thread_num;
+    gc_uint64 pause_time_histogram[GC_PAUSE_HISTOGRAM_SIZE];
+    /* total size of the blocks allocated from the heap and freed */
+    gc_uint64 size_allocated;
+    gc_uint64 size_freed;
+    /* current size of the heap and of the free space in it */
+    gc_uint64 heap_size;
+    gc_uint64 free_size;
+} gc_pause_stat_t;
+
 /* extra information attached to specific object */
 typedef struct extra_info_node {
     gc_object_t obj;
@@ -260,6 +389,149 @@ gc_add_root(void *heap, gc_object_t obj);
 int
 gci_gc_heap(void *heap);
 
+/**
+ * Write barrier, should be called after a reference is stored into
+ * a WO, so that a minor GC can find the young objects it refers to.
+ *
+ * @param obj the WO which the reference is stored into
+ */
+void
+gc_write_barrier(gc_object_t obj);
+
+/**
+ * Snapshot-at-the-beginning write barrier of the incremental GC, should
+ * be called before the references in the slots of a WO are overwritten,
+ * so that the objects they refer to are still marked if their heap is
+ * being marked.
+ *
+ * @param slots the reference slots which are going to be overwritten
+ * @param num the number of the slots
+ */
+void
+gc_pre_write_barrier(gc_object_t *slots, gc_uint32 num);
+
+/**
+ * Disable the minor GC of a heap, all the following reclaims of the
+ * heap are full GCs. It is required when the heap is used by code which
+ * doesn't call the write barrier.
+ *
+ * @param handle the heap to disable minor GC
+ */
+void
+gc_disable_minor_gc(gc_handle_t handle);
+
+/**
+ * Disable the incremental GC of a heap, all the following reclaims of
+ * the heap are stop-the-world. It is required when the heap is used by
+ * code which doesn't call the pre write barrier.
+ *
+ * @param handle the heap to disable incremental GC
+ */
+void
+gc_disable_incremental_gc(gc_handle_t handle);
+
+/**
+ * Get the nursery of a heap, so that the compiled code can bump allocate
+ * WOs from it without calling into the heap. The caller must be the only
+ * thread which uses the heap, and the allocation must follow the layout
+ * kept by the heap: each WO gets a HMU header with the pinuse bit set,
+ * and [cur, end) is kept as a HMU_FM block unless it is empty.
+ * cur and end are both NULL when the nursery is empty or disabled.
+ *
+ * @param handle the heap to get the nursery
+ *
+ * @return the nursery of the heap
+ */
+gc_tlab_t *
+gc_get_tlab(gc_handle_t handle);
+
+/**
+ * Get the statistics of the reclaims and the allocations of a heap
+ *
+ * @param handle the heap to get the statistics
+ * @param stat [out] the statistics
+ */
+void
+gc_get_pause_stat(gc_handle_t handle, gc_pause_stat_t *stat);
+
+/**
+ * Call the visitor with each WO in a heap and the size of its block, the
+ * heap lock is held meanwhile. The WOs which became unreachable after
+ * the last reclaim are visited too, except the ones already found by
+ * the running lazy sweep.
+ *
+ * @param handle the heap to walk
+ * @param visitor the callback, it mustn't allocate from the heap
+ * @param user_data the data passed to the visitor
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if the heap is corrupted
+ */
+int
+gc_traverse_objects(gc_handle_t handle, gc_object_visitor_t visitor,
+                    void *user_data);
+
+/**
+ * Create the GC helper threads which are shared by all the heaps,
+ * a heap is marked and swept by the thread which triggers the GC
+ * together with them if it is large enough.
+ *
+ * @param num the number of helper threads to create
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if the threads can't be
+ *         created or GC_PARALLEL is disabled
+ */
+int
+gc_init_helper_threads(gc_uint32 num);
+
+/**
+ * Stop and destroy the GC helper threads
+ */
+void
+gc_destroy_helper_threads(void);
+
+/**
+ * Set the time budget of the slices of the incremental GC, the heaps
+ * created afterwards are marked and swept in slices interleaved with
+ * the allocations if it isn't 0.
+ *
+ * @param budget_us the time budget of a slice in microseconds, 0 means
+ *        the heaps are reclaimed stop-the-world
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if GC_INCREMENTAL is disabled
+ */
+int
+gc_set_slice_budget(gc_uint32 budget_us);
+
+/**
+ * Create a heap which reserves an address range for max_size bytes and
+ * commits init_size bytes of it. The heap grows when an allocation
+ * can't be satisfied after a GC and by the growth policy, and the free
+ * pages at its end are decommitted by the sweeps.
+ *
+ * @param init_size the size of the heap initially committed, the heap
+ *        never shrinks below it
+ * @param max_size the maximum size of the heap
+ *
+ * @return gc handle if success, NULL if the address range can't be
+ *         reserved or GC_GROWABLE_HEAP is disabled
+ */
+gc_handle_t
+gc_init_growable(gc_size_t init_size, gc_size_t max_size);
+
+/**
+ * Set the growth policy of the growable heaps
+ *
+ * @param live_ratio the percentage of a heap which is expected to be live
+ *        after a GC, the heap is grown or shrunk towards it, 0 means
+ *        the default GC_DEFAULT_LIVE_RATIO
+ * @param max_pause_us the heap isn't grown by the policy while the last
+ *        GC pause is longer than it, 0 means no limit
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if GC_GROWABLE_HEAP is disabled
+ */
+int
+gc_set_heap_growth_policy(gc_uint32 live_ratio, gc_uint32 max_pause_us);
+
 extra_info_node_t *
 gc_search_extra_info_node(gc_handle_t handle, gc_object_t obj,
                           gc_size_t *p_index);
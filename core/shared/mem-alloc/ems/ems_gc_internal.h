@@ -17,10 +17,10 @@ extern "C" {
 typedef enum hmu_type_enum {
     HMU_TYPE_MIN = 0,
     HMU_TYPE_MAX = 3,
-    HMU_WO = 3, /* WASM Object */
+    HMU_WO = GC_HMU_UT_WO, /* WASM Object */
     HMU_VO = 2, /* VM Object */
     HMU_FC = 1,
-    HMU_FM = 0
+    HMU_FM = GC_HMU_UT_FM
 } hmu_type_t;
 
 typedef struct hmu_struct {
@@ -117,7 +117,7 @@ hmu_verify(void *vheap, hmu_t *hmu);
 #define obj_to_hmu(obj) ((hmu_t *)((gc_uint8 *)(obj)-OBJ_PREFIX_SIZE) - 1)
 
 #define HMU_UT_SIZE 2
-#define HMU_UT_OFFSET 30
+#define HMU_UT_OFFSET GC_HMU_UT_OFFSET
 
 /* clang-format off */
 #define hmu_get_ut(hmu) \
@@ -129,7 +129,7 @@ hmu_verify(void *vheap, hmu_t *hmu);
 /* clang-format on */
 
 /* P in use bit means the previous chunk is in use */
-#define HMU_P_OFFSET 29
+#define HMU_P_OFFSET GC_HMU_P_OFFSET
 
 #define hmu_mark_pinuse(hmu) SETBIT((hmu)->header, HMU_P_OFFSET)
 #define hmu_unmark_pinuse(hmu) CLRBIT((hmu)->header, HMU_P_OFFSET)
@@ -137,12 +137,24 @@ hmu_verify(void *vheap, hmu_t *hmu);
 
 #define HMU_WO_VT_SIZE 27
 #define HMU_WO_VT_OFFSET 0
-#define HMU_WO_MB_OFFSET 28
+#define HMU_WO_MB_OFFSET GC_HMU_WO_MB_OFFSET
 
 #define hmu_mark_wo(hmu) SETBIT((hmu)->header, HMU_WO_MB_OFFSET)
 #define hmu_unmark_wo(hmu) CLRBIT((hmu)->header, HMU_WO_MB_OFFSET)
 #define hmu_is_wo_marked(hmu) GETBIT((hmu)->header, HMU_WO_MB_OFFSET)
 
+/**
+ * Remembered bit of WO, set by the write barrier when a reference is
+ * stored into an old (marked) object, so that the minor GC scans the
+ * object for references to young objects. The AOT code checks it inline,
+ * see GC_HMU_WO_UT_MB in ems_gc.h.
+ */
+#define HMU_WO_RB_OFFSET GC_HMU_WO_RB_OFFSET
+
+#define hmu_remember_wo(hmu) SETBIT((hmu)->header, HMU_WO_RB_OFFSET)
+#define hmu_forget_wo(hmu) CLRBIT((hmu)->header, HMU_WO_RB_OFFSET)
+#define hmu_is_wo_remembered(hmu) GETBIT((hmu)->header, HMU_WO_RB_OFFSET)
+
 /**
  * The hmu size is divisible by 8, its lowest 3 bits are 0, so we only
  * store its higher bits of bit [29..3], and bit [2..0] are not stored.
@@ -156,6 +168,7 @@ hmu_verify(void *vheap, hmu_t *hmu);
 
 #define hmu_is_vo_freed(hmu) GETBIT((hmu)->header, HMU_VO_FB_OFFSET)
 #define hmu_unfree_vo(hmu) CLRBIT((hmu)->header, HMU_VO_FB_OFFSET)
+#define hmu_free_vo(hmu) SETBIT((hmu)->header, HMU_VO_FB_OFFSET)
 
 #define hmu_get_size(hmu) \
     (GETBITS((hmu)->header, HMU_SIZE_OFFSET, HMU_SIZE_SIZE) << 3)
@@ -204,6 +217,16 @@ set_hmu_normal_node_next(hmu_normal_node_t *node, hmu_normal_node_t *next)
     }
 }
 
+static inline void
+hmu_set_free_size(hmu_t *hmu)
+{
+    gc_size_t size;
+    bh_assert(hmu && hmu_get_ut(hmu) == HMU_FC);
+
+    size = hmu_get_size(hmu);
+    *((uint32 *)((char *)hmu + size) - 1) = size;
+}
+
 /**
  * Define hmu_tree_node as a packed struct, since it is at the 4-byte
  * aligned address and the size of hmu_head is 4, so in 64-bit target,
@@ -249,6 +272,12 @@ bh_static_assert(offsetof(hmu_tree_node_t, left) == 4);
                   == 0);                                                    \
     } while (0)
 
+#if GC_PARALLEL != 0
+/* number of the regions which the heap is split into for the
+   parallel sweep */
+#define GC_SWEEP_REGION_NUM 64
+#endif
+
 typedef struct gc_heap_struct {
     /* for double checking*/
     gc_handle_t heap_id;
@@ -296,6 +325,42 @@ typedef struct gc_heap_struct {
 
     /* Whether the heap can do reclaim */
     unsigned is_reclaim_enabled : 1;
+
+#if GC_GENERATIONAL != 0
+    /* whether the next reclaim must be a full GC */
+    unsigned is_full_gc_required : 1;
+
+    /* whether minor GC is disabled, e.g. the heap is used by AOT
+       code compiled without the write barrier */
+    unsigned is_minor_gc_disabled : 1;
+
+    /* whether the running reclaim is a minor GC */
+    unsigned is_doing_minor_gc : 1;
+
+    /* whether the heap is in the registry of the generational heaps,
+       so that the write barrier can add the WOs it remembers to
+       remembered_set, otherwise the minor GC scans the whole heap for
+       the remembered WOs */
+    unsigned is_remembered_set_tracked : 1;
+
+    /* whether a node of remembered_set failed to be allocated */
+    unsigned is_remembered_set_overflowed : 1;
+
+    /* whether a node of young_ranges failed to be allocated, the minor
+       GC sweeps the whole heap if so */
+    unsigned is_young_range_overflowed : 1;
+#endif
+
+#if GC_PARALLEL != 0
+    /* whether sweep_region_offsets are still at the starts of blocks */
+    unsigned is_sweep_region_valid : 1;
+#endif
+
+#if GC_INCREMENTAL != 0
+    /* whether the reclaims are done in slices, it is cleared when the
+       heap is used by code which doesn't call the pre write barrier */
+    unsigned is_incremental_gc_enabled : 1;
+#endif
 #endif
 
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
@@ -314,6 +379,52 @@ typedef struct gc_heap_struct {
     gc_size_t total_gc_count;
     gc_size_t total_gc_time;
     gc_size_t max_gc_time;
+#if GC_GENERATIONAL != 0
+    gc_size_t total_minor_gc_count;
+    gc_size_t total_full_gc_count;
+    /* size of the live blocks after the last full GC */
+    gc_size_t live_size_after_full_gc;
+    /* the old WOs remembered by the write barrier since the last GC,
+       a list of mark nodes */
+    void *remembered_set;
+    /* the address ranges of the blocks allocated for WOs since the last
+       GC, which are the young generation swept by the minor GC */
+    void *young_ranges;
+    /* slot of the heap in the registry of the generational heaps */
+    gc_uint32 generational_slot;
+#endif
+    gc_pause_stat_t pause_stat;
+#if GC_PARALLEL != 0
+    /* Offsets of the blocks which the heap is split into regions at for
+       the parallel sweep, each is the first block at or after
+       i * current_size / GC_SWEEP_REGION_NUM, they are recorded by the
+       previous sweep */
+    gc_size_t sweep_region_offsets[GC_SWEEP_REGION_NUM];
+#endif
+    /* The unused part of the chunk which WOs are bump allocated from,
+       it is kept as a HMU_FM block so the heap can be walked at any time.
+       It is always empty if GC_NURSERY_SIZE is 0, and may be used by the
+       compiled code, see gc_get_tlab() */
+    gc_tlab_t nursery;
+#if GC_INCREMENTAL != 0
+    /* phase of the incremental reclaim, see gc_phase_t */
+    gc_uint32 gc_phase;
+    /* size allocated since the last slice of the incremental reclaim */
+    gc_size_t size_allocated_since_slice;
+    /* the blocks before it have been swept by the lazy sweep, the free
+       blocks after it aren't linked into the free lists yet */
+    hmu_t *sweep_cursor;
+    /* slot of the heap in the registry of the heaps being marked */
+    gc_uint32 marking_slot;
+#endif
+#if GC_GROWABLE_HEAP != 0
+    /* size of the address range reserved from the heap structure, the
+       part after base_addr + current_size isn't committed. It is 0 if
+       the heap is created from a buffer and can't grow. */
+    gc_size_t reserved_size;
+    /* the size which the heap can grow to */
+    gc_size_t max_size;
+#endif
     /* Usually there won't be too many extra info node, so we try to use a fixed
      * array to store them, if the fixed array don't have enough space to store
      * the nodes, a new space will be allocated from heap */
@@ -335,6 +446,34 @@ typedef struct gc_heap_struct {
 
 #define GC_DEFAULT_THRESHOLD_FACTOR 300
 
+#if GC_GROWABLE_HEAP != 0
+/* Percentage of a growable heap which is expected to be live after
+   a GC by default */
+#ifndef GC_DEFAULT_LIVE_RATIO
+#define GC_DEFAULT_LIVE_RATIO 50
+#endif
+#endif
+
+#if GC_INCREMENTAL != 0
+/* Phases of the incremental reclaim of a heap */
+typedef enum gc_phase {
+    /* no reclaim is running */
+    GC_PHASE_IDLE = 0,
+    /* the to-expand list is expanded slice by slice, the new WOs are
+       allocated marked */
+    GC_PHASE_MARK,
+    /* the heap is swept lazily slice by slice from sweep_cursor, the
+       live WOs are unmarked */
+    GC_PHASE_SWEEP
+} gc_phase_t;
+
+/* A slice of the incremental reclaim is done after this size is
+   allocated from the heap */
+#ifndef GC_SLICE_ALLOC_SIZE
+#define GC_SLICE_ALLOC_SIZE (16 * 1024)
+#endif
+#endif
+
 static inline void
 gc_update_threshold(gc_heap_t *heap)
 {
@@ -342,6 +481,149 @@ gc_update_threshold(gc_heap_t *heap)
         heap->total_free_size * heap->gc_threshold_factor / 1000;
 }
 
+/* Reset the nursery, its remaining space is merged into free chunks
+   by the sweep, so it isn't counted as allocated */
+static inline void
+gc_reset_nursery(gc_heap_t *heap)
+{
+    heap->pause_stat.size_allocated -=
+        (gc_uint64)(heap->nursery.end - heap->nursery.cur);
+    heap->nursery.cur = heap->nursery.end = NULL;
+}
+
+/* Blocks may be merged, so the recorded sweep regions may no longer
+   start at blocks, the next sweep records them again */
+static inline void
+gc_invalidate_sweep_regions(gc_heap_t *heap)
+{
+#if GC_PARALLEL != 0
+    heap->is_sweep_region_valid = 0;
+#else
+    (void)heap;
+#endif
+}
+
+#if GC_INCREMENTAL != 0
+/**
+ * Whether the heap is reclaimed incrementally
+ */
+bool
+gci_is_incremental_gc_enabled(gc_heap_t *heap);
+
+/**
+ * Start an incremental reclaim of the heap: enumerate the rootset in
+ * a pause, the heap is then marked and swept by gci_gc_slice()
+ *
+ * @param heap the heap to reclaim, its lock shouldn't be held
+ *
+ * @return GC_SUCCESS if the reclaim is started or is already running,
+ *         GC_ERROR if the heap should be reclaimed stop-the-world
+ */
+int
+gci_start_incremental_gc(gc_heap_t *heap);
+
+/**
+ * Do a slice of the incremental reclaim of the heap, the heap lock
+ * should be held
+ *
+ * @param heap the heap being reclaimed
+ * @param is_mark_unbounded whether to finish the marking without time
+ *        budget, e.g. when an allocation fails
+ */
+void
+gci_gc_slice(gc_heap_t *heap, bool is_mark_unbounded);
+#endif
+
+#if GC_GENERATIONAL != 0
+/**
+ * Add the heap to the registry of the generational heaps, so that the
+ * write barrier can find the heap of an old WO and add the WO to its
+ * remembered set. The heap is scanned by the minor GC for the remembered
+ * WOs instead if the registry is full.
+ */
+void
+gci_init_generations(gc_heap_t *heap);
+
+/**
+ * Forget the generations of the heap after its blocks are moved, the
+ * next reclaim is a full GC
+ */
+void
+gci_reset_generations(gc_heap_t *heap);
+
+/**
+ * Remove the heap from the registry of the generational heaps, and free
+ * its remembered set and young ranges
+ */
+void
+gci_destroy_generations(gc_heap_t *heap);
+
+/**
+ * Record a block allocated for WOs as young, so that it is swept by the
+ * next minor GC, the heap lock should be held
+ *
+ * @param heap the heap which the block is allocated from
+ * @param hmu the block, e.g. a chunk of the nursery
+ * @param size the size of the block
+ */
+void
+gci_add_young_range(gc_heap_t *heap, hmu_t *hmu, gc_size_t size);
+#endif
+
+#if GC_GROWABLE_HEAP != 0
+/**
+ * Get the size which the growth policy expects the heap to have
+ *
+ * @param heap the growable heap
+ * @param live_size the size of the live blocks in the heap
+ *
+ * @return the expected size, which is between the initial size and the
+ *         maximum size of the heap
+ */
+gc_size_t
+gci_get_target_heap_size(gc_heap_t *heap, gc_size_t live_size);
+
+/**
+ * Whether the last GC pause of the heap is longer than the growth
+ * policy allows, the heap isn't grown by the policy if so
+ */
+bool
+gci_is_pause_too_long(gc_heap_t *heap);
+
+/**
+ * Commit more pages to the heap and add them to the free lists as a free
+ * chunk. The heap lock should be held and no reclaim should be running.
+ *
+ * @param heap the growable heap
+ * @param new_size the new size of the heap, it is rounded up to the page
+ *        size and limited to the maximum size
+ *
+ * @return true if the heap is grown, false otherwise
+ */
+bool
+gci_grow_heap(gc_heap_t *heap, gc_size_t new_size);
+
+/**
+ * Shrink the heap and decommit the pages after its new end, the blocks
+ * after new_size must be free and not linked into the free lists, e.g.
+ * the free run at the end of the heap found by a sweep
+ *
+ * @param heap the growable heap
+ * @param new_size the new size of the heap, it is rounded up to the page
+ *        size
+ */
+void
+gci_shrink_heap(gc_heap_t *heap, gc_size_t new_size);
+
+/**
+ * Give the physical pages inside the large free chunks of the heap back
+ * to the system, the chunks stay in the free lists and their pages are
+ * committed again by the page faults after they are allocated
+ */
+void
+gci_decommit_free_chunks(gc_heap_t *heap);
+#endif
+
 #define gct_vm_mutex_init os_mutex_init
 #define gct_vm_mutex_destroy os_mutex_destroy
 #define gct_vm_mutex_lock os_mutex_lock
@@ -355,6 +637,20 @@ gc_update_threshold(gc_heap_t *heap)
 
 #endif /* end of WAMS_ENABLE_GC != 0 */
 
+/* Whether the block has been swept, i.e. it can be merged with the
+   free blocks around it */
+static inline bool
+gc_is_hmu_swept(gc_heap_t *heap, hmu_t *hmu)
+{
+#if GC_INCREMENTAL != 0
+    return heap->gc_phase != GC_PHASE_SWEEP || hmu < heap->sweep_cursor;
+#else
+    (void)heap;
+    (void)hmu;
+    return true;
+#endif
+}
+
 /**
  * MISC internal used APIs
  */
@@ -362,6 +658,12 @@ gc_update_threshold(gc_heap_t *heap)
 bool
 gci_add_fc(gc_heap_t *heap, hmu_t *hmu, gc_size_t size);
 
+/**
+ * Remove a free chunk from KFC, e.g. to merge it with its neighbour
+ */
+bool
+gci_unlink_hmu(gc_heap_t *heap, hmu_t *hmu);
+
 int
 gci_is_heap_valid(gc_heap_t *heap);
 
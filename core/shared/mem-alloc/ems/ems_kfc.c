@@ -25,11 +25,15 @@ gc_init_internal(gc_heap_t *heap, char *base_addr, gc_size_t heap_max_size)
     heap->base_addr = (gc_uint8 *)base_addr;
     heap->heap_id = (gc_handle_t)heap;
 
+    heap->init_size = heap->current_size;
     heap->total_free_size = heap->current_size;
     heap->highmark_size = 0;
 #if WASM_ENABLE_GC != 0
     heap->gc_threshold_factor = GC_DEFAULT_THRESHOLD_FACTOR;
     gc_update_threshold(heap);
+#if GC_INCREMENTAL != 0
+    heap->is_incremental_gc_enabled = 1;
+#endif
 #endif
 
     root = heap->kfc_tree_root = (hmu_tree_node_t *)heap->kfc_tree_root_buf;
@@ -133,10 +137,21 @@ gc_destroy_with_pool(gc_handle_t handle)
 {
     gc_heap_t *heap = (gc_heap_t *)handle;
     int ret = GC_SUCCESS;
+#if GC_GROWABLE_HEAP != 0
+    gc_size_t reserved_size = heap->reserved_size;
+#endif
 
 #if WASM_ENABLE_GC != 0
     gc_size_t i = 0;
 
+#if GC_INCREMENTAL != 0
+    /* stop the running incremental reclaim */
+    gc_disable_incremental_gc(handle);
+#endif
+#if GC_GENERATIONAL != 0
+    gci_destroy_generations(heap);
+#endif
+
     if (heap->extra_info_node_cnt > 0) {
         for (i = 0; i < heap->extra_info_node_cnt; i++) {
             extra_info_node_t *node = heap->extra_info_nodes[i];
@@ -172,11 +187,259 @@ gc_destroy_with_pool(gc_handle_t handle)
 #endif
 
     os_mutex_destroy(&heap->lock);
+#if GC_GROWABLE_HEAP != 0
+    if (reserved_size > 0) {
+        /* the heap structure is in the reserved range */
+        os_munmap(heap, reserved_size);
+        return ret;
+    }
+#endif
     memset(heap->base_addr, 0, heap->current_size);
     memset(heap, 0, sizeof(gc_heap_t));
     return ret;
 }
 
+#if GC_GROWABLE_HEAP != 0
+static gc_uint32 gc_heap_live_ratio = GC_DEFAULT_LIVE_RATIO;
+static gc_uint32 gc_heap_max_pause;
+
+static bool
+commit_pages(void *addr, size_t size)
+{
+#ifdef BH_PLATFORM_WINDOWS
+    if (!os_mem_commit(addr, size, MMAP_PROT_READ | MMAP_PROT_WRITE))
+        return false;
+#endif
+    return os_mprotect(addr, size, MMAP_PROT_READ | MMAP_PROT_WRITE) == 0;
+}
+
+static void
+decommit_pages(void *addr, size_t size)
+{
+#ifdef BH_PLATFORM_WINDOWS
+    os_mem_decommit(addr, size);
+#else
+#ifdef MADV_DONTNEED
+    /* give the physical pages back, they are zero-filled when committed
+       again */
+    madvise(addr, size, MADV_DONTNEED);
+#endif
+    os_mprotect(addr, size, MMAP_PROT_NONE);
+#endif
+}
+
+/* Get the end of the pages committed for a heap of the size */
+static gc_uint8 *
+get_commit_end(gc_heap_t *heap, uint64 size)
+{
+    uintptr_t page_size = (uintptr_t)os_getpagesize();
+    uintptr_t end = (uintptr_t)heap->base_addr + (uintptr_t)size;
+
+    return (gc_uint8 *)((end + page_size - 1) & ~(page_size - 1));
+}
+
+/* Round the size up so that the heap uses all of its committed pages,
+   base_addr isn't 8-byte aligned, see GC_HEAD_PADDING */
+static uint64
+align_heap_size(gc_heap_t *heap, uint64 size)
+{
+    return (uint64)(get_commit_end(heap, size) - heap->base_addr) & ~(uint64)7;
+}
+
+gc_handle_t
+gc_init_growable(gc_size_t init_size, gc_size_t max_size)
+{
+    uint64 page_size = (uint64)os_getpagesize();
+    uint64 reserved_size, commit_size;
+    gc_heap_t *heap;
+    char *buf;
+
+    commit_size = ((uint64)init_size + page_size - 1) & ~(page_size - 1);
+    reserved_size = ((uint64)max_size + page_size - 1) & ~(page_size - 1);
+    if (reserved_size < commit_size)
+        reserved_size = commit_size;
+    if (reserved_size > UINT32_MAX - page_size) {
+        LOG_ERROR("[GC_ERROR]heap reserved size (%" PRIu64 ") too large\n",
+                  reserved_size);
+        return NULL;
+    }
+
+    if (!(buf = os_mmap(NULL, (size_t)reserved_size, MMAP_PROT_NONE,
+                        MMAP_MAP_NONE, os_get_invalid_handle()))) {
+        LOG_ERROR("[GC_ERROR]failed to reserve heap address range\n");
+        return NULL;
+    }
+
+    if (!commit_pages(buf, (size_t)commit_size)
+        || !(heap = gc_init_with_pool(buf, (gc_size_t)commit_size))) {
+        os_munmap(buf, (size_t)reserved_size);
+        return NULL;
+    }
+
+    heap->reserved_size = (gc_size_t)reserved_size;
+    heap->max_size =
+        (gc_size_t)((gc_uint8 *)buf + reserved_size - heap->base_addr)
+        & (gc_size_t)~7;
+    return heap;
+}
+
+int
+gc_set_heap_growth_policy(gc_uint32 live_ratio, gc_uint32 max_pause_us)
+{
+    if (live_ratio > 100)
+        return GC_ERROR;
+
+    gc_heap_live_ratio = live_ratio ? live_ratio : GC_DEFAULT_LIVE_RATIO;
+    gc_heap_max_pause = max_pause_us;
+    return GC_SUCCESS;
+}
+
+gc_size_t
+gci_get_target_heap_size(gc_heap_t *heap, gc_size_t live_size)
+{
+    uint64 size = (uint64)live_size * 100 / gc_heap_live_ratio;
+
+    if (size < heap->init_size)
+        size = heap->init_size;
+    size = align_heap_size(heap, size);
+    if (size > heap->max_size)
+        size = heap->max_size;
+    return (gc_size_t)size;
+}
+
+bool
+gci_is_pause_too_long(gc_heap_t *heap)
+{
+    return gc_heap_max_pause > 0
+           && heap->pause_stat.last_time > gc_heap_max_pause;
+}
+
+bool
+gci_grow_heap(gc_heap_t *heap, gc_size_t new_size)
+{
+    gc_uint8 *old_end = heap->base_addr + heap->current_size;
+    gc_uint8 *commit_start, *commit_end;
+    uint64 size = align_heap_size(heap, new_size);
+    hmu_t *hmu = (hmu_t *)old_end;
+    gc_size_t grow_size;
+
+    if (heap->reserved_size == 0
+#if GC_INCREMENTAL != 0
+        || heap->gc_phase != GC_PHASE_IDLE
+#endif
+    )
+        return false;
+
+    if (size > heap->max_size)
+        size = heap->max_size;
+    if (size <= heap->current_size)
+        return false;
+
+    grow_size = (gc_size_t)size - heap->current_size;
+    commit_start = get_commit_end(heap, heap->current_size);
+    commit_end = get_commit_end(heap, size);
+    if (commit_end > commit_start
+        && !commit_pages(commit_start, (size_t)(commit_end - commit_start))) {
+        LOG_ERROR("[GC_ERROR]failed to commit heap pages\n");
+        return false;
+    }
+
+    heap->current_size = (gc_size_t)size;
+    /* The previous block isn't merged with the new chunk even if it is
+       free, the next sweep merges them */
+    hmu->header = 0;
+    if (!gci_add_fc(heap, hmu, grow_size)) {
+        heap->current_size -= grow_size;
+        if (commit_end > commit_start)
+            decommit_pages(commit_start, (size_t)(commit_end - commit_start));
+        return false;
+    }
+    hmu_mark_pinuse(hmu);
+
+    heap->total_free_size += grow_size;
+    gc_update_threshold(heap);
+    return true;
+}
+
+/* Free chunks with less pages than this aren't decommitted, the page
+   faults to commit them again would cost more than what is saved */
+#ifndef GC_DECOMMIT_SIZE_MIN
+#define GC_DECOMMIT_SIZE_MIN (64 * 1024)
+#endif
+
+void
+gci_decommit_free_chunks(gc_heap_t *heap)
+{
+#if !defined(BH_PLATFORM_WINDOWS) && defined(MADV_DONTNEED)
+    uintptr_t page_size = (uintptr_t)os_getpagesize();
+    hmu_tree_node_t *root = heap->kfc_tree_root, *node = root->right;
+    hmu_tree_node_t *parent;
+    uintptr_t start, end;
+
+    /* walk the tree in pre-order with the parent links */
+    while (node) {
+        /* keep the tree node at the start and the size at the end */
+        start = (uintptr_t)(node + 1);
+        start = (start + page_size - 1) & ~(page_size - 1);
+        end = (uintptr_t)node + node->size - sizeof(gc_size_t);
+        end &= ~(page_size - 1);
+        if (end > start && end - start >= GC_DECOMMIT_SIZE_MIN)
+            madvise((void *)start, end - start, MADV_DONTNEED);
+
+        if (node->left) {
+            node = node->left;
+        }
+        else if (node->right) {
+            node = node->right;
+        }
+        else {
+            /* go up to the first node whose right subtree isn't walked */
+            while ((parent = node->parent) != root
+                   && (parent->left != node || !parent->right))
+                node = parent;
+            node = parent != root ? parent->right : NULL;
+        }
+    }
+#else
+    /* the pages can't be decommitted while they are still accessible */
+    (void)heap;
+#endif
+}
+
+void
+gci_shrink_heap(gc_heap_t *heap, gc_size_t new_size)
+{
+    uint64 size = align_heap_size(heap, new_size);
+    gc_uint8 *decommit_start, *decommit_end;
+
+    if (heap->reserved_size == 0 || size >= heap->current_size)
+        return;
+
+    decommit_start = get_commit_end(heap, size);
+    decommit_end = get_commit_end(heap, heap->current_size);
+    if (decommit_end > decommit_start)
+        decommit_pages(decommit_start,
+                       (size_t)(decommit_end - decommit_start));
+    heap->current_size = (gc_size_t)size;
+}
+#elif WASM_ENABLE_GC != 0
+gc_handle_t
+gc_init_growable(gc_size_t init_size, gc_size_t max_size)
+{
+    (void)init_size;
+    (void)max_size;
+    return NULL;
+}
+
+int
+gc_set_heap_growth_policy(gc_uint32 live_ratio, gc_uint32 max_pause_us)
+{
+    (void)live_ratio;
+    (void)max_pause_us;
+    return GC_ERROR;
+}
+#endif
+
 #if WASM_ENABLE_GC != 0
 #if WASM_ENABLE_THREAD_MGR == 0
 void
@@ -186,6 +449,9 @@ gc_enable_gc_reclaim(gc_handle_t handle, void *exec_env)
 
     heap->is_reclaim_enabled = 1;
     heap->exec_env = exec_env;
+#if GC_GENERATIONAL != 0
+    gci_init_generations(heap);
+#endif
 }
 #else
 void
@@ -195,6 +461,9 @@ gc_enable_gc_reclaim(gc_handle_t handle, void *cluster)
 
     heap->is_reclaim_enabled = 1;
     heap->cluster = cluster;
+#if GC_GENERATIONAL != 0
+    gci_init_generations(heap);
+#endif
 }
 #endif
 #endif
@@ -280,6 +549,14 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
     adjust_ptr(p_right, offset);
     adjust_ptr(p_parent, offset);
 
+#if GC_NURSERY_SIZE != 0
+    adjust_ptr(&heap->nursery.cur, offset);
+    adjust_ptr(&heap->nursery.end, offset);
+#endif
+#if GC_GENERATIONAL != 0
+    gci_reset_generations(heap);
+#endif
+
     cur = (hmu_t *)heap->base_addr;
     end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
 
@@ -535,9 +812,15 @@ gc_dump_perf_profiling(gc_handle_t *handle)
     gc_heap_t *gc_heap_handle = (void *)handle;
     if (gc_heap_handle) {
         os_printf("\nGC performance summary\n");
-        os_printf("    Total GC time (ms): %u\n",
+        os_printf("    Total GC time (us): %u\n",
                   gc_heap_handle->total_gc_time);
-        os_printf("    Max GC time (ms): %u\n", gc_heap_handle->max_gc_time);
+        os_printf("    Max GC time (us): %u\n", gc_heap_handle->max_gc_time);
+#if GC_GENERATIONAL != 0
+        os_printf("    Minor GC count: %u\n",
+                  gc_heap_handle->total_minor_gc_count);
+        os_printf("    Full GC count: %u\n",
+                  gc_heap_handle->total_full_gc_count);
+#endif
     }
     else {
         os_printf("Failed to dump GC performance\n");
@@ -128,6 +128,87 @@ mem_allocator_unset_gc_finalizer(mem_allocator_t allocator, void *obj)
     gc_unset_finalizer((gc_handle_t)allocator, (gc_object_t)obj);
 }
 
+void
+mem_allocator_write_barrier(void *obj)
+{
+    gc_write_barrier((gc_object_t)obj);
+}
+
+void
+mem_allocator_pre_write_barrier(void *slots, uint32 num)
+{
+    gc_pre_write_barrier((gc_object_t *)slots, num);
+}
+
+void
+mem_allocator_disable_minor_gc(mem_allocator_t allocator)
+{
+    gc_disable_minor_gc((gc_handle_t)allocator);
+}
+
+void
+mem_allocator_disable_incremental_gc(mem_allocator_t allocator)
+{
+    gc_disable_incremental_gc((gc_handle_t)allocator);
+}
+
+void *
+mem_allocator_get_tlab(mem_allocator_t allocator)
+{
+    return gc_get_tlab((gc_handle_t)allocator);
+}
+
+void
+mem_allocator_get_pause_stat(mem_allocator_t allocator, void *pause_stat)
+{
+    gc_get_pause_stat((gc_handle_t)allocator, (gc_pause_stat_t *)pause_stat);
+}
+
+bool
+mem_allocator_traverse_objects(mem_allocator_t allocator,
+                               gc_object_visitor_t visitor, void *user_data)
+{
+    return gc_traverse_objects((gc_handle_t)allocator, visitor, user_data)
+           == GC_SUCCESS;
+}
+
+#if WASM_ENABLE_GC_PARALLEL != 0
+bool
+mem_allocator_init_gc_helper_threads(uint32 num)
+{
+    return gc_init_helper_threads(num) == GC_SUCCESS;
+}
+
+void
+mem_allocator_destroy_gc_helper_threads(void)
+{
+    gc_destroy_helper_threads();
+}
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+void
+mem_allocator_set_gc_slice_budget(uint32 budget_us)
+{
+    gc_set_slice_budget(budget_us);
+}
+#endif
+
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+mem_allocator_t
+mem_allocator_create_growable(uint32_t init_size, uint32_t max_size)
+{
+    return gc_init_growable(init_size, max_size);
+}
+
+bool
+mem_allocator_set_gc_heap_growth_policy(uint32 live_ratio,
+                                        uint32 max_pause_us)
+{
+    return gc_set_heap_growth_policy(live_ratio, max_pause_us) == GC_SUCCESS;
+}
+#endif
+
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
 void
 mem_allocator_dump_perf_profiling(mem_allocator_t allocator)
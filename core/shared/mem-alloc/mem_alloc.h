@@ -22,6 +22,11 @@ typedef void *mem_allocator_t;
 typedef void (*gc_finalizer_t)(void *obj, void *data);
 #endif
 
+#ifndef GC_OBJECT_VISITOR_T_DEFINED
+#define GC_OBJECT_VISITOR_T_DEFINED
+typedef void (*gc_object_visitor_t)(void *obj, uint32 size, void *user_data);
+#endif
+
 mem_allocator_t
 mem_allocator_create(void *mem, uint32_t size);
 
@@ -80,6 +85,50 @@ mem_allocator_set_gc_finalizer(mem_allocator_t allocator, void *obj,
 void
 mem_allocator_unset_gc_finalizer(mem_allocator_t allocator, void *obj);
 
+void
+mem_allocator_write_barrier(void *obj);
+
+void
+mem_allocator_pre_write_barrier(void *slots, uint32 num);
+
+void
+mem_allocator_disable_minor_gc(mem_allocator_t allocator);
+
+void
+mem_allocator_disable_incremental_gc(mem_allocator_t allocator);
+
+void *
+mem_allocator_get_tlab(mem_allocator_t allocator);
+
+void
+mem_allocator_get_pause_stat(mem_allocator_t allocator, void *pause_stat);
+
+bool
+mem_allocator_traverse_objects(mem_allocator_t allocator,
+                               gc_object_visitor_t visitor, void *user_data);
+
+#if WASM_ENABLE_GC_PARALLEL != 0
+bool
+mem_allocator_init_gc_helper_threads(uint32 num);
+
+void
+mem_allocator_destroy_gc_helper_threads(void);
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+void
+mem_allocator_set_gc_slice_budget(uint32 budget_us);
+#endif
+
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+mem_allocator_t
+mem_allocator_create_growable(uint32_t init_size, uint32_t max_size);
+
+bool
+mem_allocator_set_gc_heap_growth_policy(uint32 live_ratio,
+                                        uint32 max_pause_us);
+#endif
+
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
 void
 mem_allocator_dump_perf_profiling(mem_allocator_t allocator);
@@ -61,10 +61,28 @@ print_help(void)
     printf("  --jit-codecache-size=n   Set fast jit maximum code cache size in bytes,\n");
     printf("                           default is %u KB\n", FAST_JIT_DEFAULT_CODE_CACHE_SIZE / 1024);
 #endif
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+    printf("  --loader-threads=n       Set the number of loader helper threads, default is 0\n");
+#endif
 #if WASM_ENABLE_GC != 0
     printf("  --gc-heap-size=n         Set maximum gc heap size in bytes,\n");
     printf("                           default is %u KB\n", GC_HEAP_SIZE_DEFAULT / 1024);
 #endif
+#if WASM_ENABLE_GC_PARALLEL != 0
+    printf("  --gc-threads=n           Set the number of GC helper threads, default is 0\n");
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    printf("  --gc-slice-budget=us     Set the time budget of an incremental GC slice in\n");
+    printf("                           microseconds, default is 0 (stop-the-world GC)\n");
+#endif
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+    printf("  --gc-heap-max-size=n     Let the gc heap grow on demand from --gc-heap-size\n");
+    printf("                           to n bytes, default is 0 (fixed size gc heap)\n");
+    printf("  --gc-heap-live-ratio=n   Grow or shrink the gc heap after a GC so that n%% of\n");
+    printf("                           it is live, default is 50\n");
+    printf("  --gc-heap-max-pause=us   Don't grow the gc heap by the live ratio while the\n");
+    printf("                           last GC pause is longer than it, default is 0 (no limit)\n");
+#endif
 #if WASM_ENABLE_JIT != 0
     printf("  --llvm-jit-size-level=n  Set LLVM JIT size level, default is 3\n");
     printf("  --llvm-jit-opt-level=n   Set LLVM JIT optimization level, default is 3\n");
@@ -78,7 +96,21 @@ print_help(void)
 #endif
 #endif /* WASM_ENABLE_JIT != 0*/
 #if WASM_ENABLE_LINUX_PERF != 0
-    printf("  --enable-linux-perf      Enable linux perf support. It works in aot and llvm-jit.\n");
+    printf("  --enable-linux-perf      Enable linux perf support. It works in aot, llvm-jit\n");
+    printf("                           and fast-jit.\n");
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    printf("  --profile=<path>         Sample the wasm call stacks while running and write\n");
+    printf("                           them to the file as folded stacks\n");
+    printf("  --profile-interval=us    Set the sampling interval in microseconds,\n");
+    printf("                           default is 10000\n");
+#endif
+#if WASM_ENABLE_FUEL != 0
+    printf("  --fuel=n                 Stop running the wasm code after about n opcodes\n");
+#endif
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    printf("  --module-image=<file>    Map the prepared function bodies from the module image\n");
+    printf("                           file, which is written if it doesn't match the module\n");
 #endif
     printf("  --repl                   Start a very simple REPL (read-eval-print-loop) mode\n"
            "                           that runs commands in the form of \"FUNC ARG...\"\n");
@@ -584,6 +616,20 @@ main(int argc, char *argv[])
 #if WASM_ENABLE_GC != 0
     uint32 gc_heap_size = GC_HEAP_SIZE_DEFAULT;
 #endif
+#if WASM_ENABLE_GC_PARALLEL != 0
+    uint32 gc_helper_thread_num = 0;
+#endif
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+    uint32 loader_helper_thread_num = 0;
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    uint32 gc_slice_budget_us = 0;
+#endif
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+    uint32 gc_heap_max_size = 0;
+    uint32 gc_heap_live_ratio = 0;
+    uint32 gc_heap_max_pause_us = 0;
+#endif
 #if WASM_ENABLE_JIT != 0
     uint32 llvm_jit_size_level = 3;
     uint32 llvm_jit_opt_level = 3;
@@ -591,6 +637,16 @@ main(int argc, char *argv[])
 #endif
 #if WASM_ENABLE_LINUX_PERF != 0
     bool enable_linux_perf = false;
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    const char *profile_file = NULL;
+    uint32 profile_interval_us = 0;
+#endif
+#if WASM_ENABLE_FUEL != 0
+    const char *fuel = NULL;
+#endif
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    const char *module_image_file = NULL;
 #endif
     wasm_module_t wasm_module = NULL;
     wasm_module_inst_t wasm_module_inst = NULL;
@@ -698,6 +754,44 @@ main(int argc, char *argv[])
             gc_heap_size = atoi(argv[0] + 15);
         }
 #endif
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+        else if (!strncmp(argv[0], "--loader-threads=", 17)) {
+            if (argv[0][17] == '\0')
+                return print_help();
+            loader_helper_thread_num = atoi(argv[0] + 17);
+        }
+#endif
+#if WASM_ENABLE_GC_PARALLEL != 0
+        else if (!strncmp(argv[0], "--gc-threads=", 13)) {
+            if (argv[0][13] == '\0')
+                return print_help();
+            gc_helper_thread_num = atoi(argv[0] + 13);
+        }
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        else if (!strncmp(argv[0], "--gc-slice-budget=", 18)) {
+            if (argv[0][18] == '\0')
+                return print_help();
+            gc_slice_budget_us = atoi(argv[0] + 18);
+        }
+#endif
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+        else if (!strncmp(argv[0], "--gc-heap-max-size=", 19)) {
+            if (argv[0][19] == '\0')
+                return print_help();
+            gc_heap_max_size = atoi(argv[0] + 19);
+        }
+        else if (!strncmp(argv[0], "--gc-heap-live-ratio=", 21)) {
+            if (argv[0][21] == '\0')
+                return print_help();
+            gc_heap_live_ratio = atoi(argv[0] + 21);
+        }
+        else if (!strncmp(argv[0], "--gc-heap-max-pause=", 20)) {
+            if (argv[0][20] == '\0')
+                return print_help();
+            gc_heap_max_pause_us = atoi(argv[0] + 20);
+        }
+#endif
 #if WASM_ENABLE_JIT != 0
         else if (!strncmp(argv[0], "--llvm-jit-size-level=", 22)) {
             if (argv[0][22] == '\0')
@@ -756,6 +850,32 @@ main(int argc, char *argv[])
             enable_linux_perf = true;
         }
 #endif
+#if WASM_ENABLE_MODULE_IMAGE != 0
+        else if (!strncmp(argv[0], "--module-image=", 15)) {
+            if (argv[0][15] == '\0')
+                return print_help();
+            module_image_file = argv[0] + 15;
+        }
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+        else if (!strncmp(argv[0], "--profile=", 10)) {
+            if (argv[0][10] == '\0')
+                return print_help();
+            profile_file = argv[0] + 10;
+        }
+        else if (!strncmp(argv[0], "--profile-interval=", 19)) {
+            if (argv[0][19] == '\0')
+                return print_help();
+            profile_interval_us = atoi(argv[0] + 19);
+        }
+#endif
+#if WASM_ENABLE_FUEL != 0
+        else if (!strncmp(argv[0], "--fuel=", 7)) {
+            if (argv[0][7] == '\0')
+                return print_help();
+            fuel = argv[0] + 7;
+        }
+#endif
 #if WASM_ENABLE_MULTI_MODULE != 0
         else if (!strncmp(argv[0],
                           "--module-path=", strlen("--module-path="))) {
@@ -859,6 +979,24 @@ main(int argc, char *argv[])
     init_args.gc_heap_size = gc_heap_size;
 #endif
 
+#if WASM_ENABLE_GC_PARALLEL != 0
+    init_args.gc_helper_thread_num = gc_helper_thread_num;
+#endif
+
+#if WASM_ENABLE_PARALLEL_LOADER != 0
+    init_args.loader_helper_thread_num = loader_helper_thread_num;
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    init_args.gc_slice_budget_us = gc_slice_budget_us;
+#endif
+
+#if WASM_ENABLE_GC_GROWABLE_HEAP != 0
+    init_args.gc_heap_max_size = gc_heap_max_size;
+    init_args.gc_heap_live_ratio = gc_heap_live_ratio;
+    init_args.gc_heap_max_pause_us = gc_heap_max_pause_us;
+#endif
+
 #if WASM_ENABLE_JIT != 0
     init_args.llvm_jit_size_level = llvm_jit_size_level;
     init_args.llvm_jit_opt_level = llvm_jit_opt_level;
@@ -930,8 +1068,21 @@ main(int argc, char *argv[])
 #endif
 
     /* load WASM module */
-    if (!(wasm_module = wasm_runtime_load(wasm_file_buf, wasm_file_size,
-                                          error_buf, sizeof(error_buf)))) {
+#if WASM_ENABLE_MODULE_IMAGE != 0
+    if (module_image_file) {
+        LoadArgs load_args = { 0 };
+
+        load_args.name = "";
+        load_args.module_image_path = module_image_file;
+        wasm_module = wasm_runtime_load_ex(wasm_file_buf, wasm_file_size,
+                                           &load_args, error_buf,
+                                           sizeof(error_buf));
+    }
+    else
+#endif
+        wasm_module = wasm_runtime_load(wasm_file_buf, wasm_file_size,
+                                        error_buf, sizeof(error_buf));
+    if (!wasm_module) {
         printf("%s\n", error_buf);
         goto fail2;
     }
@@ -996,6 +1147,23 @@ main(int argc, char *argv[])
     }
 #endif
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    if (profile_file
+        && !wasm_runtime_start_sampling_profiler(profile_interval_us)) {
+        printf("Failed to start the sampling profiler\n");
+        profile_file = NULL;
+    }
+#endif
+
+#if WASM_ENABLE_FUEL != 0
+    if (fuel
+        && !wasm_runtime_set_fuel(
+            wasm_runtime_get_exec_env_singleton(wasm_module_inst),
+            strtoull(fuel, NULL, 10))) {
+        printf("Failed to set the fuel\n");
+    }
+#endif
+
     ret = 0;
     const char *exception = NULL;
     if (is_repl_mode) {
@@ -1026,6 +1194,14 @@ main(int argc, char *argv[])
     if (exception)
         printf("%s\n", exception);
 
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+    if (profile_file) {
+        wasm_runtime_stop_sampling_profiler();
+        if (!wasm_runtime_dump_sampling_profile(profile_file))
+            printf("Failed to write the samples to %s\n", profile_file);
+    }
+#endif
+
 #if WASM_ENABLE_STATIC_PGO != 0 && WASM_ENABLE_AOT != 0
     if (get_package_type(wasm_file_buf, wasm_file_size) == Wasm_Module_AoT
         && gen_prof_file)
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+WAMR_DIR=$PWD/../../..
+IWASM_BUILD_DIR=${WAMR_DIR}/product-mini/platforms/${PLATFORM}/build
+WAMRC_CMD=${WAMR_DIR}/wamr-compiler/build/wamrc
+
+echo "===> compile call_overhead src to call_overhead"
+gcc -O3 -o call_overhead src/call_overhead.c \
+    -I${WAMR_DIR}/core/iwasm/include ${IWASM_BUILD_DIR}/libiwasm.a \
+    -lpthread -lm -ldl
+
+echo "===> compile call_overhead.wat to call_overhead.wasm"
+wasm-tools parse -o call_overhead.wasm call_overhead.wat
+
+echo "===> compile call_overhead.wasm to call_overhead.aot"
+${WAMRC_CMD} -o call_overhead.aot call_overhead.wasm
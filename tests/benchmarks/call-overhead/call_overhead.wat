@@ -0,0 +1,46 @@
+;; Copyright (C) 2019 Intel Corporation.  All rights reserved.
+;; SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+;; Tiny functions called from the host, so that the cost of a call is
+;; mostly the cost of entering and leaving the runtime
+(module
+  (func (export "add") (param i32 i32) (result i32)
+    local.get 0
+    local.get 1
+    i32.add)
+
+  (func (export "mix") (param i64 f64 i32 f32) (result f64)
+    local.get 1
+    local.get 0
+    f64.convert_i64_s
+    f64.add
+    local.get 2
+    f64.convert_i32_s
+    f64.add
+    local.get 3
+    f64.promote_f32
+    f64.add)
+
+  ;; more than 16 argument cells
+  (func (export "sum10")
+    (param i64 i64 i64 i64 i64 i64 i64 i64 i64 i64) (result i64)
+    local.get 0
+    local.get 1
+    i64.add
+    local.get 2
+    i64.add
+    local.get 3
+    i64.add
+    local.get 4
+    i64.add
+    local.get 5
+    i64.add
+    local.get 6
+    i64.add
+    local.get 7
+    i64.add
+    local.get 8
+    i64.add
+    local.get 9
+    i64.add)
+)
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+ITERATIONS=${1:-10000000}
+
+echo "Run call_overhead with aot mode .."
+./call_overhead call_overhead.aot ${ITERATIONS}
+
+echo "Run call_overhead with interpreter mode .."
+./call_overhead call_overhead.wasm ${ITERATIONS}
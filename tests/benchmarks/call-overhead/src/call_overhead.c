@@ -0,0 +1,378 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "wasm_export.h"
+
+typedef enum {
+    CALL_WASM,
+    CALL_WASM_A,
+    CALL_PREPARED,
+    CALL_BATCH,
+    CALL_KIND_NUM,
+} CallKind;
+
+static const char *call_kind_names[CALL_KIND_NUM] = {
+    "wasm_runtime_call_wasm",
+    "wasm_runtime_call_wasm_a",
+    "wasm_runtime_call_prepared",
+    "wasm_runtime_call_wasm_batch",
+};
+
+/* The number of calls of a wasm_runtime_call_wasm_batch */
+#define BATCH_SIZE 256
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint8_t *
+read_file(const char *path, uint32_t *p_size)
+{
+    FILE *file;
+    uint8_t *buf;
+    long size;
+
+    if (!(file = fopen(path, "rb")))
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0 || !(buf = malloc(size))
+        || fread(buf, 1, size, file) != (size_t)size) {
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *p_size = (uint32_t)size;
+    return buf;
+}
+
+/* add(i, 1) */
+static void
+fill_add(uint32_t i, uint32_t *argv)
+{
+    argv[0] = i;
+    argv[1] = 1;
+}
+
+static void
+sum_add(const uint32_t *argv, uint64_t *p_sum)
+{
+    *p_sum += argv[0];
+}
+
+static bool
+call_add(CallKind kind, wasm_exec_env_t exec_env, wasm_function_inst_t func,
+         wasm_prepared_call_t prepared, uint32_t i, uint64_t *p_sum)
+{
+    uint32_t argv[2];
+    wasm_val_t args[2], results[1];
+    uint64_t slots[2], result;
+
+    switch (kind) {
+        case CALL_WASM:
+            fill_add(i, argv);
+            if (!wasm_runtime_call_wasm(exec_env, func, 2, argv))
+                return false;
+            sum_add(argv, p_sum);
+            return true;
+        case CALL_WASM_A:
+            args[0].kind = WASM_I32;
+            args[0].of.i32 = (int32_t)i;
+            args[1].kind = WASM_I32;
+            args[1].of.i32 = 1;
+            if (!wasm_runtime_call_wasm_a(exec_env, func, 1, results, 2, args))
+                return false;
+            *p_sum += (uint32_t)results[0].of.i32;
+            return true;
+        default:
+            slots[0] = i;
+            slots[1] = 1;
+            if (!wasm_runtime_call_prepared(prepared, slots, &result))
+                return false;
+            *p_sum += (uint32_t)result;
+            return true;
+    }
+}
+
+/* mix(i, 0.5, 1, 0.25f) */
+static void
+fill_mix(uint32_t i, uint32_t *argv)
+{
+    int64_t i64 = i;
+    double f64 = 0.5;
+    int32_t i32 = 1;
+    float f32 = 0.25f;
+
+    memcpy(argv, &i64, sizeof(i64));
+    memcpy(argv + 2, &f64, sizeof(f64));
+    memcpy(argv + 4, &i32, sizeof(i32));
+    memcpy(argv + 5, &f32, sizeof(f32));
+}
+
+static void
+sum_mix(const uint32_t *argv, uint64_t *p_sum)
+{
+    double ret;
+
+    memcpy(&ret, argv, sizeof(ret));
+    *p_sum += (uint64_t)(ret * 4);
+}
+
+static bool
+call_mix(CallKind kind, wasm_exec_env_t exec_env, wasm_function_inst_t func,
+         wasm_prepared_call_t prepared, uint32_t i, uint64_t *p_sum)
+{
+    uint32_t argv[6];
+    wasm_val_t args[4], results[1];
+    uint64_t slots[4], result;
+    int64_t i64 = i;
+    double f64 = 0.5, ret;
+    int32_t i32 = 1;
+    float f32 = 0.25f;
+
+    switch (kind) {
+        case CALL_WASM:
+            fill_mix(i, argv);
+            if (!wasm_runtime_call_wasm(exec_env, func, 6, argv))
+                return false;
+            memcpy(&ret, argv, sizeof(ret));
+            break;
+        case CALL_WASM_A:
+            args[0].kind = WASM_I64;
+            args[0].of.i64 = i64;
+            args[1].kind = WASM_F64;
+            args[1].of.f64 = f64;
+            args[2].kind = WASM_I32;
+            args[2].of.i32 = i32;
+            args[3].kind = WASM_F32;
+            args[3].of.f32 = f32;
+            if (!wasm_runtime_call_wasm_a(exec_env, func, 1, results, 4, args))
+                return false;
+            ret = results[0].of.f64;
+            break;
+        default:
+            slots[0] = (uint64_t)i64;
+            memcpy(&slots[1], &f64, sizeof(f64));
+            slots[2] = (uint32_t)i32;
+            slots[3] = 0;
+            memcpy(&slots[3], &f32, sizeof(f32));
+            if (!wasm_runtime_call_prepared(prepared, slots, &result))
+                return false;
+            memcpy(&ret, &result, sizeof(ret));
+            break;
+    }
+    *p_sum += (uint64_t)(ret * 4);
+    return true;
+}
+
+/* sum10(i, 1, 2, ..., 9) */
+static void
+fill_sum10(uint32_t i, uint32_t *argv)
+{
+    int64_t value;
+    uint32_t j;
+
+    for (j = 0; j < 10; j++) {
+        value = j == 0 ? (int64_t)i : (int64_t)j;
+        memcpy(argv + j * 2, &value, sizeof(value));
+    }
+}
+
+static void
+sum_sum10(const uint32_t *argv, uint64_t *p_sum)
+{
+    int64_t value;
+
+    memcpy(&value, argv, sizeof(value));
+    *p_sum += (uint64_t)value;
+}
+
+static bool
+call_sum10(CallKind kind, wasm_exec_env_t exec_env, wasm_function_inst_t func,
+           wasm_prepared_call_t prepared, uint32_t i, uint64_t *p_sum)
+{
+    uint32_t argv[20];
+    wasm_val_t args[10], results[1];
+    uint64_t slots[10], result;
+    uint32_t j;
+
+    switch (kind) {
+        case CALL_WASM:
+            fill_sum10(i, argv);
+            if (!wasm_runtime_call_wasm(exec_env, func, 20, argv))
+                return false;
+            sum_sum10(argv, p_sum);
+            return true;
+        case CALL_WASM_A:
+            for (j = 0; j < 10; j++) {
+                args[j].kind = WASM_I64;
+                args[j].of.i64 = j == 0 ? (int64_t)i : (int64_t)j;
+            }
+            if (!wasm_runtime_call_wasm_a(exec_env, func, 1, results, 10,
+                                          args))
+                return false;
+            *p_sum += (uint64_t)results[0].of.i64;
+            return true;
+        default:
+            for (j = 0; j < 10; j++)
+                slots[j] = j == 0 ? i : j;
+            if (!wasm_runtime_call_prepared(prepared, slots, &result))
+                return false;
+            *p_sum += result;
+            return true;
+    }
+}
+
+typedef bool (*CallFunc)(CallKind kind, wasm_exec_env_t exec_env,
+                         wasm_function_inst_t func,
+                         wasm_prepared_call_t prepared, uint32_t i,
+                         uint64_t *p_sum);
+
+static const struct {
+    const char *name;
+    CallFunc call;
+    void (*fill)(uint32_t i, uint32_t *argv);
+    void (*sum)(const uint32_t *argv, uint64_t *p_sum);
+    /* the parameter cells and the result cells */
+    uint32_t param_cell_num;
+    uint32_t ret_cell_num;
+} bench_funcs[] = {
+    { "add", call_add, fill_add, sum_add, 2, 1 },
+    { "mix", call_mix, fill_mix, sum_mix, 6, 2 },
+    { "sum10", call_sum10, fill_sum10, sum_sum10, 20, 2 },
+};
+
+/* Call a function over the iterations in batches of BATCH_SIZE calls */
+static bool
+call_batches(uint32_t index, wasm_exec_env_t exec_env,
+             wasm_function_inst_t func, uint32_t iterations, uint64_t *p_sum)
+{
+    uint32_t args[BATCH_SIZE * 20], results[BATCH_SIZE * 2];
+    uint32_t param_cell_num = bench_funcs[index].param_cell_num;
+    uint32_t ret_cell_num = bench_funcs[index].ret_cell_num;
+    uint32_t i, j, num_calls;
+
+    for (i = 0; i < iterations; i += num_calls) {
+        num_calls =
+            iterations - i < BATCH_SIZE ? iterations - i : BATCH_SIZE;
+        for (j = 0; j < num_calls; j++)
+            bench_funcs[index].fill(i + j, args + j * param_cell_num);
+        if (wasm_runtime_call_wasm_batch(exec_env, func, num_calls, args,
+                                         results, NULL)
+            > 0)
+            return false;
+        for (j = 0; j < num_calls; j++)
+            bench_funcs[index].sum(results + j * ret_cell_num, p_sum);
+    }
+    return true;
+}
+
+int
+main(int argc, char *argv[])
+{
+    char error_buf[128];
+    uint8_t *wasm_buf;
+    uint32_t wasm_size, iterations, i, j;
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    wasm_exec_env_t exec_env = NULL;
+    wasm_function_inst_t func;
+    wasm_prepared_call_t prepared;
+    uint64_t sums[CALL_KIND_NUM];
+    double start, costs[CALL_KIND_NUM];
+    CallKind kind;
+    bool ok;
+    int ret = 1;
+
+    if (argc < 2) {
+        printf("Usage: %s <wasm or aot file> [iterations]\n", argv[0]);
+        return 1;
+    }
+    iterations = argc > 2 ? (uint32_t)atoi(argv[2]) : 10000000;
+
+    if (!(wasm_buf = read_file(argv[1], &wasm_size))) {
+        printf("Read file %s failed\n", argv[1]);
+        return 1;
+    }
+
+    if (!wasm_runtime_init()) {
+        printf("Init runtime failed\n");
+        goto fail1;
+    }
+
+    if (!(module = wasm_runtime_load(wasm_buf, wasm_size, error_buf,
+                                     sizeof(error_buf)))
+        || !(module_inst = wasm_runtime_instantiate(module, 65536, 0, error_buf,
+                                                    sizeof(error_buf)))
+        || !(exec_env = wasm_runtime_create_exec_env(module_inst, 65536))) {
+        printf("%s\n", exec_env ? "Create exec env failed" : error_buf);
+        goto fail2;
+    }
+
+    printf("%-8s%-30s%12s\n", "func", "api", "ns/call");
+    for (i = 0; i < sizeof(bench_funcs) / sizeof(bench_funcs[0]); i++) {
+        if (!(func = wasm_runtime_lookup_function(module_inst,
+                                                  bench_funcs[i].name))
+            || !(prepared = wasm_runtime_create_prepared_call(exec_env, func))) {
+            printf("Prepare function %s failed\n", bench_funcs[i].name);
+            goto fail2;
+        }
+
+        for (kind = 0; kind < CALL_KIND_NUM; kind++) {
+            sums[kind] = 0;
+            start = now_ns();
+            if (kind == CALL_BATCH) {
+                /* the arguments are filled and the results are summed
+                   in the loop as the other APIs do */
+                ok = call_batches(i, exec_env, func, iterations, &sums[kind]);
+            }
+            else {
+                for (j = 0, ok = true; ok && j < iterations; j++)
+                    ok = bench_funcs[i].call(kind, exec_env, func, prepared, j,
+                                             &sums[kind]);
+            }
+            if (!ok) {
+                printf("Call %s failed: %s\n", bench_funcs[i].name,
+                       wasm_runtime_get_exception(module_inst));
+                wasm_runtime_destroy_prepared_call(prepared);
+                goto fail2;
+            }
+            costs[kind] = (now_ns() - start) / iterations;
+            printf("%-8s%-30s%12.1f\n", bench_funcs[i].name,
+                   call_kind_names[kind], costs[kind]);
+        }
+        wasm_runtime_destroy_prepared_call(prepared);
+
+        for (kind = 1; kind < CALL_KIND_NUM; kind++) {
+            if (sums[kind] != sums[0]) {
+                printf("Results of %s mismatch\n", bench_funcs[i].name);
+                goto fail2;
+            }
+        }
+    }
+    ret = 0;
+
+fail2:
+    if (exec_env)
+        wasm_runtime_destroy_exec_env(exec_env);
+    if (module_inst)
+        wasm_runtime_deinstantiate(module_inst);
+    if (module)
+        wasm_runtime_unload(module);
+    wasm_runtime_destroy();
+fail1:
+    free(wasm_buf);
+    return ret;
+}
@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+WAMRC="../../../wamr-compiler/build/wamrc"
+
+echo "Compile gc_alloc.wat to gc_alloc.wasm .."
+wasm-tools parse -o gc_alloc.wasm gc_alloc.wat
+
+echo "Compile gc_alloc.wasm to gc_alloc.aot .."
+${WAMRC} --enable-gc -o gc_alloc.aot gc_alloc.wasm
+
+echo "Done"
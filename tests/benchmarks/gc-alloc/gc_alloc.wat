@@ -0,0 +1,86 @@
+;; Copyright (C) 2019 Intel Corporation.  All rights reserved.
+;; SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+;; An allocation-heavy workload: a long-lived list of `n_old` nodes is built
+;; first, then every iteration allocates 8 short-lived nodes and stores two
+;; more into objects that survived earlier collections, so that both the
+;; nursery and the remembered set are exercised. Returns the sum of the values
+;; of the long-lived list, or -1 if a reachable node was lost.
+(module
+  (type $node (struct (field $val (mut i32))
+                      (field $next (mut (ref null $node)))
+                      (field $side (mut (ref null $node)))))
+  (type $nodes (array (mut (ref null $node))))
+
+  (global $old (mut (ref null $node)) (ref.null $node))
+  (global $ring (mut (ref null $nodes)) (ref.null $nodes))
+
+  (func (export "run") (param $n_old i32) (param $iters i32) (result i32)
+    (local $i i32) (local $head (ref null $node)) (local $k i32)
+    (local $bad i32) (local $j i32) (local $sum i32)
+
+    ;; the long-lived list
+    (block $done
+      (loop $build
+        (br_if $done (i32.ge_s (local.get $i) (local.get $n_old)))
+        (local.set $head
+          (struct.new $node (local.get $i) (local.get $head)
+                            (ref.null $node)))
+        (local.set $i (i32.add (local.get $i) (i32.const 1)))
+        (br $build)))
+    (global.set $old (local.get $head))
+    (global.set $ring (array.new_default $nodes (i32.const 16)))
+
+    (block $done
+      (loop $iter
+        (br_if $done (i32.ge_s (local.get $k) (local.get $iters)))
+        ;; check the young nodes stored by the previous iteration
+        (if (local.get $k)
+          (then
+            (local.set $bad
+              (i32.or (local.get $bad)
+                (i32.ne
+                  (struct.get $node $val
+                    (struct.get $node $side (global.get $old)))
+                  (i32.mul (i32.sub (local.get $k) (i32.const 1))
+                           (i32.const 2)))))
+            (local.set $bad
+              (i32.or (local.get $bad)
+                (i32.ne
+                  (struct.get $node $val
+                    (array.get $nodes (global.get $ring)
+                      (i32.and (i32.sub (local.get $k) (i32.const 1))
+                               (i32.const 15))))
+                  (i32.mul (i32.sub (local.get $k) (i32.const 1))
+                           (i32.const 3)))))))
+        ;; garbage
+        (local.set $j (i32.const 0))
+        (block $done2
+          (loop $garbage
+            (br_if $done2 (i32.ge_s (local.get $j) (i32.const 8)))
+            (drop (struct.new $node (local.get $j) (ref.null $node)
+                                    (ref.null $node)))
+            (local.set $j (i32.add (local.get $j) (i32.const 1)))
+            (br $garbage)))
+        ;; old-to-young references
+        (struct.set $node $side (global.get $old)
+          (struct.new $node (i32.mul (local.get $k) (i32.const 2))
+                            (ref.null $node) (ref.null $node)))
+        (array.set $nodes (global.get $ring)
+          (i32.and (local.get $k) (i32.const 15))
+          (struct.new $node (i32.mul (local.get $k) (i32.const 3))
+                            (ref.null $node) (ref.null $node)))
+        (local.set $k (i32.add (local.get $k) (i32.const 1)))
+        (br $iter)))
+
+    (local.set $head (global.get $old))
+    (block $done
+      (loop $sum
+        (br_if $done (ref.is_null (local.get $head)))
+        (local.set $sum
+          (i32.add (local.get $sum)
+                   (struct.get $node $val (local.get $head))))
+        (local.set $head (struct.get $node $next (local.get $head)))
+        (br $sum)))
+    (select (i32.const -1) (local.get $sum) (local.get $bad)))
+)
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+IWASM="../../../product-mini/platforms/${PLATFORM}/build/iwasm"
+GC_HEAP_SIZE=${GC_HEAP_SIZE:-1048576}
+GC_OPTS="--gc-heap-size=${GC_HEAP_SIZE}"
+if [[ -n "${GC_THREADS}" ]]; then
+    GC_OPTS="${GC_OPTS} --gc-threads=${GC_THREADS}"
+fi
+N_OLD=${1:-5000}
+ITERS=${2:-2000000}
+
+echo "Run gc_alloc with iwasm aot mode .."
+time ${IWASM} ${GC_OPTS} -f run gc_alloc.aot ${N_OLD} ${ITERS}
+
+echo "Run gc_alloc with iwasm interpreter mode .."
+time ${IWASM} ${GC_OPTS} -f run gc_alloc.wasm ${N_OLD} ${ITERS}
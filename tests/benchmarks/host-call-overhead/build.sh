@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+WAMR_DIR=$PWD/../../..
+IWASM_BUILD_DIR=${WAMR_DIR}/product-mini/platforms/${PLATFORM}/build
+
+echo "===> compile host_call_overhead src to host_call_overhead"
+gcc -O3 -o host_call_overhead src/host_call_overhead.c \
+    -I${WAMR_DIR}/core/iwasm/include ${IWASM_BUILD_DIR}/libiwasm.a \
+    -lpthread -lm -ldl
+
+echo "===> compile host_call_overhead.wat to host_call_overhead.wasm"
+wasm-tools parse -o host_call_overhead.wasm host_call_overhead.wat
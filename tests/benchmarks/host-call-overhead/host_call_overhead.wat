@@ -0,0 +1,58 @@
+;; Copyright (C) 2019 Intel Corporation.  All rights reserved.
+;; SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+;; Loops calling tiny host functions, so that the cost of a loop iteration
+;; is mostly the cost of calling the host function
+(module
+  (import "env" "nop" (func $nop))
+  (import "env" "add" (func $add (param i32 i32) (result i32)))
+  (import "env" "counter" (func $counter (result i64)))
+  (import "env" "sum_bytes" (func $sum_bytes (param i32 i32) (result i32)))
+
+  (memory (export "memory") 1)
+  (data (i32.const 16) "0123456789abcdef")
+
+  (func (export "run_nop") (param $n i32) (result i64)
+    (local $i i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (call $nop)
+        (local.set $i (i32.add (local.get $i) (i32.const 1)))
+        (br $loop)))
+    (i64.extend_i32_u (local.get $i)))
+
+  (func (export "run_add") (param $n i32) (result i64)
+    (local $i i32) (local $sum i32)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (local.set $sum (call $add (local.get $sum) (local.get $i)))
+        (local.set $i (i32.add (local.get $i) (i32.const 1)))
+        (br $loop)))
+    (i64.extend_i32_u (local.get $sum)))
+
+  (func (export "run_counter") (param $n i32) (result i64)
+    (local $i i32) (local $sum i64)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (local.set $sum (i64.add (local.get $sum) (call $counter)))
+        (local.set $i (i32.add (local.get $i) (i32.const 1)))
+        (br $loop)))
+    (local.get $sum))
+
+  ;; a pointer and length param, checked and converted by the runtime
+  (func (export "run_sum_bytes") (param $n i32) (result i64)
+    (local $i i32) (local $sum i64)
+    (block $done
+      (loop $loop
+        (br_if $done (i32.ge_u (local.get $i) (local.get $n)))
+        (local.set $sum
+          (i64.add (local.get $sum)
+                   (i64.extend_i32_u
+                     (call $sum_bytes (i32.const 16) (i32.const 16)))))
+        (local.set $i (i32.add (local.get $i) (i32.const 1)))
+        (br $loop)))
+    (local.get $sum))
+)
@@ -0,0 +1,9 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+ITERATIONS=${1:-10000000}
+
+echo "Run host_call_overhead with interpreter mode .."
+./host_call_overhead host_call_overhead.wasm ${ITERATIONS}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "wasm_export.h"
+
+static uint64_t counter_value;
+
+static void
+nop_wrapper(wasm_exec_env_t exec_env)
+{
+    (void)exec_env;
+}
+
+static int32_t
+add_wrapper(wasm_exec_env_t exec_env, int32_t a, int32_t b)
+{
+    (void)exec_env;
+    return a + b;
+}
+
+static int64_t
+counter_wrapper(wasm_exec_env_t exec_env)
+{
+    (void)exec_env;
+    return (int64_t)++counter_value;
+}
+
+static int32_t
+sum_bytes_wrapper(wasm_exec_env_t exec_env, const uint8_t *buf, uint32_t len)
+{
+    int32_t sum = 0;
+    uint32_t i;
+
+    (void)exec_env;
+    for (i = 0; i < len; i++)
+        sum += buf[i];
+    return sum;
+}
+
+/* clang-format off */
+static NativeSymbol native_symbols[] = {
+    { "nop", nop_wrapper, "()", NULL },
+    { "add", add_wrapper, "(ii)i", NULL },
+    { "counter", counter_wrapper, "()I", NULL },
+    { "sum_bytes", sum_bytes_wrapper, "(*~)i", NULL },
+};
+/* clang-format on */
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static uint8_t *
+read_file(const char *path, uint32_t *p_size)
+{
+    FILE *file;
+    uint8_t *buf;
+    long size;
+
+    if (!(file = fopen(path, "rb")))
+        return NULL;
+    fseek(file, 0, SEEK_END);
+    size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (size <= 0 || !(buf = malloc(size))
+        || fread(buf, 1, size, file) != (size_t)size) {
+        fclose(file);
+        return NULL;
+    }
+    fclose(file);
+    *p_size = (uint32_t)size;
+    return buf;
+}
+
+/* The expected result of a loop of n iterations */
+static uint64_t
+expected_result(const char *name, uint32_t n)
+{
+    const char *data = "0123456789abcdef";
+    uint64_t sum = 0;
+    uint32_t i;
+
+    if (!strcmp(name, "run_nop"))
+        return n;
+    if (!strcmp(name, "run_add"))
+        /* sum of 0 .. n - 1 in i32 */
+        return (uint32_t)((uint64_t)n * (n - 1) / 2);
+    if (!strcmp(name, "run_counter"))
+        /* sum of 1 .. n */
+        return (uint64_t)n * (n + 1) / 2;
+    for (i = 0; i < 16; i++)
+        sum += (uint8_t)data[i];
+    return sum * n;
+}
+
+int
+main(int argc, char *argv[])
+{
+    static const char *bench_funcs[] = { "run_nop", "run_add", "run_counter",
+                                         "run_sum_bytes" };
+    char error_buf[128];
+    uint8_t *wasm_buf;
+    uint32_t wasm_size, iterations, i;
+    uint32_t wasm_argv[2];
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    wasm_exec_env_t exec_env = NULL;
+    wasm_function_inst_t func;
+    uint64_t result;
+    double start, cost;
+    int ret = 1;
+
+    if (argc < 2) {
+        printf("Usage: %s <wasm file> [iterations]\n", argv[0]);
+        return 1;
+    }
+    iterations = argc > 2 ? (uint32_t)atoi(argv[2]) : 10000000;
+
+    if (!(wasm_buf = read_file(argv[1], &wasm_size))) {
+        printf("Read file %s failed\n", argv[1]);
+        return 1;
+    }
+
+    if (!wasm_runtime_init()) {
+        printf("Init runtime failed\n");
+        goto fail1;
+    }
+
+    if (!wasm_runtime_register_natives("env", native_symbols,
+                                       sizeof(native_symbols)
+                                           / sizeof(NativeSymbol))) {
+        printf("Register natives failed\n");
+        goto fail2;
+    }
+
+    if (!(module = wasm_runtime_load(wasm_buf, wasm_size, error_buf,
+                                     sizeof(error_buf)))
+        || !(module_inst = wasm_runtime_instantiate(module, 65536, 0, error_buf,
+                                                    sizeof(error_buf)))
+        || !(exec_env = wasm_runtime_create_exec_env(module_inst, 65536))) {
+        printf("%s\n", exec_env ? "Create exec env failed" : error_buf);
+        goto fail2;
+    }
+
+    printf("%-16s%12s\n", "func", "ns/call");
+    for (i = 0; i < sizeof(bench_funcs) / sizeof(bench_funcs[0]); i++) {
+        if (!(func = wasm_runtime_lookup_function(module_inst,
+                                                  bench_funcs[i]))) {
+            printf("Lookup function %s failed\n", bench_funcs[i]);
+            goto fail2;
+        }
+
+        counter_value = 0;
+        wasm_argv[0] = iterations;
+        start = now_ns();
+        if (!wasm_runtime_call_wasm(exec_env, func, 1, wasm_argv)) {
+            printf("Call %s failed: %s\n", bench_funcs[i],
+                   wasm_runtime_get_exception(module_inst));
+            goto fail2;
+        }
+        cost = (now_ns() - start) / iterations;
+        printf("%-16s%12.1f\n", bench_funcs[i], cost);
+
+        memcpy(&result, wasm_argv, sizeof(result));
+        if (result != expected_result(bench_funcs[i], iterations)) {
+            printf("Result of %s mismatch\n", bench_funcs[i]);
+            goto fail2;
+        }
+    }
+    ret = 0;
+
+fail2:
+    if (exec_env)
+        wasm_runtime_destroy_exec_env(exec_env);
+    if (module_inst)
+        wasm_runtime_deinstantiate(module_inst);
+    if (module)
+        wasm_runtime_unload(module);
+    wasm_runtime_destroy();
+fail1:
+    free(wasm_buf);
+    return ret;
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+WAMRC_CMD=$PWD/../../../wamr-compiler/build/wamrc
+
+echo "===> compile fd_threads src to fd_threads_native"
+gcc -O3 -o fd_threads_native src/fd_threads.c -lpthread
+
+echo "===> compile fd_threads src to fd_threads.wasm"
+/opt/wasi-sdk/bin/clang -O3 --target=wasm32-wasi-threads -pthread \
+    -Wl,--import-memory,--export-memory,--max-memory=67108864 \
+    -o fd_threads.wasm src/fd_threads.c
+
+echo "===> compile fd_threads.wasm to fd_threads.aot"
+${WAMRC_CMD} --enable-multi-thread -o fd_threads.aot fd_threads.wasm
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+readonly IWASM_CMD="../../../product-mini/platforms/${PLATFORM}/build/iwasm"
+readonly WRITE_COUNT=${1:-200000}
+
+for threads in 1 2 4 8
+do
+    echo "============> run fd_threads native, ${threads} threads"
+    ./fd_threads_native ${threads} ${WRITE_COUNT}
+
+    echo "============> run fd_threads.aot, ${threads} threads"
+    ${IWASM_CMD} --dir=. fd_threads.aot ${threads} ${WRITE_COUNT}
+done
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+/* N threads, each writing small chunks to its own file. The runtime looks
+   up the file descriptor on every write, so this measures how well fd
+   table lookups scale with the number of threads. */
+
+#define MAX_THREADS 64
+
+typedef struct {
+    int fd;
+    int count;
+} thread_arg_t;
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void *
+writer(void *arg)
+{
+    thread_arg_t *targ = arg;
+    char buf[16] = "0123456789abcde";
+    int i;
+
+    for (i = 0; i < targ->count; i++) {
+        if (pwrite(targ->fd, buf, sizeof(buf), 0) != sizeof(buf))
+            return (void *)1;
+    }
+    return NULL;
+}
+
+int
+main(int argc, char **argv)
+{
+    pthread_t threads[MAX_THREADS];
+    thread_arg_t args[MAX_THREADS];
+    int nthreads = argc > 1 ? atoi(argv[1]) : 4;
+    int count = argc > 2 ? atoi(argv[2]) : 200000;
+    char path[32];
+    void *ret;
+    double start, end;
+    int i, failed = 0;
+
+    if (nthreads <= 0 || nthreads > MAX_THREADS || count <= 0) {
+        fprintf(stderr, "usage: fd_threads [threads (1-%d)] [writes]\n",
+                MAX_THREADS);
+        return 1;
+    }
+
+    for (i = 0; i < nthreads; i++) {
+        snprintf(path, sizeof(path), "fd_threads_%d.tmp", i);
+        if ((args[i].fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644))
+            < 0) {
+            perror("open");
+            return 1;
+        }
+        args[i].count = count;
+    }
+
+    start = now_ns();
+    for (i = 0; i < nthreads; i++) {
+        if (pthread_create(&threads[i], NULL, writer, &args[i]) != 0) {
+            fprintf(stderr, "failed to create thread\n");
+            return 1;
+        }
+    }
+    for (i = 0; i < nthreads; i++) {
+        pthread_join(threads[i], &ret);
+        failed |= ret != NULL;
+    }
+    end = now_ns();
+
+    for (i = 0; i < nthreads; i++) {
+        close(args[i].fd);
+        snprintf(path, sizeof(path), "fd_threads_%d.tmp", i);
+        unlink(path);
+    }
+
+    if (failed) {
+        fprintf(stderr, "write failed\n");
+        return 1;
+    }
+
+    printf("%d threads: %.1f ns/write, %.0f writes/s in total\n", nthreads,
+           (end - start) / count, (double)nthreads * count * 1e9 / (end - start));
+    return 0;
+}
@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+WAMRC_CMD=$PWD/../../../wamr-compiler/build/wamrc
+SOCKET_EXT_DIR=$PWD/../../../core/iwasm/libraries/lib-socket
+
+echo "===> compile client src to client_native"
+gcc -O3 -o client_native src/client.c
+
+echo "===> compile server src to server.wasm"
+/opt/wasi-sdk/bin/clang -O3 -I${SOCKET_EXT_DIR}/inc \
+    -o server.wasm src/server.c ${SOCKET_EXT_DIR}/src/wasi/wasi_socket_ext.c
+
+echo "===> compile server.wasm to server.aot"
+${WAMRC_CMD} -o server.aot server.wasm
@@ -0,0 +1,28 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+# Set IWASM to compare with another build, e.g. one configured with
+# -DCMAKE_C_FLAGS=-DDISABLE_EPOLL
+readonly IWASM_CMD=${IWASM:-"../../../product-mini/platforms/${PLATFORM}/build/iwasm"}
+readonly PORT=18081
+readonly IDLE=${1:-10000}
+readonly ACTIVE=${2:-100}
+readonly ROUNDS=${3:-2000}
+
+# Both the server and the client hold one descriptor per connection
+ulimit -n $((IDLE + ACTIVE + 64)) || exit 1
+
+for idle in 0 ${IDLE}
+do
+    connections=$((idle + ACTIVE))
+    echo "============> ${idle} idle, ${ACTIVE} active connections"
+    ${IWASM_CMD} --addr-pool=127.0.0.1/32 server.aot ${PORT} ${connections} &
+    SERVER_PID=$!
+    sleep 1
+    ./client_native ${PORT} ${connections} ${ACTIVE} ${ROUNDS}
+    wait ${SERVER_PID}
+done
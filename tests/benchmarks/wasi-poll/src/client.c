@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Native load generator for the poll_oneoff benchmark server: opens
+   <connections> connections, then for <rounds> rounds sends one byte on
+   each of the <active> connections and waits for all of the echoes. The
+   other connections stay idle. */
+
+static double
+now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int
+connect_to(int port)
+{
+    struct sockaddr_in addr = { 0 };
+    int sock;
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0
+        || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("connect");
+        exit(1);
+    }
+    return sock;
+}
+
+int
+main(int argc, char *argv[])
+{
+    double begin, elapsed;
+    int *socks;
+    int port, count, active, rounds, step, i, r;
+    char c = 'x';
+
+    if (argc < 5) {
+        printf("Usage: %s <port> <connections> <active> <rounds>\n", argv[0]);
+        return 1;
+    }
+    port = atoi(argv[1]);
+    count = atoi(argv[2]);
+    active = atoi(argv[3]);
+    rounds = atoi(argv[4]);
+    if (active < 1 || active > count) {
+        printf("<active> must be between 1 and <connections>\n");
+        return 1;
+    }
+
+    if (!(socks = calloc((size_t)count, sizeof(*socks)))) {
+        printf("Allocate memory failed\n");
+        return 1;
+    }
+    for (i = 0; i < count; i++)
+        socks[i] = connect_to(port);
+
+    /* Spread the active connections over the whole set */
+    step = count / active;
+
+    begin = now_s();
+    for (r = 0; r < rounds; r++) {
+        for (i = 0; i < active; i++) {
+            if (send(socks[i * step], &c, 1, 0) != 1) {
+                perror("send");
+                return 1;
+            }
+        }
+        for (i = 0; i < active; i++) {
+            if (recv(socks[i * step], &c, 1, 0) != 1) {
+                perror("recv");
+                return 1;
+            }
+        }
+    }
+    elapsed = now_s() - begin;
+
+    printf("%d connections, %d active: %.1f us per round, %.0f messages/s\n",
+           count, active, elapsed * 1e6 / rounds,
+           (double)rounds * active / elapsed);
+
+    for (i = 0; i < count; i++)
+        close(socks[i]);
+    free(socks);
+    return 0;
+}
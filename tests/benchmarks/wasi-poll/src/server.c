@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <wasi/api.h>
+#include <wasi_socket_ext.h>
+
+/* An echo server for the poll_oneoff benchmark. It accepts <connections>
+   connections, then waits on all of them with a single poll_oneoff() call
+   per round and echoes whatever arrived on the ready ones, until every
+   connection is closed. Most connections stay idle, so the cost of a round
+   shows how poll_oneoff() scales with the number of idle subscriptions. */
+
+static __wasi_subscription_t *subs;
+static __wasi_event_t *events;
+static int *conns;
+static char buf[256];
+
+static void
+set_subscription(int i, int conn)
+{
+    conns[i] = conn;
+    memset(&subs[i], 0, sizeof(subs[i]));
+    subs[i].userdata = (__wasi_userdata_t)i;
+    subs[i].u.tag = __WASI_EVENTTYPE_FD_READ;
+    subs[i].u.u.fd_read.file_descriptor = (__wasi_fd_t)conn;
+}
+
+int
+main(int argc, char *argv[])
+{
+    struct sockaddr_in addr = { 0 };
+    __wasi_size_t nevents, i;
+    __wasi_errno_t err;
+    ssize_t n;
+    int sock, count, open, closed, k, on = 1;
+
+    if (argc < 3) {
+        printf("Usage: %s <port> <connections>\n", argv[0]);
+        return 1;
+    }
+    count = atoi(argv[2]);
+
+    subs = calloc((size_t)count, sizeof(*subs));
+    events = calloc((size_t)count, sizeof(*events));
+    conns = calloc((size_t)count, sizeof(*conns));
+    if (!subs || !events || !conns) {
+        printf("Allocate memory failed\n");
+        return 1;
+    }
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(atoi(argv[1]));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0
+        || setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) < 0
+        || bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0
+        || listen(sock, 1024) < 0) {
+        perror("listen");
+        return 1;
+    }
+
+    for (k = 0; k < count; k++) {
+        int conn = accept(sock, NULL, NULL);
+        if (conn < 0) {
+            perror("accept");
+            return 1;
+        }
+        set_subscription(k, conn);
+    }
+    close(sock);
+
+    open = count;
+    while (open > 0) {
+        err = __wasi_poll_oneoff(subs, events, (__wasi_size_t)open, &nevents);
+        if (err != __WASI_ERRNO_SUCCESS) {
+            printf("poll_oneoff failed: %d\n", err);
+            return 1;
+        }
+
+        closed = 0;
+        for (i = 0; i < nevents; i++) {
+            int conn = conns[events[i].userdata];
+
+            if ((n = recv(conn, buf, sizeof(buf), 0)) > 0
+                && send(conn, buf, (size_t)n, 0) == n)
+                continue;
+
+            close(conn);
+            conns[events[i].userdata] = -1;
+            closed++;
+        }
+
+        /* Drop the closed connections from the subscriptions */
+        if (closed > 0) {
+            for (k = 0, i = 0; i < (__wasi_size_t)open; i++) {
+                if (conns[i] >= 0)
+                    set_subscription(k++, conns[i]);
+            }
+            open = k;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+readonly IWASM_CMD="../../../product-mini/platforms/${PLATFORM}/build/iwasm"
+readonly PORT=18080
+readonly REQUESTS=${1:-200}
+readonly ECHO_MB=${2:-2048}
+
+run_server()
+{
+    ${IWASM_CMD} --addr-pool=127.0.0.1/32 --dir=. server.aot ${PORT} "$@" &
+    SERVER_PID=$!
+    sleep 1
+}
+
+stop_server()
+{
+    kill ${SERVER_PID}
+    wait ${SERVER_PID} 2>/dev/null
+}
+
+for copy in copy ""
+do
+    echo "============> static file, ${copy:-sendfile}"
+    run_server static static.bin ${copy}
+    ./client_native ${PORT} static ${REQUESTS}
+    stop_server
+
+    echo "============> echo, ${copy:-sendfile}"
+    run_server echo ${copy}
+    ./client_native ${PORT} echo ${ECHO_MB}
+    stop_server
+done
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Native load generator for the sendfile benchmark server:
+     static <requests>: fetches the file <requests> times, one connection
+                        per request
+     echo <megabytes>: streams the data through one connection */
+
+#define CHUNK_SIZE (64 * 1024)
+
+static char buf[CHUNK_SIZE];
+
+static double
+now_s(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int
+connect_to(int port)
+{
+    struct sockaddr_in addr = { 0 };
+    int sock;
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0
+        || connect(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        perror("connect");
+        exit(1);
+    }
+    return sock;
+}
+
+static long long
+fetch(int port)
+{
+    const char *request = "GET / HTTP/1.0\r\n\r\n";
+    long long total = 0;
+    ssize_t n;
+    int sock = connect_to(port);
+
+    if (send(sock, request, strlen(request), 0) < 0) {
+        perror("send");
+        exit(1);
+    }
+    while ((n = recv(sock, buf, sizeof(buf), 0)) > 0)
+        total += n;
+    close(sock);
+    return total;
+}
+
+static long long
+echo(int port, long long size)
+{
+    long long sent = 0, received = 0;
+    ssize_t n;
+    int sock = connect_to(port);
+
+    memset(buf, 'x', sizeof(buf));
+    while (received < size) {
+        /* Keep at most one chunk in flight, so neither side blocks on a
+           full socket buffer */
+        if (sent < size) {
+            n = send(sock, buf,
+                     size - sent < CHUNK_SIZE ? size - sent : CHUNK_SIZE, 0);
+            if (n < 0)
+                break;
+            sent += n;
+        }
+        while (received < sent) {
+            if ((n = recv(sock, buf, sizeof(buf), 0)) <= 0)
+                goto out;
+            received += n;
+        }
+    }
+out:
+    close(sock);
+    return received;
+}
+
+int
+main(int argc, char *argv[])
+{
+    long long total = 0, count;
+    double start, elapsed;
+    int port, i;
+
+    if (argc < 4) {
+        printf("Usage: %s <port> static <requests>\n"
+               "       %s <port> echo <megabytes>\n",
+               argv[0], argv[0]);
+        return 1;
+    }
+
+    port = atoi(argv[1]);
+    count = atoll(argv[3]);
+
+    start = now_s();
+    if (!strcmp(argv[2], "static")) {
+        for (i = 0; i < count; i++)
+            total += fetch(port);
+    }
+    else {
+        total = echo(port, count * 1024 * 1024);
+    }
+    elapsed = now_s() - start;
+
+    printf("%s: %lld bytes in %.3f s, %.1f MB/s\n", argv[2], total, elapsed,
+           total / elapsed / (1024 * 1024));
+    return 0;
+}
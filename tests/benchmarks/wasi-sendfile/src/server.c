@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <wasi_socket_ext.h>
+
+/* A minimal server for the sendfile benchmark, in one of two modes:
+     static <file>: answers every connection with the contents of the file
+     echo: sends back whatever is received on a connection until EOF
+   The data is moved with sendfile(), or with read() and send() through a
+   buffer in linear memory when "copy" is given. */
+
+#define CHUNK_SIZE (64 * 1024)
+
+static char buf[CHUNK_SIZE];
+
+static int
+send_all(int fd, const char *data, size_t len)
+{
+    ssize_t n;
+
+    while (len > 0) {
+        if ((n = send(fd, data, len, 0)) <= 0)
+            return -1;
+        data += n;
+        len -= (size_t)n;
+    }
+    return 0;
+}
+
+static int
+serve_static(int conn, const char *path, int copy)
+{
+    char header[128];
+    struct stat st;
+    off_t offset = 0;
+    ssize_t n;
+    int fd, ret = -1;
+
+    /* Whatever the request is, it is answered with the file */
+    if (recv(conn, buf, sizeof(buf), 0) <= 0)
+        return -1;
+
+    if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &st) < 0) {
+        perror("open");
+        goto fail;
+    }
+
+    snprintf(header, sizeof(header),
+             "HTTP/1.0 200 OK\r\nContent-Length: %lld\r\n\r\n",
+             (long long)st.st_size);
+    if (send_all(conn, header, strlen(header)) < 0)
+        goto fail;
+
+    while (offset < st.st_size) {
+        if (copy) {
+            if ((n = read(fd, buf, sizeof(buf))) <= 0
+                || send_all(conn, buf, (size_t)n) < 0)
+                goto fail;
+            offset += n;
+        }
+        else if (sendfile(conn, fd, &offset, CHUNK_SIZE) <= 0) {
+            goto fail;
+        }
+    }
+    ret = 0;
+
+fail:
+    if (fd >= 0)
+        close(fd);
+    return ret;
+}
+
+static int
+serve_echo(int conn, int copy)
+{
+    ssize_t n;
+
+    for (;;) {
+        if (copy) {
+            if ((n = recv(conn, buf, sizeof(buf), 0)) <= 0
+                || send_all(conn, buf, (size_t)n) < 0)
+                break;
+        }
+        else if ((n = sendfile(conn, conn, NULL, CHUNK_SIZE)) <= 0) {
+            break;
+        }
+    }
+    return n == 0 ? 0 : -1;
+}
+
+int
+main(int argc, char *argv[])
+{
+    struct sockaddr_in addr = { 0 };
+    const char *mode, *path = NULL;
+    int port, copy, sock, conn, on = 1;
+
+    if (argc < 3) {
+        printf("Usage: %s <port> static <file> [copy]\n"
+               "       %s <port> echo [copy]\n",
+               argv[0], argv[0]);
+        return 1;
+    }
+
+    port = atoi(argv[1]);
+    mode = argv[2];
+    if (!strcmp(mode, "static")) {
+        if (argc < 4) {
+            printf("missing file\n");
+            return 1;
+        }
+        path = argv[3];
+        copy = argc > 4 && !strcmp(argv[4], "copy");
+    }
+    else {
+        copy = argc > 3 && !strcmp(argv[3], "copy");
+    }
+
+    if ((sock = socket(AF_INET, SOCK_STREAM, 0)) < 0) {
+        perror("socket");
+        return 1;
+    }
+    setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0
+        || listen(sock, 16) < 0) {
+        perror("bind");
+        return 1;
+    }
+
+    printf("listening on 127.0.0.1:%d, %s mode, %s\n", port, mode,
+           copy ? "read/send" : "sendfile");
+    fflush(stdout);
+
+    for (;;) {
+        if ((conn = accept(sock, NULL, NULL)) < 0) {
+            perror("accept");
+            break;
+        }
+        if (path)
+            serve_static(conn, path, copy);
+        else
+            serve_echo(conn, copy);
+        close(conn);
+    }
+
+    close(sock);
+    return 0;
+}
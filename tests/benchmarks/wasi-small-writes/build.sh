@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+WAMRC_CMD=$PWD/../../../wamr-compiler/build/wamrc
+
+echo "===> compile small_writes src to small_writes_native"
+gcc -O3 -o small_writes_native src/small_writes.c
+
+echo "===> compile small_writes src to small_writes.wasm"
+/opt/wasi-sdk/bin/clang -O3 -o small_writes.wasm src/small_writes.c
+
+echo "===> compile small_writes.wasm to small_writes.aot"
+${WAMRC_CMD} -o small_writes.aot small_writes.wasm
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+
+readonly IWASM_CMD="../../../product-mini/platforms/${PLATFORM}/build/iwasm"
+readonly WRITE_COUNT=${1:-1000000}
+
+echo "============> run small_writes native"
+./small_writes_native ${WRITE_COUNT} > /dev/null
+
+echo "============> run small_writes.aot"
+${IWASM_CMD} small_writes.aot ${WRITE_COUNT} > /dev/null
+
+echo "============> run small_writes.wasm"
+${IWASM_CMD} small_writes.wasm ${WRITE_COUNT} > /dev/null
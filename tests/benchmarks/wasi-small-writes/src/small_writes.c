@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+/* Issue many small writes to stdout, which is expected to be redirected
+   to /dev/null, and report the average cost of a write on stderr. */
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static void
+report(const char *name, int count, double start, double end)
+{
+    fprintf(stderr, "%-24s %10d writes %10.1f ns/write\n", name, count,
+            (end - start) / count);
+}
+
+int
+main(int argc, char **argv)
+{
+    static const char line[] = "[info] request served\n";
+    static const char prefix[] = "[info] ";
+    static const char message[] = "request served\n";
+    struct iovec iov[16];
+    int count = argc > 1 ? atoi(argv[1]) : 1000000;
+    double start;
+    int i, j;
+
+    if (count <= 0) {
+        fprintf(stderr, "invalid write count\n");
+        return 1;
+    }
+
+    start = now_ns();
+    for (i = 0; i < count; i++) {
+        if (write(STDOUT_FILENO, line, sizeof(line) - 1) < 0)
+            return 1;
+    }
+    report("write", count, start, now_ns());
+
+    /* Like printf, which writes the buffered data and the new data at once */
+    iov[0].iov_base = (void *)prefix;
+    iov[0].iov_len = sizeof(prefix) - 1;
+    iov[1].iov_base = (void *)message;
+    iov[1].iov_len = sizeof(message) - 1;
+    start = now_ns();
+    for (i = 0; i < count; i++) {
+        if (writev(STDOUT_FILENO, iov, 2) < 0)
+            return 1;
+    }
+    report("writev, 2 iovecs", count, start, now_ns());
+
+    /* Longer lists than the runtime translates on the stack */
+    for (j = 0; j < 16; j++) {
+        iov[j].iov_base = (void *)line;
+        iov[j].iov_len = 1;
+    }
+    start = now_ns();
+    for (i = 0; i < count; i++) {
+        if (writev(STDOUT_FILENO, iov, 16) < 0)
+            return 1;
+    }
+    report("writev, 16 iovecs", count, start, now_ns());
+
+    start = now_ns();
+    for (i = 0; i < count; i++) {
+        printf("%s", line);
+        fflush(stdout);
+    }
+    report("printf + fflush", count, start, now_ns());
+
+    return 0;
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+#include "bh_platform.h"
+#include "bh_read_file.h"
+#include "wasm_export.h"
+#include "wasm_runtime_common.h"
+#include "ems_gc_internal.h"
+
+static std::string CWD;
+
+static std::string
+get_binary_path()
+{
+    char cwd[1024] = { 0 };
+
+    if (readlink("/proc/self/exe", cwd, 1024) <= 0) {
+        return std::string();
+    }
+
+    char *path_end = strrchr(cwd, '/');
+    if (path_end != NULL) {
+        *path_end = '\0';
+    }
+
+    return std::string(cwd);
+}
+
+// Runs a module on the GC heap of its instance, and collects the heap
+// at the points chosen by the test
+class GCHeapTest : public testing::Test
+{
+  protected:
+    static void SetUpTestCase() { CWD = get_binary_path(); }
+
+    // The runtime is initialized by instantiate(), so that a test can
+    // change init_args first
+    void SetUp()
+    {
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+
+        init_args.mem_alloc_type = Alloc_With_Pool;
+        init_args.mem_alloc_option.pool.heap_buf = global_heap_buf;
+        init_args.mem_alloc_option.pool.heap_size = sizeof(global_heap_buf);
+        init_args.gc_heap_size = 1024 * 1024;
+    }
+
+    void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        if (wasm_file_buf)
+            wasm_runtime_free(wasm_file_buf);
+        if (cleanup)
+            wasm_runtime_destroy();
+    }
+
+  public:
+    void instantiate(const char *wasm_file)
+    {
+        std::string file = CWD + "/" + wasm_file;
+
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+        cleanup = true;
+
+        wasm_file_buf =
+            (uint8 *)bh_read_file_to_buffer(file.c_str(), &wasm_file_size);
+        ASSERT_NE(nullptr, wasm_file_buf);
+        module = wasm_runtime_load(wasm_file_buf, wasm_file_size, error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(nullptr, module) << error_buf;
+        module_inst = wasm_runtime_instantiate(module, 16 * 1024, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_NE(nullptr, module_inst) << error_buf;
+        // The exec_env enables the reclaim of the instance's GC heap
+        exec_env = wasm_runtime_create_exec_env(module_inst, 16 * 1024);
+        ASSERT_NE(nullptr, exec_env);
+        heap = (gc_heap_t *)wasm_runtime_get_gc_heap_handle(module_inst);
+        ASSERT_NE(nullptr, heap);
+    }
+
+    uint32 call(const char *name, uint32 argc, uint32 argv[])
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+
+        EXPECT_NE(nullptr, func) << name;
+        if (!func)
+            return 0;
+        EXPECT_TRUE(wasm_runtime_call_wasm(exec_env, func, argc, argv))
+            << name << ": " << wasm_runtime_get_exception(module_inst);
+        return argv[0];
+    }
+
+    uint32 call(const char *name, std::initializer_list<uint32> args = {})
+    {
+        uint32 argv[8] = { 0 };
+
+        std::copy(args.begin(), args.end(), argv);
+        return call(name, (uint32)args.size(), argv);
+    }
+
+    // A minor GC if the heap has an old generation, otherwise a full one
+    void collect(bool full)
+    {
+#if GC_GENERATIONAL != 0
+        if (full)
+            heap->is_full_gc_required = 1;
+#endif
+        ASSERT_EQ(GC_SUCCESS, gci_gc_heap(heap));
+    }
+
+    // Check the nodes kept in the list by copies of build(n)
+    void check_list(uint32 n, uint32 copies = 1)
+    {
+        const uint32 kept = n / 16;
+
+        // Every 16th node is kept: 16 * (0 + 1 + ... + kept - 1), the
+        // sum wraps around as the i32 of the module
+        EXPECT_EQ(copies * kept, call("count"));
+        EXPECT_EQ(copies * 8 * kept * (kept - 1), call("sum"));
+    }
+
+    // Build a list on the heap, which is collected several times while
+    // the nodes are allocated
+    void build_list(const char *wasm_file)
+    {
+        const uint32 n = 64000;
+        wasm_gc_stats_t stats, stats_end;
+
+        instantiate(wasm_file);
+        ASSERT_FALSE(HasFatalFailure());
+
+        ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+        call("build", { n });
+        ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats_end));
+        // The nursery is refilled many times
+        EXPECT_GT(stats_end.size_allocated - stats.size_allocated,
+                  (uint64)GC_NURSERY_SIZE * 4);
+        EXPECT_GT(stats_end.gc_count, stats.gc_count);
+        check_list(n);
+
+        // Allocation goes on after a full GC
+        collect(true);
+        check_list(n);
+        call("build", { n });
+        check_list(n, 2);
+    }
+
+#if GC_INCREMENTAL != 0
+    // Reverse the list while the heap is marked in slices: each step
+    // overwrites the only reference to the rest of the list, which is
+    // then recorded by the pre write barrier
+    void reverse_list(const char *wasm_file)
+    {
+        const uint32 n = 64000;
+        uint32 marking_reversals = 0;
+        wasm_gc_stats_t stats;
+
+        init_args.gc_slice_budget_us = 100;
+        instantiate(wasm_file);
+        ASSERT_FALSE(HasFatalFailure());
+        ASSERT_TRUE(gci_is_incremental_gc_enabled(heap));
+
+        call("build", { n });
+        for (uint32 i = 0; i < 64; i++) {
+            if (heap->gc_phase == GC_PHASE_MARK)
+                marking_reversals++;
+            call("reverse");
+        }
+        EXPECT_GT(marking_reversals, 0u);
+        check_list(n);
+
+        // Each slice is a pause, so there are more pauses than reclaims
+        ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+#if GC_GENERATIONAL != 0
+        EXPECT_GT(stats.gc_count, heap->total_full_gc_count);
+#endif
+
+        // The reclaim in progress is finished at once
+        collect(true);
+        EXPECT_EQ((gc_uint32)GC_PHASE_IDLE, heap->gc_phase);
+        check_list(n);
+    }
+#endif
+
+  public:
+    RuntimeInitArgs init_args;
+    char global_heap_buf[16 * 1024 * 1024];
+    bool cleanup = false;
+    uint8 *wasm_file_buf = nullptr;
+    uint32 wasm_file_size = 0;
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t module_inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+    gc_heap_t *heap = nullptr;
+    char error_buf[128];
+};
+
+#if GC_GENERATIONAL != 0
+// Young objects which are only referred to by old objects survive the
+// minor GC through the write barrier of each instruction storing them
+TEST_F(GCHeapTest, old_to_young_stores)
+{
+    gc_size_t minor_gc_count, full_gc_count;
+
+    instantiate("write_barrier.wasm");
+
+    // The holder struct and array become old
+    call("init");
+    collect(true);
+    full_gc_count = heap->total_full_gc_count;
+
+    call("store_struct", { 100 });
+    call("store_array", { 0, 200 });
+    call("fill_array", { 1, 300, 3 });
+    call("copy_array", { 4, 400 });
+    call("store_array", { 6, 500 });
+    // A young object replaced by another one before the GC is garbage
+    call("store_array", { 6, 600 });
+
+    minor_gc_count = heap->total_minor_gc_count;
+    collect(false);
+    EXPECT_EQ(minor_gc_count + 1, heap->total_minor_gc_count);
+    EXPECT_EQ(full_gc_count, heap->total_full_gc_count);
+
+    // The space of the collected objects is reused before each check
+    for (bool full : { false, true }) {
+        if (full) {
+            full_gc_count = heap->total_full_gc_count;
+            collect(true);
+            EXPECT_EQ(full_gc_count + 1, heap->total_full_gc_count);
+        }
+        call("churn", { 1000 });
+
+        EXPECT_EQ(100u, call("get_struct"));
+        EXPECT_EQ(200u, call("get_array", { 0 }));
+        for (uint32 i = 1; i < 4; i++)
+            EXPECT_EQ(300u, call("get_array", { i }));
+        EXPECT_EQ(400u, call("get_array", { 4 }));
+        EXPECT_EQ(400u, call("get_array", { 5 }));
+        EXPECT_EQ(600u, call("get_array", { 6 }));
+    }
+}
+#endif
+
+TEST_F(GCHeapTest, build_list)
+{
+    build_list("alloc.wasm");
+}
+
+// The AOT code bump allocates the nodes from the nursery inline, and
+// calls the runtime to refill it
+TEST_F(GCHeapTest, build_list_aot)
+{
+    build_list("alloc.aot");
+}
+
+// The sizes allocated and freed are those of the nodes built and
+// collected
+TEST_F(GCHeapTest, gc_stats)
+{
+    const uint32 n = 64000, kept = n / 16;
+    wasm_gc_stats_t stats, stats_end;
+    uint64 node_size;
+
+    instantiate("alloc.wasm");
+    ASSERT_FALSE(HasFatalFailure());
+    collect(true);
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+
+    call("build", { n });
+    collect(true);
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats_end));
+    // The kept nodes are the only live objects of type 0
+    ASSERT_TRUE(wasm_runtime_get_gc_live_sizes(module_inst, &node_size, 1));
+    ASSERT_EQ(0u, node_size % kept);
+    node_size /= kept;
+    EXPECT_GE(node_size, 16u);
+    EXPECT_GT(stats_end.gc_count, stats.gc_count);
+    EXPECT_EQ(n * node_size, stats_end.size_allocated - stats.size_allocated);
+    EXPECT_EQ((n - kept) * node_size, stats_end.size_freed - stats.size_freed);
+    EXPECT_EQ(stats_end.size_allocated - stats_end.size_freed,
+              stats_end.heap_size - stats_end.free_size);
+
+    stats = stats_end;
+    call("clear");
+    collect(true);
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats_end));
+    EXPECT_EQ(stats.size_allocated, stats_end.size_allocated);
+    EXPECT_EQ(kept * node_size, stats_end.size_freed - stats.size_freed);
+    EXPECT_EQ(stats.free_size + kept * node_size, stats_end.free_size);
+}
+
+#if GC_PARALLEL != 0
+// The helper threads mark and sweep heaps of at least 4MB together with
+// the collector thread
+TEST_F(GCHeapTest, parallel_gc)
+{
+    const uint32 n = 256000;
+    wasm_gc_stats_t stats;
+
+    init_args.gc_heap_size = 8 * 1024 * 1024;
+    init_args.gc_helper_thread_num = 3;
+    instantiate("alloc.wasm");
+    ASSERT_FALSE(HasFatalFailure());
+
+    // The nodes allocated fill the heap
+    call("build", { n });
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+    EXPECT_GT(stats.gc_count, 0u);
+    EXPECT_GT(stats.last_gc_thread_num, 1u);
+    check_list(n);
+
+    collect(true);
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+    EXPECT_GT(stats.last_gc_thread_num, 1u);
+    check_list(n);
+}
+#endif
+
+#if GC_INCREMENTAL != 0
+TEST_F(GCHeapTest, incremental_gc)
+{
+    reverse_list("alloc.wasm");
+}
+
+// The AOT code calls the pre write barrier while the heap is marked
+TEST_F(GCHeapTest, incremental_gc_aot)
+{
+    reverse_list("alloc.aot");
+}
+#endif
+
+#if GC_GROWABLE_HEAP != 0
+// The heap grows with the nodes kept alive, and is shrunk once they are
+// collected
+TEST_F(GCHeapTest, growable_heap)
+{
+    const uint32 n = 256000;
+    wasm_gc_stats_t stats;
+    uint64 init_size, grown_size;
+
+    init_args.gc_heap_size = 256 * 1024;
+    init_args.gc_heap_max_size = 16 * 1024 * 1024;
+    instantiate("alloc.wasm");
+    ASSERT_FALSE(HasFatalFailure());
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+    init_size = stats.heap_size;
+
+    // The nodes kept take more than the initial heap
+    call("build", { n });
+    check_list(n);
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+    EXPECT_GT(stats.heap_size, init_size);
+
+    call("build", { n });
+    check_list(n, 2);
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+    EXPECT_GT(stats.heap_size, init_size * 2);
+    grown_size = stats.heap_size;
+
+    call("clear");
+    collect(true);
+    EXPECT_EQ(0u, call("count"));
+    ASSERT_TRUE(wasm_runtime_get_gc_stats(module_inst, &stats));
+    EXPECT_LT(stats.heap_size, grown_size);
+}
+#endif
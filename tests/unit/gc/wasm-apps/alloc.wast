@@ -0,0 +1,74 @@
+(module
+  (type $node (struct (field i32) (field (mut (ref null $node)))))
+
+  (global $list (mut (ref null $node)) (ref.null $node))
+
+  ;; Allocate n nodes, every 16th one is kept in the list
+  (func (export "build") (param $n i32)
+    (local $i i32)
+    (local $node (ref null $node))
+    (loop $l
+      (local.set $node (struct.new $node (local.get $i) (global.get $list)))
+      (if (i32.eqz (i32.and (local.get $i) (i32.const 15)))
+        (then (global.set $list (local.get $node))))
+      (br_if $l (i32.lt_u
+                  (local.tee $i (i32.add (local.get $i) (i32.const 1)))
+                  (local.get $n)))
+    )
+  )
+
+  (func (export "count") (result i32)
+    (local $node (ref null $node))
+    (local $count i32)
+    (local.set $node (global.get $list))
+    (block $done
+      (loop $l
+        (br_if $done (ref.is_null (local.get $node)))
+        (local.set $count (i32.add (local.get $count) (i32.const 1)))
+        (local.set $node (struct.get $node 1 (local.get $node)))
+        (br $l)
+      )
+    )
+    (local.get $count)
+  )
+
+  (func (export "sum") (result i32)
+    (local $node (ref null $node))
+    (local $sum i32)
+    (local.set $node (global.get $list))
+    (block $done
+      (loop $l
+        (br_if $done (ref.is_null (local.get $node)))
+        (local.set $sum (i32.add (local.get $sum)
+                                 (struct.get $node 0 (local.get $node))))
+        (local.set $node (struct.get $node 1 (local.get $node)))
+        (br $l)
+      )
+    )
+    (local.get $sum)
+  )
+
+  ;; Reverse the list in place, a node of garbage is allocated per step
+  (func (export "reverse")
+    (local $prev (ref null $node))
+    (local $cur (ref null $node))
+    (local $next (ref null $node))
+    (local.set $cur (global.get $list))
+    (block $done
+      (loop $l
+        (br_if $done (ref.is_null (local.get $cur)))
+        (local.set $next (struct.get $node 1 (local.get $cur)))
+        (struct.set $node 1 (local.get $cur) (local.get $prev))
+        (local.set $prev (local.get $cur))
+        (local.set $cur (local.get $next))
+        (drop (struct.new $node (i32.const -1) (ref.null $node)))
+        (br $l)
+      )
+    )
+    (global.set $list (local.get $prev))
+  )
+
+  (func (export "clear")
+    (global.set $list (ref.null $node))
+  )
+)
@@ -0,0 +1,54 @@
+(module
+  (type $box (struct (field (mut i32))))
+  (type $holder (struct (field (mut (ref null $box)))))
+  (type $boxes (array (mut (ref null $box))))
+
+  (global $old_struct (mut (ref null $holder)) (ref.null $holder))
+  (global $old_array (mut (ref null $boxes)) (ref.null $boxes))
+
+  (func (export "init")
+    (global.set $old_struct (struct.new_default $holder))
+    (global.set $old_array (array.new_default $boxes (i32.const 8)))
+  )
+
+  (func (export "store_struct") (param $v i32)
+    (struct.set $holder 0 (global.get $old_struct)
+      (struct.new $box (local.get $v)))
+  )
+
+  (func (export "store_array") (param $i i32) (param $v i32)
+    (array.set $boxes (global.get $old_array) (local.get $i)
+      (struct.new $box (local.get $v)))
+  )
+
+  (func (export "fill_array") (param $i i32) (param $v i32) (param $n i32)
+    (array.fill $boxes (global.get $old_array) (local.get $i)
+      (struct.new $box (local.get $v)) (local.get $n))
+  )
+
+  (func (export "copy_array") (param $i i32) (param $v i32)
+    (local $young (ref null $boxes))
+    (local.set $young
+      (array.new $boxes (struct.new $box (local.get $v)) (i32.const 2)))
+    (array.copy $boxes $boxes (global.get $old_array) (local.get $i)
+      (local.get $young) (i32.const 0) (i32.const 2))
+  )
+
+  (func (export "churn") (param $n i32)
+    (loop $l
+      (drop (struct.new $box (i32.const -1)))
+      (drop (array.new_default $boxes (i32.const 16)))
+      (br_if $l (local.tee $n (i32.sub (local.get $n) (i32.const 1))))
+    )
+  )
+
+  (func (export "get_struct") (result i32)
+    (struct.get $box 0
+      (struct.get $holder 0 (global.get $old_struct)))
+  )
+
+  (func (export "get_array") (param $i i32) (result i32)
+    (struct.get $box 0
+      (array.get $boxes (global.get $old_array) (local.get $i)))
+  )
+)
@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "gtest/gtest.h"
+#include "wasm_runtime_common.h"
+#include "wasm_runtime.h"
+#include "bh_platform.h"
+
+#include "wasm-apps/lazy_wasm.h"
+
+/* The indexes of the functions of the test module */
+#define SUM_FUNC 0
+#define INVALID_FUNC 1
+
+#define THREAD_NUM 8
+
+static void
+put_uleb(std::vector<uint8> &buf, uint32 value)
+{
+    do {
+        uint8 byte = value & 0x7F;
+
+        value >>= 7;
+        buf.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+}
+
+/* Generate a module exporting the sum function of the test module, with its
+   body padded by nops so that preparing it takes long enough for the threads
+   to run into each other */
+static std::vector<uint8>
+generate_padded_module(uint32 pad)
+{
+    static const uint8 sections[] = {
+        0x00, 'a', 's', 'm', 0x01, 0x00, 0x00, 0x00,
+        /* type section: (i32) -> i32 */
+        0x01, 0x06, 0x01, 0x60, 0x01, 0x7F, 0x01, 0x7F,
+        /* function section */
+        0x03, 0x02, 0x01, 0x00,
+        /* export section: "sum" */
+        0x07, 0x07, 0x01, 0x03, 's', 'u', 'm', 0x00, 0x00,
+    };
+    static const uint8 sum_code[] = {
+        0x02, 0x40, 0x03, 0x40, 0x20, 0x00, 0x45, 0x0D, 0x01, 0x20,
+        0x01, 0x20, 0x00, 0x6A, 0x21, 0x01, 0x20, 0x00, 0x41, 0x01,
+        0x6B, 0x21, 0x00, 0x0C, 0x00, 0x0B, 0x0B, 0x20, 0x01, 0x0B,
+    };
+    std::vector<uint8> buf(sections, sections + sizeof(sections)), body,
+        payload;
+
+    /* one i32 local */
+    body = { 0x01, 0x01, 0x7F };
+    body.insert(body.end(), pad, 0x01);
+    body.insert(body.end(), sum_code, sum_code + sizeof(sum_code));
+
+    payload = { 0x01 };
+    put_uleb(payload, (uint32)body.size());
+    payload.insert(payload.end(), body.begin(), body.end());
+
+    buf.push_back(0x0A);
+    put_uleb(buf, (uint32)payload.size());
+    buf.insert(buf.end(), payload.begin(), payload.end());
+    return buf;
+}
+
+class LazyLoaderTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_Pool;
+        init_args.mem_alloc_option.pool.heap_buf = global_heap_buf;
+        init_args.mem_alloc_option.pool.heap_size = sizeof(global_heap_buf);
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+    }
+
+    virtual void TearDown()
+    {
+        for (int i = 0; i < 2; i++) {
+            if (exec_envs[i])
+                wasm_runtime_destroy_exec_env(exec_envs[i]);
+            if (module_insts[i])
+                wasm_runtime_deinstantiate(module_insts[i]);
+            if (modules[i])
+                wasm_runtime_unload(modules[i]);
+        }
+        wasm_runtime_destroy();
+    }
+
+    /* Load and instantiate the i-th module from a copy of its binary, the
+       functions of each module are prepared separately */
+    void load(int i, const std::vector<uint8> &wasm)
+    {
+        bufs[i] = wasm;
+        modules[i] = wasm_runtime_load(bufs[i].data(), (uint32)bufs[i].size(),
+                                       error_buf, sizeof(error_buf));
+        ASSERT_TRUE(modules[i] != NULL) << error_buf;
+        module_insts[i] = wasm_runtime_instantiate(
+            modules[i], 8192, 0, error_buf, sizeof(error_buf));
+        ASSERT_TRUE(module_insts[i] != NULL) << error_buf;
+        exec_envs[i] = wasm_runtime_create_exec_env(module_insts[i], 8192);
+        ASSERT_TRUE(exec_envs[i] != NULL);
+    }
+
+    std::vector<uint8> lazy_wasm_buf()
+    {
+        return std::vector<uint8>(lazy_wasm, lazy_wasm + sizeof(lazy_wasm));
+    }
+
+    WASMFunction *function(int i, uint32 func_idx)
+    {
+        return ((WASMModule *)modules[i])->functions[func_idx];
+    }
+
+    uint32 free_size()
+    {
+        mem_alloc_info_t info;
+
+        EXPECT_TRUE(wasm_runtime_get_mem_alloc_info(&info));
+        return info.total_free_size;
+    }
+
+    /* Call sum(n) of a module instance in a new exec env of the current
+       thread */
+    static bool call_sum(wasm_module_inst_t module_inst, uint32 n,
+                         uint32 *p_result)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, "sum");
+        wasm_exec_env_t exec_env;
+        uint32 argv[1] = { n };
+        bool ret;
+
+        if (!func
+            || !(exec_env = wasm_runtime_create_exec_env(module_inst, 8192)))
+            return false;
+        ret = wasm_runtime_call_wasm(exec_env, func, 1, argv);
+        wasm_runtime_destroy_exec_env(exec_env);
+        *p_result = argv[0];
+        return ret;
+    }
+
+  public:
+    char global_heap_buf[512 * 1024];
+    std::vector<uint8> bufs[2];
+    wasm_module_t modules[2] = { NULL, NULL };
+    wasm_module_inst_t module_insts[2] = { NULL, NULL };
+    wasm_exec_env_t exec_envs[2] = { NULL, NULL };
+    char error_buf[128];
+};
+
+/* An invalid function body doesn't fail the load, the valid functions run */
+TEST_F(LazyLoaderTest, invalid_function_loads)
+{
+    uint32 result;
+
+    ASSERT_NO_FATAL_FAILURE(load(0, lazy_wasm_buf()));
+    EXPECT_FALSE(BH_ATOMIC_32_LOAD(function(0, SUM_FUNC)->is_prepared));
+    EXPECT_FALSE(BH_ATOMIC_32_LOAD(function(0, INVALID_FUNC)->is_prepared));
+
+    ASSERT_TRUE(call_sum(module_insts[0], 100, &result))
+        << wasm_runtime_get_exception(module_insts[0]);
+    EXPECT_EQ(5050u, result);
+    EXPECT_TRUE(BH_ATOMIC_32_LOAD(function(0, SUM_FUNC)->is_prepared));
+    EXPECT_FALSE(BH_ATOMIC_32_LOAD(function(0, INVALID_FUNC)->is_prepared));
+}
+
+/* The invalid function fails when it is called, directly or by another
+   function, with the error of validating it, which is kept */
+TEST_F(LazyLoaderTest, invalid_function_fails_on_call)
+{
+    const char *names[] = { "invalid", "call_invalid", "invalid" };
+    const char *exception;
+    WASMFunction *wasm_func;
+    uint32 argv[1];
+
+    ASSERT_NO_FATAL_FAILURE(load(0, lazy_wasm_buf()));
+
+    for (const char *name : names) {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_insts[0], name);
+
+        ASSERT_TRUE(func != NULL) << name;
+        EXPECT_FALSE(wasm_runtime_call_wasm(exec_envs[0], func, 0, argv));
+        exception = wasm_runtime_get_exception(module_insts[0]);
+        ASSERT_TRUE(exception != NULL) << name;
+        EXPECT_STREQ("Exception: invalid function 1: type mismatch: "
+                     "expect data but stack was empty",
+                     exception);
+        wasm_runtime_clear_exception(module_insts[0]);
+
+        wasm_func = function(0, INVALID_FUNC);
+        EXPECT_FALSE(BH_ATOMIC_32_LOAD(wasm_func->is_prepared));
+        EXPECT_TRUE(wasm_func->prepare_error != NULL);
+    }
+}
+
+/* Threads calling a function for the first time at once prepare it once:
+   they use as much memory as a single call does */
+TEST_F(LazyLoaderTest, concurrent_first_calls_prepare_once)
+{
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false), failed(false);
+    std::vector<std::thread> threads;
+    uint32 size_before, single_size, result;
+
+    std::vector<uint8> wasm = generate_padded_module(4 * 1024 * 1024);
+
+    ASSERT_NO_FATAL_FAILURE(load(0, wasm));
+    ASSERT_NO_FATAL_FAILURE(load(1, wasm));
+
+    size_before = free_size();
+    ASSERT_TRUE(call_sum(module_insts[0], 100, &result));
+    EXPECT_EQ(5050u, result);
+    single_size = size_before - free_size();
+    EXPECT_GT(single_size, 0u);
+
+    size_before = free_size();
+    for (int i = 0; i < THREAD_NUM; i++) {
+        threads.emplace_back([&]() {
+            bool thread_env_inited = wasm_runtime_init_thread_env();
+            uint32 thread_result = 0;
+
+            ready++;
+            while (!go.load())
+                std::this_thread::yield();
+            if (!thread_env_inited
+                || !call_sum(module_insts[1], 100, &thread_result)
+                || thread_result != 5050)
+                failed = true;
+            if (thread_env_inited)
+                wasm_runtime_destroy_thread_env();
+        });
+    }
+    while (ready.load() < THREAD_NUM)
+        std::this_thread::yield();
+    go = true;
+    for (std::thread &thread : threads)
+        thread.join();
+
+    EXPECT_FALSE(failed.load());
+    EXPECT_TRUE(BH_ATOMIC_32_LOAD(function(1, SUM_FUNC)->is_prepared));
+    EXPECT_EQ(single_size, size_before - free_size());
+}
@@ -0,0 +1,19 @@
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+readonly CURR_DIR=$PWD
+readonly BINARYDUMP_DIR=$PWD/../../../../test-tools/binarydump-tool
+readonly WAST2WASM="/opt/wabt/bin/wat2wasm"
+
+# build binarydump
+cd $BINARYDUMP_DIR
+mkdir -p build && cd build
+cmake .. && make -j
+cp -a binarydump $CURR_DIR
+
+cd $CURR_DIR
+
+## build lazy, which has an invalid function body
+$WAST2WASM --no-check -o lazy.wasm lazy.wast
+./binarydump -o lazy_wasm.h -n lazy_wasm lazy.wasm
+rm -f lazy.wasm
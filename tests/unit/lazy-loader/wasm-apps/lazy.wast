@@ -0,0 +1,16 @@
+(module
+  (func $sum (export "sum") (param i32) (result i32) (local i32)
+    (block
+      (loop
+        (br_if 1 (i32.eqz (local.get 0)))
+        (local.set 1 (i32.add (local.get 1) (local.get 0)))
+        (local.set 0 (i32.sub (local.get 0) (i32.const 1)))
+        (br 0)))
+    (local.get 1))
+  ;; invalid, i32.add pops from an empty stack
+  (func $invalid (export "invalid") (result i32)
+    i32.add
+    i32.const 0)
+  (func (export "call_invalid") (result i32)
+    (call $invalid))
+)
@@ -0,0 +1,16 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+static unsigned char lazy_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0A, 0x02, 0x60,
+    0x01, 0x7F, 0x01, 0x7F, 0x60, 0x00, 0x01, 0x7F, 0x03, 0x04, 0x03, 0x00,
+    0x01, 0x01, 0x07, 0x20, 0x03, 0x03, 0x73, 0x75, 0x6D, 0x00, 0x00, 0x07,
+    0x69, 0x6E, 0x76, 0x61, 0x6C, 0x69, 0x64, 0x00, 0x01, 0x0C, 0x63, 0x61,
+    0x6C, 0x6C, 0x5F, 0x69, 0x6E, 0x76, 0x61, 0x6C, 0x69, 0x64, 0x00, 0x02,
+    0x0A, 0x2E, 0x03, 0x21, 0x01, 0x01, 0x7F, 0x02, 0x40, 0x03, 0x40, 0x20,
+    0x00, 0x45, 0x0D, 0x01, 0x20, 0x01, 0x20, 0x00, 0x6A, 0x21, 0x01, 0x20,
+    0x00, 0x41, 0x01, 0x6B, 0x21, 0x00, 0x0C, 0x00, 0x0B, 0x0B, 0x20, 0x01,
+    0x0B, 0x05, 0x00, 0x6A, 0x41, 0x00, 0x0B, 0x04, 0x00, 0x10, 0x01, 0x0B
+};
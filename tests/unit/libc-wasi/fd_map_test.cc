@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <unistd.h>
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include "bh_read_file.h"
+#include "wasm_runtime_common.h"
+#include "wasmtime_ssp.h"
+
+static std::string CWD;
+
+static std::string
+get_binary_path()
+{
+    char cwd[1024];
+    memset(cwd, 0, 1024);
+
+    if (readlink("/proc/self/exe", cwd, 1024) <= 0) {
+    }
+
+    char *path_end = strrchr(cwd, '/');
+    if (path_end != NULL) {
+        *path_end = '\0';
+    }
+
+    return std::string(cwd);
+}
+
+class FdMapTest : public testing::Test
+{
+  protected:
+    static void SetUpTestCase() { CWD = get_binary_path(); }
+
+    virtual void SetUp()
+    {
+        std::string wasm_file = CWD + "/fd_map.wasm";
+        char file_path[] = "/tmp/fd_map_test_XXXXXX";
+        std::vector<uint8> content(2 * page_size);
+
+        // Two host pages, filled with 0x11 and 0x22
+        memset(content.data(), 0x11, page_size);
+        memset(content.data() + page_size, 0x22, page_size);
+        ASSERT_NE(-1, fd = mkstemp(file_path));
+        unlink(file_path);
+        ASSERT_EQ((ssize_t)content.size(),
+                  write(fd, content.data(), content.size()));
+
+        wasm_file_buf = (uint8 *)bh_read_file_to_buffer(wasm_file.c_str(),
+                                                        &wasm_file_size);
+        ASSERT_NE(nullptr, wasm_file_buf);
+        module = wasm_runtime_load(wasm_file_buf, wasm_file_size, error_buf,
+                                   sizeof(error_buf));
+        ASSERT_NE(nullptr, module) << error_buf;
+        // The file is the guest's fd 0, which gets the read right of a
+        // regular file
+        wasm_runtime_set_wasi_args_ex(module, NULL, 0, NULL, 0, NULL, 0, NULL,
+                                      0, fd, -1, -1);
+        module_inst = wasm_runtime_instantiate(module, 16 * 1024, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_NE(nullptr, module_inst) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(module_inst, 16 * 1024);
+        ASSERT_NE(nullptr, exec_env);
+    }
+
+    virtual void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        if (wasm_file_buf)
+            wasm_runtime_free(wasm_file_buf);
+        if (fd >= 0)
+            close(fd);
+    }
+
+    bool call_func(const char *name, uint32 argc, uint32 argv[])
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+
+        return func && wasm_runtime_call_wasm(exec_env, func, argc, argv);
+    }
+
+    uint32 call_map(uint64 offset, uint32 buf, uint32 len)
+    {
+        // fd 0 is the file passed as stdin
+        uint32 argv[5] = { 0, (uint32)offset, (uint32)(offset >> 32), buf,
+                           len };
+
+        EXPECT_TRUE(call_func("map", 5, argv));
+        return argv[0];
+    }
+
+    uint32 call_unmap(uint32 buf, uint32 len)
+    {
+        uint32 argv[2] = { buf, len };
+
+        EXPECT_TRUE(call_func("unmap", 2, argv));
+        return argv[0];
+    }
+
+    uint32 call_load(uint32 addr)
+    {
+        uint32 argv[1] = { addr };
+
+        EXPECT_TRUE(call_func("load", 1, argv));
+        return argv[0];
+    }
+
+  public:
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    uint32 page_size = (uint32)getpagesize();
+    int fd = -1;
+    uint8 *wasm_file_buf = nullptr;
+    uint32 wasm_file_size = 0;
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t module_inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+    char error_buf[128];
+};
+
+#if WASM_DISABLE_HW_BOUND_CHECK == 0
+TEST_F(FdMapTest, map_and_unmap)
+{
+    // Map both pages of the file at the second page of the linear memory
+    EXPECT_EQ(0, call_map(0, page_size, 2 * page_size));
+    EXPECT_EQ(0x11111111, call_load(page_size));
+    EXPECT_EQ(0x22222222, call_load(2 * page_size));
+
+    // The whole mapping is replaced with zeroed pages, once
+    EXPECT_EQ(0, call_unmap(page_size, 2 * page_size));
+    EXPECT_EQ(0, call_load(page_size));
+    EXPECT_EQ(0, call_load(2 * page_size));
+    EXPECT_EQ(__WASI_EINVAL, call_unmap(page_size, 2 * page_size));
+
+    // The range can be mapped again
+    EXPECT_EQ(0, call_map(page_size, page_size, page_size));
+    EXPECT_EQ(0x22222222, call_load(page_size));
+    EXPECT_EQ(0, call_unmap(page_size, page_size));
+}
+
+TEST_F(FdMapTest, invalid_ranges)
+{
+    uint32 argv[5];
+
+    EXPECT_EQ(0, call_map(0, page_size, 2 * page_size));
+
+    // Overlapping an existing mapping
+    EXPECT_EQ(__WASI_EINVAL, call_map(0, 2 * page_size, page_size));
+    // Unaligned destination and file offset
+    EXPECT_EQ(__WASI_EINVAL, call_map(0, 4 * page_size + 4, page_size));
+    EXPECT_EQ(__WASI_EINVAL, call_map(4, 4 * page_size, page_size));
+    // Past the last page of the file
+    EXPECT_EQ(__WASI_EINVAL, call_map(page_size, 4 * page_size, 2 * page_size));
+
+    // Past the end of the linear memory
+    argv[0] = 0;
+    argv[1] = argv[2] = 0;
+    argv[3] = 2 * 65536 - page_size;
+    argv[4] = 2 * page_size;
+    EXPECT_FALSE(call_func("map", 5, argv));
+    EXPECT_NE(nullptr, strstr(wasm_runtime_get_exception(module_inst),
+                              "out of bounds memory access"));
+    wasm_runtime_clear_exception(module_inst);
+
+    // Ranges that weren't mapped, or only a part of a mapping
+    EXPECT_EQ(__WASI_EINVAL, call_unmap(4 * page_size, page_size));
+    EXPECT_EQ(__WASI_EINVAL, call_unmap(page_size, page_size));
+    EXPECT_EQ(0x11111111, call_load(page_size));
+
+    EXPECT_EQ(0, call_unmap(page_size, 2 * page_size));
+}
+#else
+TEST_F(FdMapTest, not_supported)
+{
+    // The linear memory may move when it grows
+    EXPECT_NE(0, call_map(0, page_size, page_size));
+    EXPECT_NE(0, call_unmap(page_size, page_size));
+}
+#endif
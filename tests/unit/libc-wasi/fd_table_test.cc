@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include "wasmtime_ssp.h"
+extern "C" {
+#include "posix.h"
+}
+
+// The descriptor replaced by the churn thread, the one it builds the
+// replacement at, and one that is never modified
+#define CHURN_FD 10
+#define SPARE_FD 11
+#define STABLE_FD 12
+
+class FdTableTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        char live_template[] = "/tmp/fd_table_live_XXXXXX";
+        char trap_template[] = "/tmp/fd_table_trap_XXXXXX";
+        char stable_template[] = "/tmp/fd_table_stable_XXXXXX";
+        int fd;
+
+        ASSERT_TRUE(fd_table_init(&ft));
+        ASSERT_TRUE(fd_prestats_init(&prestats));
+        table_initialized = true;
+
+        ASSERT_NE(-1, fd = mkstemp(live_template));
+        close(fd);
+        live_path = live_template;
+        ASSERT_NE(-1, fd = mkstemp(trap_template));
+        close(fd);
+        trap_path = trap_template;
+        ASSERT_NE(-1, fd = mkstemp(stable_template));
+        stable_path = stable_template;
+        ASSERT_TRUE(fd_table_insert_existing(&ft, STABLE_FD, fd, false));
+        ASSERT_TRUE(fd_table_insert_existing(&ft, CHURN_FD, open_live(), false));
+    }
+
+    virtual void TearDown()
+    {
+        if (table_initialized) {
+            fd_table_destroy(&ft);
+            fd_prestats_destroy(&prestats);
+        }
+        for (const std::string &path : { live_path, trap_path, stable_path })
+            if (!path.empty())
+                unlink(path.c_str());
+    }
+
+    int open_live() { return open(live_path.c_str(), O_WRONLY | O_APPEND); }
+
+    off_t file_size(const std::string &path)
+    {
+        struct stat st;
+
+        EXPECT_EQ(0, stat(path.c_str(), &st));
+        return st.st_size;
+    }
+
+    __wasi_errno_t write_byte(__wasi_fd_t fd)
+    {
+        char c = 'x';
+        __wasi_ciovec_t iov = { (const uint8_t *)&c, 1 };
+        size_t nwritten = 0;
+        __wasi_errno_t error =
+            wasmtime_ssp_fd_write(NULL, &ft, fd, &iov, 1, &nwritten);
+
+        EXPECT_TRUE(error != 0 || nwritten == 1);
+        return error;
+    }
+
+    // Replace the object of CHURN_FD by closing it or by renumbering a
+    // new one over it. The released object's host descriptor number is
+    // then taken by the trap file while no descriptor refers to it.
+    void churn(bool use_close)
+    {
+        int trap;
+
+        if (use_close) {
+            ASSERT_EQ(0, wasmtime_ssp_fd_close(NULL, &ft, &prestats, CHURN_FD));
+            ASSERT_NE(-1, trap = open(trap_path.c_str(), O_WRONLY | O_APPEND));
+            ASSERT_TRUE(
+                fd_table_insert_existing(&ft, CHURN_FD, open_live(), false));
+        }
+        else {
+            ASSERT_TRUE(
+                fd_table_insert_existing(&ft, SPARE_FD, open_live(), false));
+            ASSERT_EQ(0, wasmtime_ssp_fd_renumber(NULL, &ft, &prestats,
+                                                  SPARE_FD, CHURN_FD));
+            ASSERT_NE(-1, trap = open(trap_path.c_str(), O_WRONLY | O_APPEND));
+        }
+        close(trap);
+    }
+
+  public:
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    struct fd_table ft;
+    struct fd_prestats prestats;
+    bool table_initialized = false;
+    std::string live_path, trap_path, stable_path;
+};
+
+// Lock-free lookups race with close and renumber of the same descriptor.
+// Every write must go through an object that the descriptor referred to,
+// never through a released one: those have their host descriptor closed,
+// and the churn thread reopens it as the trap file, which must stay empty.
+TEST_F(FdTableTest, lookups_race_with_close_and_renumber)
+{
+    const int n_threads = 4, n_rounds = 20000;
+    std::atomic<bool> done(false);
+    std::atomic<uint64> churn_written(0), stable_written(0);
+    std::vector<std::thread> threads;
+
+    for (int i = 0; i < n_threads; i++) {
+        threads.emplace_back([&]() {
+            while (!done.load()) {
+                __wasi_errno_t error = write_byte(CHURN_FD);
+
+                // Closed between the two steps of a round
+                if (error == 0)
+                    churn_written++;
+                else
+                    EXPECT_EQ(__WASI_EBADF, error);
+                EXPECT_EQ(0, write_byte(STABLE_FD));
+                stable_written++;
+            }
+        });
+    }
+
+    for (int round = 0; round < n_rounds && !HasFatalFailure(); round++)
+        churn(round % 2 == 0);
+
+    done = true;
+    for (std::thread &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(0, file_size(trap_path));
+    EXPECT_EQ((off_t)churn_written.load(), file_size(live_path));
+    EXPECT_EQ((off_t)stable_written.load(), file_size(stable_path));
+    EXPECT_GT(churn_written.load(), 0u);
+}
@@ -0,0 +1,16 @@
+(module
+  (import "wasi_snapshot_preview1" "fd_map"
+    (func $fd_map (param i32 i64 i32 i32) (result i32)))
+  (import "wasi_snapshot_preview1" "fd_unmap"
+    (func $fd_unmap (param i32 i32) (result i32)))
+  (memory (export "memory") 2)
+  (func (export "map") (param i32 i64 i32 i32) (result i32)
+    (call $fd_map (local.get 0) (local.get 1) (local.get 2) (local.get 3))
+  )
+  (func (export "unmap") (param i32 i32) (result i32)
+    (call $fd_unmap (local.get 0) (local.get 1))
+  )
+  (func (export "load") (param i32) (result i32)
+    (i32.load (local.get 0))
+  )
+)
@@ -0,0 +1,232 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "wasm_runtime_common.h"
+#include "bh_platform.h"
+
+#include "wasm-apps/call_indirect_wasm.h"
+
+/* The elements of the table of the test module */
+#define ELEM_ADD 0
+#define ELEM_FAIL 1
+#define ELEM_MUL 2
+#define ELEM_NULL 3
+#define ELEM_NUM 4
+
+static int add_attachment, fail_attachment;
+
+/* Check that the host functions are called with their own attachments */
+static int32
+add_wrapper(wasm_exec_env_t exec_env, int32 a, int32 b)
+{
+    if (wasm_runtime_get_function_attachment(exec_env) != &add_attachment) {
+        wasm_runtime_set_exception(wasm_runtime_get_module_inst(exec_env),
+                                   "wrong attachment");
+        return 0;
+    }
+    return a + b;
+}
+
+static int32
+fail_wrapper(wasm_exec_env_t exec_env, int32 a)
+{
+    char buf[32];
+
+    if (wasm_runtime_get_function_attachment(exec_env) != &fail_attachment)
+        snprintf(buf, sizeof(buf), "wrong attachment");
+    else
+        snprintf(buf, sizeof(buf), "failed with %d", a);
+    wasm_runtime_set_exception(wasm_runtime_get_module_inst(exec_env), buf);
+    return 0;
+}
+
+static NativeSymbol call_indirect_native_symbols[] = {
+    { "add", (void *)add_wrapper, "(ii)i", &add_attachment },
+    { "fail", (void *)fail_wrapper, "(i)i", &fail_attachment },
+};
+
+/* Run the test module in LLVM JIT mode, its call_indirect of the imports
+   calls the host functions without entering the interpreter */
+class LLVMJITCallIndirectTest : public testing::Test
+{
+  protected:
+    /* LLVM is shut down when the runtime is destroyed and can't be
+       initialized again in the same process, so the runtime is kept for
+       all the tests */
+    static void SetUpTestCase()
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        init_args.running_mode = Mode_LLVM_JIT;
+        init_args.llvm_jit_opt_level = 3;
+        init_args.llvm_jit_size_level = 3;
+        init_args.native_module_name = "env";
+        init_args.native_symbols = call_indirect_native_symbols;
+        init_args.n_native_symbols =
+            sizeof(call_indirect_native_symbols) / sizeof(NativeSymbol);
+        initialized = wasm_runtime_full_init(&init_args);
+    }
+
+    static void TearDownTestCase()
+    {
+        if (initialized)
+            wasm_runtime_destroy();
+    }
+
+    virtual void SetUp()
+    {
+        ASSERT_TRUE(initialized);
+
+        buf.assign(call_indirect_wasm,
+                   call_indirect_wasm + sizeof(call_indirect_wasm));
+        module = wasm_runtime_load(buf.data(), (uint32)buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_TRUE(module != NULL) << error_buf;
+        module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                               sizeof(error_buf));
+        ASSERT_TRUE(module_inst != NULL) << error_buf;
+        ASSERT_EQ(Mode_LLVM_JIT, wasm_runtime_get_running_mode(module_inst));
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+        ASSERT_TRUE(exec_env != NULL);
+    }
+
+    virtual void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    /* Call the element of the table with the binop type */
+    bool call_binop(uint32 elem_idx, int32 a, int32 b)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, "call_binop");
+        uint32 argv[3] = { elem_idx, (uint32)a, (uint32)b };
+
+        EXPECT_TRUE(func != NULL);
+        if (!func || !wasm_runtime_call_wasm(exec_env, func, 3, argv))
+            return false;
+        result = (int32)argv[0];
+        return true;
+    }
+
+    /* Call the element of the table with the unop type */
+    bool call_unop(uint32 elem_idx, int32 a)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, "call_unop");
+        uint32 argv[2] = { elem_idx, (uint32)a };
+
+        EXPECT_TRUE(func != NULL);
+        if (!func || !wasm_runtime_call_wasm(exec_env, func, 2, argv))
+            return false;
+        result = (int32)argv[0];
+        return true;
+    }
+
+    /* Expect the last call to have failed with the exception */
+    void expect_exception(const char *expected)
+    {
+        const char *exception = wasm_runtime_get_exception(module_inst);
+
+        ASSERT_TRUE(exception != NULL);
+        EXPECT_STREQ(expected, exception);
+        wasm_runtime_clear_exception(module_inst);
+    }
+
+    wasm_instance_stats_t get_stats()
+    {
+        wasm_instance_stats_t stats;
+
+        EXPECT_TRUE(wasm_runtime_get_instance_stats(module_inst, &stats));
+        return stats;
+    }
+
+  public:
+    static bool initialized;
+    std::vector<uint8> buf;
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    wasm_exec_env_t exec_env = NULL;
+    char error_buf[128];
+    int32 result = 0;
+};
+
+bool LLVMJITCallIndirectTest::initialized = false;
+
+/* The host function is called through the quick native entry of its
+   signature with its attachment, and returns to the jitted code */
+TEST_F(LLVMJITCallIndirectTest, host_function)
+{
+    wasm_instance_stats_t stats;
+    uint32 i;
+
+    for (i = 0; i < 100; i++) {
+        ASSERT_TRUE(call_binop(ELEM_ADD, (int32)i, -7))
+            << wasm_runtime_get_exception(module_inst);
+        EXPECT_EQ((int32)i - 7, result);
+    }
+
+    stats = get_stats();
+    EXPECT_EQ(100u, stats.jit_entry_count);
+    EXPECT_EQ(100u, stats.jit_exit_count);
+    EXPECT_EQ(100u, stats.host_call_count);
+    EXPECT_EQ(0u, stats.jit_slow_transition_count);
+}
+
+/* A wasm function of the table is called by the jitted code itself */
+TEST_F(LLVMJITCallIndirectTest, wasm_function)
+{
+    wasm_instance_stats_t stats;
+
+    ASSERT_TRUE(call_binop(ELEM_MUL, 6, -7))
+        << wasm_runtime_get_exception(module_inst);
+    EXPECT_EQ(-42, result);
+
+    stats = get_stats();
+    EXPECT_EQ(1u, stats.jit_entry_count);
+    EXPECT_EQ(0u, stats.jit_exit_count);
+    EXPECT_EQ(0u, stats.host_call_count);
+}
+
+/* The exception raised by the host function unwinds the jitted code */
+TEST_F(LLVMJITCallIndirectTest, host_exception)
+{
+    EXPECT_FALSE(call_unop(ELEM_FAIL, 5));
+    expect_exception("Exception: failed with 5");
+
+    /* the instance is still usable */
+    ASSERT_TRUE(call_binop(ELEM_ADD, 1, 2))
+        << wasm_runtime_get_exception(module_inst);
+    EXPECT_EQ(3, result);
+}
+
+/* The type of the element is checked before the host function is called,
+   and the index is checked against the table */
+TEST_F(LLVMJITCallIndirectTest, type_and_element_checks)
+{
+    EXPECT_FALSE(call_binop(ELEM_FAIL, 1, 2));
+    expect_exception("Exception: indirect call type mismatch");
+    EXPECT_FALSE(call_unop(ELEM_ADD, 1));
+    expect_exception("Exception: indirect call type mismatch");
+    EXPECT_FALSE(call_unop(ELEM_MUL, 1));
+    expect_exception("Exception: indirect call type mismatch");
+
+    EXPECT_FALSE(call_binop(ELEM_NULL, 1, 2));
+    expect_exception("Exception: uninitialized element");
+    EXPECT_FALSE(call_binop(ELEM_NUM, 1, 2));
+    expect_exception("Exception: undefined element");
+
+    /* none of the host functions was called */
+    EXPECT_EQ(0u, get_stats().host_call_count);
+}
@@ -0,0 +1,19 @@
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+readonly CURR_DIR=$PWD
+readonly BINARYDUMP_DIR=$PWD/../../../../test-tools/binarydump-tool
+readonly WAST2WASM="/opt/wabt/bin/wat2wasm"
+
+# build binarydump
+cd $BINARYDUMP_DIR
+mkdir -p build && cd build
+cmake .. && make -j
+cp -a binarydump $CURR_DIR
+
+cd $CURR_DIR
+
+## build call_indirect
+$WAST2WASM -o call_indirect.wasm call_indirect.wast
+./binarydump -o call_indirect_wasm.h -n call_indirect_wasm call_indirect.wasm
+rm -f call_indirect.wasm
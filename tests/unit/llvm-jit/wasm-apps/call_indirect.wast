@@ -0,0 +1,16 @@
+(module
+  (type $binop (func (param i32 i32) (result i32)))
+  (type $unop (func (param i32) (result i32)))
+  (import "env" "add" (func $add (type $binop)))
+  (import "env" "fail" (func $fail (type $unop)))
+  (table 4 funcref)
+  (elem (i32.const 0) $add $fail $mul)
+  (func $mul (type $binop)
+    (i32.mul (local.get 0) (local.get 1)))
+  ;; call the binop at the index of the table
+  (func (export "call_binop") (param i32 i32 i32) (result i32)
+    (call_indirect (type $binop) (local.get 1) (local.get 2) (local.get 0)))
+  ;; call the unop at the index of the table
+  (func (export "call_unop") (param i32 i32) (result i32)
+    (call_indirect (type $unop) (local.get 1) (local.get 0)))
+)
@@ -0,0 +1,19 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+static unsigned char call_indirect_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x13, 0x03, 0x60,
+    0x02, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x60, 0x03,
+    0x7F, 0x7F, 0x7F, 0x01, 0x7F, 0x02, 0x16, 0x02, 0x03, 0x65, 0x6E, 0x76,
+    0x03, 0x61, 0x64, 0x64, 0x00, 0x00, 0x03, 0x65, 0x6E, 0x76, 0x04, 0x66,
+    0x61, 0x69, 0x6C, 0x00, 0x01, 0x03, 0x04, 0x03, 0x00, 0x02, 0x00, 0x04,
+    0x04, 0x01, 0x70, 0x00, 0x04, 0x07, 0x1A, 0x02, 0x0A, 0x63, 0x61, 0x6C,
+    0x6C, 0x5F, 0x62, 0x69, 0x6E, 0x6F, 0x70, 0x00, 0x03, 0x09, 0x63, 0x61,
+    0x6C, 0x6C, 0x5F, 0x75, 0x6E, 0x6F, 0x70, 0x00, 0x04, 0x09, 0x09, 0x01,
+    0x00, 0x41, 0x00, 0x0B, 0x03, 0x00, 0x01, 0x02, 0x0A, 0x1F, 0x03, 0x07,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0x6C, 0x0B, 0x0B, 0x00, 0x20, 0x01, 0x20,
+    0x02, 0x20, 0x00, 0x11, 0x00, 0x00, 0x0B, 0x09, 0x00, 0x20, 0x01, 0x20,
+    0x00, 0x11, 0x01, 0x00, 0x0B
+};
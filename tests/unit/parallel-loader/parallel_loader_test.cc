@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "wasm_runtime_common.h"
+#include "bh_platform.h"
+
+/* Enough functions, each padded with nops, for a code section larger than
+   the one prepared by the loading thread alone */
+#define FUNC_NUM 2048
+#define FUNC_PAD 32
+#define HELPER_THREAD_NUM 4
+
+/* The kinds of the function bodies generated */
+enum {
+    BODY_VALID,
+    /* local.get of a function without locals */
+    BODY_UNKNOWN_LOCAL,
+    /* i32.add with an empty stack */
+    BODY_TYPE_MISMATCH,
+};
+
+static void
+put_uleb(std::vector<uint8> &buf, uint32 value)
+{
+    do {
+        uint8 byte = value & 0x7F;
+
+        value >>= 7;
+        buf.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+}
+
+static void
+put_sleb(std::vector<uint8> &buf, int32 value)
+{
+    bool more;
+
+    do {
+        uint8 byte = value & 0x7F;
+
+        value >>= 7;
+        more = !((value == 0 && !(byte & 0x40))
+                 || (value == -1 && (byte & 0x40)));
+        buf.push_back(more ? byte | 0x80 : byte);
+    } while (more);
+}
+
+static void
+put_section(std::vector<uint8> &buf, uint8 id,
+            const std::vector<uint8> &payload)
+{
+    buf.push_back(id);
+    put_uleb(buf, (uint32)payload.size());
+    buf.insert(buf.end(), payload.begin(), payload.end());
+}
+
+/* Generate a module of FUNC_NUM functions of type () -> i32, function i
+   returns i * 3 and is exported as "f<i>" if it is the first, the middle or
+   the last one. bodies maps the indexes of the invalid functions to their
+   kinds. */
+static std::vector<uint8>
+generate_module(const std::vector<std::pair<uint32, int>> &bodies = {})
+{
+    static const uint8 header[] = {
+        0x00, 'a', 's', 'm', 0x01, 0x00, 0x00, 0x00
+    };
+    std::vector<uint8> buf(header, header + sizeof(header)), payload, body;
+    const uint32 exports[] = { 0, FUNC_NUM / 2, FUNC_NUM - 1 };
+    std::string name;
+    uint32 i;
+    int kind;
+
+    payload = { 0x01, 0x60, 0x00, 0x01, 0x7F };
+    put_section(buf, 1, payload);
+
+    payload.clear();
+    put_uleb(payload, FUNC_NUM);
+    payload.insert(payload.end(), FUNC_NUM, 0x00);
+    put_section(buf, 3, payload);
+
+    payload.clear();
+    put_uleb(payload, sizeof(exports) / sizeof(uint32));
+    for (uint32 index : exports) {
+        name = "f" + std::to_string(index);
+        put_uleb(payload, (uint32)name.size());
+        payload.insert(payload.end(), name.begin(), name.end());
+        payload.push_back(0x00);
+        put_uleb(payload, index);
+    }
+    put_section(buf, 7, payload);
+
+    payload.clear();
+    put_uleb(payload, FUNC_NUM);
+    for (i = 0; i < FUNC_NUM; i++) {
+        kind = BODY_VALID;
+        for (const auto &bad : bodies)
+            if (bad.first == i)
+                kind = bad.second;
+
+        /* no locals */
+        body = { 0x00 };
+        body.insert(body.end(), FUNC_PAD, 0x01);
+        if (kind == BODY_UNKNOWN_LOCAL)
+            body.insert(body.end(), { 0x20, 0x00 });
+        else if (kind == BODY_TYPE_MISMATCH)
+            body.push_back(0x6A);
+        body.push_back(0x41);
+        put_sleb(body, (int32)(i * 3));
+        body.push_back(0x0B);
+
+        put_uleb(payload, (uint32)body.size());
+        payload.insert(payload.end(), body.begin(), body.end());
+    }
+    put_section(buf, 10, payload);
+
+    return buf;
+}
+
+class ParallelLoaderTest : public testing::Test
+{
+  protected:
+    virtual void TearDown()
+    {
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        if (initialized)
+            wasm_runtime_destroy();
+    }
+
+    void init(uint32 helper_thread_num)
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        init_args.loader_helper_thread_num = helper_thread_num;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+        initialized = true;
+    }
+
+    void destroy()
+    {
+        wasm_runtime_destroy();
+        initialized = false;
+    }
+
+    /* Load a copy of the binary, which is kept until the module is
+       unloaded */
+    bool load(const std::vector<uint8> &wasm)
+    {
+        buf = wasm;
+        module = wasm_runtime_load(buf.data(), (uint32)buf.size(), error_buf,
+                                   sizeof(error_buf));
+        return module != NULL;
+    }
+
+    /* The error of loading the binary without and with the helpers, which
+       must be the same */
+    std::string load_error(const std::vector<uint8> &wasm)
+    {
+        std::string sequential_error;
+
+        init(0);
+        EXPECT_FALSE(load(wasm));
+        sequential_error = error_buf;
+        destroy();
+
+        init(HELPER_THREAD_NUM);
+        EXPECT_FALSE(load(wasm));
+        EXPECT_EQ(sequential_error, error_buf);
+        return error_buf;
+    }
+
+    /* Call an exported function, returning -1 if it fails */
+    int32 call(uint32 index)
+    {
+        std::string name = "f" + std::to_string(index);
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name.c_str());
+        wasm_exec_env_t exec_env =
+            wasm_runtime_get_exec_env_singleton(module_inst);
+        wasm_val_t result;
+
+        EXPECT_TRUE(func != NULL) << name;
+        if (!func || !wasm_runtime_call_wasm_a(exec_env, func, 1, &result, 0,
+                                               NULL))
+            return -1;
+        return result.of.i32;
+    }
+
+  public:
+    bool initialized = false;
+    std::vector<uint8> buf;
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    char error_buf[128];
+};
+
+TEST_F(ParallelLoaderTest, valid_module_runs)
+{
+    std::vector<uint8> wasm = generate_module();
+
+    ASSERT_GE(wasm.size(), 64u * 1024);
+    ASSERT_NO_FATAL_FAILURE(init(HELPER_THREAD_NUM));
+    ASSERT_TRUE(load(wasm)) << error_buf;
+    module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                           sizeof(error_buf));
+    ASSERT_TRUE(module_inst != NULL) << error_buf;
+
+    EXPECT_EQ(0, call(0));
+    EXPECT_EQ(FUNC_NUM / 2 * 3, call(FUNC_NUM / 2));
+    EXPECT_EQ((FUNC_NUM - 1) * 3, call(FUNC_NUM - 1));
+}
+
+/* The last function is validated too, though it may be left to a helper */
+TEST_F(ParallelLoaderTest, invalid_last_function_fails)
+{
+    std::string error = load_error(
+        generate_module({ { FUNC_NUM - 1, BODY_UNKNOWN_LOCAL } }));
+
+    EXPECT_NE(std::string::npos, error.find("unknown local")) << error;
+}
+
+/* Whichever thread finds its error first, the one of the lowest function
+   index is reported */
+TEST_F(ParallelLoaderTest, lowest_invalid_function_is_reported)
+{
+    std::string error;
+
+    error = load_error(generate_module(
+        { { FUNC_NUM - 600, BODY_TYPE_MISMATCH },
+          { FUNC_NUM - 1, BODY_UNKNOWN_LOCAL } }));
+    EXPECT_NE(std::string::npos, error.find("type mismatch")) << error;
+
+    destroy();
+
+    error = load_error(generate_module(
+        { { FUNC_NUM - 600, BODY_UNKNOWN_LOCAL },
+          { FUNC_NUM - 1, BODY_TYPE_MISMATCH } }));
+    EXPECT_NE(std::string::npos, error.find("unknown local")) << error;
+}
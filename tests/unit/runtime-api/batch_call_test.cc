@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "calls_module_test.h"
+
+class BatchCallTest : public CallsModuleTest
+{};
+
+TEST_F(BatchCallTest, all_calls_succeed)
+{
+    wasm_function_inst_t func = lookup("add");
+    uint32 args[2 * 100], results[100];
+    bool failed[100];
+    uint32 i;
+
+    ASSERT_TRUE(func != NULL);
+    for (i = 0; i < 100; i++) {
+        args[2 * i] = i;
+        args[2 * i + 1] = 1000;
+        failed[i] = true;
+    }
+
+    EXPECT_EQ(wasm_runtime_call_wasm_batch(exec_env, func, 100, args, results,
+                                           failed),
+              0);
+    for (i = 0; i < 100; i++) {
+        EXPECT_EQ(results[i], i + 1000);
+        EXPECT_FALSE(failed[i]);
+    }
+    EXPECT_TRUE(wasm_runtime_get_exception(module_inst) == NULL);
+}
+
+TEST_F(BatchCallTest, traps_in_the_middle)
+{
+    wasm_function_inst_t func = lookup("div");
+    uint32 args[] = { 10, 2, 7, 0, 9, 3, 0x80000000, (uint32)-1, 8, 4 };
+    uint32 results[5] = { 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF,
+                          0xDEADBEEF };
+    bool failed[5];
+
+    ASSERT_TRUE(func != NULL);
+    EXPECT_EQ(
+        wasm_runtime_call_wasm_batch(exec_env, func, 5, args, results, failed),
+        2);
+
+    /* the calls after a trap still run */
+    EXPECT_FALSE(failed[0]);
+    EXPECT_TRUE(failed[1]);
+    EXPECT_FALSE(failed[2]);
+    EXPECT_TRUE(failed[3]);
+    EXPECT_FALSE(failed[4]);
+    EXPECT_EQ(results[0], 5);
+    EXPECT_EQ(results[1], 0xDEADBEEF);
+    EXPECT_EQ(results[2], 3);
+    EXPECT_EQ(results[3], 0xDEADBEEF);
+    EXPECT_EQ(results[4], 2);
+
+    /* the exception of the last failed call is restored */
+    EXPECT_STREQ(wasm_runtime_get_exception(module_inst),
+                 "Exception: integer overflow");
+
+    /* the failed array is optional, and the next batch works */
+    wasm_runtime_clear_exception(module_inst);
+    EXPECT_EQ(
+        wasm_runtime_call_wasm_batch(exec_env, func, 3, args, results, NULL),
+        1);
+    EXPECT_STREQ(wasm_runtime_get_exception(module_inst),
+                 "Exception: integer divide by zero");
+    wasm_runtime_clear_exception(module_inst);
+    EXPECT_EQ(
+        wasm_runtime_call_wasm_batch(exec_env, func, 1, args + 4, results, NULL),
+        0);
+    EXPECT_EQ(results[0], 3);
+}
+
+TEST_F(BatchCallTest, proc_exit_stops_the_batch)
+{
+    wasm_function_inst_t func = lookup("stop_if");
+    uint32 args[] = { 0, 3, STOP_PROC_EXIT, 0, 0 };
+    uint32 results[5] = { 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF,
+                          0xDEADBEEF };
+    bool failed[5];
+
+    ASSERT_TRUE(func != NULL);
+    EXPECT_EQ(
+        wasm_runtime_call_wasm_batch(exec_env, func, 5, args, results, failed),
+        4);
+
+    /* an ordinary exception doesn't stop the batch, proc_exit skips the
+       remaining calls */
+    EXPECT_FALSE(failed[0]);
+    EXPECT_TRUE(failed[1]);
+    EXPECT_TRUE(failed[2]);
+    EXPECT_TRUE(failed[3]);
+    EXPECT_TRUE(failed[4]);
+    EXPECT_EQ(results[0], 0);
+    EXPECT_EQ(results[3], 0xDEADBEEF);
+    EXPECT_EQ(results[4], 0xDEADBEEF);
+
+    /* the exception of proc_exit is kept */
+    EXPECT_STREQ(wasm_runtime_get_exception(module_inst),
+                 "Exception: wasi proc exit");
+}
+
+TEST_F(BatchCallTest, terminate_stops_the_batch)
+{
+    wasm_function_inst_t func = lookup("stop_if");
+    uint32 args[] = { 0, STOP_TERMINATE, 0 };
+    uint32 results[3] = { 0xDEADBEEF, 0xDEADBEEF, 0xDEADBEEF };
+    bool failed[3];
+
+    ASSERT_TRUE(func != NULL);
+    EXPECT_EQ(
+        wasm_runtime_call_wasm_batch(exec_env, func, 3, args, results, failed),
+        2);
+
+    EXPECT_FALSE(failed[0]);
+    EXPECT_TRUE(failed[1]);
+    EXPECT_TRUE(failed[2]);
+    EXPECT_EQ(results[0], 0);
+    EXPECT_EQ(results[2], 0xDEADBEEF);
+    EXPECT_STREQ(wasm_runtime_get_exception(module_inst),
+                 "Exception: terminated by user");
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#pragma once
+
+#include <vector>
+#include "gtest/gtest.h"
+#include "wasm_runtime_common.h"
+#include "bh_platform.h"
+
+#include "wasm-apps/calls_wasm.h"
+
+/* Arguments of env.stop, called by the stop_if function of the test module */
+#define STOP_PROC_EXIT 1
+#define STOP_TERMINATE 2
+
+/* Raise the exceptions of proc_exit and wasm_runtime_terminate, or an
+   ordinary exception */
+static void
+stop_wrapper(wasm_exec_env_t exec_env, int32 kind)
+{
+    wasm_module_inst_t module_inst = wasm_runtime_get_module_inst(exec_env);
+
+    if (kind == STOP_PROC_EXIT)
+        wasm_runtime_set_exception(module_inst, "wasi proc exit");
+    else if (kind == STOP_TERMINATE)
+        wasm_runtime_set_exception(module_inst, "terminated by user");
+    else
+        wasm_runtime_set_exception(module_inst, "stopped");
+}
+
+/* Called in a loop by the call_host function of the test module */
+static void
+nop_wrapper(wasm_exec_env_t exec_env)
+{
+    (void)exec_env;
+}
+
+static NativeSymbol calls_native_symbols[] = {
+    { "stop", (void *)stop_wrapper, "(i)", NULL },
+    { "nop", (void *)nop_wrapper, "()", NULL },
+};
+
+/* Initialize the runtime with the natives imported by the test module,
+   the tests load the module themselves */
+class CallsTest : public testing::Test
+{
+  protected:
+    virtual void SetUp()
+    {
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+
+        init_args.mem_alloc_type = Alloc_With_Pool;
+        init_args.mem_alloc_option.pool.heap_buf = global_heap_buf;
+        init_args.mem_alloc_option.pool.heap_size = sizeof(global_heap_buf);
+        init_args.native_module_name = "env";
+        init_args.native_symbols = calls_native_symbols;
+        init_args.n_native_symbols =
+            sizeof(calls_native_symbols) / sizeof(NativeSymbol);
+
+        ASSERT_EQ(wasm_runtime_full_init(&init_args), true);
+
+        memset(&load_args, 0, sizeof(LoadArgs));
+        load_args.name = (char *)"calls";
+    }
+
+    virtual void TearDown()
+    {
+        deinstantiate();
+        if (module)
+            wasm_runtime_unload(module);
+        wasm_runtime_destroy();
+    }
+
+    /* Load a module from a copy of its binary, the loader may modify the
+       binary which must be kept until the module is unloaded */
+    void load(const uint8 *wasm, uint32 size)
+    {
+        buf.assign(wasm, wasm + size);
+        module = wasm_runtime_load(buf.data(), buf.size(), error_buf,
+                                   sizeof(error_buf));
+        ASSERT_TRUE(module != NULL) << error_buf;
+    }
+
+    /* Load the test module */
+    void load() { load(calls_wasm, sizeof(calls_wasm)); }
+
+    void instantiate(wasm_module_t loaded_module)
+    {
+        module_inst = wasm_runtime_instantiate(loaded_module, 8192, 0,
+                                               error_buf, sizeof(error_buf));
+        ASSERT_TRUE(module_inst != NULL) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+        ASSERT_TRUE(exec_env != NULL);
+    }
+
+    void deinstantiate()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        exec_env = NULL;
+        module_inst = NULL;
+    }
+
+    wasm_function_inst_t lookup(const char *name)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+
+        EXPECT_TRUE(func != NULL) << name;
+        return func;
+    }
+
+  public:
+    char global_heap_buf[512 * 1024];
+    RuntimeInitArgs init_args;
+    LoadArgs load_args;
+    std::vector<uint8> buf;
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    wasm_exec_env_t exec_env = NULL;
+    char error_buf[128];
+};
+
+/* Load and instantiate the test module before each test */
+class CallsModuleTest : public CallsTest
+{
+  protected:
+    virtual void SetUp()
+    {
+        ASSERT_NO_FATAL_FAILURE(CallsTest::SetUp());
+        ASSERT_NO_FATAL_FAILURE(load());
+        ASSERT_NO_FATAL_FAILURE(instantiate(module));
+    }
+};
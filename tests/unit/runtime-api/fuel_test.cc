@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "thread_manager.h"
+
+#include "calls_module_test.h"
+
+/* Opcodes of an iteration of the loop of the sum function */
+#define SUM_LOOP_FUEL 12
+
+class FuelTest : public CallsModuleTest
+{
+  protected:
+    virtual void SetUp()
+    {
+        ASSERT_NO_FATAL_FAILURE(CallsModuleTest::SetUp());
+        ASSERT_TRUE((func = lookup("sum")) != NULL);
+    }
+
+    /* Return the fuel charged by sum(n) */
+    uint64 charge_of_sum(wasm_exec_env_t env, uint32 n)
+    {
+        uint32 argv[1] = { n };
+        uint64 fuel = 1000000;
+
+        EXPECT_TRUE(wasm_runtime_set_fuel(env, fuel));
+        EXPECT_TRUE(wasm_runtime_call_wasm(env, func, 1, argv));
+        EXPECT_EQ(argv[0], n * (n + 1) / 2);
+        return fuel - wasm_runtime_get_fuel(env);
+    }
+
+  public:
+    wasm_function_inst_t func = NULL;
+};
+
+typedef struct ThreadResult {
+    uint64 fuel_at_start;
+    bool success;
+} ThreadResult;
+
+static void *
+thread_routine(void *arg)
+{
+    wasm_exec_env_t exec_env = (wasm_exec_env_t)arg;
+    ThreadResult *result = (ThreadResult *)exec_env->thread_arg;
+    wasm_function_inst_t func = wasm_runtime_lookup_function(
+        wasm_runtime_get_module_inst(exec_env), "sum");
+    uint32 argv[1] = { 100 };
+
+    result->fuel_at_start = wasm_runtime_get_fuel(exec_env);
+    result->success = wasm_runtime_call_wasm(exec_env, func, 1, argv);
+    return NULL;
+}
+
+static bool
+refill_callback(wasm_exec_env_t exec_env, void *user_data)
+{
+    uint32 *p_count = (uint32 *)user_data;
+
+    (*p_count)++;
+    return wasm_runtime_add_fuel(exec_env, 100);
+}
+
+static bool
+stop_callback(wasm_exec_env_t exec_env, void *user_data)
+{
+    (*(uint32 *)user_data)++;
+    return false;
+}
+
+TEST_F(FuelTest, unlimited_by_default)
+{
+    uint32 argv[1] = { 1000 };
+
+    EXPECT_EQ(wasm_runtime_get_fuel(exec_env), (uint64)INT64_MAX);
+    ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func, 1, argv));
+    EXPECT_EQ(argv[0], 500500);
+}
+
+TEST_F(FuelTest, deterministic_charge)
+{
+    uint64 charge0 = charge_of_sum(exec_env, 0);
+
+    EXPECT_GT(charge0, 0);
+    /* the same code is charged the same, and each opcode costs one */
+    EXPECT_EQ(charge_of_sum(exec_env, 0), charge0);
+    EXPECT_EQ(charge_of_sum(exec_env, 1), charge0 + SUM_LOOP_FUEL);
+    EXPECT_EQ(charge_of_sum(exec_env, 100), charge0 + 100 * SUM_LOOP_FUEL);
+    EXPECT_EQ(charge_of_sum(exec_env, 100), charge0 + 100 * SUM_LOOP_FUEL);
+}
+
+TEST_F(FuelTest, exhausted)
+{
+    uint64 charge = charge_of_sum(exec_env, 100);
+    uint32 argv[1] = { 100 };
+
+    /* just enough fuel */
+    ASSERT_TRUE(wasm_runtime_set_fuel(exec_env, charge));
+    EXPECT_TRUE(wasm_runtime_call_wasm(exec_env, func, 1, argv));
+    EXPECT_EQ(wasm_runtime_get_fuel(exec_env), 0);
+
+    /* the loop is stopped at its header once the fuel is negative */
+    argv[0] = 100;
+    ASSERT_TRUE(wasm_runtime_set_fuel(exec_env, charge - SUM_LOOP_FUEL - 1));
+    EXPECT_FALSE(wasm_runtime_call_wasm(exec_env, func, 1, argv));
+    EXPECT_STREQ(wasm_runtime_get_exception(module_inst),
+                 "Exception: fuel exhausted");
+    EXPECT_EQ(wasm_runtime_get_fuel(exec_env), 0);
+    wasm_runtime_clear_exception(module_inst);
+
+    /* a callback which doesn't refill the fuel doesn't continue */
+    uint32 count = 0;
+    argv[0] = 100;
+    wasm_runtime_set_fuel_exhausted_callback(exec_env, stop_callback, &count);
+    ASSERT_TRUE(wasm_runtime_set_fuel(exec_env, 10));
+    EXPECT_FALSE(wasm_runtime_call_wasm(exec_env, func, 1, argv));
+    EXPECT_EQ(count, 1);
+    wasm_runtime_clear_exception(module_inst);
+}
+
+TEST_F(FuelTest, refilled_by_callback)
+{
+    uint64 charge = charge_of_sum(exec_env, 1000);
+    uint32 argv[1] = { 1000 }, count = 0;
+
+    wasm_runtime_set_fuel_exhausted_callback(exec_env, refill_callback,
+                                             &count);
+    ASSERT_TRUE(wasm_runtime_set_fuel(exec_env, 100));
+    ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func, 1, argv));
+    EXPECT_EQ(argv[0], 500500);
+    /* refilled 100 each time the fuel is negative at a loop header */
+    EXPECT_GE(count * 100 + 100, charge);
+    EXPECT_LE(count * 100, charge);
+}
+
+TEST_F(FuelTest, thread_inherits_fuel)
+{
+    uint64 charge = charge_of_sum(exec_env, 100);
+    wasm_module_inst_t new_module_inst;
+    ThreadResult result = { 0 };
+    uint32 count = 0;
+
+    wasm_runtime_set_fuel_exhausted_callback(exec_env, stop_callback, &count);
+    ASSERT_TRUE(wasm_runtime_set_fuel(exec_env, charge - SUM_LOOP_FUEL - 1));
+
+    /* create the thread the same way as pthread_create and thread-spawn */
+    new_module_inst = wasm_runtime_instantiate(module, 8192, 0, error_buf,
+                                               sizeof(error_buf));
+    ASSERT_TRUE(new_module_inst != NULL) << error_buf;
+    ASSERT_EQ(wasm_cluster_create_thread(exec_env, new_module_inst, false, 0,
+                                         0, thread_routine, &result),
+              0);
+    wasm_cluster_wait_for_all_except_self(wasm_exec_env_get_cluster(exec_env),
+                                          exec_env);
+
+    /* the thread starts with the fuel left of its parent and is stopped
+       by the callback of its parent */
+    EXPECT_EQ(result.fuel_at_start, charge - SUM_LOOP_FUEL - 1);
+    EXPECT_FALSE(result.success);
+    EXPECT_EQ(count, 1);
+    /* and charged separately */
+    EXPECT_EQ(wasm_runtime_get_fuel(exec_env), charge - SUM_LOOP_FUEL - 1);
+    wasm_runtime_clear_exception(module_inst);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "thread_manager.h"
+#include "calls_module_test.h"
+
+#if WASM_ENABLE_INSTANCE_STATS != 0 && WASM_ENABLE_THREAD_MGR != 0
+
+#define THREAD_NUM 4
+#define CALLS_PER_THREAD 100000
+
+static bool
+call_host(wasm_exec_env_t exec_env, uint32 n)
+{
+    wasm_function_inst_t func = wasm_runtime_lookup_function(
+        wasm_runtime_get_module_inst(exec_env), "call_host");
+    uint32 argv[1] = { n };
+
+    return func && wasm_runtime_call_wasm(exec_env, func, 1, argv);
+}
+
+static void *
+thread_routine(void *arg)
+{
+    wasm_exec_env_t exec_env = (wasm_exec_env_t)arg;
+
+    *(bool *)exec_env->thread_arg = call_host(exec_env, CALLS_PER_THREAD);
+    return NULL;
+}
+
+class InstanceStatsTest : public CallsModuleTest
+{
+  public:
+    uint64 host_call_count(wasm_module_inst_t inst)
+    {
+        wasm_instance_stats_t stats;
+
+        EXPECT_TRUE(wasm_runtime_get_instance_stats(inst, &stats));
+        return stats.host_call_count;
+    }
+};
+
+TEST_F(InstanceStatsTest, host_calls)
+{
+    ASSERT_TRUE(call_host(exec_env, 1000));
+    EXPECT_EQ(1000u, host_call_count(module_inst));
+
+    wasm_runtime_reset_instance_stats(module_inst);
+    EXPECT_EQ(0u, host_call_count(module_inst));
+}
+
+/* The instances of the threads spawned, created the same way as by
+   thread-spawn, count into the stats of the parent at the same time */
+TEST_F(InstanceStatsTest, spawned_threads_count_into_parent)
+{
+    wasm_module_inst_t new_module_inst;
+    bool results[THREAD_NUM] = { false };
+    wasm_instance_stats_t stats;
+
+    for (int i = 0; i < THREAD_NUM; i++) {
+        new_module_inst = wasm_runtime_instantiate_internal(
+            module, module_inst, exec_env, 8192, 0, 0, error_buf,
+            sizeof(error_buf));
+        ASSERT_TRUE(new_module_inst != NULL) << error_buf;
+        /* the same stats are returned while the thread is created */
+        EXPECT_EQ(host_call_count(module_inst),
+                  host_call_count(new_module_inst));
+        ASSERT_EQ(wasm_cluster_create_thread(exec_env, new_module_inst, false,
+                                             0, 0, thread_routine,
+                                             &results[i]),
+                  0);
+    }
+    EXPECT_TRUE(call_host(exec_env, CALLS_PER_THREAD));
+    /* the instances of the threads are destroyed when they exit */
+    wasm_cluster_wait_for_all_except_self(wasm_exec_env_get_cluster(exec_env),
+                                          exec_env);
+
+    for (int i = 0; i < THREAD_NUM; i++)
+        EXPECT_TRUE(results[i]);
+    ASSERT_TRUE(wasm_runtime_get_instance_stats(module_inst, &stats));
+    EXPECT_EQ((uint64)(THREAD_NUM + 1) * CALLS_PER_THREAD,
+              stats.host_call_count);
+    EXPECT_GT(stats.wasm_cpu_time_us + stats.host_cpu_time_us, 0u);
+}
+
+#endif
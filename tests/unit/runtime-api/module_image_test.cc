@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "wasm.h"
+#include "wasm_module_image.h"
+
+#include "calls_module_test.h"
+
+class ModuleImageTest : public CallsTest
+{
+  protected:
+    virtual void SetUp()
+    {
+        char dir_template[] = "/tmp/wamr_module_image_XXXXXX";
+
+        ASSERT_NO_FATAL_FAILURE(CallsTest::SetUp());
+
+        ASSERT_TRUE(mkdtemp(dir_template) != NULL);
+        image_dir = dir_template;
+        image_path = image_dir + "/calls.img";
+        load_args.module_image_path = image_path.c_str();
+    }
+
+    virtual void TearDown()
+    {
+        unlink(image_path.c_str());
+        rmdir(image_dir.c_str());
+        CallsTest::TearDown();
+    }
+
+    /* Load the binary with the module image, the loader may modify the
+       binary so each load is given its own copy, which must be kept until
+       the module is unloaded */
+    wasm_module_t load_with_image(std::vector<uint8> &buf)
+    {
+        wasm_module_t module = wasm_runtime_load_ex(
+            buf.data(), buf.size(), &load_args, error_buf, sizeof(error_buf));
+        EXPECT_TRUE(module != NULL) << error_buf;
+        return module;
+    }
+
+    bool is_image_mapped(wasm_module_t module)
+    {
+        return ((WASMModule *)module)->image_addr != NULL;
+    }
+
+    bool image_exists()
+    {
+        struct stat st;
+        return stat(image_path.c_str(), &st) == 0 && st.st_size > 0;
+    }
+
+    mode_t image_mode()
+    {
+        struct stat st;
+        EXPECT_EQ(stat(image_path.c_str(), &st), 0);
+        return st.st_mode & 0777;
+    }
+
+    std::string hash_hex(const char *str)
+    {
+        uint8 hash[MODULE_IMAGE_HASH_SIZE];
+        char hex[MODULE_IMAGE_HASH_SIZE * 2 + 1];
+        uint32 i;
+
+        wasm_module_image_hash((const uint8 *)str, (uint32)strlen(str), hash);
+        for (i = 0; i < MODULE_IMAGE_HASH_SIZE; i++)
+            snprintf(hex + i * 2, 3, "%02x", hash[i]);
+        return hex;
+    }
+
+    /* Run the functions prepared by the loader or taken from the image */
+    void check_module(wasm_module_t loaded_module, const char *data)
+    {
+        wasm_function_inst_t func;
+        uint32 argv[6];
+        int64 i64 = -5;
+        float32 f32 = 1.5f;
+        float64 f64 = 0.25, ret;
+
+        ASSERT_NO_FATAL_FAILURE(instantiate(loaded_module));
+
+        ASSERT_TRUE((func = lookup("sum")) != NULL);
+        argv[0] = 100;
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func, 1, argv));
+        EXPECT_EQ(argv[0], 5050);
+
+        ASSERT_TRUE((func = lookup("mix")) != NULL);
+        memcpy(argv, &i64, sizeof(int64));
+        memcpy(argv + 2, &f32, sizeof(float32));
+        memcpy(argv + 3, &f64, sizeof(float64));
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func, 5, argv));
+        memcpy(&ret, argv, sizeof(float64));
+        EXPECT_EQ(ret, -3.25);
+
+        ASSERT_TRUE((func = lookup("div")) != NULL);
+        argv[0] = 1;
+        argv[1] = 0;
+        EXPECT_FALSE(wasm_runtime_call_wasm(exec_env, func, 2, argv));
+        EXPECT_STREQ(wasm_runtime_get_exception(module_inst),
+                     "Exception: integer divide by zero");
+
+        EXPECT_EQ(memcmp(wasm_runtime_addr_app_to_native(module_inst, 16),
+                         data, 5),
+                  0);
+
+        deinstantiate();
+    }
+
+  public:
+    std::string image_dir;
+    std::string image_path;
+};
+
+TEST_F(ModuleImageTest, write_then_map)
+{
+    std::vector<uint8> buf1(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    std::vector<uint8> buf2(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    wasm_module_t module1, module2;
+
+    /* no image yet, the module is prepared and the image is written */
+    module1 = load_with_image(buf1);
+    ASSERT_TRUE(module1 != NULL);
+    EXPECT_FALSE(is_image_mapped(module1));
+    EXPECT_TRUE(image_exists());
+
+    /* the next load maps it, while the first module is still loaded */
+    module2 = load_with_image(buf2);
+    ASSERT_TRUE(module2 != NULL);
+    EXPECT_TRUE(is_image_mapped(module2));
+
+    check_module(module1, "hello");
+    check_module(module2, "hello");
+
+    wasm_runtime_unload(module1);
+    wasm_runtime_unload(module2);
+}
+
+TEST_F(ModuleImageTest, stale_image_is_rewritten)
+{
+    std::vector<uint8> buf1(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    std::vector<uint8> buf2(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    std::vector<uint8> buf3(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    wasm_module_t module;
+
+    module = load_with_image(buf1);
+    ASSERT_TRUE(module != NULL);
+    wasm_runtime_unload(module);
+    ASSERT_TRUE(image_exists());
+
+    /* change the data of the binary, "hello" is at its end */
+    buf2[buf2.size() - 5] = 'j';
+    buf3[buf3.size() - 5] = 'j';
+
+    /* the image of the other binary isn't used, and is replaced */
+    module = load_with_image(buf2);
+    ASSERT_TRUE(module != NULL);
+    EXPECT_FALSE(is_image_mapped(module));
+    check_module(module, "jello");
+    wasm_runtime_unload(module);
+
+    module = load_with_image(buf3);
+    ASSERT_TRUE(module != NULL);
+    EXPECT_TRUE(is_image_mapped(module));
+    check_module(module, "jello");
+    wasm_runtime_unload(module);
+}
+
+TEST_F(ModuleImageTest, corrupted_image_is_rejected)
+{
+    std::vector<uint8> buf1(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    std::vector<uint8> buf2(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    wasm_module_t module;
+
+    module = load_with_image(buf1);
+    ASSERT_TRUE(module != NULL);
+    wasm_runtime_unload(module);
+
+    /* truncate the image to its first bytes */
+    ASSERT_EQ(truncate(image_path.c_str(), 16), 0);
+
+    module = load_with_image(buf2);
+    ASSERT_TRUE(module != NULL);
+    EXPECT_FALSE(is_image_mapped(module));
+    check_module(module, "hello");
+    wasm_runtime_unload(module);
+}
+
+/* The test vectors of FIPS 180-4, the padding of the 56-byte message takes
+   a second block, the last message is longer than a block */
+TEST_F(ModuleImageTest, binary_hash_is_sha256)
+{
+    EXPECT_EQ(hash_hex(""), "e3b0c44298fc1c149afbf4c8996fb924"
+                            "27ae41e4649b934ca495991b7852b855");
+    EXPECT_EQ(hash_hex("abc"), "ba7816bf8f01cfea414140de5dae2223"
+                               "b00361a396177a9cb410ff61f20015ad");
+    EXPECT_EQ(hash_hex("abcdbcdecdefdefgefghfghighijhijk"
+                       "ijkljklmklmnlmnomnopnopq"),
+              "248d6a61d20638b8e5c026930c3e6039"
+              "a33ce45964ff2167f6ecedd419db06c1");
+    EXPECT_EQ(hash_hex("abcdefghbcdefghicdefghijdefghijk"
+                       "efghijklfghijklmghijklmnhijklmno"
+                       "ijklmnopjklmnopqklmnopqrlmnopqrs"
+                       "mnopqrstnopqrstu"),
+              "cf5b16a778af8380036ce59e7b049237"
+              "0b249b11e8f07a51afac45037afee9d1");
+}
+
+TEST_F(ModuleImageTest, image_writable_by_others_is_rejected)
+{
+    std::vector<uint8> buf1(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    std::vector<uint8> buf2(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    std::vector<uint8> buf3(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    wasm_module_t module;
+
+    module = load_with_image(buf1);
+    ASSERT_TRUE(module != NULL);
+    wasm_runtime_unload(module);
+    EXPECT_EQ(image_mode() & (S_IWGRP | S_IWOTH), 0u);
+
+    /* the others could have written it, it isn't used and is replaced */
+    ASSERT_EQ(chmod(image_path.c_str(), 0666), 0);
+    module = load_with_image(buf2);
+    ASSERT_TRUE(module != NULL);
+    EXPECT_FALSE(is_image_mapped(module));
+    check_module(module, "hello");
+    wasm_runtime_unload(module);
+    EXPECT_EQ(image_mode() & (S_IWGRP | S_IWOTH), 0u);
+
+    module = load_with_image(buf3);
+    ASSERT_TRUE(module != NULL);
+    EXPECT_TRUE(is_image_mapped(module));
+    check_module(module, "hello");
+    wasm_runtime_unload(module);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "calls_module_test.h"
+
+class PreparedCallTest : public CallsModuleTest
+{
+  protected:
+    wasm_prepared_call_t prepare(const char *name)
+    {
+        wasm_function_inst_t func = lookup(name);
+
+        if (!func)
+            return NULL;
+        return wasm_runtime_create_prepared_call(exec_env, func);
+    }
+};
+
+TEST_F(PreparedCallTest, call_repeatedly)
+{
+    wasm_prepared_call_t call = prepare("add");
+    uint64 args[2], results[1];
+    uint32 i;
+
+    ASSERT_TRUE(call != NULL);
+    for (i = 0; i < 1000; i++) {
+        args[0] = i;
+        args[1] = (uint64)(uint32)-7;
+        ASSERT_TRUE(wasm_runtime_call_prepared(call, args, results));
+        EXPECT_EQ((uint32)results[0], i - 7);
+    }
+    wasm_runtime_destroy_prepared_call(call);
+}
+
+TEST_F(PreparedCallTest, same_results_as_call_wasm)
+{
+    wasm_prepared_call_t call = prepare("mix");
+    wasm_function_inst_t func = lookup("mix");
+    int64 i64 = -(1LL << 40);
+    float32 f32 = -2.5f;
+    float64 f64 = 1e10, ret_prepared, ret_call;
+    uint64 args[3] = { 0 }, results[1];
+    uint32 argv[5];
+
+    ASSERT_TRUE(call != NULL);
+
+    /* an i64 takes a whole slot, an f32 the low 32 bits */
+    memcpy(&args[0], &i64, sizeof(int64));
+    memcpy(&args[1], &f32, sizeof(float32));
+    memcpy(&args[2], &f64, sizeof(float64));
+    ASSERT_TRUE(wasm_runtime_call_prepared(call, args, results));
+    memcpy(&ret_prepared, &results[0], sizeof(float64));
+
+    memcpy(argv, &i64, sizeof(int64));
+    memcpy(argv + 2, &f32, sizeof(float32));
+    memcpy(argv + 3, &f64, sizeof(float64));
+    ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func, 5, argv));
+    memcpy(&ret_call, argv, sizeof(float64));
+
+    EXPECT_EQ(ret_prepared, ret_call);
+    EXPECT_EQ(ret_prepared, (float64)i64 + (float64)f32 + f64);
+    wasm_runtime_destroy_prepared_call(call);
+}
+
+TEST_F(PreparedCallTest, trap_then_call_again)
+{
+    wasm_prepared_call_t call = prepare("div");
+    uint64 args[2], results[1] = { 0x1234 };
+
+    ASSERT_TRUE(call != NULL);
+
+    args[0] = 1;
+    args[1] = 0;
+    EXPECT_FALSE(wasm_runtime_call_prepared(call, args, results));
+    EXPECT_STREQ(wasm_runtime_get_exception(module_inst),
+                 "Exception: integer divide by zero");
+    /* the results are left unchanged */
+    EXPECT_EQ(results[0], 0x1234);
+
+    /* the prepared call is still usable after the trap */
+    wasm_runtime_clear_exception(module_inst);
+    args[0] = (uint64)(uint32)-9;
+    args[1] = 3;
+    ASSERT_TRUE(wasm_runtime_call_prepared(call, args, results));
+    EXPECT_EQ((int32)results[0], -3);
+    EXPECT_TRUE(wasm_runtime_get_exception(module_inst) == NULL);
+    wasm_runtime_destroy_prepared_call(call);
+}
+
+TEST_F(PreparedCallTest, several_calls_with_one_exec_env)
+{
+    wasm_prepared_call_t call_add = prepare("add");
+    wasm_prepared_call_t call_sum = prepare("sum");
+    uint64 args[2], results[1];
+
+    ASSERT_TRUE(call_add != NULL);
+    ASSERT_TRUE(call_sum != NULL);
+
+    args[0] = 100;
+    ASSERT_TRUE(wasm_runtime_call_prepared(call_sum, args, results));
+    EXPECT_EQ((uint32)results[0], 5050);
+
+    args[0] = 40;
+    args[1] = 2;
+    ASSERT_TRUE(wasm_runtime_call_prepared(call_add, args, results));
+    EXPECT_EQ((uint32)results[0], 42);
+
+    wasm_runtime_destroy_prepared_call(call_sum);
+    wasm_runtime_destroy_prepared_call(call_add);
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "calls_module_test.h"
+#include "wasm.h"
+
+#include "wasm-apps/natives_wasm.h"
+
+#if WASM_ENABLE_QUICK_NATIVE_ENTRY != 0
+
+/* Sum the bytes of a buffer given with its length */
+static uint32
+checksum_wrapper(wasm_exec_env_t exec_env, const uint8 *buf, uint32 len)
+{
+    uint32 sum = 0, i;
+
+    for (i = 0; i < len; i++)
+        sum += buf[i];
+    return sum;
+}
+
+static uint32
+length_wrapper(wasm_exec_env_t exec_env, const char *str)
+{
+    return (uint32)strlen(str);
+}
+
+static uint32
+peek_wrapper(wasm_exec_env_t exec_env, const uint8 *p)
+{
+    return *p;
+}
+
+/* Mix the params so that each of them, in its place, counts in the result */
+static int64
+combine_wrapper(wasm_exec_env_t exec_env, int64 a, int32 b, int64 c)
+{
+    return a - c * 3 + b;
+}
+
+static NativeSymbol natives_native_symbols[] = {
+    { "checksum", (void *)checksum_wrapper, "(*~)i", NULL },
+    { "length", (void *)length_wrapper, "($)i", NULL },
+    { "peek", (void *)peek_wrapper, "(*)i", NULL },
+    { "combine", (void *)combine_wrapper, "(IiI)I", NULL },
+};
+
+/* Load the natives module, whose imports are all called through the quick
+   native entries */
+class QuickNativeEntryTest : public CallsTest
+{
+  protected:
+    virtual void SetUp()
+    {
+        ASSERT_NO_FATAL_FAILURE(CallsTest::SetUp());
+        ASSERT_TRUE(wasm_runtime_register_natives(
+            "env", natives_native_symbols,
+            sizeof(natives_native_symbols) / sizeof(NativeSymbol)));
+        ASSERT_NO_FATAL_FAILURE(load(natives_wasm, sizeof(natives_wasm)));
+        ASSERT_NO_FATAL_FAILURE(instantiate(module));
+        memory = (uint8 *)wasm_runtime_addr_app_to_native(module_inst, 0);
+    }
+
+    virtual void TearDown()
+    {
+        CallsTest::TearDown();
+        wasm_runtime_unregister_natives("env", natives_native_symbols);
+    }
+
+    /* Call an i32 function of the module with its i32 params, return whether
+       it succeeds and keep the result in ret */
+    bool call(const char *name, uint32 argc, uint32 arg0, uint32 arg1 = 0)
+    {
+        wasm_function_inst_t func = lookup(name);
+        uint32 argv[2] = { arg0, arg1 };
+
+        if (!func || !wasm_runtime_call_wasm(exec_env, func, argc, argv))
+            return false;
+        ret = argv[0];
+        return true;
+    }
+
+    /* Expect the last call to have trapped out of bounds */
+    void expect_oob()
+    {
+        const char *exception = wasm_runtime_get_exception(module_inst);
+
+        ASSERT_TRUE(exception != NULL);
+        EXPECT_TRUE(strstr(exception, "out of bounds memory access"))
+            << exception;
+        wasm_runtime_clear_exception(module_inst);
+    }
+
+  public:
+    uint8 *memory;
+    uint32 ret;
+};
+
+TEST_F(QuickNativeEntryTest, imports_use_quick_entries)
+{
+    WASMModule *wasm_module = (WASMModule *)module;
+    uint32 i;
+
+    ASSERT_EQ(4u, wasm_module->import_function_count);
+    for (i = 0; i < wasm_module->import_function_count; i++) {
+        WASMFunctionImport *import =
+            &wasm_module->import_functions[i].u.function;
+
+        EXPECT_TRUE(import->quick_native_entry != NULL) << import->field_name;
+        /* Only combine has no pointer params */
+        EXPECT_EQ(i != 3, import->quick_native_ptr_args) << import->field_name;
+    }
+}
+
+TEST_F(QuickNativeEntryTest, buffer_params)
+{
+    const uint32 size = 65536;
+
+    memset(memory + size - 4, 1, 4);
+    ASSERT_TRUE(call("checksum", 2, 16, 5));
+    EXPECT_EQ((uint32)('h' + 'e' + 'l' + 'l' + 'o'), ret);
+    ASSERT_TRUE(call("checksum", 2, size - 4, 4));
+    EXPECT_EQ(4u, ret);
+    ASSERT_TRUE(call("checksum", 2, 0, size));
+    EXPECT_EQ(4u + 'h' + 'e' + 'l' + 'l' + 'o', ret);
+
+    /* The whole buffer is checked, not only its start */
+    EXPECT_FALSE(call("checksum", 2, size - 4, 5));
+    expect_oob();
+    EXPECT_FALSE(call("checksum", 2, 1, size));
+    expect_oob();
+    /* An empty buffer may end the memory, not start after it */
+    ASSERT_TRUE(call("checksum", 2, size, 0));
+    EXPECT_EQ(0u, ret);
+    EXPECT_FALSE(call("checksum", 2, size + 1, 0));
+    expect_oob();
+}
+
+TEST_F(QuickNativeEntryTest, string_params)
+{
+    const uint32 size = 65536;
+
+    ASSERT_TRUE(call("length", 1, 16));
+    EXPECT_EQ(5u, ret);
+    ASSERT_TRUE(call("length", 1, 18));
+    EXPECT_EQ(3u, ret);
+
+    /* A string must end in the memory */
+    EXPECT_FALSE(call("length", 1, size));
+    expect_oob();
+    memset(memory + size - 4, 'x', 4);
+    EXPECT_FALSE(call("length", 1, size - 4));
+    expect_oob();
+    memory[size - 1] = '\0';
+    ASSERT_TRUE(call("length", 1, size - 4));
+    EXPECT_EQ(3u, ret);
+}
+
+TEST_F(QuickNativeEntryTest, pointer_params)
+{
+    const uint32 size = 65536;
+
+    ASSERT_TRUE(call("peek", 1, 17));
+    EXPECT_EQ((uint32)'e', ret);
+    memory[size - 1] = 0xA5;
+    ASSERT_TRUE(call("peek", 1, size - 1));
+    EXPECT_EQ(0xA5u, ret);
+
+    EXPECT_FALSE(call("peek", 1, size));
+    expect_oob();
+    EXPECT_FALSE(call("peek", 1, (uint32)-1));
+    expect_oob();
+}
+
+TEST_F(QuickNativeEntryTest, i64_params_and_result)
+{
+    wasm_function_inst_t combine = lookup("combine");
+    int64 a = (1LL << 40) + 5, c = -(1LL << 35) - 7, result;
+    int32 b = -3;
+    uint32 argv[5];
+
+    ASSERT_TRUE(combine != NULL);
+    memcpy(argv, &a, sizeof(int64));
+    argv[2] = (uint32)b;
+    memcpy(argv + 3, &c, sizeof(int64));
+    ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, combine, 5, argv));
+    memcpy(&result, argv, sizeof(int64));
+    EXPECT_EQ(a - c * 3 + b, result);
+}
+
+#endif /* end of WASM_ENABLE_QUICK_NATIVE_ENTRY != 0 */
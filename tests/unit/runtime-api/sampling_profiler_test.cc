@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <unistd.h>
+#include "calls_module_test.h"
+
+#if WASM_ENABLE_SAMPLING_PROFILER != 0
+
+/* The frame names of the spin and sum functions, by their indexes without
+   the imported stop function */
+#define SPIN_FRAME "aot_func#5"
+#define SUM_FRAME "aot_func#3"
+
+class SamplingProfilerTest : public CallsModuleTest
+{
+  protected:
+    virtual void TearDown()
+    {
+        wasm_runtime_stop_sampling_profiler();
+        if (!profile_path.empty())
+            unlink(profile_path.c_str());
+        CallsModuleTest::TearDown();
+    }
+
+    /* Read the folded stacks written by the profiler, each line is the
+       frames from the outermost one, separated by ';', and the count */
+    void read_profile(std::map<std::string, uint64> &stacks)
+    {
+        std::ifstream file(profile_path);
+        std::string line;
+        size_t space;
+
+        ASSERT_TRUE(file.is_open());
+        while (std::getline(file, line)) {
+            space = line.rfind(' ');
+            ASSERT_NE(std::string::npos, space) << line;
+            stacks[line.substr(0, space)] += std::stoull(line.substr(space + 1));
+        }
+    }
+
+  public:
+    std::string profile_path;
+};
+
+/* A busy loop is sampled in the function it spins in, below its caller */
+TEST_F(SamplingProfilerTest, busy_loop)
+{
+    wasm_function_inst_t spin = lookup("spin");
+    char path[] = "/tmp/sampling_profile_XXXXXX";
+    std::map<std::string, uint64> stacks;
+    uint64 start, total = 0;
+    uint32 argv[1];
+    int fd;
+
+    ASSERT_NE(-1, fd = mkstemp(path));
+    close(fd);
+    profile_path = path;
+
+    ASSERT_TRUE(wasm_runtime_start_sampling_profiler(1000));
+    start = os_time_get_boot_us();
+    while (os_time_get_boot_us() - start < 300 * 1000) {
+        argv[0] = 1000000;
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, spin, 1, argv));
+        /* 1 + 2 + ... + 1000000, wrapped around */
+        ASSERT_EQ((uint32)(1000000ull * 1000001 / 2), argv[0]);
+    }
+    wasm_runtime_stop_sampling_profiler();
+
+    ASSERT_TRUE(wasm_runtime_dump_sampling_profile(path));
+    ASSERT_NO_FATAL_FAILURE(read_profile(stacks));
+
+    /* The loop runs in sum, the samples taken between the calls or in
+       spin itself are rare */
+    for (const auto &stack : stacks) {
+        EXPECT_EQ(0u, stack.first.find(SPIN_FRAME)) << stack.first;
+        total += stack.second;
+    }
+    EXPECT_GT(stacks[SPIN_FRAME ";" SUM_FRAME], total / 2);
+    EXPECT_GE(total, 20u);
+}
+
+#endif /* end of WASM_ENABLE_SAMPLING_PROFILER != 0 */
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "calls_module_test.h"
+
+class StreamingLoaderTest : public CallsTest
+{
+  protected:
+    /* Feed the binary to a stream byte by byte, return the offset of the
+       byte on which the stream fails, or the size if it doesn't fail */
+    uint32 feed_byte_by_byte(wasm_module_stream_t stream, const uint8 *buf,
+                             uint32 size)
+    {
+        uint32 i;
+
+        for (i = 0; i < size; i++) {
+            if (!wasm_runtime_load_stream_feed(stream, buf + i, 1, error_buf,
+                                               sizeof(error_buf)))
+                break;
+        }
+        return i;
+    }
+
+    /* Check that the module behaves the same as the one loaded at once */
+    void check_module(wasm_module_t loaded_module)
+    {
+        wasm_function_inst_t func;
+        uint32 argv[2];
+        char *data;
+
+        ASSERT_EQ(wasm_runtime_get_export_count(loaded_module), 8);
+        ASSERT_NO_FATAL_FAILURE(instantiate(loaded_module));
+
+        ASSERT_TRUE((func = lookup("add")) != NULL);
+        argv[0] = 2;
+        argv[1] = 3;
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func, 2, argv));
+        EXPECT_EQ(argv[0], 5);
+
+        ASSERT_TRUE((func = lookup("sum")) != NULL);
+        argv[0] = 100;
+        ASSERT_TRUE(wasm_runtime_call_wasm(exec_env, func, 1, argv));
+        EXPECT_EQ(argv[0], 5050);
+
+        /* the data section is the last one to arrive */
+        ASSERT_TRUE(wasm_runtime_validate_app_addr(module_inst, 16, 5));
+        data = (char *)wasm_runtime_addr_app_to_native(module_inst, 16);
+        EXPECT_EQ(memcmp(data, "hello", 5), 0);
+
+        deinstantiate();
+    }
+};
+
+TEST_F(StreamingLoaderTest, load_at_once)
+{
+    ASSERT_NO_FATAL_FAILURE(load());
+    check_module(module);
+}
+
+TEST_F(StreamingLoaderTest, load_byte_by_byte_with_size)
+{
+    wasm_module_stream_t stream;
+    wasm_module_t module;
+
+    stream = wasm_runtime_load_stream_begin(sizeof(calls_wasm), &load_args,
+                                            error_buf, sizeof(error_buf));
+    ASSERT_TRUE(stream != NULL) << error_buf;
+    ASSERT_EQ(feed_byte_by_byte(stream, calls_wasm, sizeof(calls_wasm)),
+              sizeof(calls_wasm))
+        << error_buf;
+
+    module =
+        wasm_runtime_load_stream_finish(stream, error_buf, sizeof(error_buf));
+    ASSERT_TRUE(module != NULL) << error_buf;
+    check_module(module);
+    wasm_runtime_unload(module);
+}
+
+TEST_F(StreamingLoaderTest, load_byte_by_byte_without_size)
+{
+    wasm_module_stream_t stream;
+    wasm_module_t module;
+
+    stream = wasm_runtime_load_stream_begin(0, &load_args, error_buf,
+                                            sizeof(error_buf));
+    ASSERT_TRUE(stream != NULL) << error_buf;
+    ASSERT_EQ(feed_byte_by_byte(stream, calls_wasm, sizeof(calls_wasm)),
+              sizeof(calls_wasm))
+        << error_buf;
+
+    module =
+        wasm_runtime_load_stream_finish(stream, error_buf, sizeof(error_buf));
+    ASSERT_TRUE(module != NULL) << error_buf;
+    check_module(module);
+    wasm_runtime_unload(module);
+}
+
+TEST_F(StreamingLoaderTest, invalid_section_fails_on_arrival)
+{
+    std::vector<uint8> buf(calls_wasm, calls_wasm + sizeof(calls_wasm));
+    /* the type section is [8, 33), its first type has an invalid form */
+    uint32 type_section_end = 8 + 2 + buf[9];
+    wasm_module_stream_t stream;
+
+    ASSERT_EQ(buf[11], 0x60);
+    buf[11] = 0x5F;
+
+    stream = wasm_runtime_load_stream_begin(buf.size(), &load_args, error_buf,
+                                            sizeof(error_buf));
+    ASSERT_TRUE(stream != NULL) << error_buf;
+    EXPECT_LT(feed_byte_by_byte(stream, buf.data(), buf.size()),
+              type_section_end);
+    wasm_runtime_load_stream_abort(stream);
+}
+
+TEST_F(StreamingLoaderTest, truncated_binary_fails_on_finish)
+{
+    wasm_module_stream_t stream;
+
+    stream = wasm_runtime_load_stream_begin(0, &load_args, error_buf,
+                                            sizeof(error_buf));
+    ASSERT_TRUE(stream != NULL) << error_buf;
+    ASSERT_EQ(feed_byte_by_byte(stream, calls_wasm, sizeof(calls_wasm) - 1),
+              sizeof(calls_wasm) - 1)
+        << error_buf;
+    EXPECT_TRUE(wasm_runtime_load_stream_finish(stream, error_buf,
+                                                sizeof(error_buf))
+                == NULL);
+}
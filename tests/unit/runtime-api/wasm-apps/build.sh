@@ -0,0 +1,24 @@
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+readonly CURR_DIR=$PWD
+readonly BINARYDUMP_DIR=$PWD/../../../../test-tools/binarydump-tool
+readonly WAST2WASM="/opt/wabt/bin/wat2wasm"
+
+# build binarydump
+cd $BINARYDUMP_DIR
+mkdir -p build && cd build
+cmake .. && make -j
+cp -a binarydump $CURR_DIR
+
+cd $CURR_DIR
+
+## build calls
+$WAST2WASM -o calls.wasm calls.wast
+./binarydump -o calls_wasm.h -n calls_wasm calls.wasm
+rm -f calls.wasm
+
+## build natives
+$WAST2WASM -o natives.wasm natives.wast
+./binarydump -o natives_wasm.h -n natives_wasm natives.wasm
+rm -f natives.wasm
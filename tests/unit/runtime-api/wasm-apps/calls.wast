@@ -0,0 +1,35 @@
+(module
+  (import "env" "stop" (func $stop (param i32)))
+  (import "env" "nop" (func $nop))
+  (memory (export "memory") 1)
+  (func (export "add") (param i32 i32) (result i32)
+    (i32.add (local.get 0) (local.get 1)))
+  (func (export "div") (param i32 i32) (result i32)
+    (i32.div_s (local.get 0) (local.get 1)))
+  (func (export "mix") (param i64 f32 f64) (result f64)
+    (f64.add
+      (f64.add (f64.convert_i64_s (local.get 0)) (f64.promote_f32 (local.get 1)))
+      (local.get 2)))
+  (func $sum (export "sum") (param i32) (result i32) (local i32)
+    (block
+      (loop
+        (br_if 1 (i32.eqz (local.get 0)))
+        (local.set 1 (i32.add (local.get 1) (local.get 0)))
+        (local.set 0 (i32.sub (local.get 0) (i32.const 1)))
+        (br 0)))
+    (local.get 1))
+  (func (export "stop_if") (param i32) (result i32)
+    (if (local.get 0)
+      (then (call $stop (local.get 0))))
+    (local.get 0))
+  (func (export "spin") (param i32) (result i32)
+    (call $sum (local.get 0)))
+  (func (export "call_host") (param i32)
+    (block
+      (loop
+        (br_if 1 (i32.eqz (local.get 0)))
+        (call $nop)
+        (local.set 0 (i32.sub (local.get 0) (i32.const 1)))
+        (br 0))))
+  (data (i32.const 16) "hello")
+)
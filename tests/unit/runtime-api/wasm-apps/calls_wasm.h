@@ -0,0 +1,30 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+static unsigned char calls_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x1A, 0x05, 0x60,
+    0x01, 0x7F, 0x00, 0x60, 0x00, 0x00, 0x60, 0x02, 0x7F, 0x7F, 0x01, 0x7F,
+    0x60, 0x03, 0x7E, 0x7D, 0x7C, 0x01, 0x7C, 0x60, 0x01, 0x7F, 0x01, 0x7F,
+    0x02, 0x16, 0x02, 0x03, 0x65, 0x6E, 0x76, 0x04, 0x73, 0x74, 0x6F, 0x70,
+    0x00, 0x00, 0x03, 0x65, 0x6E, 0x76, 0x03, 0x6E, 0x6F, 0x70, 0x00, 0x01,
+    0x03, 0x08, 0x07, 0x02, 0x02, 0x03, 0x04, 0x04, 0x04, 0x00, 0x05, 0x03,
+    0x01, 0x00, 0x01, 0x07, 0x3F, 0x08, 0x06, 0x6D, 0x65, 0x6D, 0x6F, 0x72,
+    0x79, 0x02, 0x00, 0x03, 0x61, 0x64, 0x64, 0x00, 0x02, 0x03, 0x64, 0x69,
+    0x76, 0x00, 0x03, 0x03, 0x6D, 0x69, 0x78, 0x00, 0x04, 0x03, 0x73, 0x75,
+    0x6D, 0x00, 0x05, 0x07, 0x73, 0x74, 0x6F, 0x70, 0x5F, 0x69, 0x66, 0x00,
+    0x06, 0x04, 0x73, 0x70, 0x69, 0x6E, 0x00, 0x07, 0x09, 0x63, 0x61, 0x6C,
+    0x6C, 0x5F, 0x68, 0x6F, 0x73, 0x74, 0x00, 0x08, 0x0A, 0x6E, 0x07, 0x07,
+    0x00, 0x20, 0x00, 0x20, 0x01, 0x6A, 0x0B, 0x07, 0x00, 0x20, 0x00, 0x20,
+    0x01, 0x6D, 0x0B, 0x0C, 0x00, 0x20, 0x00, 0xB9, 0x20, 0x01, 0xBB, 0xA0,
+    0x20, 0x02, 0xA0, 0x0B, 0x21, 0x01, 0x01, 0x7F, 0x02, 0x40, 0x03, 0x40,
+    0x20, 0x00, 0x45, 0x0D, 0x01, 0x20, 0x01, 0x20, 0x00, 0x6A, 0x21, 0x01,
+    0x20, 0x00, 0x41, 0x01, 0x6B, 0x21, 0x00, 0x0C, 0x00, 0x0B, 0x0B, 0x20,
+    0x01, 0x0B, 0x0D, 0x00, 0x20, 0x00, 0x04, 0x40, 0x20, 0x00, 0x10, 0x00,
+    0x0B, 0x20, 0x00, 0x0B, 0x06, 0x00, 0x20, 0x00, 0x10, 0x05, 0x0B, 0x18,
+    0x00, 0x02, 0x40, 0x03, 0x40, 0x20, 0x00, 0x45, 0x0D, 0x01, 0x10, 0x01,
+    0x20, 0x00, 0x41, 0x01, 0x6B, 0x21, 0x00, 0x0C, 0x00, 0x0B, 0x0B, 0x0B,
+    0x0B, 0x0B, 0x01, 0x00, 0x41, 0x10, 0x0B, 0x05, 0x68, 0x65, 0x6C, 0x6C,
+    0x6F
+};
@@ -0,0 +1,16 @@
+(module
+  (import "env" "checksum" (func $checksum (param i32 i32) (result i32)))
+  (import "env" "length" (func $length (param i32) (result i32)))
+  (import "env" "peek" (func $peek (param i32) (result i32)))
+  (import "env" "combine" (func $combine (param i64 i32 i64) (result i64)))
+  (memory (export "memory") 1)
+  (func (export "checksum") (param i32 i32) (result i32)
+    (call $checksum (local.get 0) (local.get 1)))
+  (func (export "length") (param i32) (result i32)
+    (call $length (local.get 0)))
+  (func (export "peek") (param i32) (result i32)
+    (call $peek (local.get 0)))
+  (func (export "combine") (param i64 i32 i64) (result i64)
+    (call $combine (local.get 0) (local.get 1) (local.get 2)))
+  (data (i32.const 16) "hello")
+)
@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+static unsigned char natives_wasm[] = {
+    0x00, 0x61, 0x73, 0x6D, 0x01, 0x00, 0x00, 0x00, 0x01, 0x13, 0x03, 0x60,
+    0x02, 0x7F, 0x7F, 0x01, 0x7F, 0x60, 0x01, 0x7F, 0x01, 0x7F, 0x60, 0x03,
+    0x7E, 0x7F, 0x7E, 0x01, 0x7E, 0x02, 0x36, 0x04, 0x03, 0x65, 0x6E, 0x76,
+    0x08, 0x63, 0x68, 0x65, 0x63, 0x6B, 0x73, 0x75, 0x6D, 0x00, 0x00, 0x03,
+    0x65, 0x6E, 0x76, 0x06, 0x6C, 0x65, 0x6E, 0x67, 0x74, 0x68, 0x00, 0x01,
+    0x03, 0x65, 0x6E, 0x76, 0x04, 0x70, 0x65, 0x65, 0x6B, 0x00, 0x01, 0x03,
+    0x65, 0x6E, 0x76, 0x07, 0x63, 0x6F, 0x6D, 0x62, 0x69, 0x6E, 0x65, 0x00,
+    0x02, 0x03, 0x05, 0x04, 0x00, 0x01, 0x01, 0x02, 0x05, 0x03, 0x01, 0x00,
+    0x01, 0x07, 0x2F, 0x05, 0x06, 0x6D, 0x65, 0x6D, 0x6F, 0x72, 0x79, 0x02,
+    0x00, 0x08, 0x63, 0x68, 0x65, 0x63, 0x6B, 0x73, 0x75, 0x6D, 0x00, 0x04,
+    0x06, 0x6C, 0x65, 0x6E, 0x67, 0x74, 0x68, 0x00, 0x05, 0x04, 0x70, 0x65,
+    0x65, 0x6B, 0x00, 0x06, 0x07, 0x63, 0x6F, 0x6D, 0x62, 0x69, 0x6E, 0x65,
+    0x00, 0x07, 0x0A, 0x23, 0x04, 0x08, 0x00, 0x20, 0x00, 0x20, 0x01, 0x10,
+    0x00, 0x0B, 0x06, 0x00, 0x20, 0x00, 0x10, 0x01, 0x0B, 0x06, 0x00, 0x20,
+    0x00, 0x10, 0x02, 0x0B, 0x0A, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02,
+    0x10, 0x03, 0x0B, 0x0B, 0x0B, 0x01, 0x00, 0x41, 0x10, 0x0B, 0x05, 0x68,
+    0x65, 0x6C, 0x6C, 0x6F
+};
@@ -40,6 +40,7 @@ readonly THREAD_PROPOSAL_TESTS="tests/proposals/wasi-threads/"
 readonly THREAD_INTERNAL_TESTS="${WAMR_DIR}/core/iwasm/libraries/lib-wasi-threads/test/"
 readonly THREAD_STRESS_TESTS="${WAMR_DIR}/core/iwasm/libraries/lib-wasi-threads/stress-test/"
 readonly LIB_SOCKET_TESTS="${WAMR_DIR}/core/iwasm/libraries/lib-socket/test/"
+readonly LIBC_WASI_TESTS="${WAMR_DIR}/core/iwasm/libraries/libc-wasi/test/"
 
 add_env_key_to_test_config_file() {
     filepath="tests/$2/testsuite/$3.json"
@@ -119,6 +120,12 @@ if [[ $MODE != "aot" ]];then
             ${THREAD_INTERNAL_TESTS} \
             ${LIB_SOCKET_TESTS}"
 
+    # The libc-wasi tests check the Linux implementation of poll_oneoff and
+    # sock_sendfile
+    if [ "$PLATFORM" == "linux" ]; then
+        TEST_OPTIONS="${TEST_OPTIONS} ${LIBC_WASI_TESTS}"
+    fi
+
     if [ -n "$TEST_FILTER" ]; then
         TEST_OPTIONS="${TEST_OPTIONS} --exclude-filter ${TEST_FILTER}"
     fi